@@ -0,0 +1,201 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/* C interface of the Informer library (libinformer)
+
+   Analyzers are opaque handles, one type per sample precision (informer_f32
+   and informer_f64). All the data is passed as caller owned arrays: once an
+   analyzer has analyzed a frame with the same settings (sizes, options and
+   normalization), nothing is allocated per call, and no pointer passed to the
+   library is retained after the call returns.
+
+   Descriptors are written in a fixed order, given by the index tables below:
+   time descriptors first (INFORMER_TIME_DESCRIPTOR_COUNT values), frequency
+   descriptors then (INFORMER_FREQUENCY_DESCRIPTOR_COUNT values). New
+   descriptors are only appended, so the indices are stable across versions
+   with the same INFORMER_C_ABI_VERSION.
+
+   An analyzer must not be used by more than one thread at a time, different
+   analyzers can be used concurrently. */
+
+#ifndef INFORMER_C_H_
+#define INFORMER_C_H_
+
+#include <stddef.h>
+
+#if defined(INFORMER_C_STATIC)
+    #define INFORMER_C_API
+#elif defined(_WIN32)
+    #if defined(INFORMER_C_BUILD)
+        #define INFORMER_C_API __declspec(dllexport)
+    #else
+        #define INFORMER_C_API __declspec(dllimport)
+    #endif
+#else
+    #define INFORMER_C_API __attribute__((visibility("default")))
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+#define INFORMER_C_ABI_VERSION 1
+
+/* Return codes */
+#define INFORMER_OK 0
+#define INFORMER_ERROR_INVALID_ARGUMENT -1
+#define INFORMER_ERROR_NOT_FOUND -2
+#define INFORMER_ERROR_INTERNAL -3
+
+/* Descriptor domains */
+#define INFORMER_DOMAIN_TIME 0
+#define INFORMER_DOMAIN_FREQUENCY 1
+
+/* Time descriptors indices */
+#define INFORMER_TIME_PEAK 0
+#define INFORMER_TIME_RMS 1
+#define INFORMER_TIME_VARIANCE 2
+#define INFORMER_TIME_KURTOSIS 3
+#define INFORMER_TIME_SKEWNESS 4
+#define INFORMER_TIME_F0 5
+#define INFORMER_TIME_ZEROCROSSING 6
+#define INFORMER_TIME_DESCRIPTOR_COUNT 7
+
+/* Frequency descriptors indices */
+#define INFORMER_FREQUENCY_CENTROID 0
+#define INFORMER_FREQUENCY_SPREAD 1
+#define INFORMER_FREQUENCY_CRESTFACTOR 2
+#define INFORMER_FREQUENCY_DECREASE 3
+#define INFORMER_FREQUENCY_ENTROPY 4
+#define INFORMER_FREQUENCY_FLATNESS 5
+#define INFORMER_FREQUENCY_FLUX 6
+#define INFORMER_FREQUENCY_IRREGULARITY 7
+#define INFORMER_FREQUENCY_KURTOSIS 8
+#define INFORMER_FREQUENCY_PEAK 9
+#define INFORMER_FREQUENCY_ROLLOFF 10
+#define INFORMER_FREQUENCY_SKEWNESS 11
+#define INFORMER_FREQUENCY_SLOPE 12
+#define INFORMER_FREQUENCY_F0 13
+#define INFORMER_FREQUENCY_DESCRIPTOR_COUNT 14
+
+typedef struct informer_f32 informer_f32;
+typedef struct informer_f64 informer_f64;
+
+/* Library information */
+INFORMER_C_API int informer_abi_version(void);
+INFORMER_C_API const char* informer_time_descriptor_name(size_t index);
+INFORMER_C_API const char* informer_frequency_descriptor_name(size_t index);
+
+/* Profiling, effective only when libinformer is built with INFORMER_PROFILE
+   (otherwise no stage is reported and the trace is empty) */
+typedef struct informer_profile_stage
+{
+    char name[64];
+    unsigned long long count;
+    double mean_ns;
+    double p99_ns;
+} informer_profile_stage;
+
+/* Returns the number of profiled stages, at most capacity of them are copied */
+INFORMER_C_API size_t informer_profile_summary(informer_profile_stage* stages, size_t capacity);
+/* Returns the length of the Chrome trace JSON, copied (null terminated) if it fits in capacity */
+INFORMER_C_API size_t informer_profile_chrome_trace(char* trace, size_t capacity);
+INFORMER_C_API int informer_profile_write_chrome_trace(const char* path);
+INFORMER_C_API void informer_profile_reset(void);
+
+/* Single precision analyzer */
+
+/* Returns NULL if the parameters are not valid or the allocation fails */
+INFORMER_C_API informer_f32* informer_f32_create(double sample_rate, unsigned int stft_size);
+INFORMER_C_API void informer_f32_destroy(informer_f32* informer);
+
+INFORMER_C_API int informer_f32_set_sample_rate(informer_f32* informer, double sample_rate);
+INFORMER_C_API int informer_f32_set_stft_size(informer_f32* informer, unsigned int stft_size);
+INFORMER_C_API int informer_f32_set_rolloff_point(informer_f32* informer, double rolloff_point);
+INFORMER_C_API int informer_f32_set_chroma_bins(informer_f32* informer, unsigned int chroma_bins);
+INFORMER_C_API int informer_f32_set_pitch_tracking(informer_f32* informer, int enable);
+INFORMER_C_API int informer_f32_set_chroma_key(informer_f32* informer, int enable);
+
+/* Analyze one frame. buffer (buffer_size samples) or magnitudes (magnitudes_size
+   values, stft_size / 2 + 1, any other size is rejected) can be NULL to skip the
+   corresponding domain.
+   time_descriptors and frequency_descriptors, if not NULL, receive
+   INFORMER_TIME_DESCRIPTOR_COUNT and INFORMER_FREQUENCY_DESCRIPTOR_COUNT values.
+   The previous magnitudes (for the flux) are those of the previous call. */
+INFORMER_C_API int informer_f32_analyze(informer_f32* informer,
+                                        const float* buffer, size_t buffer_size,
+                                        const float* magnitudes, size_t magnitudes_size,
+                                        float* time_descriptors, float* frequency_descriptors,
+                                        int normalize);
+
+/* Analyze frames consecutive frames. Frame i starts at buffers + i * buffer_stride
+   and magnitudes + i * magnitudes_stride, descriptors of frame i are written at
+   time_descriptors + i * INFORMER_TIME_DESCRIPTOR_COUNT and
+   frequency_descriptors + i * INFORMER_FREQUENCY_DESCRIPTOR_COUNT. */
+INFORMER_C_API int informer_f32_analyze_batch(informer_f32* informer, size_t frames,
+                                              const float* buffers, size_t buffer_size, size_t buffer_stride,
+                                              const float* magnitudes, size_t magnitudes_size, size_t magnitudes_stride,
+                                              float* time_descriptors, float* frequency_descriptors,
+                                              int normalize);
+
+/* Any descriptor of the last analyzed frame by domain and name, including the ones
+   outside the index tables ("f0tracked" and "voicing" in the time domain, "key" and
+   "keystrength" in the frequency domain, see set_chroma_key) */
+INFORMER_C_API int informer_f32_get_descriptor(const informer_f32* informer, int domain, const char* name, float* value);
+
+/* Copy the chroma vector of the last frame, returns the number of chroma bins
+   (the copy is performed only if capacity is large enough) */
+INFORMER_C_API size_t informer_f32_get_chroma(const informer_f32* informer, float* chroma, size_t capacity);
+
+/* Double precision analyzer */
+
+INFORMER_C_API informer_f64* informer_f64_create(double sample_rate, unsigned int stft_size);
+INFORMER_C_API void informer_f64_destroy(informer_f64* informer);
+
+INFORMER_C_API int informer_f64_set_sample_rate(informer_f64* informer, double sample_rate);
+INFORMER_C_API int informer_f64_set_stft_size(informer_f64* informer, unsigned int stft_size);
+INFORMER_C_API int informer_f64_set_rolloff_point(informer_f64* informer, double rolloff_point);
+INFORMER_C_API int informer_f64_set_chroma_bins(informer_f64* informer, unsigned int chroma_bins);
+INFORMER_C_API int informer_f64_set_pitch_tracking(informer_f64* informer, int enable);
+INFORMER_C_API int informer_f64_set_chroma_key(informer_f64* informer, int enable);
+
+INFORMER_C_API int informer_f64_analyze(informer_f64* informer,
+                                        const double* buffer, size_t buffer_size,
+                                        const double* magnitudes, size_t magnitudes_size,
+                                        double* time_descriptors, double* frequency_descriptors,
+                                        int normalize);
+
+INFORMER_C_API int informer_f64_analyze_batch(informer_f64* informer, size_t frames,
+                                              const double* buffers, size_t buffer_size, size_t buffer_stride,
+                                              const double* magnitudes, size_t magnitudes_size, size_t magnitudes_stride,
+                                              double* time_descriptors, double* frequency_descriptors,
+                                              int normalize);
+
+INFORMER_C_API int informer_f64_get_descriptor(const informer_f64* informer, int domain, const char* name, double* value);
+
+INFORMER_C_API size_t informer_f64_get_chroma(const informer_f64* informer, double* chroma, size_t capacity);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif // INFORMER_C_H_
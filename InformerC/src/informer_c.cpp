@@ -0,0 +1,547 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#include "informer_c.h"
+#include "informer.h"
+
+#include <array>
+#include <new>
+
+// The index tables of the C header must follow the descriptor enums of the library
+static_assert(INFORMER_TIME_DESCRIPTOR_COUNT == static_cast<int>(Informer::TimeDescriptor::Count), "Time descriptor table mismatch");
+static_assert(INFORMER_FREQUENCY_DESCRIPTOR_COUNT == static_cast<int>(Informer::FrequencyDescriptor::Count), "Frequency descriptor table mismatch");
+static_assert(INFORMER_TIME_ZEROCROSSING == static_cast<int>(Informer::TimeDescriptor::ZeroCrossing), "Time descriptor table mismatch");
+static_assert(INFORMER_FREQUENCY_F0 == static_cast<int>(Informer::FrequencyDescriptor::F0), "Frequency descriptor table mismatch");
+
+namespace
+{
+
+// Descriptors of the index tables inside the maps of the analyzer, found by name only when
+// the maps gain entries (the elements of an unordered_map never move), as Informer does for
+// its normalizers
+template <typename TSample>
+struct DescriptorSlots
+{
+    std::array<const TSample*, INFORMER_TIME_DESCRIPTOR_COUNT> time = {};
+    std::array<const TSample*, INFORMER_FREQUENCY_DESCRIPTOR_COUNT> frequency = {};
+    size_t time_bound = 0u;
+    size_t frequency_bound = 0u;
+};
+
+} // namespace
+
+struct informer_f32
+{
+    Informer::Informer<float> informer;
+    DescriptorSlots<float> slots;
+};
+
+struct informer_f64
+{
+    Informer::Informer<double> informer;
+    DescriptorSlots<double> slots;
+};
+
+namespace
+{
+
+template <typename Handle>
+Handle* create(double sample_rate, unsigned int stft_size)
+{
+    if (!(sample_rate > 0.0) || stft_size <= 2u)
+    {
+        return nullptr;
+    }
+
+    Handle* handle = new (std::nothrow) Handle();
+
+    if (handle != nullptr)
+    {
+        using TSample = decltype(handle->informer.get_sample_rate());
+        handle->informer.set_sample_rate(static_cast<TSample>(sample_rate));
+        handle->informer.set_stft_size(stft_size);
+    }
+
+    return handle;
+}
+
+template <typename TSample, size_t Count>
+void bind_slots(const std::unordered_map<std::string, TSample>& descriptors, const char* const (&names)[Count],
+                std::array<const TSample*, Count>& slots, size_t& bound)
+{
+    if (bound != descriptors.size())
+    {
+        for (size_t d = 0; d < Count; d++)
+        {
+            const auto it = descriptors.find(names[d]);
+            slots[d] = it != descriptors.end() ? &it->second : nullptr;
+        }
+
+        bound = descriptors.size();
+    }
+}
+
+template <typename TSample, size_t Count>
+void write_slots(const std::array<const TSample*, Count>& slots, TSample* values)
+{
+    for (size_t d = 0; d < Count; d++)
+    {
+        values[d] = slots[d] != nullptr ? *slots[d] : static_cast<TSample>(0.0);
+    }
+}
+
+template <typename TSample>
+void write_descriptors(const Informer::Informer<TSample>& informer, DescriptorSlots<TSample>& slots, bool time, bool frequency,
+                       TSample* time_descriptors, TSample* frequency_descriptors)
+{
+    if (time && time_descriptors != nullptr)
+    {
+        bind_slots(informer.get_time_descriptors(), Informer::time_descriptor_names, slots.time, slots.time_bound);
+        write_slots(slots.time, time_descriptors);
+    }
+
+    if (frequency && frequency_descriptors != nullptr)
+    {
+        bind_slots(informer.get_frequency_descriptors(), Informer::frequency_descriptor_names, slots.frequency, slots.frequency_bound);
+        write_slots(slots.frequency, frequency_descriptors);
+    }
+}
+
+template <typename TSample>
+int analyze_frame(Informer::Informer<TSample>& informer, DescriptorSlots<TSample>& slots,
+                  const TSample* buffer, size_t buffer_size,
+                  const TSample* magnitudes, size_t magnitudes_size,
+                  TSample* time_descriptors, TSample* frequency_descriptors,
+                  int normalize)
+{
+    const bool time = buffer != nullptr;
+    const bool frequency = magnitudes != nullptr;
+
+    // A spectrum of another size would change the STFT size of the analyzer
+    if (frequency && magnitudes_size != informer.get_stft_size() / 2u + 1u)
+    {
+        return INFORMER_ERROR_INVALID_ARGUMENT;
+    }
+
+    if ((time && !informer.set_buffer(buffer, buffer_size)) ||
+        (frequency && !informer.set_magnitudes(magnitudes, magnitudes_size)))
+    {
+        return INFORMER_ERROR_INVALID_ARGUMENT;
+    }
+
+    informer.compute_descriptors(time, frequency);
+
+    if (normalize)
+    {
+        informer.normalize_descriptors();
+    }
+
+    write_descriptors(informer, slots, time, frequency, time_descriptors, frequency_descriptors);
+
+    return INFORMER_OK;
+}
+
+template <typename Handle, typename TSample>
+int analyze(Handle* handle,
+            const TSample* buffer, size_t buffer_size,
+            const TSample* magnitudes, size_t magnitudes_size,
+            TSample* time_descriptors, TSample* frequency_descriptors,
+            int normalize)
+{
+    if (handle == nullptr || (buffer == nullptr && magnitudes == nullptr))
+    {
+        return INFORMER_ERROR_INVALID_ARGUMENT;
+    }
+
+    try
+    {
+        return analyze_frame(handle->informer, handle->slots, buffer, buffer_size, magnitudes, magnitudes_size,
+                             time_descriptors, frequency_descriptors, normalize);
+    }
+    catch (...)
+    {
+        return INFORMER_ERROR_INTERNAL;
+    }
+}
+
+template <typename Handle, typename TSample>
+int analyze_batch(Handle* handle, size_t frames,
+                  const TSample* buffers, size_t buffer_size, size_t buffer_stride,
+                  const TSample* magnitudes, size_t magnitudes_size, size_t magnitudes_stride,
+                  TSample* time_descriptors, TSample* frequency_descriptors,
+                  int normalize)
+{
+    if (handle == nullptr || (buffers == nullptr && magnitudes == nullptr) ||
+        (buffers != nullptr && buffer_stride < buffer_size) ||
+        (magnitudes != nullptr && magnitudes_stride < magnitudes_size))
+    {
+        return INFORMER_ERROR_INVALID_ARGUMENT;
+    }
+
+    try
+    {
+        for (size_t f = 0; f < frames; f++)
+        {
+            const int result = analyze_frame(handle->informer, handle->slots,
+                                             buffers != nullptr ? buffers + f * buffer_stride : nullptr, buffer_size,
+                                             magnitudes != nullptr ? magnitudes + f * magnitudes_stride : nullptr, magnitudes_size,
+                                             time_descriptors != nullptr ? time_descriptors + f * INFORMER_TIME_DESCRIPTOR_COUNT : nullptr,
+                                             frequency_descriptors != nullptr ? frequency_descriptors + f * INFORMER_FREQUENCY_DESCRIPTOR_COUNT : nullptr,
+                                             normalize);
+
+            if (result != INFORMER_OK)
+            {
+                return result;
+            }
+        }
+    }
+    catch (...)
+    {
+        return INFORMER_ERROR_INTERNAL;
+    }
+
+    return INFORMER_OK;
+}
+
+template <typename Handle, typename TSample>
+int get_descriptor(const Handle* handle, int domain, const char* name, TSample* value)
+{
+    if (handle == nullptr || name == nullptr || value == nullptr ||
+        (domain != INFORMER_DOMAIN_TIME && domain != INFORMER_DOMAIN_FREQUENCY))
+    {
+        return INFORMER_ERROR_INVALID_ARGUMENT;
+    }
+
+    try
+    {
+        const auto& descriptors = domain == INFORMER_DOMAIN_TIME ? handle->informer.get_time_descriptors() :
+                                  handle->informer.get_frequency_descriptors();
+
+        auto descriptor = descriptors.find(name);
+
+        if (descriptor == descriptors.end())
+        {
+            return INFORMER_ERROR_NOT_FOUND;
+        }
+
+        *value = descriptor->second;
+    }
+    catch (...)
+    {
+        return INFORMER_ERROR_INTERNAL;
+    }
+
+    return INFORMER_OK;
+}
+
+template <typename Handle, typename TSample>
+size_t get_chroma(const Handle* handle, TSample* chroma, size_t capacity)
+{
+    if (handle == nullptr)
+    {
+        return 0;
+    }
+
+    try
+    {
+        const auto& chroma_vector = handle->informer.get_chroma();
+
+        if (chroma != nullptr && capacity >= chroma_vector.size())
+        {
+            std::copy(chroma_vector.begin(), chroma_vector.end(), chroma);
+        }
+
+        return chroma_vector.size();
+    }
+    catch (...)
+    {
+        return 0;
+    }
+}
+
+inline int status(bool result)
+{
+    return result ? INFORMER_OK : INFORMER_ERROR_INVALID_ARGUMENT;
+}
+
+} // namespace
+
+extern "C" {
+
+int informer_abi_version(void)
+{
+    return INFORMER_C_ABI_VERSION;
+}
+
+const char* informer_time_descriptor_name(size_t index)
+{
+    return index < INFORMER_TIME_DESCRIPTOR_COUNT ? Informer::time_descriptor_names[index] : nullptr;
+}
+
+const char* informer_frequency_descriptor_name(size_t index)
+{
+    return index < INFORMER_FREQUENCY_DESCRIPTOR_COUNT ? Informer::frequency_descriptor_names[index] : nullptr;
+}
+
+// PROFILING
+
+size_t informer_profile_summary(informer_profile_stage* stages, size_t capacity)
+{
+    try
+    {
+        const auto summary = Informer::Profiler::summary();
+
+        for (size_t s = 0; s < std::min(capacity, summary.size()) && stages != nullptr; s++)
+        {
+            const size_t length = std::min(summary[s].name.size(), sizeof(stages[s].name) - 1u);
+            std::copy(summary[s].name.begin(), summary[s].name.begin() + length, stages[s].name);
+            stages[s].name[length] = '\0';
+            stages[s].count = summary[s].count;
+            stages[s].mean_ns = summary[s].mean_ns;
+            stages[s].p99_ns = summary[s].p99_ns;
+        }
+
+        return summary.size();
+    }
+    catch (...)
+    {
+        return 0;
+    }
+}
+
+size_t informer_profile_chrome_trace(char* trace, size_t capacity)
+{
+    try
+    {
+        const std::string json = Informer::Profiler::chrome_trace();
+
+        if (trace != nullptr && capacity > json.size())
+        {
+            std::copy(json.begin(), json.end(), trace);
+            trace[json.size()] = '\0';
+        }
+
+        return json.size();
+    }
+    catch (...)
+    {
+        return 0;
+    }
+}
+
+int informer_profile_write_chrome_trace(const char* path)
+{
+    if (path == nullptr)
+    {
+        return INFORMER_ERROR_INVALID_ARGUMENT;
+    }
+
+    try
+    {
+        return Informer::Profiler::write_chrome_trace(path) ? INFORMER_OK : INFORMER_ERROR_INTERNAL;
+    }
+    catch (...)
+    {
+        return INFORMER_ERROR_INTERNAL;
+    }
+}
+
+void informer_profile_reset(void)
+{
+    Informer::Profiler::reset();
+}
+
+// SINGLE PRECISION
+
+informer_f32* informer_f32_create(double sample_rate, unsigned int stft_size)
+{
+    return create<informer_f32>(sample_rate, stft_size);
+}
+
+void informer_f32_destroy(informer_f32* informer)
+{
+    delete informer;
+}
+
+int informer_f32_set_sample_rate(informer_f32* informer, double sample_rate)
+{
+    return informer != nullptr ? status(informer->informer.set_sample_rate(static_cast<float>(sample_rate))) : INFORMER_ERROR_INVALID_ARGUMENT;
+}
+
+int informer_f32_set_stft_size(informer_f32* informer, unsigned int stft_size)
+{
+    return informer != nullptr ? status(informer->informer.set_stft_size(stft_size)) : INFORMER_ERROR_INVALID_ARGUMENT;
+}
+
+int informer_f32_set_rolloff_point(informer_f32* informer, double rolloff_point)
+{
+    return informer != nullptr ? status(informer->informer.set_rolloff_point(static_cast<float>(rolloff_point))) : INFORMER_ERROR_INVALID_ARGUMENT;
+}
+
+int informer_f32_set_chroma_bins(informer_f32* informer, unsigned int chroma_bins)
+{
+    return informer != nullptr ? status(informer->informer.set_chroma_bins(chroma_bins)) : INFORMER_ERROR_INVALID_ARGUMENT;
+}
+
+int informer_f32_set_pitch_tracking(informer_f32* informer, int enable)
+{
+    if (informer == nullptr)
+    {
+        return INFORMER_ERROR_INVALID_ARGUMENT;
+    }
+
+    informer->informer.set_pitch_tracking(enable != 0);
+
+    return INFORMER_OK;
+}
+
+int informer_f32_set_chroma_key(informer_f32* informer, int enable)
+{
+    if (informer == nullptr)
+    {
+        return INFORMER_ERROR_INVALID_ARGUMENT;
+    }
+
+    informer->informer.set_chroma_key(enable != 0);
+
+    return INFORMER_OK;
+}
+
+int informer_f32_analyze(informer_f32* informer,
+                         const float* buffer, size_t buffer_size,
+                         const float* magnitudes, size_t magnitudes_size,
+                         float* time_descriptors, float* frequency_descriptors,
+                         int normalize)
+{
+    return analyze(informer, buffer, buffer_size, magnitudes, magnitudes_size,
+                   time_descriptors, frequency_descriptors, normalize);
+}
+
+int informer_f32_analyze_batch(informer_f32* informer, size_t frames,
+                               const float* buffers, size_t buffer_size, size_t buffer_stride,
+                               const float* magnitudes, size_t magnitudes_size, size_t magnitudes_stride,
+                               float* time_descriptors, float* frequency_descriptors,
+                               int normalize)
+{
+    return analyze_batch(informer, frames, buffers, buffer_size, buffer_stride,
+                         magnitudes, magnitudes_size, magnitudes_stride,
+                         time_descriptors, frequency_descriptors, normalize);
+}
+
+int informer_f32_get_descriptor(const informer_f32* informer, int domain, const char* name, float* value)
+{
+    return get_descriptor(informer, domain, name, value);
+}
+
+size_t informer_f32_get_chroma(const informer_f32* informer, float* chroma, size_t capacity)
+{
+    return get_chroma(informer, chroma, capacity);
+}
+
+// DOUBLE PRECISION
+
+informer_f64* informer_f64_create(double sample_rate, unsigned int stft_size)
+{
+    return create<informer_f64>(sample_rate, stft_size);
+}
+
+void informer_f64_destroy(informer_f64* informer)
+{
+    delete informer;
+}
+
+int informer_f64_set_sample_rate(informer_f64* informer, double sample_rate)
+{
+    return informer != nullptr ? status(informer->informer.set_sample_rate(sample_rate)) : INFORMER_ERROR_INVALID_ARGUMENT;
+}
+
+int informer_f64_set_stft_size(informer_f64* informer, unsigned int stft_size)
+{
+    return informer != nullptr ? status(informer->informer.set_stft_size(stft_size)) : INFORMER_ERROR_INVALID_ARGUMENT;
+}
+
+int informer_f64_set_rolloff_point(informer_f64* informer, double rolloff_point)
+{
+    return informer != nullptr ? status(informer->informer.set_rolloff_point(rolloff_point)) : INFORMER_ERROR_INVALID_ARGUMENT;
+}
+
+int informer_f64_set_chroma_bins(informer_f64* informer, unsigned int chroma_bins)
+{
+    return informer != nullptr ? status(informer->informer.set_chroma_bins(chroma_bins)) : INFORMER_ERROR_INVALID_ARGUMENT;
+}
+
+int informer_f64_set_pitch_tracking(informer_f64* informer, int enable)
+{
+    if (informer == nullptr)
+    {
+        return INFORMER_ERROR_INVALID_ARGUMENT;
+    }
+
+    informer->informer.set_pitch_tracking(enable != 0);
+
+    return INFORMER_OK;
+}
+
+int informer_f64_set_chroma_key(informer_f64* informer, int enable)
+{
+    if (informer == nullptr)
+    {
+        return INFORMER_ERROR_INVALID_ARGUMENT;
+    }
+
+    informer->informer.set_chroma_key(enable != 0);
+
+    return INFORMER_OK;
+}
+
+int informer_f64_analyze(informer_f64* informer,
+                         const double* buffer, size_t buffer_size,
+                         const double* magnitudes, size_t magnitudes_size,
+                         double* time_descriptors, double* frequency_descriptors,
+                         int normalize)
+{
+    return analyze(informer, buffer, buffer_size, magnitudes, magnitudes_size,
+                   time_descriptors, frequency_descriptors, normalize);
+}
+
+int informer_f64_analyze_batch(informer_f64* informer, size_t frames,
+                               const double* buffers, size_t buffer_size, size_t buffer_stride,
+                               const double* magnitudes, size_t magnitudes_size, size_t magnitudes_stride,
+                               double* time_descriptors, double* frequency_descriptors,
+                               int normalize)
+{
+    return analyze_batch(informer, frames, buffers, buffer_size, buffer_stride,
+                         magnitudes, magnitudes_size, magnitudes_stride,
+                         time_descriptors, frequency_descriptors, normalize);
+}
+
+int informer_f64_get_descriptor(const informer_f64* informer, int domain, const char* name, double* value)
+{
+    return get_descriptor(informer, domain, name, value);
+}
+
+size_t informer_f64_get_chroma(const informer_f64* informer, double* chroma, size_t capacity)
+{
+    return get_chroma(informer, chroma, capacity);
+}
+
+} // extern "C"
@@ -0,0 +1,397 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef INFORMER_CLI_ANALYSIS_CACHE_H_
+#define INFORMER_CLI_ANALYSIS_CACHE_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <string>
+#include <system_error>
+#include <thread>
+#include <vector>
+
+#include "descriptor_files.h"
+
+// On disk cache of analyzed files.
+//
+// An entry holds the descriptors of one file, keyed on a hash of the decoded
+// samples and a hash of the analysis parameters (frame, hop, window, sample
+// rate, descriptors, library version...). A file seen before with the same
+// parameters is not analyzed again. The entry also stores a hash of the
+// samples read by each block of frames, and a link file remembers the last
+// entry of each input path: when a file changes, only the blocks whose
+// samples changed are analyzed again.
+//
+// The least recently used entries (by modification time, refreshed on each
+// hit) are removed by evict() when the cache grows past its size.
+
+// Fast non cryptographic 64 bit hash, four independent lanes
+inline uint64_t hash64(const void* data, const size_t& size, const uint64_t& seed = 0u)
+{
+    constexpr uint64_t prime_1 = 0x9E3779B185EBCA87ull;
+    constexpr uint64_t prime_2 = 0xC2B2AE3D27D4EB4Full;
+
+    auto round = [](uint64_t lane, const uint64_t& input)
+    {
+        lane += input * prime_2;
+        lane = (lane << 31) | (lane >> 33);
+        return lane * prime_1;
+    };
+
+    const uint8_t* p = static_cast<const uint8_t*>(data);
+    uint64_t lanes[4] = {seed + prime_1 + prime_2, seed + prime_2, seed, seed - prime_1};
+    size_t i = 0u;
+
+    for (; i + 32u <= size; i += 32u)
+    {
+        for (size_t l = 0; l < 4; l++)
+        {
+            uint64_t word;
+            std::memcpy(&word, p + i + l * 8u, 8u);
+            lanes[l] = round(lanes[l], word);
+        }
+    }
+
+    uint64_t hash = size;
+    for (size_t l = 0; l < 4; l++)
+    {
+        hash = (hash ^ round(0u, lanes[l])) * prime_1 + prime_2;
+    }
+
+    for (; i + 8u <= size; i += 8u)
+    {
+        uint64_t word;
+        std::memcpy(&word, p + i, 8u);
+        hash = round(hash ^ word, word);
+    }
+
+    for (; i < size; i++)
+    {
+        hash = round(hash ^ p[i], p[i]);
+    }
+
+    // Final avalanche
+    hash ^= hash >> 33;
+    hash *= prime_2;
+    hash ^= hash >> 29;
+    hash *= prime_1;
+    hash ^= hash >> 32;
+
+    return hash;
+}
+
+inline uint64_t hash_combine(const uint64_t& hash, const std::string& value)
+{
+    return hash64(value.data(), value.size(), hash);
+}
+
+struct CacheEntryHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t descriptor_count;
+    uint64_t parameters;
+    uint64_t content;
+    uint64_t frames;
+    uint32_t block_frames;
+    uint32_t block_count;
+};
+
+static_assert(sizeof(CacheEntryHeader) == 48u, "Unexpected CacheEntryHeader padding");
+
+// A cached analysis: descriptors and per block hashes
+struct CachedAnalysis
+{
+    uint64_t content = 0u;
+    uint32_t block_frames = 0u;
+    std::vector<uint64_t> block_hashes;
+    DescriptorTable table;
+};
+
+class AnalysisCache
+{
+public:
+    static constexpr char entry_magic[8] = {'I', 'N', 'F', 'O', 'C', 'C', 'H', '\0'};
+    static constexpr uint32_t entry_version = 1u;
+
+    AnalysisCache(const std::string& directory, const uint64_t& max_bytes) : directory_(directory), max_bytes_(max_bytes)
+    {
+        std::error_code error;
+
+        if (!directory_.empty())
+        {
+            std::filesystem::create_directories(directory_, error);
+        }
+    }
+
+    bool is_enabled() const
+    {
+        return !directory_.empty();
+    }
+
+    // Entry with exactly this content and these parameters
+    bool load(const uint64_t& parameters, const uint64_t& content, CachedAnalysis& analysis) const
+    {
+        const std::filesystem::path path = entry_path_(parameters, content);
+
+        if (!is_enabled() || !read_entry_(path, parameters, analysis) || analysis.content != content)
+        {
+            return false;
+        }
+
+        // Refresh the LRU stamp
+        std::error_code error;
+        std::filesystem::last_write_time(path, std::filesystem::file_time_type::clock::now(), error);
+
+        return true;
+    }
+
+    // Last entry stored for this input path with these parameters, whatever its content
+    bool load_previous(const uint64_t& parameters, const std::string& input, CachedAnalysis& analysis) const
+    {
+        if (!is_enabled())
+        {
+            return false;
+        }
+
+        std::ifstream link(link_path_(parameters, input), std::ios::binary);
+        uint64_t content = 0u;
+
+        if (!link.read(reinterpret_cast<char*>(&content), sizeof(uint64_t)))
+        {
+            return false;
+        }
+
+        return read_entry_(entry_path_(parameters, content), parameters, analysis) && analysis.content == content;
+    }
+
+    // Entries are written to a temporary file and renamed, so that concurrent
+    // writers and readers never see a partial entry
+    bool store(const uint64_t& parameters, const std::string& input, const CachedAnalysis& analysis) const
+    {
+        if (!is_enabled())
+        {
+            return false;
+        }
+
+        CacheEntryHeader header;
+        std::memset(&header, 0, sizeof(CacheEntryHeader));
+        std::memcpy(header.magic, entry_magic, sizeof(entry_magic));
+        header.version = entry_version;
+        header.descriptor_count = static_cast<uint32_t>(analysis.table.names.size());
+        header.parameters = parameters;
+        header.content = analysis.content;
+        header.frames = analysis.table.frames;
+        header.block_frames = analysis.block_frames;
+        header.block_count = static_cast<uint32_t>(analysis.block_hashes.size());
+
+        const std::filesystem::path path = entry_path_(parameters, analysis.content);
+        const std::filesystem::path temporary = temporary_path_(path);
+
+        {
+            std::ofstream file(temporary, std::ios::binary | std::ios::out | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&header), sizeof(CacheEntryHeader));
+            file.write(reinterpret_cast<const char*>(analysis.block_hashes.data()),
+                       static_cast<std::streamsize>(analysis.block_hashes.size() * sizeof(uint64_t)));
+            file.write(reinterpret_cast<const char*>(analysis.table.values.data()),
+                       static_cast<std::streamsize>(analysis.table.values.size() * sizeof(float)));
+
+            if (!file)
+            {
+                return false;
+            }
+        }
+
+        const std::filesystem::path link = link_path_(parameters, input);
+        const std::filesystem::path temporary_link = temporary_path_(link);
+
+        {
+            std::ofstream file(temporary_link, std::ios::binary | std::ios::out | std::ios::trunc);
+            file.write(reinterpret_cast<const char*>(&analysis.content), sizeof(uint64_t));
+
+            if (!file)
+            {
+                return false;
+            }
+        }
+
+        std::error_code error;
+        std::filesystem::rename(temporary, path, error);
+        std::filesystem::rename(temporary_link, link, error);
+
+        return !error;
+    }
+
+    // Remove the least recently used entries until the cache fits its size,
+    // returns the number of removed entries
+    size_t evict() const
+    {
+        if (!is_enabled())
+        {
+            return 0u;
+        }
+
+        struct Entry
+        {
+            std::filesystem::path path;
+            std::filesystem::file_time_type time;
+            uint64_t size;
+        };
+
+        std::vector<Entry> entries;
+        uint64_t total = 0u;
+        std::error_code error;
+
+        for (std::filesystem::directory_iterator it(directory_, error), end; it != end; it.increment(error))
+        {
+            if (it->path().extension() == ".entry")
+            {
+                const uint64_t size = it->file_size(error);
+                entries.push_back({it->path(), it->last_write_time(error), size});
+                total += size;
+            }
+        }
+
+        std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b)
+        {
+            return a.time < b.time;
+        });
+
+        size_t removed = 0u;
+        for (const auto& entry : entries)
+        {
+            if (total <= max_bytes_)
+            {
+                break;
+            }
+
+            if (std::filesystem::remove(entry.path, error))
+            {
+                total -= entry.size;
+                removed++;
+            }
+        }
+
+        // Links to removed entries
+        if (removed > 0u)
+        {
+            std::vector<std::filesystem::path> links;
+            for (std::filesystem::directory_iterator it(directory_, error), end; it != end; it.increment(error))
+            {
+                if (it->path().extension() == ".link")
+                {
+                    links.push_back(it->path());
+                }
+            }
+
+            for (const auto& link : links)
+            {
+                std::ifstream file(link, std::ios::binary);
+                uint64_t content = 0u;
+                const std::string parameters = link.filename().string().substr(0, 16);
+
+                if (file.read(reinterpret_cast<char*>(&content), sizeof(uint64_t)) &&
+                    !std::filesystem::exists(std::filesystem::path(directory_) / (parameters + "-" + hex_(content) + ".entry"), error))
+                {
+                    file.close();
+                    std::filesystem::remove(link, error);
+                }
+            }
+        }
+
+        return removed;
+    }
+
+private:
+    static std::string hex_(const uint64_t& value)
+    {
+        char text[17];
+        std::snprintf(text, sizeof(text), "%016llx", static_cast<unsigned long long>(value));
+
+        return text;
+    }
+
+    std::filesystem::path entry_path_(const uint64_t& parameters, const uint64_t& content) const
+    {
+        return std::filesystem::path(directory_) / (hex_(parameters) + "-" + hex_(content) + ".entry");
+    }
+
+    std::filesystem::path link_path_(const uint64_t& parameters, const std::string& input) const
+    {
+        return std::filesystem::path(directory_) / (hex_(parameters) + "-" + hex_(hash_combine(parameters, input)) + ".link");
+    }
+
+    static std::filesystem::path temporary_path_(const std::filesystem::path& path)
+    {
+        const uint64_t thread = std::hash<std::thread::id>()(std::this_thread::get_id());
+
+        return path.string() + "." + hex_(thread) + ".tmp";
+    }
+
+    static bool read_entry_(const std::filesystem::path& path, const uint64_t& parameters, CachedAnalysis& analysis)
+    {
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+
+        if (!file)
+        {
+            return false;
+        }
+
+        const uint64_t file_size = static_cast<uint64_t>(file.tellg());
+        file.seekg(0);
+
+        CacheEntryHeader header;
+        if (file_size < sizeof(CacheEntryHeader) ||
+            !file.read(reinterpret_cast<char*>(&header), sizeof(CacheEntryHeader)) ||
+            std::memcmp(header.magic, entry_magic, sizeof(entry_magic)) != 0 ||
+            header.version != entry_version || header.parameters != parameters ||
+            header.descriptor_count != analysis.table.names.size() ||
+            file_size != sizeof(CacheEntryHeader) + header.block_count * sizeof(uint64_t) +
+                         header.frames * header.descriptor_count * sizeof(float))
+        {
+            return false;
+        }
+
+        analysis.content = header.content;
+        analysis.block_frames = header.block_frames;
+        analysis.block_hashes.resize(header.block_count);
+        analysis.table.frames = header.frames;
+        analysis.table.values.resize(header.frames * header.descriptor_count);
+        file.read(reinterpret_cast<char*>(analysis.block_hashes.data()),
+                  static_cast<std::streamsize>(analysis.block_hashes.size() * sizeof(uint64_t)));
+        file.read(reinterpret_cast<char*>(analysis.table.values.data()),
+                  static_cast<std::streamsize>(analysis.table.values.size() * sizeof(float)));
+
+        return static_cast<bool>(file);
+    }
+
+    std::string directory_;
+    uint64_t max_bytes_;
+};
+
+#endif // INFORMER_CLI_ANALYSIS_CACHE_H_
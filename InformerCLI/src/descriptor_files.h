@@ -0,0 +1,168 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef INFORMER_CLI_DESCRIPTOR_FILES_H_
+#define INFORMER_CLI_DESCRIPTOR_FILES_H_
+
+#include <cstdint>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+#include "informer_tracks.h"
+
+enum class OutputFormat
+{
+    Csv,
+    Npy,
+    Tracks
+};
+
+// Descriptors of a whole file, frame major: values[frame * names.size() + d]
+struct DescriptorTable
+{
+    std::vector<std::string> names;
+    std::vector<float> values;
+    uint64_t frames = 0u;
+    double sample_rate = 0.0;
+    uint32_t frame_size = 0u;
+    uint32_t hop_size = 0u;
+};
+
+inline const char* output_extension(const OutputFormat& format)
+{
+    switch (format)
+    {
+    case OutputFormat::Npy:
+        return ".npy";
+    case OutputFormat::Tracks:
+        return ".itrk";
+    default:
+        return ".csv";
+    }
+}
+
+// One row per frame: frame start time in seconds, then the descriptors
+inline bool write_csv(const std::string& path, const DescriptorTable& table)
+{
+    std::ofstream file(path, std::ios::out | std::ios::trunc);
+
+    if (!file)
+    {
+        return false;
+    }
+
+    file << "time";
+    for (const auto& name : table.names)
+    {
+        file << "," << name;
+    }
+    file << "\n";
+
+    const size_t dims = table.names.size();
+    char number[32];
+
+    for (uint64_t f = 0; f < table.frames; f++)
+    {
+        std::snprintf(number, sizeof(number), "%.6f", static_cast<double>(f * table.hop_size) / table.sample_rate);
+        file << number;
+
+        for (size_t d = 0; d < dims; d++)
+        {
+            std::snprintf(number, sizeof(number), ",%.9g", table.values[f * dims + d]);
+            file << number;
+        }
+
+        file << "\n";
+    }
+
+    return static_cast<bool>(file);
+}
+
+// NumPy .npy (format 1.0), a float32 array of shape (frames, descriptors).
+// The column order is the one of the descriptors option.
+inline bool write_npy(const std::string& path, const DescriptorTable& table)
+{
+    std::ofstream file(path, std::ios::binary | std::ios::out | std::ios::trunc);
+
+    if (!file)
+    {
+        return false;
+    }
+
+    std::string header = "{'descr': '<f4', 'fortran_order': False, 'shape': (" +
+                         std::to_string(table.frames) + ", " + std::to_string(table.names.size()) + "), }";
+
+    // Magic (6) + version (2) + header length (2) + header, padded with spaces
+    // and terminated by a newline to a multiple of 64 bytes
+    const size_t total = (10u + header.size() + 1u + 63u) / 64u * 64u;
+    header.append(total - 10u - header.size() - 1u, ' ');
+    header.push_back('\n');
+
+    const uint16_t header_size = static_cast<uint16_t>(header.size());
+    const char preamble[8] = {'\x93', 'N', 'U', 'M', 'P', 'Y', '\x01', '\x00'};
+    const char length[2] = {static_cast<char>(header_size & 0xFFu), static_cast<char>(header_size >> 8)};
+
+    file.write(preamble, 8);
+    file.write(length, 2);
+    file.write(header.data(), static_cast<std::streamsize>(header.size()));
+    file.write(reinterpret_cast<const char*>(table.values.data()), static_cast<std::streamsize>(table.values.size() * sizeof(float)));
+
+    return static_cast<bool>(file);
+}
+
+inline bool write_tracks(const std::string& path, const DescriptorTable& table, const bool& packed)
+{
+    Informer::Tracks::TrackWriter writer;
+
+    if (!writer.open(path, table.names, table.sample_rate, table.frame_size, table.hop_size, 4096u,
+                     packed ? Informer::Tracks::Codec::Packed : Informer::Tracks::Codec::Raw))
+    {
+        return false;
+    }
+
+    for (uint64_t f = 0; f < table.frames; f++)
+    {
+        if (!writer.write_frame(table.values.data() + f * table.names.size()))
+        {
+            return false;
+        }
+    }
+
+    return writer.close();
+}
+
+inline bool write_descriptors(const std::string& path, const DescriptorTable& table, const OutputFormat& format, const bool& packed)
+{
+    switch (format)
+    {
+    case OutputFormat::Npy:
+        return write_npy(path, table);
+    case OutputFormat::Tracks:
+        return write_tracks(path, table, packed);
+    default:
+        return write_csv(path, table);
+    }
+}
+
+#endif // INFORMER_CLI_DESCRIPTOR_FILES_H_
@@ -0,0 +1,801 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/* informer-cli: analyze audio files or whole directory trees and write
+   one descriptors file per input (CSV, NPY or track file) */
+
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <complex>
+#include <condition_variable>
+#include <cstdio>
+#include <cstdlib>
+#include <filesystem>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "informer.h"
+#include "dj_fft.h"
+
+#include "analysis_cache.h"
+#include "descriptor_files.h"
+#include "wav_reader.h"
+
+namespace fs = std::filesystem;
+
+struct Options
+{
+    std::vector<std::string> inputs;
+    std::string output_dir;
+    OutputFormat format = OutputFormat::Csv;
+    unsigned int frame_size = 4096u;
+    unsigned int hop_size = 0u;
+    std::string window = "hann";
+    std::vector<std::string> descriptors;
+    int channel = -1;
+    bool normalize = false;
+    bool pitch_tracking = false;
+    bool chroma_key = false;
+    bool packed = false;
+    unsigned int jobs = 0u;
+    // Threads of each file, for the large frames (see Informer::set_reduction_threads)
+    unsigned int frame_threads = 1u;
+    uint64_t max_memory = 1024u;
+    std::string cache_dir;
+    uint64_t cache_size = 10240u;
+    bool quiet = false;
+};
+
+struct Job
+{
+    fs::path input;
+    fs::path output;
+};
+
+static void print_usage()
+{
+    std::printf(
+        "Usage: informer-cli [options] <file or directory>...\n"
+        "\n"
+        "Analyze WAV files (directories are searched recursively) and write one\n"
+        "descriptors file per input.\n"
+        "\n"
+        "Options:\n"
+        "  -o, --output <dir>         output folder, mirroring the input tree (default: next to the inputs)\n"
+        "  -f, --format <format>      csv, npy or tracks (default: csv)\n"
+        "      --frame <size>         analysis frame size, a power of two (default: 4096)\n"
+        "      --hop <size>           hop size (default: half the frame size)\n"
+        "      --window <window>      hann, blackman (Blackman-Harris) or none (default: hann)\n"
+        "  -d, --descriptors <list>   comma separated descriptors, as time::<name> or freq::<name>\n"
+        "                             (default: all the time and frequency descriptors)\n"
+        "      --channel <index>      analyze a single channel (default: mix of all the channels)\n"
+        "      --normalize            normalize the descriptors in [0, 1] range\n"
+        "      --pitch-tracking       compute time::f0tracked and time::voicing\n"
+        "      --key                  compute freq::key and freq::keystrength\n"
+        "      --packed               compress the track files (with --format tracks)\n"
+        "  -j, --jobs <count>         number of worker threads (default: all the cores); with fewer\n"
+        "                             files, the spare ones split the analysis of large frames\n"
+        "      --max-memory <MB>      bound on the decoded audio in flight (default: 1024)\n"
+        "      --cache <dir>          reuse the analyses of unchanged files (or blocks) stored in dir\n"
+        "      --cache-size <MB>      cache size, least recently used entries are removed (default: 10240)\n"
+        "  -q, --quiet                print only the summary\n"
+        "  -h, --help                 show this help\n");
+}
+
+static std::vector<std::string> split(const std::string& list)
+{
+    std::vector<std::string> items;
+    size_t start = 0u;
+
+    while (start <= list.size())
+    {
+        size_t end = list.find(',', start);
+        if (end == std::string::npos)
+        {
+            end = list.size();
+        }
+
+        if (end > start)
+        {
+            items.push_back(list.substr(start, end - start));
+        }
+
+        start = end + 1u;
+    }
+
+    return items;
+}
+
+static bool parse_options(int argc, char* argv[], Options& options)
+{
+    for (int a = 1; a < argc; a++)
+    {
+        const std::string arg = argv[a];
+        const bool has_value = a + 1 < argc;
+
+        auto value = [&]() -> std::string
+        {
+            return argv[++a];
+        };
+
+        try
+        {
+            if (arg == "-h" || arg == "--help")
+            {
+                print_usage();
+                std::exit(0);
+            }
+            else if ((arg == "-o" || arg == "--output") && has_value)
+            {
+                options.output_dir = value();
+            }
+            else if ((arg == "-f" || arg == "--format") && has_value)
+            {
+                const std::string format = value();
+
+                if (format == "csv")
+                {
+                    options.format = OutputFormat::Csv;
+                }
+                else if (format == "npy")
+                {
+                    options.format = OutputFormat::Npy;
+                }
+                else if (format == "tracks")
+                {
+                    options.format = OutputFormat::Tracks;
+                }
+                else
+                {
+                    std::fprintf(stderr, "Unknown format: %s\n", format.c_str());
+                    return false;
+                }
+            }
+            else if (arg == "--frame" && has_value)
+            {
+                options.frame_size = static_cast<unsigned int>(std::stoul(value()));
+            }
+            else if (arg == "--hop" && has_value)
+            {
+                options.hop_size = static_cast<unsigned int>(std::stoul(value()));
+            }
+            else if (arg == "--window" && has_value)
+            {
+                options.window = value();
+            }
+            else if ((arg == "-d" || arg == "--descriptors") && has_value)
+            {
+                options.descriptors = split(value());
+            }
+            else if (arg == "--channel" && has_value)
+            {
+                options.channel = std::stoi(value());
+            }
+            else if (arg == "--normalize")
+            {
+                options.normalize = true;
+            }
+            else if (arg == "--pitch-tracking")
+            {
+                options.pitch_tracking = true;
+            }
+            else if (arg == "--key")
+            {
+                options.chroma_key = true;
+            }
+            else if (arg == "--packed")
+            {
+                options.packed = true;
+            }
+            else if ((arg == "-j" || arg == "--jobs") && has_value)
+            {
+                options.jobs = static_cast<unsigned int>(std::stoul(value()));
+            }
+            else if (arg == "--max-memory" && has_value)
+            {
+                options.max_memory = std::stoull(value());
+            }
+            else if (arg == "--cache" && has_value)
+            {
+                options.cache_dir = value();
+            }
+            else if (arg == "--cache-size" && has_value)
+            {
+                options.cache_size = std::stoull(value());
+            }
+            else if (arg == "-q" || arg == "--quiet")
+            {
+                options.quiet = true;
+            }
+            else if (!arg.empty() && arg[0] == '-')
+            {
+                std::fprintf(stderr, "Unknown or incomplete option: %s\n", arg.c_str());
+                return false;
+            }
+            else
+            {
+                options.inputs.push_back(arg);
+            }
+        }
+        catch (const std::exception&)
+        {
+            std::fprintf(stderr, "Invalid value for %s\n", arg.c_str());
+            return false;
+        }
+    }
+
+    if (options.inputs.empty())
+    {
+        print_usage();
+        return false;
+    }
+
+    if (options.frame_size < 64u || (options.frame_size & (options.frame_size - 1u)) != 0u)
+    {
+        std::fprintf(stderr, "The frame size must be a power of two, at least 64\n");
+        return false;
+    }
+
+    if (options.hop_size == 0u)
+    {
+        options.hop_size = options.frame_size / 2u;
+    }
+
+    if (options.window != "hann" && options.window != "blackman" && options.window != "none")
+    {
+        std::fprintf(stderr, "Unknown window: %s\n", options.window.c_str());
+        return false;
+    }
+
+    if (options.jobs == 0u)
+    {
+        options.jobs = std::max(1u, std::thread::hardware_concurrency());
+    }
+
+    options.max_memory = std::max<uint64_t>(options.max_memory, 1u) * 1024u * 1024u;
+    options.cache_size *= 1024u * 1024u;
+
+    return true;
+}
+
+// Descriptors computed for a silent frame, to validate the requested names
+static bool check_descriptors(Options& options)
+{
+    Informer::Informer<float> informer;
+    informer.set_stft_size(options.frame_size);
+    informer.set_pitch_tracking(options.pitch_tracking);
+    informer.set_chroma_key(options.chroma_key);
+    informer.set_buffer(std::vector<float>(options.frame_size, 0.0f));
+    informer.set_magnitudes(std::vector<float>(options.frame_size / 2u + 1u, 0.0f));
+    informer.compute_descriptors();
+
+    const auto time_descriptors = informer.get_time_descriptors();
+    const auto frequency_descriptors = informer.get_frequency_descriptors();
+
+    if (options.descriptors.empty())
+    {
+        for (const auto& name : Informer::time_descriptor_names)
+        {
+            options.descriptors.push_back(std::string("time::") + name);
+        }
+
+        for (const auto& name : Informer::frequency_descriptor_names)
+        {
+            options.descriptors.push_back(std::string("freq::") + name);
+        }
+
+        if (options.pitch_tracking)
+        {
+            options.descriptors.push_back("time::f0tracked");
+            options.descriptors.push_back("time::voicing");
+        }
+
+        if (options.chroma_key)
+        {
+            options.descriptors.push_back("freq::key");
+            options.descriptors.push_back("freq::keystrength");
+        }
+
+        return true;
+    }
+
+    for (const auto& name : options.descriptors)
+    {
+        const bool time = name.rfind("time::", 0) == 0 && time_descriptors.count(name.substr(6)) > 0;
+        const bool frequency = name.rfind("freq::", 0) == 0 && frequency_descriptors.count(name.substr(6)) > 0;
+
+        if (!time && !frequency)
+        {
+            std::fprintf(stderr, "Unknown descriptor: %s\n", name.c_str());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+static bool is_audio_file(const fs::path& path)
+{
+    std::string extension = path.extension().string();
+    std::transform(extension.begin(), extension.end(), extension.begin(), [](unsigned char c)
+    {
+        return static_cast<char>(std::tolower(c));
+    });
+
+    return extension == ".wav" || extension == ".wave";
+}
+
+static std::vector<Job> collect_jobs(const Options& options)
+{
+    std::vector<Job> jobs;
+    const char* extension = output_extension(options.format);
+
+    for (const auto& input : options.inputs)
+    {
+        const fs::path root(input);
+        std::error_code error;
+
+        if (fs::is_directory(root, error))
+        {
+            std::vector<fs::path> files;
+            for (fs::recursive_directory_iterator it(root, fs::directory_options::skip_permission_denied, error), end; it != end; it.increment(error))
+            {
+                if (it->is_regular_file(error) && is_audio_file(it->path()))
+                {
+                    files.push_back(it->path());
+                }
+            }
+
+            std::sort(files.begin(), files.end());
+
+            for (const auto& file : files)
+            {
+                fs::path output = options.output_dir.empty() ? file : fs::path(options.output_dir) / fs::relative(file, root, error);
+                jobs.push_back({file, output.replace_extension(extension)});
+            }
+        }
+        else if (fs::is_regular_file(root, error))
+        {
+            fs::path output = options.output_dir.empty() ? root : fs::path(options.output_dir) / root.filename();
+            jobs.push_back({root, output.replace_extension(extension)});
+        }
+        else
+        {
+            std::fprintf(stderr, "Not found: %s\n", input.c_str());
+        }
+    }
+
+    return jobs;
+}
+
+// Bounds the memory used by the files being analyzed: a worker reserves the
+// size of the decoded samples and of the descriptors before reading a file.
+// A file larger than the whole budget is processed alone.
+class MemoryBudget
+{
+public:
+    explicit MemoryBudget(const uint64_t& capacity) : capacity_(capacity)
+    {
+    }
+
+    uint64_t acquire(uint64_t bytes)
+    {
+        bytes = std::min(bytes, capacity_);
+        std::unique_lock<std::mutex> lock(mutex_);
+        available_.wait(lock, [&]()
+        {
+            return used_ + bytes <= capacity_;
+        });
+        used_ += bytes;
+
+        return bytes;
+    }
+
+    void release(const uint64_t& bytes)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            used_ -= bytes;
+        }
+        available_.notify_all();
+    }
+
+private:
+    std::mutex mutex_;
+    std::condition_variable available_;
+    uint64_t capacity_;
+    uint64_t used_ = 0u;
+};
+
+// Per thread analysis state, reused across files
+class FileAnalyzer
+{
+public:
+    explicit FileAnalyzer(const Options& options) : options_(options)
+    {
+        informer_.set_stft_size(options.frame_size);
+        informer_.set_pitch_tracking(options.pitch_tracking);
+        informer_.set_chroma_key(options.chroma_key);
+        informer_.set_reduction_threads(options.frame_threads);
+
+        const std::vector<float> ones(options.frame_size, 1.0f);
+        window_ = options.window == "none" ? ones : Informer::Frequency::window(ones, options.window == "hann");
+
+        frame_.assign(options.frame_size, 0.0f);
+        fft_frame_.resize(options.frame_size);
+        magnitudes_.assign(options.frame_size / 2u + 1u, 0.0f);
+
+        for (const auto& name : options.descriptors)
+        {
+            time_.push_back(name.rfind("time::", 0) == 0);
+            keys_.push_back(name.substr(6));
+        }
+
+        // Skip a whole domain when none of its descriptors is requested
+        compute_time_ = std::find(time_.begin(), time_.end(), true) != time_.end();
+        compute_frequency_ = std::find(time_.begin(), time_.end(), false) != time_.end();
+    }
+
+    static uint64_t frame_count(const uint64_t& samples, const unsigned int& hop_size)
+    {
+        return (samples + hop_size - 1u) / hop_size;
+    }
+
+    // Prepare the table and the analyzer state for a new file
+    void begin(const std::vector<float>& samples, DescriptorTable& table)
+    {
+        table.frames = frame_count(samples.size(), options_.hop_size);
+        table.values.assign(table.frames * keys_.size(), 0.0f);
+        informer_.set_sample_rate(static_cast<float>(table.sample_rate));
+
+        // Start each file from silence: no flux from the previous file, fresh pitch tracker
+        std::fill(magnitudes_.begin(), magnitudes_.end(), 0.0f);
+        informer_.set_magnitudes(magnitudes_.data(), magnitudes_.size());
+        informer_.set_pitch_tracking(false);
+        informer_.set_pitch_tracking(options_.pitch_tracking);
+    }
+
+    // Analyze the frames [first, last) of the table. The spectrum of the frame
+    // before first is computed again, so that the flux does not depend on the
+    // frames analyzed before.
+    void analyze(const std::vector<float>& samples, DescriptorTable& table, const uint64_t& first, const uint64_t& last)
+    {
+        const size_t dims = keys_.size();
+
+        if (first > 0u && compute_frequency_)
+        {
+            spectrum_(samples, first - 1u);
+            informer_.set_magnitudes(magnitudes_.data(), magnitudes_.size());
+        }
+
+        for (uint64_t f = first; f < last; f++)
+        {
+            if (compute_frequency_)
+            {
+                spectrum_(samples, f);
+                informer_.set_magnitudes(magnitudes_.data(), magnitudes_.size());
+            }
+            else
+            {
+                read_frame_(samples, f);
+            }
+
+            informer_.set_buffer(frame_.data(), frame_.size());
+            informer_.compute_descriptors(compute_time_, compute_frequency_);
+
+            if (options_.normalize)
+            {
+                informer_.normalize_descriptors();
+            }
+
+            float* row = table.values.data() + f * dims;
+            for (size_t d = 0; d < dims; d++)
+            {
+                row[d] = time_[d] ? informer_.get_time_descriptor(keys_[d]) : informer_.get_frequency_descriptor(keys_[d]);
+            }
+        }
+    }
+
+    void analyze(const std::vector<float>& samples, DescriptorTable& table)
+    {
+        begin(samples, table);
+        analyze(samples, table, 0u, table.frames);
+    }
+
+private:
+    // Frames past the end of the file are zero padded
+    void read_frame_(const std::vector<float>& samples, const uint64_t& frame)
+    {
+        const uint64_t start = frame * options_.hop_size;
+        const uint64_t available = std::min<uint64_t>(options_.frame_size, samples.size() - start);
+        std::copy(samples.begin() + start, samples.begin() + start + available, frame_.begin());
+        std::fill(frame_.begin() + available, frame_.end(), 0.0f);
+    }
+
+    void spectrum_(const std::vector<float>& samples, const uint64_t& frame)
+    {
+        read_frame_(samples, frame);
+
+        for (unsigned int s = 0; s < options_.frame_size; s++)
+        {
+            fft_frame_[s] = std::complex<float>(frame_[s] * window_[s], 0.0f);
+        }
+
+        const auto spectrum = dj::fft1d(fft_frame_, dj::fft_dir::DIR_FWD);
+        for (size_t k = 0; k < magnitudes_.size(); k++)
+        {
+            magnitudes_[k] = std::abs(spectrum[k]);
+        }
+    }
+
+    const Options& options_;
+    Informer::Informer<float> informer_;
+    std::vector<float> window_;
+    std::vector<float> frame_;
+    dj::fft_arg<float> fft_frame_;
+    std::vector<float> magnitudes_;
+    std::vector<bool> time_;
+    std::vector<std::string> keys_;
+    bool compute_time_ = true;
+    bool compute_frequency_ = true;
+};
+
+// Frames per cache block: a changed sample invalidates only the blocks reading it
+constexpr uint32_t cache_block_frames = 256u;
+
+// Everything that changes the descriptors of a given audio content
+static uint64_t parameters_hash(const Options& options, const uint32_t& sample_rate)
+{
+    std::string parameters = std::to_string(INFORMER_VERSION_MAJOR) + "." + std::to_string(INFORMER_VERSION_MINOR) +
+                             "|" + std::to_string(INFORMER_ANALYSIS_SCHEMA) +
+                             "|" + std::to_string(static_cast<int>(Informer::accumulation)) +
+                             "|" + std::to_string(options.frame_size) + "|" + std::to_string(options.hop_size) +
+                             "|" + options.window + "|" + std::to_string(options.channel) +
+                             "|" + std::to_string(options.normalize) + "|" + std::to_string(options.pitch_tracking) +
+                             "|" + std::to_string(options.chroma_key) + "|" + std::to_string(sample_rate);
+
+    for (const auto& name : options.descriptors)
+    {
+        parameters += "|" + name;
+    }
+
+    return hash64(parameters.data(), parameters.size());
+}
+
+// Hash of the samples read by each block of frames, including the frame
+// before the block (the flux depends on it)
+static std::vector<uint64_t> block_hashes(const std::vector<float>& samples, const uint64_t& frames, const Options& options)
+{
+    std::vector<uint64_t> hashes((frames + cache_block_frames - 1u) / cache_block_frames);
+
+    for (uint64_t b = 0; b < hashes.size(); b++)
+    {
+        const uint64_t first = b * cache_block_frames;
+        const uint64_t last = std::min<uint64_t>(first + cache_block_frames, frames);
+        const uint64_t begin = first > 0u ? (first - 1u) * options.hop_size : 0u;
+        const uint64_t end = std::min<uint64_t>((last - 1u) * options.hop_size + options.frame_size, samples.size());
+
+        hashes[b] = hash64(samples.data() + begin, (end - begin) * sizeof(float), begin);
+    }
+
+    return hashes;
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+
+    if (!parse_options(argc, argv, options) || !check_descriptors(options))
+    {
+        return 1;
+    }
+
+    const std::vector<Job> jobs = collect_jobs(options);
+
+    if (jobs.empty())
+    {
+        std::fprintf(stderr, "No WAV files found\n");
+        return 1;
+    }
+
+    MemoryBudget budget(options.max_memory);
+    const AnalysisCache cache(options.cache_dir, options.cache_size);
+    std::atomic<size_t> cache_hits(0u);
+    std::atomic<uint64_t> reused_frames(0u);
+    std::atomic<size_t> next_job(0u);
+    std::atomic<size_t> done(0u);
+    std::atomic<size_t> failed(0u);
+    std::atomic<uint64_t> audio_frames_ms(0u);
+    std::atomic<uint64_t> input_bytes(0u);
+    std::mutex print_mutex;
+
+    const unsigned int workers = std::min<unsigned int>(options.jobs, static_cast<unsigned int>(jobs.size()));
+    options.frame_threads = std::clamp(options.jobs / workers, 1u, Informer::ReductionPool::max_threads);
+    const auto start = std::chrono::steady_clock::now();
+
+    auto worker = [&]()
+    {
+        FileAnalyzer analyzer(options);
+        std::vector<float> samples;
+        CachedAnalysis analysis;
+        CachedAnalysis previous;
+        DescriptorTable& table = analysis.table;
+        table.names = options.descriptors;
+        table.frame_size = options.frame_size;
+        table.hop_size = options.hop_size;
+        previous.table.names = options.descriptors;
+
+        for (size_t j = next_job++; j < jobs.size(); j = next_job++)
+        {
+            const Job& job = jobs[j];
+            WavInfo info;
+            std::string error;
+
+            {
+                std::ifstream file(job.input, std::ios::binary);
+                if (!file || !read_wav_info(file, info))
+                {
+                    error = "unsupported or invalid WAV file";
+                }
+            }
+
+            if (error.empty())
+            {
+                // Samples, descriptors and, with the cache, the descriptors of the previous version
+                const uint64_t table_bytes = FileAnalyzer::frame_count(info.frames, options.hop_size) * options.descriptors.size() * sizeof(float);
+                const uint64_t bytes = info.frames * sizeof(float) + table_bytes * (cache.is_enabled() ? 2u : 1u);
+                const uint64_t reserved = budget.acquire(bytes);
+
+                if (!read_wav_mono(job.input.string(), options.channel, info, samples))
+                {
+                    error = "cannot read the samples";
+                }
+                else
+                {
+                    table.sample_rate = info.sample_rate;
+
+                    if (!cache.is_enabled())
+                    {
+                        analyzer.analyze(samples, table);
+                    }
+                    else
+                    {
+                        const uint64_t parameters = parameters_hash(options, info.sample_rate);
+                        const std::string input = fs::absolute(job.input).lexically_normal().string();
+                        const uint64_t content = hash64(samples.data(), samples.size() * sizeof(float));
+
+                        if (cache.load(parameters, content, analysis))
+                        {
+                            cache_hits++;
+                            reused_frames += table.frames;
+                        }
+                        else
+                        {
+                            analyzer.begin(samples, table);
+                            analysis.content = content;
+                            analysis.block_frames = cache_block_frames;
+                            analysis.block_hashes = block_hashes(samples, table.frames, options);
+
+                            // With pitch tracking each frame depends on the whole history
+                            const bool reuse = !options.pitch_tracking && cache.load_previous(parameters, input, previous) &&
+                                               previous.block_frames == cache_block_frames;
+
+                            for (uint64_t b = 0; b < analysis.block_hashes.size(); b++)
+                            {
+                                const uint64_t first = b * cache_block_frames;
+                                const uint64_t last = std::min<uint64_t>(first + cache_block_frames, table.frames);
+
+                                if (reuse && b < previous.block_hashes.size() && previous.block_hashes[b] == analysis.block_hashes[b] &&
+                                    last <= previous.table.frames)
+                                {
+                                    std::copy(previous.table.values.begin() + first * table.names.size(),
+                                              previous.table.values.begin() + last * table.names.size(),
+                                              table.values.begin() + first * table.names.size());
+                                    reused_frames += last - first;
+                                }
+                                else
+                                {
+                                    analyzer.analyze(samples, table, first, last);
+                                }
+                            }
+
+                            if (!cache.store(parameters, input, analysis))
+                            {
+                                std::lock_guard<std::mutex> lock(print_mutex);
+                                std::fprintf(stderr, "Cannot write the cache entry of %s\n", job.input.string().c_str());
+                            }
+                        }
+                    }
+
+                    std::error_code ec;
+                    if (job.output.has_parent_path())
+                    {
+                        fs::create_directories(job.output.parent_path(), ec);
+                    }
+
+                    if (!write_descriptors(job.output.string(), table, options.format, options.packed))
+                    {
+                        error = "cannot write " + job.output.string();
+                    }
+                }
+
+                // Give the memory back before the next file
+                std::vector<float>().swap(samples);
+                std::vector<float>().swap(table.values);
+                std::vector<float>().swap(previous.table.values);
+                budget.release(reserved);
+            }
+
+            const size_t count = ++done;
+            std::lock_guard<std::mutex> lock(print_mutex);
+
+            if (!error.empty())
+            {
+                failed++;
+                std::fprintf(stderr, "[%zu/%zu] %s: %s\n", count, jobs.size(), job.input.string().c_str(), error.c_str());
+            }
+            else
+            {
+                audio_frames_ms += static_cast<uint64_t>(1000.0 * static_cast<double>(info.frames) / info.sample_rate);
+                input_bytes += info.frames * info.channels * (info.bits_per_sample / 8u);
+
+                if (!options.quiet)
+                {
+                    std::printf("[%zu/%zu] %s\n", count, jobs.size(), job.output.string().c_str());
+                }
+            }
+        }
+    };
+
+    std::vector<std::thread> pool;
+    for (unsigned int w = 0; w < workers; w++)
+    {
+        pool.emplace_back(worker);
+    }
+
+    for (auto& thread : pool)
+    {
+        thread.join();
+    }
+
+    const double seconds = std::max(1e-9, std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count());
+    const double audio_seconds = static_cast<double>(audio_frames_ms.load()) / 1000.0;
+
+    std::printf("%zu files (%zu failed) in %.2f s with %u threads: %.1f files/s, %.1f MB/s, %.0fx realtime (%.1f s of audio)\n",
+                jobs.size(), failed.load(), seconds, workers,
+                static_cast<double>(jobs.size()) / seconds,
+                static_cast<double>(input_bytes.load()) / seconds / 1e6,
+                audio_seconds / seconds, audio_seconds);
+
+    if (cache.is_enabled())
+    {
+        const size_t evicted = cache.evict();
+        std::printf("Cache: %zu unchanged files, %llu frames reused, %zu entries evicted\n",
+                    cache_hits.load(), static_cast<unsigned long long>(reused_frames.load()), evicted);
+    }
+
+    return failed.load() > 0u ? 1 : 0;
+}
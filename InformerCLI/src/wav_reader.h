@@ -0,0 +1,231 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef INFORMER_CLI_WAV_READER_H_
+#define INFORMER_CLI_WAV_READER_H_
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <vector>
+
+// Minimal RIFF/RF64 WAVE reader: integer PCM (8, 16, 24 and 32 bits) and
+// IEEE float (32 and 64 bits), plain or WAVE_FORMAT_EXTENSIBLE
+struct WavInfo
+{
+    uint32_t sample_rate = 0u;
+    uint16_t channels = 0u;
+    uint16_t bits_per_sample = 0u;
+    bool floating_point = false;
+    uint64_t frames = 0u;
+    uint64_t data_offset = 0u;
+};
+
+inline uint16_t read_le16(const uint8_t* p)
+{
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
+
+inline uint32_t read_le32(const uint8_t* p)
+{
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
+
+inline uint64_t read_le64(const uint8_t* p)
+{
+    return static_cast<uint64_t>(read_le32(p)) | (static_cast<uint64_t>(read_le32(p + 4)) << 32);
+}
+
+// Parse the header only, the samples are read by read_wav_mono()
+inline bool read_wav_info(std::ifstream& file, WavInfo& info)
+{
+    uint8_t riff[12];
+
+    if (!file.read(reinterpret_cast<char*>(riff), 12) ||
+        (std::memcmp(riff, "RIFF", 4) != 0 && std::memcmp(riff, "RF64", 4) != 0) ||
+        std::memcmp(riff + 8, "WAVE", 4) != 0)
+    {
+        return false;
+    }
+
+    const bool rf64 = std::memcmp(riff, "RF64", 4) == 0;
+    uint64_t rf64_data_size = 0u;
+    bool format_found = false;
+    uint16_t format = 0u;
+
+    uint8_t chunk[8];
+    while (file.read(reinterpret_cast<char*>(chunk), 8))
+    {
+        uint64_t chunk_size = read_le32(chunk + 4);
+        const uint64_t chunk_start = static_cast<uint64_t>(file.tellg());
+
+        if (std::memcmp(chunk, "ds64", 4) == 0 && chunk_size >= 16u)
+        {
+            uint8_t ds64[16];
+            file.read(reinterpret_cast<char*>(ds64), 16);
+            rf64_data_size = read_le64(ds64 + 8);
+        }
+        else if (std::memcmp(chunk, "fmt ", 4) == 0 && chunk_size >= 16u)
+        {
+            uint8_t fmt[40] = {0};
+            file.read(reinterpret_cast<char*>(fmt), static_cast<std::streamsize>(std::min<uint64_t>(chunk_size, 40u)));
+            format = read_le16(fmt);
+            info.channels = read_le16(fmt + 2);
+            info.sample_rate = read_le32(fmt + 4);
+            info.bits_per_sample = read_le16(fmt + 14);
+
+            // WAVE_FORMAT_EXTENSIBLE: the actual format is in the sub format GUID
+            if (format == 0xFFFEu && chunk_size >= 40u)
+            {
+                format = read_le16(fmt + 24);
+            }
+
+            format_found = true;
+        }
+        else if (std::memcmp(chunk, "data", 4) == 0)
+        {
+            if (!format_found || info.channels == 0u || info.sample_rate == 0u)
+            {
+                return false;
+            }
+
+            if (rf64 && chunk_size == 0xFFFFFFFFu)
+            {
+                chunk_size = rf64_data_size;
+            }
+
+            info.floating_point = format == 3u;
+
+            if (!((format == 1u && (info.bits_per_sample == 8u || info.bits_per_sample == 16u ||
+                                    info.bits_per_sample == 24u || info.bits_per_sample == 32u)) ||
+                  (format == 3u && (info.bits_per_sample == 32u || info.bits_per_sample == 64u))))
+            {
+                return false;
+            }
+
+            info.data_offset = chunk_start;
+            info.frames = chunk_size / (static_cast<uint64_t>(info.channels) * (info.bits_per_sample / 8u));
+
+            return true;
+        }
+
+        // Chunks are padded to an even size
+        file.seekg(static_cast<std::streamoff>(chunk_start + chunk_size + (chunk_size & 1u)));
+    }
+
+    return false;
+}
+
+inline float decode_sample(const uint8_t* p, const WavInfo& info)
+{
+    if (info.floating_point)
+    {
+        if (info.bits_per_sample == 32u)
+        {
+            float value;
+            std::memcpy(&value, p, sizeof(float));
+            return value;
+        }
+
+        double value;
+        std::memcpy(&value, p, sizeof(double));
+        return static_cast<float>(value);
+    }
+
+    switch (info.bits_per_sample)
+    {
+    case 8u:
+        return (static_cast<float>(p[0]) - 128.0f) / 128.0f;
+    case 16u:
+        return static_cast<float>(static_cast<int16_t>(read_le16(p))) / 32768.0f;
+    case 24u:
+        return static_cast<float>(static_cast<int32_t>(static_cast<uint32_t>(p[0] << 8) | (static_cast<uint32_t>(p[1]) << 16) |
+                                                       (static_cast<uint32_t>(p[2]) << 24)) >> 8) / 8388608.0f;
+    default:
+        return static_cast<float>(static_cast<int32_t>(read_le32(p))) / 2147483648.0f;
+    }
+}
+
+// Read the whole file as a single channel: channel < 0 averages all the channels
+inline bool read_wav_mono(const std::string& path, const int& channel, WavInfo& info, std::vector<float>& samples)
+{
+    std::ifstream file(path, std::ios::binary);
+
+    if (!file || !read_wav_info(file, info) || channel >= static_cast<int>(info.channels))
+    {
+        return false;
+    }
+
+    const size_t sample_bytes = info.bits_per_sample / 8u;
+    const size_t frame_bytes = sample_bytes * info.channels;
+    const float gain = 1.0f / static_cast<float>(info.channels);
+
+    samples.assign(info.frames, 0.0f);
+    file.seekg(static_cast<std::streamoff>(info.data_offset));
+
+    // Decode in chunks, so that only the mono samples are fully in memory
+    std::vector<uint8_t> chunk(frame_bytes * 65536u);
+    uint64_t frame = 0u;
+
+    while (frame < info.frames)
+    {
+        const uint64_t frames = std::min<uint64_t>(65536u, info.frames - frame);
+        file.read(reinterpret_cast<char*>(chunk.data()), static_cast<std::streamsize>(frames * frame_bytes));
+        const uint64_t read_frames = static_cast<uint64_t>(file.gcount()) / frame_bytes;
+
+        for (uint64_t f = 0; f < read_frames; f++)
+        {
+            const uint8_t* p = chunk.data() + f * frame_bytes;
+
+            if (channel >= 0)
+            {
+                samples[frame + f] = decode_sample(p + channel * sample_bytes, info);
+            }
+            else
+            {
+                float sum = 0.0f;
+                for (uint16_t c = 0; c < info.channels; c++)
+                {
+                    sum += decode_sample(p + c * sample_bytes, info);
+                }
+                samples[frame + f] = sum * gain;
+            }
+        }
+
+        frame += read_frames;
+
+        // Truncated file: keep what was read
+        if (read_frames < frames)
+        {
+            info.frames = frame;
+            samples.resize(frame);
+            break;
+        }
+    }
+
+    return true;
+}
+
+#endif // INFORMER_CLI_WAV_READER_H_
@@ -0,0 +1,725 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/* informer-daemon: analyze a live PCM stream (standard input, named pipe or
+   UNIX socket) and send the descriptors over OSC with the address tree of
+   The Informer plugin */
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <pthread.h>
+#include <sched.h>
+#include <sys/mman.h>
+
+#include "osc_sender.h"
+#include "pcm_input.h"
+#include "stream_analyzer.h"
+
+struct Options
+{
+    std::string source = "-";
+    PcmFormat format = PcmFormat::F32;
+    unsigned int channels = 2u;
+    float sample_rate = 44100.0f;
+    unsigned int frame_size = 0u;
+    unsigned int hop_size = 0u;
+    std::string host = "127.0.0.1";
+    uint16_t port = 9000u;
+    std::string root = "informer_1";
+    unsigned int report_bands = 3u;
+    bool normalize = false;
+    Informer::NormalizationMode normalize_mode = Informer::NormalizationMode::Static;
+    float smoothing = 0.0f;
+    bool bundles = true;
+    unsigned int threads = 1u;
+    int realtime_priority = 0;
+    float latency_budget_ms = 0.0f;
+    float stats_interval = 0.0f;
+    bool gate = false;
+    float gate_threshold_db = -100.0f;
+    float gate_change = 0.0f;
+};
+
+static void print_usage()
+{
+    std::printf(
+        "Usage: informer-daemon [options] [source]\n"
+        "\n"
+        "Analyze interleaved PCM from source (- for standard input, the default,\n"
+        "unix:<path> for a UNIX socket, or a named pipe) and send the descriptors\n"
+        "over OSC, as The Informer plugin does.\n"
+        "\n"
+        "Options:\n"
+        "  -f, --format <format>      s16, s24, s32 or f32, little endian (default: f32)\n"
+        "  -c, --channels <count>     interleaved channels, up to 64 (default: 2)\n"
+        "  -r, --rate <Hz>            sample rate (default: 44100)\n"
+        "      --frame <size>         analysis frame, a power of two (default: 4096, 8192 over 48 kHz)\n"
+        "      --hop <size>           samples between two updates (default: half the frame)\n"
+        "      --host <address>       OSC destination IPv4 address (default: 127.0.0.1)\n"
+        "  -p, --port <port>          OSC destination port (default: 9000)\n"
+        "      --root <name>          OSC root address (default: informer_1)\n"
+        "      --bands <count>        reported bands, 2 to 16 (default: 3)\n"
+        "      --normalize [mode]     normalize the values: static ranges, as the plugin option (default),\n"
+        "                             minmax (running range) or zscore (running mean and deviation)\n"
+        "      --smoothing <amount>   smooth the mix values, 0 (off) to 1 (default: 0)\n"
+        "      --no-bundles           send one datagram per value instead of OSC bundles\n"
+        "  -j, --threads <count>      threads sharing the channels (default: 1)\n"
+        "      --realtime [priority]  lock the memory and use SCHED_FIFO for the analysis (default priority: 70)\n"
+        "      --latency-budget <ms>  skip the oldest audio when the analysis falls this much behind\n"
+        "      --stats <seconds>      print timing statistics at this interval\n"
+        "      --gate [dB]            skip the analysis of frames below this level (default: -100)\n"
+        "      --gate-change <ratio>  with --gate, repeat the values while the level and the zero crossings\n"
+        "                             stay within this relative change (default: 0, off)\n"
+        "  -h, --help                 show this help\n");
+}
+
+static bool parse_options(int argc, char* argv[], Options& options)
+{
+    bool source_set = false;
+
+    for (int a = 1; a < argc; a++)
+    {
+        const std::string arg = argv[a];
+        const bool has_value = a + 1 < argc;
+
+        auto value = [&]() -> std::string
+        {
+            return argv[++a];
+        };
+
+        try
+        {
+            if (arg == "-h" || arg == "--help")
+            {
+                print_usage();
+                std::exit(0);
+            }
+            else if ((arg == "-f" || arg == "--format") && has_value)
+            {
+                if (!parse_pcm_format(value(), options.format))
+                {
+                    std::fprintf(stderr, "Unknown format: %s\n", argv[a]);
+                    return false;
+                }
+            }
+            else if ((arg == "-c" || arg == "--channels") && has_value)
+            {
+                options.channels = static_cast<unsigned int>(std::stoul(value()));
+            }
+            else if ((arg == "-r" || arg == "--rate") && has_value)
+            {
+                options.sample_rate = std::stof(value());
+            }
+            else if (arg == "--frame" && has_value)
+            {
+                options.frame_size = static_cast<unsigned int>(std::stoul(value()));
+            }
+            else if (arg == "--hop" && has_value)
+            {
+                options.hop_size = static_cast<unsigned int>(std::stoul(value()));
+            }
+            else if (arg == "--host" && has_value)
+            {
+                options.host = value();
+            }
+            else if ((arg == "-p" || arg == "--port") && has_value)
+            {
+                options.port = static_cast<uint16_t>(std::stoul(value()));
+            }
+            else if (arg == "--root" && has_value)
+            {
+                options.root = value();
+            }
+            else if (arg == "--bands" && has_value)
+            {
+                options.report_bands = static_cast<unsigned int>(std::stoul(value()));
+            }
+            else if (arg == "--normalize")
+            {
+                options.normalize = true;
+
+                if (has_value && argv[a + 1][0] != '-')
+                {
+                    const std::string mode = argv[a + 1];
+
+                    if (mode == "static" || mode == "minmax" || mode == "zscore")
+                    {
+                        a++;
+                        options.normalize_mode = mode == "minmax" ? Informer::NormalizationMode::RunningMinMax
+                                                 : mode == "zscore" ? Informer::NormalizationMode::RunningZScore
+                                                 : Informer::NormalizationMode::Static;
+                    }
+                }
+            }
+            else if (arg == "--smoothing" && has_value)
+            {
+                options.smoothing = std::stof(value());
+            }
+            else if (arg == "--no-bundles")
+            {
+                options.bundles = false;
+            }
+            else if ((arg == "-j" || arg == "--threads") && has_value)
+            {
+                options.threads = static_cast<unsigned int>(std::stoul(value()));
+            }
+            else if (arg == "--realtime")
+            {
+                options.realtime_priority = 70;
+
+                if (has_value && argv[a + 1][0] >= '0' && argv[a + 1][0] <= '9')
+                {
+                    options.realtime_priority = std::stoi(value());
+                }
+            }
+            else if (arg == "--latency-budget" && has_value)
+            {
+                options.latency_budget_ms = std::stof(value());
+            }
+            else if (arg == "--stats" && has_value)
+            {
+                options.stats_interval = std::stof(value());
+            }
+            else if (arg == "--gate")
+            {
+                options.gate = true;
+
+                // The level is usually negative, so a value is told from an option by its digit
+                const char* next = has_value ? argv[a + 1] : "";
+                const char digit = next[0] == '-' ? next[1] : next[0];
+
+                if (digit >= '0' && digit <= '9')
+                {
+                    options.gate_threshold_db = std::stof(value());
+                }
+            }
+            else if (arg == "--gate-change" && has_value)
+            {
+                options.gate_change = std::stof(value());
+            }
+            else if (!arg.empty() && arg[0] == '-' && arg != "-")
+            {
+                std::fprintf(stderr, "Unknown or incomplete option: %s\n", arg.c_str());
+                return false;
+            }
+            else if (!source_set)
+            {
+                options.source = arg;
+                source_set = true;
+            }
+            else
+            {
+                std::fprintf(stderr, "Only one source can be analyzed\n");
+                return false;
+            }
+        }
+        catch (const std::exception&)
+        {
+            std::fprintf(stderr, "Invalid value for %s\n", arg.c_str());
+            return false;
+        }
+    }
+
+    if (options.channels == 0u || options.channels > 64u)
+    {
+        std::fprintf(stderr, "The channels must be between 1 and 64\n");
+        return false;
+    }
+
+    if (!(options.sample_rate > 0.0f))
+    {
+        std::fprintf(stderr, "Invalid sample rate\n");
+        return false;
+    }
+
+    // Same frame sizes of the plugin
+    if (options.frame_size == 0u)
+    {
+        options.frame_size = options.sample_rate > 48000.0f ? 8192u : 4096u;
+    }
+
+    if (options.frame_size < 64u || (options.frame_size & (options.frame_size - 1u)) != 0u)
+    {
+        std::fprintf(stderr, "The frame size must be a power of two, at least 64\n");
+        return false;
+    }
+
+    if (options.hop_size == 0u || options.hop_size > options.frame_size)
+    {
+        options.hop_size = options.frame_size / 2u;
+    }
+
+    options.report_bands = std::clamp(options.report_bands, 2u, 16u);
+    options.smoothing = std::clamp(options.smoothing, 0.0f, 1.0f);
+    options.threads = std::clamp(options.threads, 1u, options.channels);
+
+    return true;
+}
+
+// Interleaved samples from the reader thread to the analysis thread. When the
+// analysis falls behind by more than max_frames, the oldest samples are dropped.
+class SampleQueue
+{
+public:
+    SampleQueue(const unsigned int& channels, const size_t& max_frames) : channels_(channels), max_frames_(max_frames)
+    {
+    }
+
+    void push(const float* samples, const size_t& frames)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            samples_.insert(samples_.end(), samples, samples + frames * channels_);
+
+            const size_t queued = samples_.size() / channels_;
+            if (max_frames_ > 0u && queued > max_frames_)
+            {
+                const size_t drop = queued - max_frames_;
+                samples_.erase(samples_.begin(), samples_.begin() + drop * channels_);
+                dropped_ += drop;
+            }
+        }
+
+        available_.notify_one();
+    }
+
+    void finish()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            finished_ = true;
+        }
+
+        available_.notify_one();
+    }
+
+    // Wait for frames interleaved frames, false when the stream is over or
+    // running is cleared (checked periodically, as it is set by a signal handler)
+    bool pop(float* samples, const size_t& frames, const std::atomic<bool>& running)
+    {
+        std::unique_lock<std::mutex> lock(mutex_);
+        while (!available_.wait_for(lock, std::chrono::milliseconds(100), [&]()
+        {
+            return samples_.size() >= frames * channels_ || finished_;
+        }))
+        {
+            if (!running)
+            {
+                return false;
+            }
+        }
+
+        if (samples_.size() < frames * channels_)
+        {
+            return false;
+        }
+
+        std::copy(samples_.begin(), samples_.begin() + frames * channels_, samples);
+        samples_.erase(samples_.begin(), samples_.begin() + frames * channels_);
+
+        return true;
+    }
+
+    uint64_t get_dropped() const
+    {
+        std::lock_guard<std::mutex> lock(mutex_);
+        return dropped_;
+    }
+
+private:
+    mutable std::mutex mutex_;
+    std::condition_variable available_;
+    std::deque<float> samples_;
+    unsigned int channels_;
+    size_t max_frames_;
+    uint64_t dropped_ = 0u;
+    bool finished_ = false;
+};
+
+// Threads analyzing a share of the channels each, started together for every hop
+class ChannelPool
+{
+public:
+    ChannelPool(const unsigned int& threads, const int& realtime_priority)
+    {
+        for (unsigned int t = 1u; t < threads; t++)
+        {
+            workers_.emplace_back([this, t, threads, realtime_priority]()
+            {
+                set_realtime_(realtime_priority);
+                uint64_t seen = 0u;
+
+                while (true)
+                {
+                    std::unique_lock<std::mutex> lock(mutex_);
+                    start_.wait(lock, [&]()
+                    {
+                        return generation_ != seen || stop_;
+                    });
+
+                    if (stop_)
+                    {
+                        return;
+                    }
+
+                    seen = generation_;
+                    lock.unlock();
+
+                    task_(t, threads);
+
+                    lock.lock();
+                    if (--running_ == 0u)
+                    {
+                        done_.notify_one();
+                    }
+                }
+            });
+        }
+
+        threads_ = threads;
+    }
+
+    ~ChannelPool()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+        }
+
+        start_.notify_all();
+
+        for (auto& worker : workers_)
+        {
+            worker.join();
+        }
+    }
+
+    // Run task(thread, threads) on all the threads, the calling one included
+    void run(const std::function<void(unsigned int, unsigned int)>& task)
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = task;
+            running_ = threads_ - 1u;
+            generation_++;
+        }
+
+        start_.notify_all();
+        task(0u, threads_);
+
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_.wait(lock, [&]()
+        {
+            return running_ == 0u;
+        });
+    }
+
+    static bool set_realtime_(const int& priority)
+    {
+        if (priority <= 0)
+        {
+            return true;
+        }
+
+        sched_param parameters = {};
+        parameters.sched_priority = std::clamp(priority, sched_get_priority_min(SCHED_FIFO), sched_get_priority_max(SCHED_FIFO));
+
+        return pthread_setschedparam(pthread_self(), SCHED_FIFO, &parameters) == 0;
+    }
+
+private:
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable start_;
+    std::condition_variable done_;
+    std::function<void(unsigned int, unsigned int)> task_;
+    unsigned int threads_ = 1u;
+    unsigned int running_ = 0u;
+    uint64_t generation_ = 0u;
+    bool stop_ = false;
+};
+
+static std::atomic<bool> running(true);
+
+static void stop(int)
+{
+    running = false;
+}
+
+int main(int argc, char* argv[])
+{
+    Options options;
+
+    if (!parse_options(argc, argv, options))
+    {
+        return 1;
+    }
+
+    PcmInput input;
+    if (!input.open(options.source, options.format, options.channels))
+    {
+        std::fprintf(stderr, "Cannot open %s\n", options.source.c_str());
+        return 1;
+    }
+
+    OscSender sender;
+    if (!sender.open(options.host, options.port, options.bundles))
+    {
+        std::fprintf(stderr, "Invalid OSC destination %s:%u\n", options.host.c_str(), options.port);
+        return 1;
+    }
+
+    std::signal(SIGINT, stop);
+    std::signal(SIGTERM, stop);
+    std::signal(SIGPIPE, SIG_IGN);
+
+    if (options.realtime_priority > 0)
+    {
+        if (mlockall(MCL_CURRENT | MCL_FUTURE) != 0 || !ChannelPool::set_realtime_(options.realtime_priority))
+        {
+            std::fprintf(stderr, "Real-time scheduling not available (missing privileges?), running with normal priority\n");
+            options.realtime_priority = 0;
+        }
+    }
+
+    const size_t budget_frames = static_cast<size_t>(options.latency_budget_ms * 0.001f * options.sample_rate);
+    SampleQueue queue(options.channels, budget_frames > 0u ? std::max<size_t>(budget_frames, options.hop_size) : 0u);
+
+    // The reader runs at normal priority, so that a slow analysis never blocks the writer
+    std::thread reader([&]()
+    {
+        sched_param parameters = {};
+        pthread_setschedparam(pthread_self(), SCHED_OTHER, &parameters);
+
+        std::vector<float> samples(static_cast<size_t>(options.hop_size) * options.channels);
+        while (running)
+        {
+            const size_t frames = input.read(samples.data(), options.hop_size);
+
+            if (frames == 0u)
+            {
+                break;
+            }
+
+            queue.push(samples.data(), frames);
+        }
+
+        queue.finish();
+    });
+
+    const unsigned int channels = options.channels;
+    const unsigned int frame_size = options.frame_size;
+    const unsigned int hop_size = options.hop_size;
+    const std::vector<unsigned int> bin_bands = equal_octave_bin_bands(options.sample_rate, frame_size, options.report_bands);
+
+    std::vector<ChannelAnalyzer> analyzers(channels);
+    for (auto& analyzer : analyzers)
+    {
+        analyzer.prepare(options.sample_rate, frame_size, bin_bands, options.report_bands);
+        analyzer.set_gate(options.gate, options.gate_threshold_db, std::max(options.gate_change, 0.0f));
+    }
+
+    std::vector<ReportNormalizer> normalizers(channels, ReportNormalizer(report_normalization_rules()));
+    for (auto& normalizer : normalizers)
+    {
+        normalizer.set_context(options.sample_rate, frame_size);
+
+        if (options.normalize_mode != Informer::NormalizationMode::Static)
+        {
+            normalizer.set_mode(options.normalize_mode);
+        }
+    }
+
+    // Last frame_size samples of each channel, oldest first
+    std::vector<std::vector<float>> frames(channels, std::vector<float>(frame_size, 0.0f));
+    std::vector<float> hop(static_cast<size_t>(hop_size) * channels);
+    std::vector<ChannelReport> reports(channels);
+    ChannelReport mix;
+    ChannelReport smoothed;
+    bool smoothed_ready = false;
+
+    // OSC addresses, built once
+    const std::string root = "/" + options.root + "/";
+    std::vector<std::vector<std::string>> addresses(channels + 1u);
+    std::vector<std::vector<std::string>> band_addresses(channels + 1u);
+    for (unsigned int c = 0u; c <= channels; c++)
+    {
+        std::string prefix = root;
+        if (c == channels)
+        {
+            prefix += "mix/";
+        }
+        else
+        {
+            prefix += (c < 9u ? "ch0" : "ch") + std::to_string(c + 1u) + "/";
+        }
+
+        for (const auto& entry : report_entries)
+        {
+            addresses[c].push_back(prefix + entry.address);
+        }
+
+        for (unsigned int b = 0u; b < options.report_bands; b++)
+        {
+            band_addresses[c].push_back(prefix + "spec/band" + (b < 9u ? "0" : "") + std::to_string(b + 1u));
+        }
+    }
+
+    ChannelPool pool(options.threads, options.realtime_priority);
+
+    const double hop_ms = 1000.0 * hop_size / options.sample_rate;
+    uint64_t hops = 0u;
+    uint64_t overruns = 0u;
+    double total_ms = 0.0;
+    double max_ms = 0.0;
+    auto last_stats = std::chrono::steady_clock::now();
+
+    auto print_stats = [&]()
+    {
+        std::fprintf(stderr, "%llu updates, analysis %.2f ms mean, %.2f ms max (hop %.2f ms), %llu overruns, %llu frames dropped, %llu send errors\n",
+                     static_cast<unsigned long long>(hops), hops > 0u ? total_ms / static_cast<double>(hops) : 0.0, max_ms, hop_ms,
+                     static_cast<unsigned long long>(overruns), static_cast<unsigned long long>(queue.get_dropped()),
+                     static_cast<unsigned long long>(sender.get_send_errors()));
+    };
+
+    while (running && queue.pop(hop.data(), hop_size, running))
+    {
+        const auto start = std::chrono::steady_clock::now();
+
+        pool.run([&](unsigned int thread, unsigned int threads)
+        {
+            for (unsigned int c = thread; c < channels; c += threads)
+            {
+                std::vector<float>& frame = frames[c];
+                std::copy(frame.begin() + hop_size, frame.end(), frame.begin());
+
+                float* tail = frame.data() + frame_size - hop_size;
+                for (unsigned int s = 0u; s < hop_size; s++)
+                {
+                    tail[s] = hop[static_cast<size_t>(s) * channels + c];
+                }
+
+                analyzers[c].analyze(frame.data(), reports[c]);
+
+                if (options.normalize)
+                {
+                    normalizers[c].process(reports[c].values);
+                }
+            }
+        });
+
+        // Mix: average of the channels
+        mix.values.fill(0.0f);
+        mix.bands.assign(options.report_bands, 0.0f);
+        for (const auto& report : reports)
+        {
+            for (size_t e = 0; e < report_entries.size(); e++)
+            {
+                mix.values[e] += report.values[e] / static_cast<float>(channels);
+            }
+
+            for (size_t b = 0; b < mix.bands.size(); b++)
+            {
+                mix.bands[b] += report.bands[b] / static_cast<float>(channels);
+            }
+        }
+
+        if (options.smoothing > 0.0f)
+        {
+            if (!smoothed_ready)
+            {
+                smoothed = mix;
+                smoothed_ready = true;
+            }
+
+            for (size_t e = 0; e < report_entries.size(); e++)
+            {
+                smoothed.values[e] += (1.0f - options.smoothing) * (mix.values[e] - smoothed.values[e]);
+            }
+
+            mix.values = smoothed.values;
+        }
+
+        for (size_t e = 0; e < report_entries.size(); e++)
+        {
+            sender.send(addresses[channels][e], mix.values[e]);
+        }
+
+        for (size_t b = 0; b < mix.bands.size(); b++)
+        {
+            sender.send(band_addresses[channels][b], mix.bands[b]);
+        }
+
+        for (unsigned int c = 0u; c < channels; c++)
+        {
+            for (size_t e = 0; e < report_entries.size(); e++)
+            {
+                sender.send(addresses[c][e], reports[c].values[e]);
+            }
+
+            for (size_t b = 0; b < reports[c].bands.size(); b++)
+            {
+                sender.send(band_addresses[c][b], reports[c].bands[b]);
+            }
+        }
+
+        sender.flush();
+
+        const auto end = std::chrono::steady_clock::now();
+        const double elapsed_ms = std::chrono::duration<double, std::milli>(end - start).count();
+        hops++;
+        total_ms += elapsed_ms;
+        max_ms = std::max(max_ms, elapsed_ms);
+        overruns += elapsed_ms > hop_ms ? 1u : 0u;
+
+        if (options.stats_interval > 0.0f && std::chrono::duration<float>(end - last_stats).count() >= options.stats_interval)
+        {
+            print_stats();
+            last_stats = end;
+            max_ms = 0.0;
+        }
+    }
+
+    running = false;
+
+    if (options.stats_interval > 0.0f)
+    {
+        print_stats();
+    }
+
+    // The reader may be blocked on an idle source, it ends with the process
+    reader.detach();
+
+    return 0;
+}
@@ -0,0 +1,178 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef INFORMER_DAEMON_OSC_SENDER_H_
+#define INFORMER_DAEMON_OSC_SENDER_H_
+
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+// UDP sender of OSC float messages. Messages are grouped in bundles (with the
+// "immediately" time tag) of at most max_packet bytes, so that a whole update
+// of many channels takes a few datagrams instead of one per value.
+class OscSender
+{
+public:
+    static constexpr size_t max_packet = 1400u;
+
+    OscSender() = default;
+
+    ~OscSender()
+    {
+        close();
+    }
+
+    OscSender(const OscSender&) = delete;
+    OscSender& operator=(const OscSender&) = delete;
+
+    bool open(const std::string& host, const uint16_t& port, const bool& bundles = true)
+    {
+        close();
+
+        std::memset(&address_, 0, sizeof(address_));
+        address_.sin_family = AF_INET;
+        address_.sin_port = htons(port);
+
+        if (inet_pton(AF_INET, host.c_str(), &address_.sin_addr) != 1)
+        {
+            return false;
+        }
+
+        socket_ = ::socket(AF_INET, SOCK_DGRAM, 0);
+        bundles_ = bundles;
+        packet_.reserve(max_packet);
+        start_packet_();
+
+        return socket_ >= 0;
+    }
+
+    void close()
+    {
+        if (socket_ >= 0)
+        {
+            ::close(socket_);
+            socket_ = -1;
+        }
+    }
+
+    // Queue a message, sent by flush() or when the current bundle is full
+    void send(const std::string& address, const float& value)
+    {
+        message_.clear();
+        append_string_(message_, address);
+        append_string_(message_, ",f");
+        append_u32_(message_, float_bits_(value));
+
+        if (!bundles_)
+        {
+            datagram_(message_);
+            return;
+        }
+
+        if (packet_.size() + 4u + message_.size() > max_packet && messages_ > 0u)
+        {
+            flush();
+        }
+
+        append_u32_(packet_, static_cast<uint32_t>(message_.size()));
+        packet_.insert(packet_.end(), message_.begin(), message_.end());
+        messages_++;
+    }
+
+    void flush()
+    {
+        if (bundles_ && messages_ > 0u)
+        {
+            datagram_(packet_);
+        }
+
+        start_packet_();
+    }
+
+    uint64_t get_send_errors() const
+    {
+        return send_errors_;
+    }
+
+private:
+    static uint32_t float_bits_(const float& value)
+    {
+        uint32_t bits;
+        std::memcpy(&bits, &value, sizeof(float));
+
+        return bits;
+    }
+
+    // OSC strings are null terminated and padded to 4 bytes, integers are big endian
+    static void append_string_(std::vector<uint8_t>& buffer, const std::string& text)
+    {
+        buffer.insert(buffer.end(), text.begin(), text.end());
+        buffer.resize(buffer.size() + 4u - text.size() % 4u, 0u);
+    }
+
+    static void append_u32_(std::vector<uint8_t>& buffer, const uint32_t& value)
+    {
+        buffer.push_back(static_cast<uint8_t>(value >> 24));
+        buffer.push_back(static_cast<uint8_t>(value >> 16));
+        buffer.push_back(static_cast<uint8_t>(value >> 8));
+        buffer.push_back(static_cast<uint8_t>(value));
+    }
+
+    void start_packet_()
+    {
+        packet_.clear();
+        messages_ = 0u;
+
+        if (bundles_)
+        {
+            append_string_(packet_, "#bundle");
+            append_u32_(packet_, 0u);
+            append_u32_(packet_, 1u);
+        }
+    }
+
+    void datagram_(const std::vector<uint8_t>& data)
+    {
+        if (socket_ < 0 ||
+            ::sendto(socket_, data.data(), data.size(), 0, reinterpret_cast<const sockaddr*>(&address_), sizeof(address_)) < 0)
+        {
+            send_errors_++;
+        }
+    }
+
+    int socket_ = -1;
+    sockaddr_in address_ = {};
+    bool bundles_ = true;
+    std::vector<uint8_t> packet_;
+    std::vector<uint8_t> message_;
+    size_t messages_ = 0u;
+    uint64_t send_errors_ = 0u;
+};
+
+#endif // INFORMER_DAEMON_OSC_SENDER_H_
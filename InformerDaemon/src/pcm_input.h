@@ -0,0 +1,269 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef INFORMER_DAEMON_PCM_INPUT_H_
+#define INFORMER_DAEMON_PCM_INPUT_H_
+
+#include <cerrno>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <vector>
+
+#include <fcntl.h>
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+// Raw interleaved little endian PCM
+enum class PcmFormat
+{
+    S16,
+    S24,
+    S32,
+    F32
+};
+
+inline bool parse_pcm_format(const std::string& name, PcmFormat& format)
+{
+    if (name == "s16")
+    {
+        format = PcmFormat::S16;
+    }
+    else if (name == "s24")
+    {
+        format = PcmFormat::S24;
+    }
+    else if (name == "s32")
+    {
+        format = PcmFormat::S32;
+    }
+    else if (name == "f32")
+    {
+        format = PcmFormat::F32;
+    }
+    else
+    {
+        return false;
+    }
+
+    return true;
+}
+
+inline size_t pcm_sample_size(const PcmFormat& format)
+{
+    switch (format)
+    {
+    case PcmFormat::S16:
+        return 2u;
+    case PcmFormat::S24:
+        return 3u;
+    default:
+        return 4u;
+    }
+}
+
+inline float decode_pcm(const uint8_t* p, const PcmFormat& format)
+{
+    switch (format)
+    {
+    case PcmFormat::S16:
+        return static_cast<float>(static_cast<int16_t>(static_cast<uint16_t>(p[0] | (p[1] << 8)))) / 32768.0f;
+    case PcmFormat::S24:
+        return static_cast<float>(static_cast<int32_t>((static_cast<uint32_t>(p[0]) << 8) | (static_cast<uint32_t>(p[1]) << 16) |
+                                                       (static_cast<uint32_t>(p[2]) << 24)) >> 8) / 8388608.0f;
+    case PcmFormat::S32:
+    {
+        const uint32_t bits = static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+                              (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+        return static_cast<float>(static_cast<int32_t>(bits)) / 2147483648.0f;
+    }
+    default:
+    {
+        float value;
+        std::memcpy(&value, p, sizeof(float));
+        return value;
+    }
+    }
+}
+
+// Stream source: "-" (standard input), "unix:<path>" (listening UNIX socket,
+// one client at a time) or a path (named pipe, reopened when the writer
+// closes it, or regular file)
+class PcmInput
+{
+public:
+    PcmInput() = default;
+
+    ~PcmInput()
+    {
+        close();
+    }
+
+    PcmInput(const PcmInput&) = delete;
+    PcmInput& operator=(const PcmInput&) = delete;
+
+    bool open(const std::string& source, const PcmFormat& format, const unsigned int& channels)
+    {
+        close();
+
+        source_ = source;
+        format_ = format;
+        frame_bytes_ = pcm_sample_size(format) * channels;
+        pending_.clear();
+
+        if (source == "-")
+        {
+            fd_ = STDIN_FILENO;
+            return true;
+        }
+
+        if (source.rfind("unix:", 0) == 0)
+        {
+            const std::string path = source.substr(5);
+            sockaddr_un address = {};
+
+            if (path.size() >= sizeof(address.sun_path))
+            {
+                return false;
+            }
+
+            address.sun_family = AF_UNIX;
+            std::memcpy(address.sun_path, path.c_str(), path.size() + 1u);
+            ::unlink(path.c_str());
+
+            listener_ = ::socket(AF_UNIX, SOCK_STREAM, 0);
+
+            return listener_ >= 0 && ::bind(listener_, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == 0 &&
+                   ::listen(listener_, 1) == 0;
+        }
+
+        struct stat info;
+        reopen_ = ::stat(source.c_str(), &info) == 0 && S_ISFIFO(info.st_mode);
+        fd_ = ::open(source.c_str(), O_RDONLY);
+
+        return fd_ >= 0;
+    }
+
+    void close()
+    {
+        if (fd_ >= 0 && fd_ != STDIN_FILENO)
+        {
+            ::close(fd_);
+        }
+
+        if (listener_ >= 0)
+        {
+            ::close(listener_);
+            ::unlink(source_.substr(5).c_str());
+        }
+
+        fd_ = -1;
+        listener_ = -1;
+    }
+
+    // Read up to frames interleaved frames, blocking until at least one is
+    // available. Returns 0 at the end of the stream.
+    size_t read(float* samples, const size_t& frames)
+    {
+        bytes_.resize(frames * frame_bytes_);
+
+        while (true)
+        {
+            if (fd_ < 0 && !connect_())
+            {
+                return 0u;
+            }
+
+            // Bytes of an incomplete frame left by the previous read
+            const size_t carried = pending_.size();
+            std::memcpy(bytes_.data(), pending_.data(), carried);
+            pending_.clear();
+
+            const ssize_t count = ::read(fd_, bytes_.data() + carried, bytes_.size() - carried);
+
+            if (count < 0 && errno == EINTR)
+            {
+                pending_.assign(bytes_.begin(), bytes_.begin() + carried);
+                continue;
+            }
+
+            if (count <= 0)
+            {
+                // Writer gone: wait for the next one on sockets and named pipes
+                if (listener_ >= 0 || reopen_)
+                {
+                    if (fd_ >= 0)
+                    {
+                        ::close(fd_);
+                    }
+                    fd_ = -1;
+                    continue;
+                }
+
+                return 0u;
+            }
+
+            const size_t total = carried + static_cast<size_t>(count);
+            const size_t read_frames = total / frame_bytes_;
+            pending_.assign(bytes_.begin() + read_frames * frame_bytes_, bytes_.begin() + total);
+
+            const size_t sample_size = pcm_sample_size(format_);
+            for (size_t s = 0; s < read_frames * frame_bytes_ / sample_size; s++)
+            {
+                samples[s] = decode_pcm(bytes_.data() + s * sample_size, format_);
+            }
+
+            if (read_frames > 0u)
+            {
+                return read_frames;
+            }
+        }
+    }
+
+private:
+    bool connect_()
+    {
+        if (listener_ >= 0)
+        {
+            fd_ = ::accept(listener_, nullptr, nullptr);
+        }
+        else if (reopen_)
+        {
+            fd_ = ::open(source_.c_str(), O_RDONLY);
+        }
+
+        return fd_ >= 0;
+    }
+
+    std::string source_;
+    PcmFormat format_ = PcmFormat::F32;
+    size_t frame_bytes_ = 4u;
+    int fd_ = -1;
+    int listener_ = -1;
+    bool reopen_ = false;
+    std::vector<uint8_t> bytes_;
+    std::vector<uint8_t> pending_;
+};
+
+#endif // INFORMER_DAEMON_PCM_INPUT_H_
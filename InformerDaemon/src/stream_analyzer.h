@@ -0,0 +1,273 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef INFORMER_DAEMON_STREAM_ANALYZER_H_
+#define INFORMER_DAEMON_STREAM_ANALYZER_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include "informer.h"
+#include "dj_fft.h"
+
+// The analysis of TheInformerAudioProcessor::processBlock: for each channel
+// the time descriptors of the last frame_size samples, the spectral
+// descriptors of their Hann windowed spectrum and the maximum magnitude in
+// reported bands of equal width in octaves. The mix is the average of the
+// channels.
+
+// Reported values, in the order and with the OSC names of the plugin
+struct ReportEntry
+{
+    const char* address;
+    bool time;
+    const char* descriptor;
+};
+
+constexpr std::array<ReportEntry, 20> report_entries =
+{{
+    {"time/kurtosis", true, "kurtosis"},
+    {"time/peak", true, "peak"},
+    {"time/pitch", true, "f0"},
+    {"time/rms", true, "rms"},
+    {"time/skewness", true, "skewness"},
+    {"time/variance", true, "variance"},
+    {"time/zerocrossing", true, "zerocrossing"},
+    {"freq/centroid", false, "centroid"},
+    {"freq/decrease", false, "decrease"},
+    {"freq/entropy", false, "entropy"},
+    {"freq/flatness", false, "flatness"},
+    {"freq/flux", false, "flux"},
+    {"freq/irregularity", false, "irregularity"},
+    {"freq/kurtosis", false, "kurtosis"},
+    {"freq/peak", false, "peak"},
+    {"freq/rolloff", false, "rolloff"},
+    {"freq/scf", false, "crestfactor"},
+    {"freq/skewness", false, "skewness"},
+    {"freq/slope", false, "slope"},
+    {"freq/spread", false, "spread"}
+}};
+
+enum ReportIndex : size_t
+{
+    TimeKurtosis = 0,
+    TimePeak,
+    TimePitch,
+    TimeRms,
+    TimeSkewness,
+    TimeVariance,
+    TimeZeroCrossing,
+    FreqCentroid,
+    FreqDecrease,
+    FreqEntropy,
+    FreqFlatness,
+    FreqFlux,
+    FreqIrregularity,
+    FreqKurtosis,
+    FreqPeak,
+    FreqRolloff,
+    FreqCrest,
+    FreqSkewness,
+    FreqSlope,
+    FreqSpread
+};
+
+struct ChannelReport
+{
+    std::array<float, report_entries.size()> values = {};
+    std::vector<float> bands;
+};
+
+using ReportNormalizer = Informer::Normalizer<float, report_entries.size()>;
+
+// Rules of the library for the reported values, with the ranges of the plugin "Normalize Values"
+// option for the spectral kurtosis and the pitch
+inline std::array<Informer::NormalizationRule<float>, report_entries.size()> report_normalization_rules()
+{
+    const auto time_rules = Informer::time_normalization_rules<float>();
+    const auto frequency_rules = Informer::frequency_normalization_rules<float>();
+    std::array<Informer::NormalizationRule<float>, report_entries.size()> rules = {};
+
+    for (size_t e = 0; e < report_entries.size(); e++)
+    {
+        const std::string name = report_entries[e].descriptor;
+
+        if (report_entries[e].time)
+        {
+            const auto d = std::find(std::begin(Informer::time_descriptor_names), std::end(Informer::time_descriptor_names), name);
+            rules[e] = time_rules[static_cast<size_t>(d - std::begin(Informer::time_descriptor_names))];
+        }
+        else
+        {
+            const auto d = std::find(std::begin(Informer::frequency_descriptor_names), std::end(Informer::frequency_descriptor_names), name);
+            rules[e] = frequency_rules[static_cast<size_t>(d - std::begin(Informer::frequency_descriptor_names))];
+        }
+    }
+
+    rules[TimePitch] = Informer::static_normalization(0.0f, 1.0f, Informer::NormalizationUnit::Nyquist, false);
+    rules[FreqKurtosis] = Informer::static_normalization(2.0f, 0.25f);
+
+    return rules;
+}
+
+// Per channel analysis state
+class ChannelAnalyzer
+{
+public:
+    void prepare(const float& sample_rate, const unsigned int& fft_size, const std::vector<unsigned int>& bin_bands,
+                 const unsigned int& report_bands)
+    {
+        fft_size_ = fft_size;
+        bin_bands_ = &bin_bands;
+        report_bands_ = report_bands;
+
+        informer_.set_sample_rate(sample_rate);
+        informer_.set_stft_size(fft_size);
+
+        // Hann window normalized to unit mean, as juce::dsp::WindowingFunction
+        window_ = Informer::Frequency::window(std::vector<float>(fft_size, 1.0f), true);
+        const float sum = std::accumulate(window_.begin(), window_.end(), 0.0f);
+        for (auto& w : window_)
+        {
+            w *= static_cast<float>(fft_size) / sum;
+        }
+
+        fft_scale_ = std::sqrt(static_cast<float>(fft_size));
+        fft_frame_.assign(fft_size, std::complex<float>(0.0f, 0.0f));
+        magnitudes_.assign(fft_size / 2u, 0.0f);
+        informer_.set_magnitudes(magnitudes_.data(), magnitudes_.size());
+    }
+
+    // Frames below threshold_db skip the FFT and report silence; with change_threshold above 0
+    // frames close to the last analyzed one repeat its values (see Informer::ActivityGate)
+    void set_gate(const bool& enable, const float& threshold_db, const float& change_threshold)
+    {
+        informer_.get_activity_gate().set_threshold(threshold_db);
+        informer_.get_activity_gate().set_change_threshold(change_threshold);
+        informer_.set_activity_gating(enable);
+    }
+
+    void analyze(const float* frame, ChannelReport& report)
+    {
+        informer_.set_buffer(frame, fft_size_);
+        informer_.compute_descriptors(true, false);
+
+        const unsigned int fft_half = fft_size_ / 2u;
+
+        if (informer_.get_activity() == Informer::Activity::Active)
+        {
+            for (unsigned int s = 0u; s < fft_size_; s++)
+            {
+                fft_frame_[s] = std::complex<float>(frame[s] * window_[s], 0.0f);
+            }
+
+            const auto spectrum = dj::fft1d(fft_frame_, dj::fft_dir::DIR_FWD);
+
+            // dj_fft scales by 1/sqrt(N), the JUCE transform of the plugin does not
+            for (unsigned int k = 0u; k < fft_half; k++)
+            {
+                magnitudes_[k] = std::abs(spectrum[k]) * fft_scale_;
+            }
+
+            // The previous magnitudes (for the flux) are kept by the analyzer
+            informer_.set_magnitudes(magnitudes_.data(), magnitudes_.size());
+        }
+        else if (informer_.get_activity() == Informer::Activity::Silent)
+        {
+            std::fill(magnitudes_.begin(), magnitudes_.end(), 0.0f);
+        }
+
+        informer_.compute_descriptors(false, true);
+
+        for (size_t e = 0; e < report_entries.size(); e++)
+        {
+            report.values[e] = report_entries[e].time ? informer_.get_time_descriptor(report_entries[e].descriptor)
+                                                      : informer_.get_frequency_descriptor(report_entries[e].descriptor);
+        }
+
+        // Maximum magnitude of each band, scaled and compressed
+        report.bands.assign(report_bands_, 0.0f);
+        if (report_bands_ > 1u)
+        {
+            for (unsigned int k = 0u; k < fft_half; k++)
+            {
+                float& band = report.bands[(*bin_bands_)[k]];
+                band = std::max(band, magnitudes_[k]);
+            }
+        }
+
+        for (auto& band : report.bands)
+        {
+            band = std::sqrt(std::min(1.0f, band / static_cast<float>(fft_half)));
+        }
+    }
+
+private:
+    Informer::Informer<float> informer_;
+    std::vector<float> window_;
+    dj::fft_arg<float> fft_frame_;
+    std::vector<float> magnitudes_;
+    const std::vector<unsigned int>* bin_bands_ = nullptr;
+    float fft_scale_ = 64.0f;
+    unsigned int fft_size_ = 4096u;
+    unsigned int report_bands_ = 3u;
+};
+
+// Band of each bin, for bands of equal width in octaves between 60 Hz and
+// 16 kHz (the first band starts at 0 Hz, the last one ends at Nyquist)
+inline std::vector<unsigned int> equal_octave_bin_bands(const float& sample_rate, const unsigned int& fft_size,
+                                                        const unsigned int& report_bands)
+{
+    std::vector<unsigned int> bin_bands(fft_size / 2u, 0u);
+
+    if (report_bands < 2u)
+    {
+        return bin_bands;
+    }
+
+    const float f_min = 60.0f;
+    const float f_max = 16000.0f;
+    const float octaves_per_band = std::log2(f_max / f_min) / static_cast<float>(report_bands);
+
+    std::vector<float> edges(report_bands + 1u, 0.0f);
+    for (unsigned int b = 1u; b < report_bands; b++)
+    {
+        edges[b] = f_min * std::pow(2.0f, static_cast<float>(b) * octaves_per_band);
+    }
+    edges[report_bands] = sample_rate * 0.5f;
+
+    for (unsigned int k = 0u; k < fft_size / 2u; k++)
+    {
+        const float frequency = static_cast<float>(k) * sample_rate / static_cast<float>(fft_size);
+        const auto edge = std::upper_bound(edges.begin(), edges.end(), frequency) - edges.begin() - 1;
+        bin_bands[k] = static_cast<unsigned int>(std::clamp<long>(edge, 0, static_cast<long>(report_bands) - 1));
+    }
+
+    return bin_bands;
+}
+
+#endif // INFORMER_DAEMON_STREAM_ANALYZER_H_
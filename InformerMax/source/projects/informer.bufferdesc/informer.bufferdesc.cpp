@@ -5,8 +5,10 @@
 
 #include "c74_min.h"
 #include "../../../../Library/informer.h"
+#include "../../../../Library/informer_tracks.h"
 #define DJ_FFT_IMPLEMENTATION
 #include "dj_fft.h"
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -127,6 +129,24 @@ public:
 		}
 	};
 
+	attribute<int, threadsafe::no, limit::clamp> threads
+	{
+		this,
+		"threads",
+		1,
+		range { 1, 8 },
+		title {"Threads"},
+		description {"Number of threads sharing the analysis of frames of 16384 samples or more, this one included."},
+		setter
+		{
+			MIN_FUNCTION
+			{
+				informer_.set_reduction_threads(static_cast<unsigned int>(int(args[0])));
+				return args;
+			}
+		}
+	};
+
 	message<> analyze
 	{
 		this,
@@ -183,6 +203,35 @@ public:
 		}
 	};
 
+	message<> write
+	{
+		this,
+		"write",
+		"Write the computed descriptors to a binary tracks file (see informer_tracks.h).",
+		setter
+		{
+			MIN_FUNCTION
+			{
+				if (args.empty())
+				{
+					cerr << "write requires a file path." << endl;
+					return {};
+				}
+
+				symbol path = args[0];
+				if (write_tracks_(path.c_str()))
+				{
+					cout << "Descriptors written to " << path.c_str() << "." << endl;
+				}
+				else
+				{
+					cerr << "Unable to write descriptors to " << path.c_str() << "." << endl;
+				}
+				return {};
+			}
+		}
+	};
+
 private:
 	Informer::Informer<sample> informer_;
 	std::vector<sample> window_;
@@ -191,6 +240,50 @@ private:
 
 	std::vector<std::vector<std::unordered_map<std::string, sample>>> f_analysis_outputs_;
 	std::vector<std::vector<std::unordered_map<std::string, sample>>> t_analysis_outputs_;
+	double sample_rate_ = 44100.0;
+
+	// One track per channel and descriptor, named as the paths of the bang output
+	inline bool write_tracks_(const std::string& path)
+	{
+		if (t_analysis_outputs_.empty() || t_analysis_outputs_[0].empty())
+		{
+			return false;
+		}
+
+		std::vector<std::string> names;
+		for (auto ch = 0; ch < t_analysis_outputs_.size(); ch++)
+		{
+			std::string channel = "ch" + std::to_string(ch+1);
+			for (const auto& descriptor : t_analysis_outputs_[ch][0])
+			{
+				names.push_back(channel + "::" + "time" + "::" + descriptor.first);
+			}
+			for (const auto& descriptor : f_analysis_outputs_[ch][0])
+			{
+				names.push_back(channel + "::" + "freq" + "::" + descriptor.first);
+			}
+		}
+		std::sort(names.begin(), names.end());
+
+		Informer::Tracks::TrackWriter writer;
+		if (!writer.open(path, names, sample_rate_, frame_size_, hop_size_))
+		{
+			return false;
+		}
+
+		for (auto frame = 0; frame < t_analysis_outputs_[0].size(); frame++)
+		{
+			for (auto ch = 0; ch < t_analysis_outputs_.size(); ch++)
+			{
+				std::string channel = "ch" + std::to_string(ch+1);
+				writer.set_values(t_analysis_outputs_[ch][frame], channel + "::" + "time" + "::");
+				writer.set_values(f_analysis_outputs_[ch][frame], channel + "::" + "freq" + "::");
+			}
+			writer.commit_frame();
+		}
+
+		return writer.close();
+	}
 
 	inline void analyze_()
 	{
@@ -198,6 +291,7 @@ private:
 
 		if (b.valid())
 		{
+			sample_rate_ = b.samplerate();
 			informer_.set_sample_rate(b.samplerate());
 			f_analysis_outputs_.clear();
 			t_analysis_outputs_.clear();
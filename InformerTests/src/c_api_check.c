@@ -0,0 +1,233 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/* c-api-check: use libinformer from C only, as an example of the interface.
+
+   The descriptors written in the index tables must match the ones read back by
+   name (also when enabling an option adds descriptors between two frames), a
+   batch must match the same frames analyzed one by one, the single and double
+   precision analyzers must agree, and invalid arguments must be rejected. */
+
+#include <math.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "informer_c.h"
+
+#define FRAME_SIZE 1024u
+#define BINS (FRAME_SIZE / 2u + 1u)
+#define FRAMES 8u
+#define SAMPLE_RATE 44100.0
+
+static const double pi = 3.14159265358979323846;
+
+static int failures = 0;
+
+static void expect(int condition, const char* what)
+{
+    if (!condition)
+    {
+        fprintf(stderr, "FAILED: %s\n", what);
+        failures++;
+    }
+}
+
+static int close_to(double value, double reference, double tolerance)
+{
+    return fabs(value - reference) <= tolerance * (fabs(reference) > 1.0 ? fabs(reference) : 1.0);
+}
+
+/* Frame f of a 440 Hz tone with a glide, and its magnitudes by a direct DFT of
+   the Hann windowed frame (the scale of an unnormalized FFT) */
+static void make_frame(unsigned int f, double* buffer, double* magnitudes)
+{
+    double windowed[FRAME_SIZE];
+
+    for (unsigned int n = 0; n < FRAME_SIZE; n++)
+    {
+        const double t = (double)(f * FRAME_SIZE / 2u + n) / SAMPLE_RATE;
+        buffer[n] = 0.6 * sin(2.0 * pi * (440.0 + 20.0 * f) * t) + 0.2 * sin(2.0 * pi * 1320.0 * t);
+        windowed[n] = buffer[n] * (0.5 - 0.5 * cos(2.0 * pi * n / FRAME_SIZE));
+    }
+
+    for (unsigned int k = 0; k < BINS; k++)
+    {
+        double re = 0.0;
+        double im = 0.0;
+
+        for (unsigned int n = 0; n < FRAME_SIZE; n++)
+        {
+            re += windowed[n] * cos(2.0 * pi * k * n / FRAME_SIZE);
+            im -= windowed[n] * sin(2.0 * pi * k * n / FRAME_SIZE);
+        }
+
+        magnitudes[k] = sqrt(re * re + im * im);
+    }
+}
+
+/* Every descriptor of the index tables must equal the one read back by name */
+static void check_by_name(const informer_f64* informer, const double* time, const double* frequency, const char* label)
+{
+    char what[128];
+    double value = 0.0;
+
+    for (size_t d = 0; d < INFORMER_TIME_DESCRIPTOR_COUNT; d++)
+    {
+        snprintf(what, sizeof(what), "%s: time %s by name", label, informer_time_descriptor_name(d));
+        expect(informer_f64_get_descriptor(informer, INFORMER_DOMAIN_TIME, informer_time_descriptor_name(d), &value) == INFORMER_OK &&
+               value == time[d], what);
+    }
+
+    for (size_t d = 0; d < INFORMER_FREQUENCY_DESCRIPTOR_COUNT; d++)
+    {
+        snprintf(what, sizeof(what), "%s: frequency %s by name", label, informer_frequency_descriptor_name(d));
+        expect(informer_f64_get_descriptor(informer, INFORMER_DOMAIN_FREQUENCY, informer_frequency_descriptor_name(d), &value) == INFORMER_OK &&
+               value == frequency[d], what);
+    }
+}
+
+int main(void)
+{
+    static double buffers[FRAMES][FRAME_SIZE];
+    static double magnitudes[FRAMES][BINS];
+    static float buffers_f32[FRAMES][FRAME_SIZE];
+    static float magnitudes_f32[FRAMES][BINS];
+
+    double time[FRAMES][INFORMER_TIME_DESCRIPTOR_COUNT];
+    double frequency[FRAMES][INFORMER_FREQUENCY_DESCRIPTOR_COUNT];
+    double batch_time[FRAMES][INFORMER_TIME_DESCRIPTOR_COUNT];
+    double batch_frequency[FRAMES][INFORMER_FREQUENCY_DESCRIPTOR_COUNT];
+    float time_f32[INFORMER_TIME_DESCRIPTOR_COUNT];
+    float frequency_f32[INFORMER_FREQUENCY_DESCRIPTOR_COUNT];
+
+    for (unsigned int f = 0; f < FRAMES; f++)
+    {
+        make_frame(f, buffers[f], magnitudes[f]);
+
+        for (unsigned int n = 0; n < FRAME_SIZE; n++)
+        {
+            buffers_f32[f][n] = (float)buffers[f][n];
+        }
+
+        for (unsigned int k = 0; k < BINS; k++)
+        {
+            magnitudes_f32[f][k] = (float)magnitudes[f][k];
+        }
+    }
+
+    expect(informer_abi_version() == INFORMER_C_ABI_VERSION, "ABI version");
+    expect(strcmp(informer_time_descriptor_name(INFORMER_TIME_RMS), "rms") == 0, "time descriptor names");
+    expect(strcmp(informer_frequency_descriptor_name(INFORMER_FREQUENCY_FLUX), "flux") == 0, "frequency descriptor names");
+    expect(informer_time_descriptor_name(INFORMER_TIME_DESCRIPTOR_COUNT) == NULL, "time descriptor names bound");
+    expect(informer_f64_create(0.0, FRAME_SIZE) == NULL, "create rejects a null sample rate");
+    expect(informer_f64_create(SAMPLE_RATE, 2u) == NULL, "create rejects a tiny STFT");
+
+    informer_f64* informer = informer_f64_create(SAMPLE_RATE, FRAME_SIZE);
+    informer_f64* batch = informer_f64_create(SAMPLE_RATE, FRAME_SIZE);
+    informer_f32* single = informer_f32_create(SAMPLE_RATE, FRAME_SIZE);
+
+    if (informer == NULL || batch == NULL || single == NULL)
+    {
+        fprintf(stderr, "FAILED: create\n");
+        return 1;
+    }
+
+    /* Invalid arguments */
+    expect(informer_f64_analyze(informer, NULL, 0u, NULL, 0u, NULL, NULL, 0) == INFORMER_ERROR_INVALID_ARGUMENT, "analyze without data");
+    expect(informer_f64_analyze(informer, NULL, 0u, magnitudes[0], BINS - 1u, NULL, NULL, 0) == INFORMER_ERROR_INVALID_ARGUMENT,
+           "analyze rejects a spectrum of another size");
+    expect(informer_f64_analyze(NULL, buffers[0], FRAME_SIZE, NULL, 0u, NULL, NULL, 0) == INFORMER_ERROR_INVALID_ARGUMENT, "analyze without analyzer");
+    expect(informer_f64_get_descriptor(informer, 2, "rms", &time[0][0]) == INFORMER_ERROR_INVALID_ARGUMENT, "unknown domain");
+
+    /* Frames one by one, chroma and key from the fifth frame on, which adds descriptors */
+    for (unsigned int f = 0; f < FRAMES; f++)
+    {
+        char label[32];
+        snprintf(label, sizeof(label), "frame %u", f);
+
+        if (f == 4u)
+        {
+            double key = 0.0;
+            expect(informer_f64_get_descriptor(informer, INFORMER_DOMAIN_FREQUENCY, "key", &key) == INFORMER_ERROR_NOT_FOUND, "no key by default");
+            expect(informer_f64_set_chroma_key(informer, 1) == INFORMER_OK && informer_f64_set_chroma_key(batch, 1) == INFORMER_OK, "enable chroma and key");
+        }
+
+        expect(informer_f64_analyze(informer, buffers[f], FRAME_SIZE, magnitudes[f], BINS, time[f], frequency[f], 0) == INFORMER_OK, "analyze");
+        check_by_name(informer, time[f], frequency[f], label);
+    }
+
+    {
+        double chroma[12];
+        double key = -1.0;
+        expect(informer_f64_get_chroma(informer, chroma, 12u) == 12u, "chroma bins");
+        expect(informer_f64_get_descriptor(informer, INFORMER_DOMAIN_FREQUENCY, "key", &key) == INFORMER_OK && key >= 0.0 && key < 24.0, "key");
+    }
+
+    /* The first frame: a 440 Hz tone with its third harmonic */
+    expect(close_to(time[0][INFORMER_TIME_F0], 440.0, 0.01), "f0 of the first frame");
+    expect(close_to(time[0][INFORMER_TIME_RMS], sqrt(0.6 * 0.6 / 2.0 + 0.2 * 0.2 / 2.0), 0.02), "rms of the first frame");
+    expect(frequency[0][INFORMER_FREQUENCY_CENTROID] > 440.0 && frequency[0][INFORMER_FREQUENCY_CENTROID] < 1320.0, "centroid of the first frame");
+
+    /* The same frames as a batch, with the chroma enabled from the start of the second half */
+    expect(informer_f64_set_chroma_key(batch, 0) == INFORMER_OK, "disable chroma and key");
+    expect(informer_f64_analyze_batch(batch, FRAMES / 2u, buffers[0], FRAME_SIZE, FRAME_SIZE, magnitudes[0], BINS, BINS,
+                                      batch_time[0], batch_frequency[0], 0) == INFORMER_OK, "first half batch");
+    expect(informer_f64_set_chroma_key(batch, 1) == INFORMER_OK, "enable chroma and key");
+    expect(informer_f64_analyze_batch(batch, FRAMES / 2u, buffers[FRAMES / 2u], FRAME_SIZE, FRAME_SIZE, magnitudes[FRAMES / 2u], BINS, BINS,
+                                      batch_time[FRAMES / 2u], batch_frequency[FRAMES / 2u], 0) == INFORMER_OK, "second half batch");
+    expect(memcmp(time, batch_time, sizeof(time)) == 0, "batch time descriptors");
+    expect(memcmp(frequency, batch_frequency, sizeof(frequency)) == 0, "batch frequency descriptors");
+
+    /* Single precision, within the rounding of float */
+    for (unsigned int f = 0; f < FRAMES; f++)
+    {
+        expect(informer_f32_analyze(single, buffers_f32[f], FRAME_SIZE, magnitudes_f32[f], BINS, time_f32, frequency_f32, 0) == INFORMER_OK,
+               "single precision analyze");
+    }
+
+    for (size_t d = 0; d < INFORMER_TIME_DESCRIPTOR_COUNT; d++)
+    {
+        expect(close_to(time_f32[d], time[FRAMES - 1u][d], 1e-3), informer_time_descriptor_name(d));
+    }
+
+    for (size_t d = 0; d < INFORMER_FREQUENCY_DESCRIPTOR_COUNT; d++)
+    {
+        expect(close_to(frequency_f32[d], frequency[FRAMES - 1u][d], 1e-3), informer_frequency_descriptor_name(d));
+    }
+
+    /* Normalized descriptors are in [0, 1], f0 stays in Hz */
+    expect(informer_f64_analyze(informer, buffers[0], FRAME_SIZE, magnitudes[0], BINS, time[0], frequency[0], 1) == INFORMER_OK, "normalized analyze");
+    check_by_name(informer, time[0], frequency[0], "normalized");
+
+    for (size_t d = 0; d < INFORMER_FREQUENCY_F0; d++)
+    {
+        expect(frequency[0][d] >= 0.0 && frequency[0][d] <= 1.0, informer_frequency_descriptor_name(d));
+    }
+
+    informer_f64_destroy(informer);
+    informer_f64_destroy(batch);
+    informer_f32_destroy(single);
+
+    printf("c api %s\n", failures == 0 ? "ok" : "FAILED");
+
+    return failures == 0 ? 0 : 1;
+}
@@ -0,0 +1,273 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/* codec-check: encode and decode columns with the lossless encodings of
+   informer_codec.h (Xor, DeltaInteger, DeltaBits and the smallest of them chosen
+   by encode()) and compare the decoded values bit for bit with the input. The
+   columns mix NaN payloads, -0, denormals, infinities and integers up to the
+   float mantissa range, with lengths around the bit packing group boundaries.
+   Truncated payloads must fail to decode. */
+
+#include <cfloat>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <limits>
+#include <string>
+#include <vector>
+
+#include "informer_codec.h"
+
+using namespace Informer::Compression;
+
+static const std::vector<size_t> lengths = {0u,
+                                            1u,
+                                            2u,
+                                            delta_group_size - 1u,
+                                            delta_group_size,
+                                            delta_group_size + 1u,
+                                            delta_group_size + 2u,
+                                            2u * delta_group_size - 1u,
+                                            2u * delta_group_size,
+                                            2u * delta_group_size + 1u,
+                                            1000u};
+
+static bool failed(const std::string& label, const char* what)
+{
+    std::fprintf(stderr, "%s: %s\n", label.c_str(), what);
+
+    return false;
+}
+
+static uint32_t next(uint32_t& state)
+{
+    state = state * 1664525u + 1013904223u;
+
+    return state;
+}
+
+// Values that a comparison with == would not tell apart or would not match
+static std::vector<float> special_values()
+{
+    return {std::numeric_limits<float>::quiet_NaN(),
+            -std::numeric_limits<float>::quiet_NaN(),
+            bits_float(0x7fc12345u),
+            bits_float(0x7f800001u),
+            0.0f,
+            -0.0f,
+            std::numeric_limits<float>::denorm_min(),
+            -std::numeric_limits<float>::denorm_min(),
+            1e-40f,
+            -3e-39f,
+            FLT_MIN,
+            FLT_MAX,
+            -FLT_MAX,
+            std::numeric_limits<float>::infinity(),
+            -std::numeric_limits<float>::infinity()};
+}
+
+static std::vector<float> smooth_column(const size_t& count)
+{
+    std::vector<float> values(count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        values[i] = 440.25f + 20.0f * std::sin(0.01f * static_cast<float>(i));
+    }
+
+    return values;
+}
+
+// A smooth column with special values scattered in it, some at group edges
+static std::vector<float> special_column(const size_t& count)
+{
+    const std::vector<float> specials = special_values();
+    std::vector<float> values = smooth_column(count);
+    uint32_t state = 777u;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (i % 5u == 0u || i % delta_group_size == 0u || i % delta_group_size == delta_group_size - 1u)
+        {
+            values[i] = specials[next(state) % specials.size()];
+        }
+    }
+
+    return values;
+}
+
+static std::vector<float> noise_column(const size_t& count)
+{
+    std::vector<float> values(count);
+    uint32_t state = 4242u;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        values[i] = bits_float(next(state));
+    }
+
+    return values;
+}
+
+// Integers swinging between the ends of the exactly representable range
+static std::vector<float> integer_column(const size_t& count)
+{
+    constexpr float limit = 16777216.0f;
+    std::vector<float> values(count);
+    uint32_t state = 99u;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        switch (i % 4u)
+        {
+        case 0u:
+            values[i] = i % 8u == 0u ? limit : -limit;
+            break;
+        case 1u:
+            values[i] = static_cast<float>(i % 24u);
+            break;
+        case 2u:
+            values[i] = 0.0f;
+            break;
+        default:
+            values[i] = static_cast<float>(static_cast<int32_t>(next(state) >> 8) - 8388608);
+            break;
+        }
+    }
+
+    return values;
+}
+
+static bool same_bits(const std::vector<float>& a, const std::vector<float>& b)
+{
+    return a.size() == b.size() && (a.empty() || std::memcmp(a.data(), b.data(), a.size() * sizeof(float)) == 0);
+}
+
+// Decode the payload and its truncated copies with the given encoding
+static bool check_payload(const std::string& label, const ColumnEncoding& encoding, const std::vector<uint8_t>& payload,
+                          const std::vector<float>& values)
+{
+    std::vector<float> decoded(values.size(), 1.0f);
+
+    if (!decode(encoding, payload.data(), payload.size(), values.size(), decoded.data()))
+    {
+        return failed(label, "decode");
+    }
+
+    if (!same_bits(decoded, values))
+    {
+        return failed(label, "values");
+    }
+
+    // Dropping half of a payload must leave the decoder short of bits
+    if (payload.size() > 8u && decode(encoding, payload.data(), payload.size() / 2u, values.size(), decoded.data()))
+    {
+        return failed(label, "truncated payload");
+    }
+
+    return true;
+}
+
+static bool check_column(const std::string& name, const std::vector<float>& values, const bool& integer)
+{
+    const std::string label = name + " " + std::to_string(values.size());
+    std::vector<uint8_t> payload;
+    bool passed = true;
+
+    encode_xor(values.data(), values.size(), payload);
+    passed &= check_payload(label + " xor", ColumnEncoding::Xor, payload, values);
+
+    encode_delta(values.data(), values.size(), false, payload);
+    passed &= check_payload(label + " delta bits", ColumnEncoding::DeltaBits, payload, values);
+
+    if (integer)
+    {
+        if (!is_integer_column(values.data(), values.size()))
+        {
+            return failed(label, "is_integer_column");
+        }
+
+        encode_delta(values.data(), values.size(), true, payload);
+        passed &= check_payload(label + " delta integer", ColumnEncoding::DeltaInteger, payload, values);
+    }
+    else if (!values.empty() && is_integer_column(values.data(), values.size()))
+    {
+        return failed(label, "is_integer_column");
+    }
+
+    const ColumnEncoding encoding = encode(values.data(), values.size(), payload);
+    passed &= check_payload(label + " encode", encoding, payload, values);
+
+    if (encoding != ColumnEncoding::Raw && payload.size() >= values.size() * sizeof(float))
+    {
+        passed = failed(label, "encode() did not keep the smallest payload");
+    }
+
+    return passed;
+}
+
+int main()
+{
+    struct Column
+    {
+        const char* name;
+        std::vector<float> (*make)(const size_t&);
+        bool integer;
+    };
+
+    const std::vector<Column> columns = {{"smooth", smooth_column, false},
+                                         {"special", special_column, false},
+                                         {"noise", noise_column, false},
+                                         {"integer", integer_column, true}};
+
+    bool passed = true;
+
+    for (const Column& column : columns)
+    {
+        bool column_passed = true;
+
+        for (const size_t& count : lengths)
+        {
+            column_passed &= check_column(column.name, column.make(count), column.integer);
+        }
+
+        std::printf("%-16s %s\n", column.name, column_passed ? "ok" : "FAILED");
+        passed &= column_passed;
+    }
+
+    // Every special value alone and in a constant run crossing a group boundary
+    bool specials_passed = true;
+
+    for (const float& value : special_values())
+    {
+        // +0 is the only integer among them
+        const bool integer = value == 0.0f && !std::signbit(value);
+        specials_passed &= check_column("single", {value}, integer);
+        specials_passed &= check_column("constant", std::vector<float>(delta_group_size + 3u, value), integer);
+    }
+
+    std::printf("%-16s %s\n", "specials", specials_passed ? "ok" : "FAILED");
+    passed &= specials_passed;
+
+    return passed ? 0 : 1;
+}
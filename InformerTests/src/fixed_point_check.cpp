@@ -0,0 +1,196 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/* fixed-point-check: compare the Q15/Q31 descriptors of informer_fixed_point.h
+   with the ones of FixedInformer<double> on the same quantized frames.
+
+   Tolerance: 0.5% of the reference value, 3% for the skewness and the kurtosis
+   (time and spectral). Dimensionless descriptors (shape, ratios, zero crossing
+   rate) use at least 1 as reference, so that values close to 0 are compared in
+   absolute terms. Levels, frequencies, flux and slope are relative only. */
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdio>
+#include <random>
+#include <vector>
+
+#include "informer.h"
+#include "informer_fixed_point.h"
+
+constexpr size_t frame_size = 1024u;
+constexpr size_t bins = frame_size / 2u + 1u;
+constexpr double sample_rate = 44100.0;
+constexpr double pi = 3.14159265358979323846;
+
+constexpr double tolerance = 0.005;
+constexpr double moments_tolerance = 0.03;
+
+// Dimensionless descriptors, in the order of TimeDescriptor and FrequencyDescriptor
+constexpr bool time_dimensionless[static_cast<size_t>(Informer::TimeDescriptor::Count)] =
+{
+    false, false, false, true, true, false, true
+};
+
+constexpr bool frequency_dimensionless[static_cast<size_t>(Informer::FrequencyDescriptor::Count)] =
+{
+    false, false, true, true, true, true, false, true, true, false, false, true, false, false
+};
+
+static bool compare(const char* label, const char* domain, const char* name, const double& reference, const double& value,
+                    const bool& dimensionless, const bool& moment)
+{
+    const double scale = dimensionless ? std::max(std::abs(reference), 1.0) : std::abs(reference);
+    const double allowed = (moment ? moments_tolerance : tolerance) * scale;
+
+    if (!(std::abs(value - reference) <= allowed))
+    {
+        std::fprintf(stderr, "%s: %s::%s is %g, expected %g (+/- %g)\n", label, domain, name, value, reference, allowed);
+        return false;
+    }
+
+    return true;
+}
+
+// Magnitudes of the Hann windowed frame, with the scale of Frequency::magnitudes()
+static std::vector<double> magnitudes(const std::array<double, frame_size>& frame)
+{
+    std::array<double, frame_size> windowed = frame;
+    Informer::FixedInformer<double, frame_size>::apply_window(windowed.data());
+
+    std::vector<double> result(bins);
+
+    for (size_t k = 0; k < bins; k++)
+    {
+        double re = 0.0;
+        double im = 0.0;
+
+        for (size_t n = 0; n < frame_size; n++)
+        {
+            const double phase = 2.0 * pi * static_cast<double>(k * n % frame_size) / static_cast<double>(frame_size);
+            re += windowed[n] * std::cos(phase);
+            im -= windowed[n] * std::sin(phase);
+        }
+
+        result[k] = std::sqrt(re * re + im * im) / static_cast<double>(frame_size);
+    }
+
+    return result;
+}
+
+template <typename TInt>
+static bool check(const char* label, const std::vector<double>& signal)
+{
+    using Informer::TimeDescriptor;
+    using Informer::FrequencyDescriptor;
+
+    const double one = static_cast<double>(static_cast<int64_t>(1) << Informer::FixedPoint::QFormat<TInt>::fraction_bits);
+
+    // Both sides analyze the same quantized values, so that only the arithmetic differs
+    std::vector<TInt> samples(frame_size);
+    std::array<double, frame_size> frame = {};
+
+    for (size_t n = 0; n < frame_size; n++)
+    {
+        samples[n] = Informer::FixedPoint::from_float<TInt>(signal[n]);
+        frame[n] = static_cast<double>(samples[n]) / one;
+    }
+
+    const std::vector<double> spectrum = magnitudes(frame);
+    std::vector<TInt> current(bins);
+    std::vector<TInt> previous(bins);
+    std::array<double, bins> current_values = {};
+    std::array<double, bins> previous_values = {};
+
+    for (size_t k = 0; k < bins; k++)
+    {
+        current[k] = Informer::FixedPoint::from_float<TInt>(spectrum[k]);
+        previous[k] = Informer::FixedPoint::from_float<TInt>(0.7 * spectrum[k] + 0.001 * static_cast<double>(k % 3u));
+        current_values[k] = static_cast<double>(current[k]) / one;
+        previous_values[k] = static_cast<double>(previous[k]) / one;
+    }
+
+    Informer::FixedInformer<double, frame_size> reference(sample_rate);
+    reference.set_buffer(frame);
+    reference.set_magnitudes(previous_values);
+    reference.set_magnitudes(current_values);
+    reference.compute_descriptors();
+
+    std::array<int32_t, static_cast<size_t>(TimeDescriptor::Count)> time = {};
+    std::array<int32_t, static_cast<size_t>(FrequencyDescriptor::Count)> frequency = {};
+    std::vector<int32_t> yin_buffer(frame_size / 2u);
+
+    Informer::FixedPoint::compute_time_descriptors(samples.data(), frame_size, time, yin_buffer.data(), static_cast<uint32_t>(sample_rate));
+    Informer::FixedPoint::compute_frequency_descriptors(current.data(), previous.data(), bins, static_cast<uint32_t>(sample_rate), frequency);
+
+    bool passed = true;
+
+    for (size_t d = 0; d < time.size(); d++)
+    {
+        const auto descriptor = static_cast<TimeDescriptor>(d);
+        const bool moment = descriptor == TimeDescriptor::Kurtosis || descriptor == TimeDescriptor::Skewness;
+        passed &= compare(label, "time", Informer::time_descriptor_names[d], reference.get_time_descriptors()[d],
+                          Informer::FixedPoint::to_float(descriptor, time[d]), time_dimensionless[d], moment);
+    }
+
+    for (size_t d = 0; d < frequency.size(); d++)
+    {
+        const auto descriptor = static_cast<FrequencyDescriptor>(d);
+        const bool moment = descriptor == FrequencyDescriptor::Kurtosis || descriptor == FrequencyDescriptor::Skewness;
+        passed &= compare(label, "freq", Informer::frequency_descriptor_names[d], reference.get_frequency_descriptors()[d],
+                          Informer::FixedPoint::to_float(descriptor, frequency[d], sample_rate), frequency_dimensionless[d], moment);
+    }
+
+    std::printf("%-16s %s\n", label, passed ? "ok" : "FAILED");
+
+    return passed;
+}
+
+int main()
+{
+    std::mt19937 generator(3u);
+    std::normal_distribution<double> gaussian(0.0, 0.2);
+
+    std::vector<double> noise(frame_size);
+    std::vector<double> sine(frame_size);
+    std::vector<double> quiet(frame_size);
+    std::vector<double> mix(frame_size);
+
+    for (size_t n = 0; n < frame_size; n++)
+    {
+        noise[n] = std::clamp(gaussian(generator), -0.99, 0.99);
+        sine[n] = 0.8 * std::sin(2.0 * pi * 440.0 * static_cast<double>(n) / sample_rate) + 0.1;
+        quiet[n] = 0.001 * sine[n];
+        mix[n] = 0.5 * sine[n] + 0.3 * noise[n];
+    }
+
+    bool passed = true;
+    passed &= check<int16_t>("q15 noise", noise);
+    passed &= check<int16_t>("q15 sine", sine);
+    passed &= check<int16_t>("q15 mix", mix);
+    passed &= check<int32_t>("q31 noise", noise);
+    passed &= check<int32_t>("q31 quiet sine", quiet);
+    passed &= check<int32_t>("q31 mix", mix);
+
+    return passed ? 0 : 1;
+}
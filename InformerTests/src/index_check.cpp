@@ -0,0 +1,243 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/* index-check: k nearest neighbour queries of the KD-tree of DescriptorIndex
+   against search_brute_force() on random clustered data, for several leaf
+   sizes, weights (zero ones included, and weights changed after the build),
+   entries still pending outside the tree and an index saved and loaded back.
+   The distances must be identical, and so must the ids unless tied. */
+
+#include <algorithm>
+#include <cstdio>
+#include <filesystem>
+#include <random>
+#include <string>
+#include <vector>
+
+#include "informer_index.h"
+
+using Informer::Index::DescriptorIndex;
+
+constexpr size_t entries = 4000u;
+constexpr size_t pending_entries = 300u;
+constexpr size_t queries = 200u;
+
+static const std::vector<std::string> names = {"time::rms", "time::zcr", "freq::centroid", "freq::spread", "freq::flatness", "corpus"};
+
+static bool failed(const std::string& label, const char* what)
+{
+    std::fprintf(stderr, "%s: %s\n", label.c_str(), what);
+
+    return false;
+}
+
+// Clusters of different spreads plus uniform entries, all within [0, 1]
+template <typename TSample>
+static std::vector<TSample> make_vector(std::mt19937& generator, const std::vector<std::vector<TSample>>& centers)
+{
+    std::uniform_real_distribution<TSample> uniform(static_cast<TSample>(0.0), static_cast<TSample>(1.0));
+    std::vector<TSample> values(names.size());
+    const size_t cluster = generator() % (centers.size() + 1u);
+
+    for (size_t d = 0; d < names.size(); d++)
+    {
+        if (cluster == centers.size())
+        {
+            values[d] = uniform(generator);
+        }
+        else
+        {
+            std::normal_distribution<TSample> normal(centers[cluster][d], static_cast<TSample>(0.01 * (cluster + 1u)));
+            values[d] = std::clamp(normal(generator), static_cast<TSample>(0.0), static_cast<TSample>(1.0));
+        }
+    }
+
+    return values;
+}
+
+// brute holds the k + 1 nearest entries, to tell whether the k-th one is tied
+template <typename TSample>
+static bool same_results(const std::vector<typename DescriptorIndex<TSample>::Match>& tree,
+                         const std::vector<typename DescriptorIndex<TSample>::Match>& brute, const size_t& k)
+{
+    if (tree.size() != std::min(k, brute.size()))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < tree.size(); i++)
+    {
+        const bool tied = (i > 0u && brute[i - 1u].distance == brute[i].distance) ||
+                          (i + 1u < brute.size() && brute[i + 1u].distance == brute[i].distance);
+
+        if (tree[i].distance != brute[i].distance || (!tied && tree[i].id != brute[i].id))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+template <typename TSample>
+static bool check_queries(const std::string& label, const DescriptorIndex<TSample>& index, const std::vector<std::vector<TSample>>& query_set)
+{
+    std::vector<typename DescriptorIndex<TSample>::Match> tree;
+    std::vector<typename DescriptorIndex<TSample>::Match> brute;
+
+    for (const size_t k : {static_cast<size_t>(1u), static_cast<size_t>(7u), static_cast<size_t>(64u)})
+    {
+        for (const auto& query : query_set)
+        {
+            index.search(query.data(), k, tree);
+            index.search_brute_force(query.data(), k + 1u, brute);
+
+            if (brute.size() != std::min(k + 1u, index.size()) || !same_results<TSample>(tree, brute, k))
+            {
+                return failed(label + " k=" + std::to_string(k), "tree and brute force results differ");
+            }
+        }
+    }
+
+    return true;
+}
+
+template <typename TSample>
+static bool check_index(const char* type, const std::string& path)
+{
+    std::mt19937 generator(2024u);
+    std::uniform_real_distribution<TSample> uniform(static_cast<TSample>(0.0), static_cast<TSample>(1.0));
+
+    std::vector<std::vector<TSample>> centers(8u, std::vector<TSample>(names.size()));
+    for (auto& center : centers)
+    {
+        for (auto& value : center)
+        {
+            value = uniform(generator);
+        }
+    }
+
+    std::vector<std::vector<TSample>> data(entries + pending_entries);
+    for (auto& values : data)
+    {
+        values = make_vector(generator, centers);
+    }
+
+    // Queries near the data, uniform and outside of the [0, 1] box
+    std::vector<std::vector<TSample>> query_set(queries);
+    for (size_t q = 0; q < queries; q++)
+    {
+        query_set[q] = make_vector(generator, centers);
+        if (q % 10u == 0u)
+        {
+            for (auto& value : query_set[q])
+            {
+                value = static_cast<TSample>(3.0) * uniform(generator) - static_cast<TSample>(1.0);
+            }
+        }
+    }
+
+    const std::vector<std::vector<TSample>> weight_sets = {{1.0, 1.0, 1.0, 1.0, 1.0, 1.0},
+                                                           {4.0, 0.5, 2.0, 0.0, 0.01, 1.0},
+                                                           {0.0, 0.0, 10.0, 0.0, 0.0, 0.1}};
+
+    bool passed = true;
+
+    for (const uint32_t leaf_size : {1u, 8u, 32u})
+    {
+        for (size_t w = 0; w < weight_sets.size(); w++)
+        {
+            const std::string label = std::string(type) + " leaf " + std::to_string(leaf_size) + " weights " + std::to_string(w);
+            DescriptorIndex<TSample> index(names, leaf_size);
+            index.set_auto_build(false);
+
+            if (!index.set_weights(weight_sets[w]))
+            {
+                return failed(label, "set_weights");
+            }
+
+            for (size_t e = 0; e < entries; e++)
+            {
+                index.insert(data[e], 1000u + e);
+            }
+            index.build();
+
+            // Entries inserted after the build are scanned outside the tree
+            for (size_t e = entries; e < entries + pending_entries; e++)
+            {
+                index.insert(data[e], 1000u + e);
+            }
+
+            if (index.size() != entries + pending_entries || index.get_pending() != pending_entries)
+            {
+                return failed(label, "pending entries");
+            }
+
+            passed &= check_queries(label, index, query_set);
+
+            // The tree was split with the old weights, the queries must still be exact
+            index.set_weights(weight_sets[(w + 1u) % weight_sets.size()]);
+            passed &= check_queries(label + " reweighted", index, query_set);
+
+            DescriptorIndex<TSample> loaded;
+            if (!index.save(path) || !loaded.load(path) || loaded.size() != index.size() ||
+                loaded.get_pending() != pending_entries || loaded.get_weights() != index.get_weights())
+            {
+                return failed(label, "save and load");
+            }
+
+            passed &= check_queries(label + " loaded", loaded, query_set);
+        }
+    }
+
+    // Inserting with auto build keeps rebuilding the tree along the way
+    DescriptorIndex<TSample> growing(names, 16u);
+    growing.set_weights(weight_sets[1]);
+    for (size_t e = 0; e < data.size(); e++)
+    {
+        growing.insert(data[e], e);
+    }
+
+    passed &= growing.get_pending() < growing.size() || failed(type, "auto build");
+    passed &= check_queries(std::string(type) + " auto build", growing, query_set);
+
+    return passed;
+}
+
+int main()
+{
+    const std::string path = (std::filesystem::temp_directory_path() / "informer_index_check.idx").string();
+
+    bool passed = true;
+
+    const bool float_passed = check_index<float>("float", path);
+    std::printf("%-16s %s\n", "float", float_passed ? "ok" : "FAILED");
+    passed &= float_passed;
+
+    const bool double_passed = check_index<double>("double", path);
+    std::printf("%-16s %s\n", "double", double_passed ? "ok" : "FAILED");
+    passed &= double_passed;
+
+    std::filesystem::remove(path);
+
+    return passed ? 0 : 1;
+}
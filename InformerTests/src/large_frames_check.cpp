@@ -0,0 +1,296 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/* large-frames-check: compare the spectral descriptors of TiledSpectrum with the
+   functions of the Frequency namespace, evaluated in double on the same
+   magnitudes, for spectra of one tile and of many tiles. The results with a
+   ReductionPool of 1 to 8 threads, and the YIN difference split over the same
+   pools, must be identical to the ones without a pool. An Informer analyzing
+   large frames must give the same descriptors with any number of reduction
+   threads, close to the ones of the per descriptor functions.
+
+   Tolerance: relative, 1e-9 in double and 1e-4 in float (entropy 5e-3, its
+   terms cancel). The peak and the rolloff may move by one bin in float. */
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#include "informer.h"
+
+constexpr double sample_rate = 48000.0;
+
+static const std::vector<unsigned int> thread_counts = {1u, 2u, 3u, 4u, 8u};
+
+static bool failed(const std::string& label, const char* what)
+{
+    std::fprintf(stderr, "%s: %s\n", label.c_str(), what);
+
+    return false;
+}
+
+template <typename TSample>
+static double tolerance()
+{
+    return sizeof(TSample) == sizeof(double) ? 1e-9 : 1e-4;
+}
+
+static bool compare(const std::string& label, const char* name, const double& reference, const double& value, const double& allowed)
+{
+    if (!(std::abs(value - reference) <= allowed))
+    {
+        std::fprintf(stderr, "%s: %s is %.17g, expected %.17g (+/- %g)\n", label.c_str(), name, value, reference, allowed);
+        return false;
+    }
+
+    return true;
+}
+
+static bool same_bits(const Informer::TiledDescriptors<float>& a, const Informer::TiledDescriptors<float>& b)
+{
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+static bool same_bits(const Informer::TiledDescriptors<double>& a, const Informer::TiledDescriptors<double>& b)
+{
+    return std::memcmp(&a, &b, sizeof(a)) == 0;
+}
+
+// Decaying noise with a zero bin and a strong partial
+template <typename TSample>
+static std::vector<TSample> make_spectrum(const size_t& bins, const unsigned int& seed)
+{
+    std::mt19937 generator(seed);
+    std::uniform_real_distribution<double> uniform(0.0, 1.0);
+    std::vector<TSample> magnitudes(bins);
+
+    for (size_t k = 0; k < bins; k++)
+    {
+        magnitudes[k] = static_cast<TSample>(uniform(generator) * uniform(generator) / (1.0 + 0.01 * static_cast<double>(k)));
+    }
+
+    magnitudes[5] = static_cast<TSample>(0.0);
+    magnitudes[bins / 7u] = static_cast<TSample>(50.0);
+
+    return magnitudes;
+}
+
+template <typename TSample>
+static bool check_spectrum(const char* type, const size_t& bins)
+{
+    using namespace Informer::Frequency;
+
+    const std::string label = std::string(type) + " " + std::to_string(bins) + " bins";
+    const std::vector<TSample> magnitudes = make_spectrum<TSample>(bins, static_cast<unsigned int>(bins));
+
+    // The references are evaluated in double on the same values
+    const std::vector<double> m(magnitudes.begin(), magnitudes.end());
+    std::vector<double> frequencies;
+    const double centroid_ref = centroid(m, sample_rate, frequencies);
+    const double spread_ref = spread(m, sample_rate, frequencies, centroid_ref);
+
+    Informer::TiledSpectrum<TSample> tiled;
+    const Informer::TiledDescriptors<TSample> d = tiled.process(magnitudes.data(), bins, static_cast<TSample>(sample_rate));
+
+    const double tol = tolerance<TSample>();
+    const double bin = sample_rate / static_cast<double>((bins - 1u) * 2u);
+    const double bin_tol = sizeof(TSample) == sizeof(double) ? 1e-9 * sample_rate : 1.01 * bin;
+
+    bool passed = true;
+    passed &= compare(label, "centroid", centroid_ref, d.centroid, tol * std::abs(centroid_ref));
+    passed &= compare(label, "spread", spread_ref, d.spread, tol * std::abs(spread_ref));
+    passed &= compare(label, "crestfactor", crestfactor(m), d.crestfactor, tol * std::abs(crestfactor(m)));
+    passed &= compare(label, "decrease", decrease(m), d.decrease, tol * std::abs(decrease(m)));
+    passed &= compare(label, "entropy", entropy(m), d.entropy, 50.0 * tol * std::abs(entropy(m)));
+    passed &= compare(label, "flatness", flatness(m), d.flatness, tol * std::abs(flatness(m)));
+    passed &= compare(label, "irregularity", irregularity(m), d.irregularity, tol * std::abs(irregularity(m)));
+    passed &= compare(label, "kurtosis", kurtosis(m, sample_rate, frequencies, centroid_ref, spread_ref), d.kurtosis,
+                      tol * std::abs(kurtosis(m, sample_rate, frequencies, centroid_ref, spread_ref)));
+    passed &= compare(label, "peak", peak(m, sample_rate, frequencies), d.peak, bin_tol);
+    passed &= compare(label, "rolloff", rolloff(m, sample_rate, 0.85, frequencies), d.rolloff, bin_tol);
+    passed &= compare(label, "skewness", skewness(m, sample_rate, frequencies, centroid_ref, spread_ref), d.skewness,
+                      tol * std::abs(skewness(m, sample_rate, frequencies, centroid_ref, spread_ref)));
+    passed &= compare(label, "slope", slope(m, sample_rate, frequencies), d.slope, tol * std::abs(slope(m, sample_rate, frequencies)));
+
+    // The tile sums are combined in tile order whatever the number of threads
+    for (const unsigned int threads : thread_counts)
+    {
+        Informer::ReductionPool pool(threads);
+
+        if (!same_bits(d, tiled.process(magnitudes.data(), bins, static_cast<TSample>(sample_rate), static_cast<TSample>(0.85), &pool)))
+        {
+            passed = failed(label + " " + std::to_string(threads) + " threads", "descriptors differ from the ones without pool");
+        }
+    }
+
+    // A silent spectrum leaves every descriptor at 0, as the reference functions do
+    const std::vector<TSample> silence(bins, static_cast<TSample>(0.0));
+    if (!same_bits(Informer::TiledDescriptors<TSample>(), tiled.process(silence.data(), bins, static_cast<TSample>(sample_rate))))
+    {
+        passed = failed(label, "silent spectrum");
+    }
+
+    return passed;
+}
+
+template <typename TSample>
+static bool check_yin(const char* type, const size_t& size)
+{
+    const std::string label = std::string(type) + " yin " + std::to_string(size);
+    std::mt19937 generator(7u);
+    std::normal_distribution<double> noise(0.0, 0.05);
+    std::vector<TSample> buffer(size);
+
+    for (size_t n = 0; n < size; n++)
+    {
+        buffer[n] = static_cast<TSample>(std::sin(0.031 * static_cast<double>(n)) + noise(generator));
+    }
+
+    std::vector<TSample> reference;
+    Informer::Amplitude::yin_difference(buffer, reference);
+
+    bool passed = true;
+
+    for (const unsigned int threads : thread_counts)
+    {
+        Informer::ReductionPool pool(threads);
+        std::vector<TSample> split;
+        Informer::Amplitude::yin_difference(buffer, split, &pool);
+
+        if (split.size() != reference.size() || std::memcmp(split.data(), reference.data(), split.size() * sizeof(TSample)) != 0)
+        {
+            passed = failed(label + " " + std::to_string(threads) + " threads", "difference differs from the one without pool");
+        }
+    }
+
+    return passed;
+}
+
+// A whole analysis of a large frame, tiled or not, with any number of threads
+template <typename TSample>
+static bool check_informer(const char* type, const size_t& frame_size)
+{
+    const std::string label = std::string(type) + " informer " + std::to_string(frame_size);
+    const size_t bins = frame_size / 2u + 1u;
+    std::vector<TSample> buffer(frame_size);
+
+    for (size_t n = 0; n < frame_size; n++)
+    {
+        buffer[n] = static_cast<TSample>(0.5 * std::sin(0.02 * static_cast<double>(n)) + 0.1 * std::sin(0.37 * static_cast<double>(n)));
+    }
+
+    const std::vector<TSample> previous = make_spectrum<TSample>(bins, 1u);
+    const std::vector<TSample> magnitudes = make_spectrum<TSample>(bins, 2u);
+
+    auto analyze = [&](const size_t& large_frame_size, const unsigned int& threads)
+    {
+        Informer::Informer<TSample> informer({}, {}, static_cast<TSample>(sample_rate));
+        informer.set_large_frame_size(large_frame_size);
+        informer.set_reduction_threads(threads);
+        informer.set_buffer(buffer);
+        informer.set_magnitudes(previous, true);
+        informer.compute_descriptors();
+        informer.set_magnitudes(magnitudes, true);
+        informer.compute_descriptors();
+
+        std::unordered_map<std::string, TSample> descriptors = informer.get_time_descriptors();
+        for (const auto& [name, value] : informer.get_frequency_descriptors())
+        {
+            descriptors["freq::" + name] = value;
+        }
+
+        return descriptors;
+    };
+
+    const auto untiled = analyze(0u, 1u);
+    const auto tiled = analyze(bins, 1u);
+
+    bool passed = true;
+
+    if (untiled.size() != tiled.size())
+    {
+        return failed(label, "descriptor sets differ");
+    }
+
+    // Bin positions and descriptors the tiles do not compute are compared exactly in double
+    const double bin = sample_rate / static_cast<double>(frame_size);
+
+    for (const auto& [name, value] : untiled)
+    {
+        const double reference = static_cast<double>(value);
+        const double allowed = name == "freq::peak" || name == "freq::rolloff" ?
+                                   (sizeof(TSample) == sizeof(double) ? 0.0 : 1.01 * bin) :
+                                   (name == "freq::entropy" ? 50.0 : 1.0) * 10.0 * tolerance<TSample>() * std::abs(reference);
+
+        if (tiled.count(name) == 0u)
+        {
+            passed = failed(label, "missing descriptor");
+            continue;
+        }
+
+        passed &= compare(label, name.c_str(), reference, static_cast<double>(tiled.at(name)), allowed);
+    }
+
+    for (const unsigned int threads : thread_counts)
+    {
+        const auto split = analyze(bins, threads);
+
+        for (const auto& [name, value] : tiled)
+        {
+            if (split.count(name) == 0u || std::memcmp(&split.at(name), &value, sizeof(TSample)) != 0)
+            {
+                passed = failed(label + " " + std::to_string(threads) + " threads " + name, "differs from 1 thread");
+            }
+        }
+    }
+
+    return passed;
+}
+
+int main()
+{
+    bool passed = true;
+
+    // One partial tile, a few tiles and many of them (a tile is 2048 bins in float, 1024 in double)
+    for (const size_t bins : {static_cast<size_t>(1500u), static_cast<size_t>(16385u), static_cast<size_t>(65537u)})
+    {
+        const bool float_passed = check_spectrum<float>("float", bins);
+        const bool double_passed = check_spectrum<double>("double", bins);
+        std::printf("%-16s %s\n", ("tiled " + std::to_string(bins)).c_str(), float_passed && double_passed ? "ok" : "FAILED");
+        passed &= float_passed && double_passed;
+    }
+
+    const bool yin_passed = check_yin<float>("float", 16384u) && check_yin<double>("double", 8193u);
+    std::printf("%-16s %s\n", "yin", yin_passed ? "ok" : "FAILED");
+    passed &= yin_passed;
+
+    const bool informer_passed = check_informer<float>("float", 32768u) && check_informer<double>("double", 16384u);
+    std::printf("%-16s %s\n", "informer", informer_passed ? "ok" : "FAILED");
+    passed &= informer_passed;
+
+    return passed ? 0 : 1;
+}
@@ -0,0 +1,330 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+/* tracks-check: write descriptor tracks with TrackWriter, read them back through
+   the memory mapping of TrackReader and compare every value bit for bit, for
+   Raw and Packed files, by track, by slice across block boundaries and by
+   frame. Truncated and corrupted copies of the files must be rejected by
+   TrackReader::open(). */
+
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iterator>
+#include <string>
+#include <vector>
+
+#include "informer_tracks.h"
+
+using Informer::Tracks::Codec;
+using Informer::Tracks::FileHeader;
+using Informer::Tracks::TrackReader;
+using Informer::Tracks::TrackWriter;
+
+constexpr uint64_t frames = 1000u;
+constexpr uint32_t block_frames = 96u;
+constexpr double sample_rate = 48000.0;
+constexpr uint32_t frame_size = 2048u;
+constexpr uint32_t hop_size = 512u;
+
+static const std::vector<std::string> names = {"rms", "centroid", "key", "flux", "f0"};
+
+static bool failed(const char* label, const char* what)
+{
+    std::fprintf(stderr, "%s: %s\n", label, what);
+
+    return false;
+}
+
+// Smooth, integer, noisy and special (NaN, -0, denormal) tracks
+static std::vector<float> make_values()
+{
+    std::vector<float> values(frames * names.size());
+    uint32_t state = 12345u;
+
+    for (uint64_t f = 0; f < frames; f++)
+    {
+        state = state * 1664525u + 1013904223u;
+        float* frame = values.data() + f * names.size();
+        frame[0] = 0.5f + 0.25f * std::sin(0.01f * static_cast<float>(f));
+        frame[1] = 1000.0f + static_cast<float>(f % 17u) * 3.5f;
+        frame[2] = static_cast<float>((f / 50u) % 24u);
+        frame[3] = static_cast<float>(state >> 8) / 16777216.0f;
+        frame[4] = f % 7u == 0u ? std::nanf("") : (f % 11u == 0u ? -0.0f : (f % 13u == 0u ? 1e-40f : 220.0f));
+    }
+
+    return values;
+}
+
+static bool same_bits(const float& a, const float& b)
+{
+    return std::memcmp(&a, &b, sizeof(float)) == 0;
+}
+
+static bool write_file(const std::string& path, const std::vector<float>& values, const Codec& codec)
+{
+    TrackWriter writer;
+
+    if (!writer.open(path, names, sample_rate, frame_size, hop_size, block_frames, codec))
+    {
+        return false;
+    }
+
+    for (uint64_t f = 0; f < frames; f++)
+    {
+        if (!writer.write_frame(values.data() + f * names.size()))
+        {
+            return false;
+        }
+    }
+
+    return writer.close();
+}
+
+static bool check_read(const char* label, const std::string& path, const std::vector<float>& values, const Codec& codec)
+{
+    TrackReader reader;
+
+    if (!reader.open(path))
+    {
+        return failed(label, "open");
+    }
+
+    if (reader.get_frame_count() != frames || reader.get_descriptor_count() != names.size() ||
+        reader.get_block_frames() != block_frames || reader.get_block_count() != (frames + block_frames - 1u) / block_frames ||
+        reader.get_sample_rate() != sample_rate || reader.get_frame_size() != frame_size ||
+        reader.get_hop_size() != hop_size || reader.get_codec() != codec || reader.get_descriptor_names() != names)
+    {
+        return failed(label, "header");
+    }
+
+    if (reader.find_descriptor("key") != 2 || reader.find_descriptor("loudness") != -1)
+    {
+        return failed(label, "find_descriptor");
+    }
+
+    if (reader.frame_at_time(reader.frame_time(517u)) != 517u || reader.frame_at_time(1e9) != frames - 1u)
+    {
+        return failed(label, "frame times");
+    }
+
+    // Raw blocks are read in place from the mapping
+    if (codec == Codec::Raw && (reader.block_track(3u, 1u) == nullptr ||
+                                !same_bits(reader.block_track(3u, 1u)[5], values[(3u * block_frames + 5u) * names.size() + 1u])))
+    {
+        return failed(label, "block_track");
+    }
+
+    std::vector<float> track(frames);
+
+    for (size_t d = 0; d < names.size(); d++)
+    {
+        if (!reader.read(d, 0u, frames, track.data()))
+        {
+            return failed(label, "read");
+        }
+
+        for (uint64_t f = 0; f < frames; f++)
+        {
+            if (!same_bits(track[f], values[f * names.size() + d]))
+            {
+                return failed(label, "track values");
+            }
+        }
+    }
+
+    // A slice starting inside a block and spanning three of them, the last one partial
+    const uint64_t first = block_frames - 7u;
+    const uint64_t count = 2u * block_frames + 20u;
+    uint64_t expected = first;
+    bool slices_ok = true;
+    const bool sliced = reader.for_each_slice(3u, first, count, [&](uint64_t frame, const float* slice, size_t size)
+    {
+        slices_ok = slices_ok && frame == expected;
+        for (size_t i = 0; i < size; i++)
+        {
+            slices_ok = slices_ok && same_bits(slice[i], values[(frame + i) * names.size() + 3u]);
+        }
+        expected += size;
+    });
+
+    if (!sliced || !slices_ok || expected != first + count)
+    {
+        return failed(label, "slices");
+    }
+
+    // The tail of the last block
+    if (!reader.read(4u, frames - 3u, 3u, track.data()) || !same_bits(track[2], values[(frames - 1u) * names.size() + 4u]))
+    {
+        return failed(label, "last block");
+    }
+
+    if (reader.read(0u, frames - 3u, 4u, track.data()) || reader.read(names.size(), 0u, 1u, track.data()))
+    {
+        return failed(label, "out of range reads");
+    }
+
+    std::vector<double> frame(names.size());
+
+    if (!reader.read_frame(frames / 2u, frame.data()) || reader.read_frame(frames, frame.data()))
+    {
+        return failed(label, "read_frame");
+    }
+
+    for (size_t d = 0; d < names.size(); d++)
+    {
+        const float value = values[(frames / 2u) * names.size() + d];
+
+        if (!(static_cast<double>(value) == frame[d] || (std::isnan(value) && std::isnan(frame[d]))))
+        {
+            return failed(label, "frame values");
+        }
+    }
+
+    return true;
+}
+
+// Write a modified copy of the file and expect TrackReader to reject it
+static bool check_rejected(const char* label, const std::string& path, const std::string& copy, const char* what,
+                           const std::function<void(std::vector<char>&)>& corrupt)
+{
+    std::ifstream input(path, std::ios::binary);
+    std::vector<char> bytes((std::istreambuf_iterator<char>(input)), std::istreambuf_iterator<char>());
+    corrupt(bytes);
+
+    std::ofstream output(copy, std::ios::binary | std::ios::trunc);
+    output.write(bytes.data(), static_cast<std::streamsize>(bytes.size()));
+    output.close();
+
+    TrackReader reader;
+
+    if (reader.open(copy))
+    {
+        return failed(label, what);
+    }
+
+    return true;
+}
+
+static bool check_corruption(const char* label, const std::string& path, const std::string& copy)
+{
+    FileHeader header;
+    {
+        std::ifstream input(path, std::ios::binary);
+        input.read(reinterpret_cast<char*>(&header), sizeof(FileHeader));
+    }
+
+    auto set_header = [](std::vector<char>& bytes, const FileHeader& modified)
+    {
+        std::memcpy(bytes.data(), &modified, sizeof(FileHeader));
+    };
+
+    bool passed = true;
+
+    passed &= check_rejected(label, path, copy, "empty file", [](std::vector<char>& bytes) { bytes.clear(); });
+    passed &= check_rejected(label, path, copy, "truncated header", [](std::vector<char>& bytes) { bytes.resize(sizeof(FileHeader) - 1u); });
+    passed &= check_rejected(label, path, copy, "header only", [](std::vector<char>& bytes) { bytes.resize(sizeof(FileHeader)); });
+    passed &= check_rejected(label, path, copy, "truncated blocks", [](std::vector<char>& bytes) { bytes.resize(bytes.size() / 2u); });
+    passed &= check_rejected(label, path, copy, "truncated index", [](std::vector<char>& bytes) { bytes.resize(bytes.size() - 1u); });
+
+    passed &= check_rejected(label, path, copy, "magic", [&](std::vector<char>& bytes)
+    {
+        FileHeader modified = header;
+        modified.magic[0] = 'X';
+        set_header(bytes, modified);
+    });
+    passed &= check_rejected(label, path, copy, "version", [&](std::vector<char>& bytes)
+    {
+        FileHeader modified = header;
+        modified.version++;
+        set_header(bytes, modified);
+    });
+    passed &= check_rejected(label, path, copy, "endianness", [&](std::vector<char>& bytes)
+    {
+        FileHeader modified = header;
+        modified.endian = 0x04030201u;
+        set_header(bytes, modified);
+    });
+    passed &= check_rejected(label, path, copy, "frame count", [&](std::vector<char>& bytes)
+    {
+        FileHeader modified = header;
+        modified.frame_count += block_frames;
+        set_header(bytes, modified);
+    });
+    passed &= check_rejected(label, path, copy, "descriptor count", [&](std::vector<char>& bytes)
+    {
+        FileHeader modified = header;
+        modified.descriptor_count = 1000000u;
+        set_header(bytes, modified);
+    });
+    passed &= check_rejected(label, path, copy, "index offset", [&](std::vector<char>& bytes)
+    {
+        FileHeader modified = header;
+        modified.index_offset = bytes.size();
+        set_header(bytes, modified);
+    });
+    passed &= check_rejected(label, path, copy, "block offset", [&](std::vector<char>& bytes)
+    {
+        Informer::Tracks::BlockIndexEntry entry;
+        std::memcpy(&entry, bytes.data() + header.index_offset, sizeof(entry));
+        entry.offset = bytes.size();
+        std::memcpy(bytes.data() + header.index_offset, &entry, sizeof(entry));
+    });
+    passed &= check_rejected(label, path, copy, "block codec", [&](std::vector<char>& bytes)
+    {
+        Informer::Tracks::BlockIndexEntry entry;
+        std::memcpy(&entry, bytes.data() + header.index_offset, sizeof(entry));
+        entry.codec = 7u;
+        std::memcpy(bytes.data() + header.index_offset, &entry, sizeof(entry));
+    });
+
+    return passed;
+}
+
+int main()
+{
+    const auto directory = std::filesystem::temp_directory_path();
+    const std::string path = (directory / "informer_tracks_check.trk").string();
+    const std::string copy = (directory / "informer_tracks_check_corrupt.trk").string();
+    const std::vector<float> values = make_values();
+
+    bool passed = true;
+
+    for (const Codec codec : {Codec::Raw, Codec::Packed})
+    {
+        const char* label = codec == Codec::Raw ? "raw" : "packed";
+        bool codec_passed = write_file(path, values, codec) || failed(label, "write");
+        codec_passed = codec_passed && check_read(label, path, values, codec);
+        codec_passed = codec_passed && check_corruption(label, path, copy);
+
+        std::printf("%-16s %s\n", label, codec_passed ? "ok" : "FAILED");
+        passed &= codec_passed;
+    }
+
+    std::filesystem::remove(path);
+    std::filesystem::remove(copy);
+
+    return passed ? 0 : 1;
+}
@@ -24,10 +24,17 @@ SOFTWARE.
 #define INFORMER_H_
 
 #include <algorithm>
+#include <array>
 #include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstdlib>
+#include <limits>
 #include <numeric>
 #include <string>
+#include <type_traits>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 #include <iostream>
@@ -36,1278 +43,5476 @@ SOFTWARE.
 #include<concepts>
 #endif
 
+#ifdef INFORMER_PROFILE
+#include <atomic>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <sstream>
+#endif
+
+#include "informer_descriptors.h"
+
+// Library version: the minor is bumped whenever the descriptors computed from
+// the same input can change (e.g. to invalidate cached analyses)
+#define INFORMER_VERSION_MAJOR 0
+#define INFORMER_VERSION_MINOR 5
+#define INFORMER_VERSION_PATCH 0
+
+// Analysis schema: bumped by every change to the definition of a descriptor,
+// between releases too, so that cached analyses keyed on it are not reused
+#define INFORMER_ANALYSIS_SCHEMA 5
+
 namespace Informer
 {
 
-/* TIME DOMAIN DESCRIPTORS */
+/* PROFILING */
 
-namespace Amplitude
+// Build with INFORMER_PROFILE defined to time every descriptor computation.
+// Without it, INFORMER_PROFILE_SCOPE expands to nothing and the functions
+// below return empty results.
+namespace Profiler
 {
 
-// PEAK
-template <typename Container>
-#if __cplusplus >= 202002L
-requires std::floating_point<typename Container::value_type>
-#endif
-typename Container::value_type peak(const Container& buffer)
+// Timing statistics of a stage (a descriptor, the windowing...), in nanoseconds.
+// The count and the mean cover all the recorded calls, the 99th percentile
+// only the events still held in the per-thread rings.
+struct StageSummary
 {
-    using TSample = typename Container::value_type;
-
-    TSample peak = static_cast<TSample>(0.0);
+    std::string name;
+    uint64_t count = 0;
+    double mean_ns = 0.0;
+    double p99_ns = 0.0;
+};
 
-    for (const auto &s : buffer)
-    {
-        if (abs(s) > peak)
-        {
-            peak = abs(s);
-        }
-    }
+#ifdef INFORMER_PROFILE
 
-    return peak;
-}
+// Number of events kept for each thread, older ones are overwritten
+constexpr size_t events_per_thread = 1u << 16;
+constexpr size_t max_stages = 128u;
 
-// ROOT MEAN SQUARE
-template <typename Container>
-#if __cplusplus >= 202002L
-requires std::floating_point<typename Container::value_type>
-#endif
-typename Container::value_type rms(const Container& buffer)
+struct Event
 {
-    using TSample = typename Container::value_type;
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> start{0};
+    std::atomic<uint64_t> duration{0};
+};
 
-    TSample rms_amp = static_cast<TSample>(0.0);
+struct StageCounter
+{
+    std::atomic<const char*> name{nullptr};
+    std::atomic<uint64_t> count{0};
+    std::atomic<uint64_t> total_ns{0};
+};
 
-    for (const auto &s : buffer)
-    {
-        rms_amp += s * s;
-    }
+// Each thread owns its profile and is its only writer, so recording an event
+// takes no lock: readers only load the published atomics
+struct ThreadProfile
+{
+    unsigned int thread_id = 0;
+    std::atomic<uint64_t> written{0};
+    std::unique_ptr<Event[]> events = std::make_unique<Event[]>(events_per_thread);
+    std::array<StageCounter, max_stages> stages;
+    std::atomic<size_t> stage_count{0};
 
-    if (buffer.size() > 0)
+    StageCounter* stage(const char* name)
     {
-        rms_amp /= buffer.size();
-        rms_amp = std::sqrt(rms_amp);
-    }
+        const size_t count = stage_count.load(std::memory_order_relaxed);
 
-    return rms_amp;
-}
+        for (size_t s = 0; s < count; s++)
+        {
+            if (stages[s].name.load(std::memory_order_relaxed) == name)
+            {
+                return &stages[s];
+            }
+        }
 
-// VARIANCE
-template <typename Container>
-#if __cplusplus >= 202002L
-requires std::floating_point<typename Container::value_type>
-#endif
-typename Container::value_type variance(const Container& buffer)
-{
-    using TSample = typename Container::value_type;
+        if (count < max_stages)
+        {
+            stages[count].name.store(name, std::memory_order_relaxed);
+            stage_count.store(count + 1u, std::memory_order_release);
 
-    TSample amp_variance = static_cast<TSample>(0.0);
+            return &stages[count];
+        }
 
-    if (buffer.empty())
-    {
-        return amp_variance;
+        return nullptr;
     }
 
-    const TSample count = static_cast<TSample>(buffer.size());
-    const TSample mean = std::accumulate(buffer.begin(), buffer.end(), static_cast<TSample>(0.0)) / count;
-
-    for (const auto &s : buffer)
+    void record(const char* name, const uint64_t& start, const uint64_t& duration)
     {
-        amp_variance += pow(s - mean, (TSample)2.0);
-    }
+        const uint64_t position = written.load(std::memory_order_relaxed);
+        Event& event = events[position % events_per_thread];
+        event.name.store(name, std::memory_order_relaxed);
+        event.start.store(start, std::memory_order_relaxed);
+        event.duration.store(duration, std::memory_order_relaxed);
+        written.store(position + 1u, std::memory_order_release);
 
-    amp_variance /= count;
-
-    return amp_variance;
-}
-
-// KURTOSIS
-template <typename Container>
-#if __cplusplus >= 202002L
-requires std::floating_point<typename Container::value_type>
-#endif
-typename Container::value_type kurtosis(const Container& buffer,
-                                        typename Container::value_type mean = static_cast<typename Container::value_type>(-10000.0),
-                                        typename Container::value_type amp_variance = static_cast<typename Container::value_type>(-10000.0))
-{
-    using TSample = typename Container::value_type;
-
-    TSample amp_kurtosis = static_cast<TSample>(0.0);
-    TSample var = amp_variance;
-    TSample amp_mean = mean;
-
-    if (var < static_cast<TSample>(-9999.0))
-    {
-        var = variance(buffer);
+        if (StageCounter* counter = stage(name))
+        {
+            counter->count.store(counter->count.load(std::memory_order_relaxed) + 1u, std::memory_order_relaxed);
+            counter->total_ns.store(counter->total_ns.load(std::memory_order_relaxed) + duration, std::memory_order_relaxed);
+        }
     }
+};
 
-    if (mean < static_cast<TSample>(-9999.0))
-    {
-        amp_mean = std::accumulate(buffer.begin(), buffer.end(), static_cast<TSample>(0.0)) / static_cast<TSample>(buffer.size());
-    }
+struct Registry
+{
+    std::mutex mutex;
+    std::vector<std::unique_ptr<ThreadProfile>> threads;
+    const std::chrono::steady_clock::time_point origin = std::chrono::steady_clock::now();
+};
 
-    if (buffer.empty() || var <= std::numeric_limits<TSample>::epsilon())
-    {
-        return amp_kurtosis;
-    }
+inline Registry& registry()
+{
+    static Registry registry;
 
-    TSample invSqrChVariance = (TSample)1.0 / (var * var);
+    return registry;
+}
 
-    for (const auto &s : buffer)
+// The registry lock is taken only the first time a thread records an event.
+// Profiles outlive their threads, so that their events can still be exported.
+inline ThreadProfile& thread_profile()
+{
+    thread_local ThreadProfile* profile = []()
     {
-        amp_kurtosis += std::pow(s - amp_mean, (TSample)4.0);
-    }
+        Registry& r = registry();
+        std::lock_guard<std::mutex> lock(r.mutex);
+        r.threads.push_back(std::make_unique<ThreadProfile>());
+        r.threads.back()->thread_id = static_cast<unsigned int>(r.threads.size());
 
-    amp_kurtosis /= static_cast<TSample>(buffer.size());
-    amp_kurtosis *= invSqrChVariance;
-    amp_kurtosis -= (TSample)3.0;
+        return r.threads.back().get();
+    }();
 
-    return amp_kurtosis;
+    return *profile;
 }
 
-// SKEWNESS
-template <typename Container>
-#if __cplusplus >= 202002L
-requires std::floating_point<typename Container::value_type>
-#endif
-typename Container::value_type skewness(const Container& buffer,
-                                        typename Container::value_type mean = static_cast<typename Container::value_type>(-10000.0),
-                                        typename Container::value_type amp_variance = static_cast<typename Container::value_type>(-10000.0))
+inline uint64_t now_ns()
 {
-    using TSample = typename Container::value_type;
-
-    TSample skewness = static_cast<TSample>(0.0);
-    TSample var = amp_variance;
-    TSample amp_mean = mean;
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now() - registry().origin).count());
+}
 
-    if (var < static_cast<TSample>(-9999.0))
+class ScopedTimer
+{
+public:
+    explicit ScopedTimer(const char* name) : name_(name), start_(now_ns())
     {
-        var = variance(buffer);
     }
 
-    if (mean < static_cast<TSample>(-9999.0))
+    ~ScopedTimer()
     {
-        amp_mean = std::accumulate(buffer.begin(), buffer.end(), static_cast<TSample>(0.0)) / static_cast<TSample>(buffer.size());
+        thread_profile().record(name_, start_, now_ns() - start_);
     }
 
-    if (buffer.empty() || var <= std::numeric_limits<TSample>::epsilon())
-    {
-        return skewness;
-    }
+    ScopedTimer(const ScopedTimer&) = delete;
+    ScopedTimer& operator=(const ScopedTimer&) = delete;
 
-    TSample invDenominator = (TSample)1.0 / std::pow(std::sqrt(var), (TSample)3.0);
+private:
+    const char* name_;
+    uint64_t start_;
+};
 
-    for (const auto &s : buffer)
-    {
-        skewness += std::pow(s - amp_mean, (TSample)3.0);
-    }
+template <typename Function>
+void for_each_event(const ThreadProfile& profile, Function function)
+{
+    const uint64_t written = profile.written.load(std::memory_order_acquire);
+    const uint64_t first = written > events_per_thread ? written - events_per_thread : 0u;
 
-    skewness /= static_cast<TSample>(buffer.size());
-    skewness *= invDenominator;
+    for (uint64_t e = first; e < written; e++)
+    {
+        const Event& event = profile.events[e % events_per_thread];
+        const char* name = event.name.load(std::memory_order_relaxed);
 
-    return skewness;
+        if (name != nullptr)
+        {
+            function(name, event.start.load(std::memory_order_relaxed), event.duration.load(std::memory_order_relaxed));
+        }
+    }
 }
 
-// FUNDAMENTAL PITCH (YIN ALGORITHM)
-template <typename Container>
-#if __cplusplus >= 202002L
-requires std::floating_point<typename Container::value_type>
-#endif
-typename Container::value_type yin(Container &buffer, typename Container::value_type sample_rate, typename Container::value_type threshold = static_cast<typename Container::value_type>(0.15))
+inline std::vector<StageSummary> summary()
 {
-    using TSample = typename Container::value_type;
+    struct Stage
+    {
+        uint64_t count = 0;
+        uint64_t total_ns = 0;
+        std::vector<uint64_t> durations;
+    };
 
-    size_t half_buffer_size = buffer.size() / 2;
-    std::vector<TSample> yin_buffer(half_buffer_size, static_cast<TSample>(0.0));
+    std::unordered_map<std::string, Stage> stages;
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
 
-    for (size_t tau = 0; tau < half_buffer_size; ++tau)
-    {
-        yin_buffer[tau] = 0.0;
-    }
-    
-    for (size_t tau = 1; tau < half_buffer_size; ++tau)
+    for (const auto& profile : r.threads)
     {
-        for (size_t i = 0; i < half_buffer_size; ++i)
-        {
-            TSample delta = buffer[i] - buffer[i + tau];
-            yin_buffer[tau] += delta * delta;
-        }
-    }
+        const size_t stage_count = profile->stage_count.load(std::memory_order_acquire);
 
-    yin_buffer[0] = 1.0;
-    TSample running_sum = static_cast<TSample>(0.0);
-    for (size_t tau = 1; tau < half_buffer_size; ++tau)
-    {
-        running_sum += yin_buffer[tau];
-        if (running_sum > static_cast<TSample>(0.0))
+        for (size_t s = 0; s < stage_count; s++)
         {
-            yin_buffer[tau] *= static_cast<TSample>(tau) / running_sum;
+            Stage& stage = stages[profile->stages[s].name.load(std::memory_order_relaxed)];
+            stage.count += profile->stages[s].count.load(std::memory_order_relaxed);
+            stage.total_ns += profile->stages[s].total_ns.load(std::memory_order_relaxed);
         }
-        else
+
+        for_each_event(*profile, [&stages](const char* name, const uint64_t&, const uint64_t& duration)
         {
-            yin_buffer[tau] = static_cast<TSample>(1.0);
-        }
+            stages[name].durations.push_back(duration);
+        });
     }
 
-    int tau_estimate = 0;
-    bool found = false;
+    std::vector<StageSummary> result;
+    result.reserve(stages.size());
 
-    for (size_t tau = 2; tau < half_buffer_size; ++tau)
+    for (auto& [name, stage] : stages)
     {
-        if (yin_buffer[tau] < threshold)
+        if (stage.count == 0u && stage.durations.empty())
         {
-            while (tau + 1 < half_buffer_size && yin_buffer[tau + 1] < yin_buffer[tau])
-            {
-                tau++;
-            }
-
-            tau_estimate = static_cast<int>(tau);
-            found = true;
-            break;
+            continue;
         }
-    }
-        
-    if (!found)
-    {
-        auto min_it = std::min_element(yin_buffer.begin() + 2, yin_buffer.end());
-        tau_estimate = static_cast<int>(std::distance(yin_buffer.begin(), min_it));
-    }
-
-    if (tau_estimate != -1)
-    {
-        TSample pitch_period = static_cast<TSample>(0.0);
 
-        TSample better_tau;
-        size_t x0;
-        size_t x2;
+        StageSummary s;
+        s.name = name;
+        s.count = stage.count;
 
-        if (tau_estimate < 1) 
-        {
-            x0 = static_cast<size_t>(tau_estimate);
-        } 
-        else 
+        if (stage.count > 0u)
         {
-            x0 = static_cast<size_t>(tau_estimate - 1);
+            s.mean_ns = static_cast<double>(stage.total_ns) / static_cast<double>(stage.count);
         }
 
-        if (tau_estimate + 1 >= static_cast<int>(half_buffer_size)) 
+        if (!stage.durations.empty())
         {
-            x2 = static_cast<size_t>(tau_estimate);
-        } 
-        else 
-        {
-            x2 = static_cast<size_t>(tau_estimate + 1);
+            const size_t p99 = (stage.durations.size() * 99u) / 100u;
+            std::nth_element(stage.durations.begin(), stage.durations.begin() + p99, stage.durations.end());
+            s.p99_ns = static_cast<double>(stage.durations[p99]);
         }
 
-        if (x0 == static_cast<size_t>(tau_estimate)) {
-            if (yin_buffer[static_cast<size_t>(tau_estimate)] <= yin_buffer[x2]) 
-            {
-                better_tau = tau_estimate;
-            } 
-            else 
-            {
-                better_tau = x2;
-            }
-        } 
-        else if (x2 == static_cast<size_t>(tau_estimate)) 
-        {
-            if (yin_buffer[static_cast<size_t>(tau_estimate)] <= yin_buffer[x0]) 
-            {
-                better_tau = tau_estimate;
-            } 
-            else 
-            {
-                better_tau = x0;
-            }
-        } 
-        else 
-        {
-            TSample s0 = yin_buffer[x0];
-            TSample s1 = yin_buffer[static_cast<size_t>(tau_estimate)];
-            TSample s2 = yin_buffer[x2];
-
-            TSample denominator = 2.0 * (s2 - 2.0 * s1 + s0);
-            if (std::abs(denominator) > 1e-5) 
-            {
-                better_tau = tau_estimate + (s0 - s2) / denominator;
-            } 
-            else 
-            {
-                better_tau = tau_estimate;
-            }
-        }
-        pitch_period = better_tau;
-    
-        if (pitch_period > 0.0)
-        {
-            return sample_rate / pitch_period;
-        }
+        result.push_back(s);
     }
 
-    return static_cast<TSample>(-1.0);
+    std::sort(result.begin(), result.end(), [](const StageSummary& a, const StageSummary& b)
+    {
+        return a.name < b.name;
+    });
+
+    return result;
 }
 
-// ZERO CROSSING RATE
-template <typename Container>
-#if __cplusplus >= 202002L
-requires std::floating_point<typename Container::value_type>
-#endif
-typename Container::value_type zerocrossing(const Container& buffer)
+// Complete events ("ph":"X") in Chrome trace event format, to be loaded in
+// chrome://tracing or Perfetto
+inline std::string chrome_trace()
 {
-    using TSample = typename Container::value_type;
+    std::ostringstream trace;
+    trace.precision(3);
+    trace << std::fixed << "{\"traceEvents\":[";
 
-    TSample zerocrossingrate = static_cast<TSample>(0.0);
+    bool first = true;
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
 
-    if (buffer.size() < 2)
+    for (const auto& profile : r.threads)
     {
-        return zerocrossingrate;
-    }
+        const unsigned int thread_id = profile->thread_id;
 
-    for (auto s = 1u; s < buffer.size(); s++)
-    {
-        zerocrossingrate += std::abs(static_cast<TSample>(!std::signbit(buffer[s])) - static_cast<TSample>(!std::signbit(buffer[s - 1])));
+        for_each_event(*profile, [&trace, &first, thread_id](const char* name, const uint64_t& start, const uint64_t& duration)
+        {
+            trace << (first ? "" : ",") << "{\"name\":\"" << name << "\",\"cat\":\"informer\",\"ph\":\"X\",\"pid\":1,\"tid\":"
+                  << thread_id << ",\"ts\":" << static_cast<double>(start) * 0.001 << ",\"dur\":" << static_cast<double>(duration) * 0.001 << "}";
+            first = false;
+        });
     }
 
-    zerocrossingrate /= static_cast<TSample>(buffer.size() - 1);
+    trace << "],\"displayTimeUnit\":\"ns\"}";
 
-    return zerocrossingrate;
+    return trace.str();
 }
 
-} // namespace Informer::Amplitude
+inline bool write_chrome_trace(const std::string& path)
+{
+    std::ofstream file(path);
 
+    if (!file)
+    {
+        return false;
+    }
 
-/* FREQUENCY DOMAIN DESCRIPTORS */
+    file << chrome_trace();
 
-namespace Frequency
-{
+    return static_cast<bool>(file);
+}
 
-// UTILITY FUNCTION: precompute the frequencies for the given STFT size and sample rate
-template <typename ISize, typename TSample>
-std::vector<TSample> precompute_frequencies(ISize stft_size = static_cast<ISize>(4096), TSample sample_rate = static_cast<TSample>(44100.0))
+// Clear all the recorded events, call it when no analysis is running
+inline void reset()
 {
-    std::vector<TSample> precomputed_frequencies = {};
-    unsigned int size = static_cast<unsigned int>(stft_size);
+    Registry& r = registry();
+    std::lock_guard<std::mutex> lock(r.mutex);
 
-    if (size > 2u)
+    for (auto& profile : r.threads)
     {
-        TSample fft_bandwidth = static_cast<TSample>(sample_rate) / static_cast<TSample>(size);
-        precomputed_frequencies.resize(size / 2u + 1u, static_cast<TSample>(0.0));
-        for (auto b = 0u; b < size / 2u + 1; b++)
+        profile->written.store(0u, std::memory_order_release);
+
+        for (auto& stage : profile->stages)
         {
-            precomputed_frequencies[b] = static_cast<TSample>(b) * fft_bandwidth;
+            stage.count.store(0u, std::memory_order_relaxed);
+            stage.total_ns.store(0u, std::memory_order_relaxed);
         }
     }
+}
 
-    return precomputed_frequencies;
+#define INFORMER_PROFILE_CONCAT_IMPL_(a, b) a##b
+#define INFORMER_PROFILE_CONCAT_(a, b) INFORMER_PROFILE_CONCAT_IMPL_(a, b)
+#define INFORMER_PROFILE_SCOPE(name) ::Informer::Profiler::ScopedTimer INFORMER_PROFILE_CONCAT_(informer_profile_scope_, __LINE__)(name)
+
+#else
+
+inline std::vector<StageSummary> summary()
+{
+    return {};
 }
 
-// UTILITY FUNCTION: from a real valued FFT, calculate the magnitudes
-template <typename Container>
-#if __cplusplus >= 202002L
-requires std::floating_point<typename Container::value_type>
-#endif
-std::vector<typename Container::value_type> magnitudes(const Container& stft)
+inline std::string chrome_trace()
 {
-    using TSample = typename Container::value_type;
+    return "{\"traceEvents\":[]}";
+}
 
-    std::vector<TSample> magnitudes_vector;
+inline bool write_chrome_trace(const std::string&)
+{
+    return false;
+}
 
-    // An even number of values and a size greater than 2 are expected
-    if (stft.size() < 2u || stft.size() % 2)
-    {
-        return magnitudes_vector;
-    }
+inline void reset()
+{
+}
 
-    magnitudes_vector.assign(stft.size() / 2 + 1, static_cast<TSample>(0.0));
+#define INFORMER_PROFILE_SCOPE(name)
 
-    // DC offset
-    magnitudes_vector[0] = stft[0];
+#endif // INFORMER_PROFILE
 
-    // Values up to Nyquist bin - 1
-    for (auto b = 2; b < stft.size(); b += 2)
-    {
-        TSample real = stft[b];
-        TSample imag = stft[b + 1];
-        magnitudes_vector[b / 2] = sqrt(real * real + imag * imag) / static_cast<TSample>(stft.size());
-    }
+} // namespace Informer::Profiler
 
-    // Nyquist frequency
-    magnitudes_vector[stft.size() / 2 + 1] = stft[1];
 
-    return magnitudes_vector;
-}
+/* ACCUMULATION */
 
-// UTILITY FUNCTION: apply a (Hann or Blackman-Harris) window function to the input signal
-template <typename Container>
+// How the descriptors sum their terms. Naive adds them in TSample, as a
+// plain loop does. Blocked (default) adds blocks of block_size terms in TSample
+// and the block sums in WideSample. Compensated keeps a Kahan-Babuska correction next
+// to the sum. Widened adds every term in WideSample. The terms are still
+// computed and stored in TSample, so with float samples the last three stay
+// close to a double analysis at nearly float cost.
+// The policy is chosen at build time, e.g. -DINFORMER_ACCUMULATION=Compensated.
+enum class Accumulation
+{
+    Naive,
+    Blocked,
+    Compensated,
+    Widened
+};
+
+#ifndef INFORMER_ACCUMULATION
+#define INFORMER_ACCUMULATION Blocked
+#endif
+
+constexpr Accumulation accumulation = Accumulation::INFORMER_ACCUMULATION;
+
+// Type of the higher precision sums: double for float, TSample otherwise
+template <typename TSample>
+using WideSample = std::conditional_t<(sizeof(TSample) < sizeof(double)), double, TSample>;
+
+// Running sum with the chosen policy. It converts to TSample, so it can
+// replace a TSample sum in an expression.
+template <typename TSample, Accumulation Policy = accumulation>
 #if __cplusplus >= 202002L
-requires std::floating_point<typename Container::value_type>
+requires std::floating_point<TSample>
 #endif
-std::vector<typename Container::value_type> window(const Container& buffer, const bool hann_window = true)
+class Accumulator
 {
-    using TSample = typename Container::value_type;
+public:
+    static constexpr unsigned int block_size = 64u;
+    using Precise = std::conditional_t<Policy == Accumulation::Naive, TSample, WideSample<TSample>>;
 
-    constexpr TSample m_pi = static_cast<TSample>(3.14159265358979323846);
-    std::vector<TSample> windowed_buffer(buffer.size());
-    for (size_t i = 0; i < buffer.size(); ++i)
+    // A term of another type (e.g. the double returned by the unqualified pow()) is added
+    // by Naive as a plain TSample sum adds it, the other policies round it to TSample first
+    template <typename Term>
+    Accumulator& operator+=(const Term& value)
     {
-        TSample x = static_cast<TSample>(i) / static_cast<TSample>(buffer.size() - 1);
-        TSample window = static_cast<TSample>(1.0);
+        const TSample term = static_cast<TSample>(value);
 
-        if (hann_window)
+        // With reassociation allowed (-ffast-math, -funsafe-math-optimizations)
+        // the compiler can cancel the correction, so the wider sum is used instead
+#if !defined(__ASSOCIATIVE_MATH__) && !defined(__FAST_MATH__)
+        if constexpr (Policy == Accumulation::Compensated)
         {
-            window = static_cast<TSample>(0.5) * (static_cast<TSample>(1.0) - cos(static_cast<TSample>(2.0) * static_cast<TSample>(m_pi) * x));
+            const TSample total = sum_ + term;
+            compensation_ += std::abs(sum_) >= std::abs(term) ? (sum_ - total) + term : (term - total) + sum_;
+            sum_ = total;
         }
         else
+#endif
+        if constexpr (Policy == Accumulation::Blocked)
         {
-            window = static_cast<TSample>(0.35875) -
-                     static_cast<TSample>(0.48829) * cos(static_cast<TSample>(2.0) *
-                         static_cast<TSample>(m_pi) * x) + static_cast<TSample>(0.14128) *
-                     cos(static_cast<TSample>(4.0) * static_cast<TSample>(m_pi) * x) -
-                     static_cast<TSample>(0.01168) * cos(static_cast<TSample>(6.0) *
-                         static_cast<TSample>(m_pi) * x);
+            sum_ += term;
+            if (++count_ == block_size)
+            {
+                wide_sum_ += static_cast<WideSample<TSample>>(sum_);
+                sum_ = static_cast<TSample>(0.0);
+                count_ = 0u;
+            }
+        }
+        else if constexpr (Policy == Accumulation::Naive)
+        {
+            sum_ += value;
+        }
+        else
+        {
+            wide_sum_ += static_cast<WideSample<TSample>>(term);
         }
 
-        windowed_buffer[i] = window * buffer[i];
-    }
-
-    return windowed_buffer;
-}
-
-// SPECTRAL CENTROID
-template <typename Container>
-#if __cplusplus >= 202002L
-requires std::floating_point<typename Container::value_type>
-#endif
-typename Container::value_type centroid(const Container& magnitudes,
-                                        typename Container::value_type sample_rate = static_cast<typename Container::value_type>(44100.0),
-                                        std::vector<typename Container::value_type>& precomputed_frequencies = {}, unsigned int stft_size = 0u)
-{
-    using TSample = typename Container::value_type;
-
-    TSample centroid = static_cast<TSample>(0.0);
-
-    if (magnitudes.empty())
-    {
-        return centroid;
+        return *this;
     }
 
-    unsigned int fft_size = magnitudes.size();
-    unsigned int bins = stft_size > 0u ? stft_size : (fft_size - 1u) * 2u;
-
-    if (precomputed_frequencies.size() < bins)
+    TSample result() const
     {
-        precomputed_frequencies = precompute_frequencies(bins, sample_rate);
+        return static_cast<TSample>(wide_sum_ + static_cast<WideSample<TSample>>(sum_) + static_cast<WideSample<TSample>>(compensation_));
     }
 
-    TSample magn_sum = static_cast<TSample>(0.0);
-
-    for (unsigned int k = 0u; k < fft_size; k++)
+    // The sum before the rounding to TSample, to keep the precision through a
+    // subtraction of two sums
+    Precise precise_result() const
     {
-        centroid += precomputed_frequencies[k] * std::abs(magnitudes[k]);
-        magn_sum += std::abs(magnitudes[k]);
+        return static_cast<Precise>(wide_sum_ + static_cast<WideSample<TSample>>(sum_) + static_cast<WideSample<TSample>>(compensation_));
     }
 
-    if (magn_sum > static_cast<TSample>(0.0))
-    {
-        centroid /= magn_sum;
-    }
-    else
+    operator TSample() const
     {
-        centroid = static_cast<TSample>(0.0);
+        return result();
     }
 
-    return centroid;
-}
+private:
+    TSample sum_ = static_cast<TSample>(0.0);
+    TSample compensation_ = static_cast<TSample>(0.0);
+    WideSample<TSample> wide_sum_ = static_cast<WideSample<TSample>>(0.0);
+    unsigned int count_ = 0u;
+};
 
-// SPECTRAL SPREAD
-// Not in alphabetical order because it is used in the kurtosis and skewness functions
+// Sum of the elements of a container
 template <typename Container>
 #if __cplusplus >= 202002L
 requires std::floating_point<typename Container::value_type>
 #endif
-typename Container::value_type spread(const Container& magnitudes,
-                                      typename Container::value_type sample_rate = static_cast<typename Container::value_type>(44100.0),
-                                      std::vector<typename Container::value_type>& precomputed_frequencies = {},
-                                      typename Container::value_type spectral_centroid = static_cast<typename Container::value_type>(-1.0),
-                                      unsigned int stft_size = 0u)
+typename Container::value_type sum(const Container& values)
 {
-    using TSample = typename Container::value_type;
-
-    TSample sspread = static_cast<TSample>(0.0);
+    Accumulator<typename Container::value_type> total;
 
-    if (magnitudes.empty())
+    for (const auto &v : values)
     {
-        return sspread;
+        total += v;
     }
 
-    unsigned int fft_size = magnitudes.size();
-    unsigned int bins = stft_size > 0u ? stft_size : (fft_size - 1u) * 2u;
+    return total;
+}
 
-    if (precomputed_frequencies.size() < bins)
+
+/* CPU DISPATCH */
+
+// The YIN difference kernel is compiled for several x86 instruction sets in the same binary, and
+// the widest one supported by the CPU is chosen the first time it runs. The build can then
+// target baseline x86-64 and still use AVX2 or AVX-512 where available. Every level splits the
+// sums over the same number of lanes, so they all give the same results. The spectral
+// descriptors are not dispatched: each of their sums adds the terms in order through the
+// accumulation policy, which a wider instruction set cannot vectorize without changing the
+// results (large frames use TiledSpectrum and the reduction threads instead).
+// The level can be forced with the INFORMER_ISA environment variable (baseline, avx2 or
+// avx512) or with Dispatch::set_level(), e.g. to compare them. Other architectures and
+// compilers without target attributes (MSVC), or builds defining INFORMER_NO_DISPATCH,
+// only have the baseline kernels.
+#if (defined(__x86_64__) || defined(__i386__)) && (defined(__GNUC__) || defined(__clang__)) && !defined(INFORMER_NO_DISPATCH)
+#define INFORMER_DISPATCH 1
+#endif
+
+// The kernels must not fuse multiplications and additions (AVX-512 has FMA, baseline x86-64
+// does not), or the levels would round differently
+#if defined(__clang__)
+#define INFORMER_TARGET(isa) __attribute__((target(isa)))
+#define INFORMER_KERNEL inline __attribute__((always_inline))
+#define INFORMER_NO_CONTRACTION _Pragma("clang fp contract(off)")
+#elif defined(__GNUC__)
+#define INFORMER_TARGET(isa) __attribute__((target(isa), optimize("fp-contract=off")))
+#define INFORMER_KERNEL inline __attribute__((always_inline, optimize("fp-contract=off")))
+#define INFORMER_NO_CONTRACTION
+#else
+#define INFORMER_KERNEL inline
+#define INFORMER_NO_CONTRACTION
+#endif
+
+enum class IsaLevel
+{
+    Baseline,
+    AVX2,
+    AVX512
+};
+
+namespace Dispatch
+{
+
+// Widest level supported by the CPU (and by the operating system, which must save the registers)
+inline IsaLevel detect()
+{
+#ifdef INFORMER_DISPATCH
+    __builtin_cpu_init();
+
+    if (__builtin_cpu_supports("avx512f"))
     {
-        precomputed_frequencies = precompute_frequencies(bins, sample_rate);
+        return IsaLevel::AVX512;
     }
 
-    if (spectral_centroid < static_cast<TSample>(0.0))
+    if (__builtin_cpu_supports("avx2"))
     {
-        spectral_centroid = centroid(magnitudes, sample_rate, precomputed_frequencies);
+        return IsaLevel::AVX2;
     }
+#endif
 
-    TSample numerator = static_cast<TSample>(0.0);
-    TSample magn_sum = static_cast<TSample>(0.0);
+    return IsaLevel::Baseline;
+}
 
-    for (unsigned int k = 0u; k < fft_size; k++)
+inline const char* name(const IsaLevel& level)
+{
+    switch (level)
     {
-        numerator += (precomputed_frequencies[k] - spectral_centroid) * (precomputed_frequencies[k] - spectral_centroid) * std::abs(magnitudes[k]);
-        magn_sum += std::abs(magnitudes[k]);
+    case IsaLevel::AVX512:
+        return "avx512";
+    case IsaLevel::AVX2:
+        return "avx2";
+    default:
+        return "baseline";
     }
+}
 
-    if (magn_sum > static_cast<TSample>(0.0))
-    {
-        sspread = std::sqrt(numerator / magn_sum);
-    }
-    else
+// UTILITY FUNCTION: level in use, initialized once from detect() and INFORMER_ISA
+inline IsaLevel& active_level_()
+{
+    static IsaLevel level = []()
     {
-        sspread = static_cast<TSample>(0.0);
-    }
+        const IsaLevel detected = detect();
+        const char* forced = std::getenv("INFORMER_ISA");
 
-    return sspread;
+        if (forced != nullptr)
+        {
+            for (const IsaLevel candidate : {IsaLevel::Baseline, IsaLevel::AVX2, IsaLevel::AVX512})
+            {
+                if (std::string(forced) == name(candidate) && candidate <= detected)
+                {
+                    return candidate;
+                }
+            }
+        }
+
+        return detected;
+    }();
+
+    return level;
 }
 
-// SPECTRAL CREST FACTOR
-template <typename Container>
-#if __cplusplus >= 202002L
-requires std::floating_point<typename Container::value_type>
-#endif
-typename Container::value_type crestfactor(const Container& magnitudes)
+inline IsaLevel level()
 {
-    using TSample = typename Container::value_type;
-
-    TSample scf = static_cast<TSample>(0.0);
+    return active_level_();
+}
 
-    if (magnitudes.empty())
+// Force a level, only if the CPU supports it. Not thread safe: call it before the analysis.
+inline bool set_level(const IsaLevel& level)
+{
+    if (level > detect())
     {
-        return scf;
+        return false;
     }
 
-    unsigned int fft_size = magnitudes.size();
+    active_level_() = level;
 
-    TSample magn_max = static_cast<TSample>(0.0);
-    TSample magn_sum = static_cast<TSample>(0.0);
+    return true;
+}
 
-    for (unsigned int k = 0u; k < fft_size; k++)
+// UTILITY FUNCTION: squared differences of the YIN lags, for tau in [tau_begin, tau_end).
+// Each sum is split over lanes interleaved partial sums, which the compiler maps to the vector
+// registers of the target without reordering the additions of a lane. Every lag only depends on
+// its own sums, so ranges of lags can be computed separately (e.g. by several threads).
+template <typename TSample>
+INFORMER_KERNEL void yin_lags_kernel_(const TSample* buffer, TSample* lags, const size_t& half_size,
+                                      const size_t& tau_begin, const size_t& tau_end)
+{
+    INFORMER_NO_CONTRACTION
+    constexpr size_t lanes = 16u;
+    const size_t blocked = half_size - half_size % lanes;
+
+    for (size_t tau = tau_begin; tau < tau_end; ++tau)
     {
-        if (std::abs(magnitudes[k]) > magn_max)
+        const TSample* shifted = buffer + tau;
+        TSample partial[lanes] = {};
+
+        for (size_t i = 0; i < blocked; i += lanes)
         {
-            magn_max = std::abs(magnitudes[k]);
+            for (size_t l = 0; l < lanes; ++l)
+            {
+                const TSample delta = buffer[i + l] - shifted[i + l];
+                partial[l] += delta * delta;
+            }
         }
-        magn_sum += std::abs(magnitudes[k]);
-    }
 
-    if (magn_sum > static_cast<TSample>(0.0))
-    {
-        scf = magn_max / magn_sum;
+        for (size_t i = blocked; i < half_size; ++i)
+        {
+            const TSample delta = buffer[i] - shifted[i];
+            partial[i - blocked] += delta * delta;
+        }
+
+        // Pairwise reduction of the lanes
+        for (size_t width = lanes / 2u; width > 0u; width /= 2u)
+        {
+            for (size_t l = 0; l < width; ++l)
+            {
+                partial[l] += partial[l + width];
+            }
+        }
+
+        lags[tau] = partial[0];
     }
+}
 
-    return scf;
+#ifdef INFORMER_DISPATCH
+template <typename TSample>
+INFORMER_TARGET("avx2") void yin_lags_avx2_(const TSample* buffer, TSample* lags, const size_t& half_size,
+                                            const size_t& tau_begin, const size_t& tau_end)
+{
+    yin_lags_kernel_(buffer, lags, half_size, tau_begin, tau_end);
 }
 
-// SPECTRAL DECREASE
-template <typename Container>
+template <typename TSample>
+INFORMER_TARGET("avx512f") void yin_lags_avx512_(const TSample* buffer, TSample* lags, const size_t& half_size,
+                                                 const size_t& tau_begin, const size_t& tau_end)
+{
+    yin_lags_kernel_(buffer, lags, half_size, tau_begin, tau_end);
+}
+#endif
+
+template <typename TSample>
+#ifdef __GNUC__
+__attribute__((optimize("fp-contract=off")))
+#endif
+void yin_lags_baseline_(const TSample* buffer, TSample* lags, const size_t& half_size,
+                        const size_t& tau_begin, const size_t& tau_end)
+{
+    yin_lags_kernel_(buffer, lags, half_size, tau_begin, tau_end);
+}
+
+// Sum of (buffer[i] - buffer[i + tau])^2 over i in [0, half_size), into lags[tau] for tau in
+// [tau_begin, tau_end) inside [1, half_size); buffer holds at least 2 * half_size - 1 samples
+template <typename TSample>
 #if __cplusplus >= 202002L
-requires std::floating_point<typename Container::value_type>
+requires std::floating_point<TSample>
 #endif
-typename Container::value_type decrease(const Container& magnitudes)
+void yin_lags(const TSample* buffer, TSample* lags, const size_t& half_size, const size_t& tau_begin, const size_t& tau_end)
 {
-    using TSample = typename Container::value_type;
+#ifdef INFORMER_DISPATCH
+    switch (level())
+    {
+    case IsaLevel::AVX512:
+        yin_lags_avx512_(buffer, lags, half_size, tau_begin, tau_end);
+        return;
+    case IsaLevel::AVX2:
+        yin_lags_avx2_(buffer, lags, half_size, tau_begin, tau_end);
+        return;
+    default:
+        break;
+    }
+#endif
 
-    TSample decrease = static_cast<TSample>(0.0);
+    yin_lags_baseline_(buffer, lags, half_size, tau_begin, tau_end);
+}
 
-    if (magnitudes.empty())
-    {
-        return decrease;
-    }
+// All the lags, tau in [1, half_size)
+template <typename TSample>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+void yin_lags(const TSample* buffer, TSample* lags, const size_t& half_size)
+{
+    yin_lags(buffer, lags, half_size, static_cast<size_t>(1u), half_size);
+}
 
-    unsigned int fft_size = magnitudes.size();
+} // namespace Informer::Dispatch
 
-    TSample magn_diff_sum = static_cast<TSample>(0.0);
-    TSample magn_sum = static_cast<TSample>(0.0);
+} // namespace Informer
 
-    for (unsigned int k = 1u; k < fft_size; k++)
-    {
-        magn_diff_sum += (std::abs(magnitudes[k]) - std::abs(magnitudes[0])) / static_cast<TSample>(k);
-        magn_sum += std::abs(magnitudes[k]);
-    }
+#include "informer_large_frames.h"
 
-    if (magn_sum > static_cast<TSample>(0.0))
-    {
-        decrease = magn_diff_sum / magn_sum;
-    }
+namespace Informer
+{
 
-    return decrease;
-}
+/* TIME DOMAIN DESCRIPTORS */
 
-// ESTIMATED FUNDAMENTAL FREQUENCY, HPS METHOD
+namespace Amplitude
+{
+
+// PEAK
 template <typename Container>
 #if __cplusplus >= 202002L
 requires std::floating_point<typename Container::value_type>
 #endif
-typename Container::value_type f0_hps(const Container& magnitudes, const unsigned int &max_compression = 5u,
-                                      typename Container::value_type sample_rate = static_cast<typename Container::value_type>(44100.0),
-                                      std::vector<typename Container::value_type>& precomputed_frequencies = {},
-                                      unsigned int stft_size = 0u)
+typename Container::value_type peak(const Container& buffer)
 {
     using TSample = typename Container::value_type;
 
-    TSample f0 = static_cast<TSample>(0.0);
+    TSample peak = static_cast<TSample>(0.0);
 
-    if (magnitudes.empty() || max_compression < 2u)
+    for (const auto &s : buffer)
     {
-        return f0;
+        if (std::abs(s) > peak)
+        {
+            peak = std::abs(s);
+        }
     }
 
-    unsigned int fft_size = magnitudes.size();
-    unsigned int bins = stft_size > 0u ? stft_size : (fft_size - 1u) * 2u;
+    return peak;
+}
+
+// ROOT MEAN SQUARE
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+typename Container::value_type rms(const Container& buffer)
+{
+    using TSample = typename Container::value_type;
+
+    Accumulator<TSample> square_sum;
 
-    if (precomputed_frequencies.size() < bins)
+    for (const auto &s : buffer)
     {
-        precomputed_frequencies = precompute_frequencies(bins, sample_rate);
+        square_sum += s * s;
     }
 
-    // Consider magnitudes only in the range 50 - 10000 Hz
-    std::vector<TSample> filtered_magnitudes;
-    unsigned int filtered_low_bands = 0u;
-    for (unsigned int b = 0u; b < fft_size; b++)
+    TSample rms_amp = square_sum;
+
+    if (buffer.size() > 0)
     {
-        if (precomputed_frequencies[b] >= 50.0 && precomputed_frequencies[b] <= 10000.0)
-        {
-            filtered_magnitudes.push_back(magnitudes[b]);
-        }
-        else if (precomputed_frequencies[b] < 50.0)
-        {
-            ++filtered_low_bands;
-        }
+        rms_amp /= buffer.size();
+        rms_amp = std::sqrt(rms_amp);
     }
 
-    if (filtered_magnitudes.size() < max_compression)
+    return rms_amp;
+}
+
+// VARIANCE
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+typename Container::value_type variance(const Container& buffer)
+{
+    using TSample = typename Container::value_type;
+
+    if (buffer.empty())
     {
-        return f0;
+        return static_cast<TSample>(0.0);
     }
 
-    unsigned int hps_length = filtered_magnitudes.size() / max_compression;
+    const TSample count = static_cast<TSample>(buffer.size());
+    const TSample mean = sum(buffer) / count;
+    Accumulator<TSample> square_sum;
 
-    if (hps_length < 2u)
+    for (const auto &s : buffer)
     {
-        return f0;
+        square_sum += pow(s - mean, (TSample)2.0);
     }
 
-    std::vector<TSample> hps_products(hps_length);
-    for (unsigned int k = 0u; k < hps_length; k++)
+    TSample amp_variance = square_sum;
+    amp_variance /= count;
+
+    return amp_variance;
+}
+
+// KURTOSIS
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+typename Container::value_type kurtosis(const Container& buffer,
+                                        typename Container::value_type mean = static_cast<typename Container::value_type>(-10000.0),
+                                        typename Container::value_type amp_variance = static_cast<typename Container::value_type>(-10000.0))
+{
+    using TSample = typename Container::value_type;
+
+    TSample amp_kurtosis = static_cast<TSample>(0.0);
+    TSample var = amp_variance;
+    TSample amp_mean = mean;
+
+    if (var < static_cast<TSample>(-9999.0))
     {
-        hps_products[k] = filtered_magnitudes[k];
+        var = variance(buffer);
     }
 
-    for (unsigned int n = 2u; n <= max_compression; n++)
+    if (mean < static_cast<TSample>(-9999.0))
     {
-        for (unsigned int k = 0u; k < hps_length; k++)
-        {
-            unsigned int original_index = n * k;
+        amp_mean = sum(buffer) / static_cast<TSample>(buffer.size());
+    }
 
-            if (original_index < filtered_magnitudes.size())
-            {
-                hps_products[k] *= filtered_magnitudes[original_index];
-            }
-        }
+    if (buffer.empty() || var <= std::numeric_limits<TSample>::epsilon())
+    {
+        return amp_kurtosis;
     }
 
-    auto max_prod = std::max_element(hps_products.begin(), hps_products.end());
-    unsigned int k_peak = std::distance(hps_products.begin(), max_prod) + filtered_low_bands;
+    TSample invSqrChVariance = (TSample)1.0 / (var * var);
+    Accumulator<TSample> fourth_sum;
 
-    f0 = precomputed_frequencies[k_peak];
+    for (const auto &s : buffer)
+    {
+        fourth_sum += std::pow(s - amp_mean, (TSample)4.0);
+    }
 
-    return f0;
+    amp_kurtosis = fourth_sum;
+    amp_kurtosis /= static_cast<TSample>(buffer.size());
+    amp_kurtosis *= invSqrChVariance;
+    amp_kurtosis -= (TSample)3.0;
+
+    return amp_kurtosis;
 }
 
-// SPECTRAL ENTROPY
+// SKEWNESS
 template <typename Container>
 #if __cplusplus >= 202002L
 requires std::floating_point<typename Container::value_type>
 #endif
-typename Container::value_type entropy(const Container& magnitudes)
+typename Container::value_type skewness(const Container& buffer,
+                                        typename Container::value_type mean = static_cast<typename Container::value_type>(-10000.0),
+                                        typename Container::value_type amp_variance = static_cast<typename Container::value_type>(-10000.0))
 {
     using TSample = typename Container::value_type;
 
-    TSample h = static_cast<TSample>(0.0);
+    TSample skewness = static_cast<TSample>(0.0);
+    TSample var = amp_variance;
+    TSample amp_mean = mean;
 
-    if (magnitudes.empty())
+    if (var < static_cast<TSample>(-9999.0))
     {
-        return h;
+        var = variance(buffer);
     }
 
-    unsigned int fft_size = magnitudes.size();
-
-    TSample power_sum = static_cast<TSample>(0.0);
+    if (mean < static_cast<TSample>(-9999.0))
+    {
+        amp_mean = sum(buffer) / static_cast<TSample>(buffer.size());
+    }
 
-    for (unsigned int k = 0u; k < fft_size; k++)
+    if (buffer.empty() || var <= std::numeric_limits<TSample>::epsilon())
     {
-        power_sum += magnitudes[k] * magnitudes[k];
+        return skewness;
     }
 
-    if (power_sum > static_cast<TSample>(0.0))
+    TSample invDenominator = (TSample)1.0 / std::pow(std::sqrt(var), (TSample)3.0);
+
+    Accumulator<TSample> cube_sum;
+
+    for (const auto &s : buffer)
     {
-        for (unsigned int k = 0u; k < fft_size; k++)
-        {
-            TSample p = magnitudes[k] * magnitudes[k] / power_sum;
-            if (p > static_cast<TSample>(0.0))
-            {
-                h += p * std::log2(p);
-            }
-        }
+        cube_sum += std::pow(s - amp_mean, (TSample)3.0);
     }
 
-    h /= std::log2(static_cast<TSample>(fft_size));
-    h *= static_cast<TSample>(-1.0);
+    skewness = cube_sum;
+    skewness /= static_cast<TSample>(buffer.size());
+    skewness *= invDenominator;
 
-    return h;
+    return skewness;
 }
 
-// SPECTRAL FLATNESS
+// UTILITY STRUCTURE: true for containers with contiguous storage of floating point samples
+template <typename Container, typename = void>
+struct is_contiguous_ : std::false_type {};
+
 template <typename Container>
+struct is_contiguous_<Container, std::void_t<decltype(std::declval<Container&>().data())>>
+    : std::is_pointer<decltype(std::declval<Container&>().data())> {};
+
+// UTILITY FUNCTION: YIN cumulative mean normalized difference function
+// Generic version, writing the first half_buffer_size lags into any random access container.
+// With a pool, contiguous buffers split the lags over its threads.
+template <typename Container, typename Scratch>
 #if __cplusplus >= 202002L
 requires std::floating_point<typename Container::value_type>
 #endif
-typename Container::value_type flatness(const Container& magnitudes)
+void yin_difference(const Container& buffer, Scratch& yin_buffer, const size_t half_buffer_size, ReductionPool* pool = nullptr)
 {
     using TSample = typename Container::value_type;
 
-    TSample specflatness = static_cast<TSample>(0.0);
+    std::fill(yin_buffer.begin(), yin_buffer.begin() + half_buffer_size, static_cast<TSample>(0.0));
 
-    if (magnitudes.empty())
+    if (half_buffer_size == 0)
     {
-        return specflatness;
+        return;
     }
 
-    unsigned int fft_size = magnitudes.size();
-
-    TSample magn_sum = static_cast<TSample>(0.0);
-    TSample ln_magn_sum = static_cast<TSample>(0.0);
-
-    for (unsigned int k = 0u; k < fft_size; k++)
+    // Contiguous buffers (std::vector, std::array) use the dispatched kernel
+    if constexpr (is_contiguous_<Container>::value && is_contiguous_<Scratch>::value &&
+                  std::is_same_v<typename Scratch::value_type, TSample>)
     {
-        magn_sum += std::abs(magnitudes[k]);
-        if (std::abs(magnitudes[k]) > static_cast<TSample>(0.0))
+        if (pool != nullptr && pool->get_threads() > 1u && half_buffer_size > 2u)
         {
-            ln_magn_sum += std::log(std::abs(magnitudes[k]));
+            const size_t tasks = std::min(half_buffer_size - 1u, static_cast<size_t>(pool->get_threads()) * 4u);
+            const size_t lags_per_task = (half_buffer_size - 1u + tasks - 1u) / tasks;
+
+            auto task = [&](const size_t& t)
+            {
+                const size_t tau_begin = 1u + t * lags_per_task;
+                const size_t tau_end = std::min(half_buffer_size, tau_begin + lags_per_task);
+                Dispatch::yin_lags(buffer.data(), yin_buffer.data(), half_buffer_size, tau_begin, tau_end);
+            };
+
+            pool->run(tasks, task);
         }
         else
         {
-            ln_magn_sum += std::log(static_cast<TSample>(0.00001));
+            Dispatch::yin_lags(buffer.data(), yin_buffer.data(), half_buffer_size);
         }
     }
-
-    if (magn_sum > static_cast<TSample>(0.0))
+    else
     {
-        specflatness = std::exp(ln_magn_sum / static_cast<TSample>(fft_size)) / (magn_sum / static_cast<TSample>(fft_size));
+        for (size_t tau = 1; tau < half_buffer_size; ++tau)
+        {
+            for (size_t i = 0; i < half_buffer_size; ++i)
+            {
+                TSample delta = buffer[i] - buffer[i + tau];
+                yin_buffer[tau] += delta * delta;
+            }
+        }
     }
 
-    return specflatness;
+    yin_buffer[0] = 1.0;
+    TSample running_sum = static_cast<TSample>(0.0);
+    for (size_t tau = 1; tau < half_buffer_size; ++tau)
+    {
+        running_sum += yin_buffer[tau];
+        if (running_sum > static_cast<TSample>(0.0))
+        {
+            yin_buffer[tau] *= static_cast<TSample>(tau) / running_sum;
+        }
+        else
+        {
+            yin_buffer[tau] = static_cast<TSample>(1.0);
+        }
+    }
 }
 
-// SPECTRAL FLUX
+// The result is written into yin_buffer, which is resized only when needed,
+// so that a caller can reuse the same scratch buffer frame after frame
 template <typename Container>
 #if __cplusplus >= 202002L
 requires std::floating_point<typename Container::value_type>
 #endif
-typename Container::value_type flux(const Container& magnitudes, const Container& previous_magnitudes)
+void yin_difference(const Container& buffer, std::vector<typename Container::value_type>& yin_buffer,
+                    ReductionPool* pool = nullptr)
 {
-    using TSample = typename Container::value_type;
-
-    TSample specflux = static_cast<TSample>(0.0);
+    size_t half_buffer_size = buffer.size() / 2;
 
-    if (magnitudes.size() != previous_magnitudes.size() || magnitudes.empty())
+    if (yin_buffer.size() != half_buffer_size)
     {
-        return specflux;
+        yin_buffer.resize(half_buffer_size);
     }
 
-    unsigned int fft_size = magnitudes.size();
+    yin_difference(buffer, yin_buffer, half_buffer_size, pool);
+}
 
-    for (unsigned int k = 0u; k < fft_size; k++)
+// UTILITY FUNCTION: first lag whose difference is below the threshold (moved to the bottom of its trough)
+// or, if there is none, the lag of the global minimum
+template <typename Scratch, typename TSample>
+size_t yin_tau(const Scratch& yin_buffer, const size_t half_buffer_size, const TSample threshold)
+{
+    for (size_t tau = 2; tau < half_buffer_size; ++tau)
     {
-        specflux += std::pow(std::abs(magnitudes[k]) - std::abs(previous_magnitudes[k]), static_cast<TSample>(2.0));
+        if (yin_buffer[tau] < threshold)
+        {
+            while (tau + 1 < half_buffer_size && yin_buffer[tau + 1] < yin_buffer[tau])
+            {
+                tau++;
+            }
+
+            return tau;
+        }
     }
 
-    specflux = std::sqrt(specflux);
-    specflux /= static_cast<TSample>(fft_size);
+    auto min_it = std::min_element(yin_buffer.begin() + 2, yin_buffer.begin() + half_buffer_size);
 
-    return specflux;
+    return static_cast<size_t>(std::distance(yin_buffer.begin(), min_it));
 }
 
-// SPECTRAL IRREGULARITY
-template <typename Container>
-#if __cplusplus >= 202002L
-requires std::floating_point<typename Container::value_type>
-#endif
-typename Container::value_type irregularity(const Container& magnitudes)
+// UTILITY FUNCTION: parabolic interpolation of a YIN lag around tau_estimate
+template <typename Scratch>
+typename Scratch::value_type yin_refine_tau(const Scratch& yin_buffer, size_t tau_estimate, size_t half_buffer_size = 0)
 {
-    using TSample = typename Container::value_type;
-
-    TSample irr = static_cast<TSample>(0.0);
+    using TSample = typename Scratch::value_type;
 
-    if (magnitudes.empty())
+    if (half_buffer_size == 0)
     {
-        return irr;
+        half_buffer_size = yin_buffer.size();
     }
 
-    unsigned int fft_size = magnitudes.size();
+    TSample better_tau;
+    size_t x0;
+    size_t x2;
 
-    TSample magn_sum = static_cast<TSample>(0.0);
+    if (tau_estimate < 1)
+    {
+        x0 = tau_estimate;
+    }
+    else
+    {
+        x0 = tau_estimate - 1;
+    }
 
-    for (unsigned int k = 0u; k < fft_size; k++)
+    if (tau_estimate + 1 >= half_buffer_size)
     {
-        magn_sum += std::abs(magnitudes[k]);
+        x2 = tau_estimate;
+    }
+    else
+    {
+        x2 = tau_estimate + 1;
+    }
 
-        if (k > 0u)
+    if (x0 == tau_estimate) {
+        if (yin_buffer[tau_estimate] <= yin_buffer[x2])
         {
-            irr += std::abs(magnitudes[k] - magnitudes[k - 1u]);
+            better_tau = static_cast<TSample>(tau_estimate);
+        }
+        else
+        {
+            better_tau = static_cast<TSample>(x2);
         }
     }
-
-    if (magn_sum > static_cast<TSample>(0.0))
+    else if (x2 == tau_estimate)
     {
-        irr /= magn_sum;
+        if (yin_buffer[tau_estimate] <= yin_buffer[x0])
+        {
+            better_tau = static_cast<TSample>(tau_estimate);
+        }
+        else
+        {
+            better_tau = static_cast<TSample>(x0);
+        }
     }
     else
     {
-        irr = static_cast<TSample>(0.0);
+        TSample s0 = yin_buffer[x0];
+        TSample s1 = yin_buffer[tau_estimate];
+        TSample s2 = yin_buffer[x2];
+
+        TSample denominator = 2.0 * (s2 - 2.0 * s1 + s0);
+        if (std::abs(denominator) > 1e-5)
+        {
+            better_tau = static_cast<TSample>(tau_estimate) + (s0 - s2) / denominator;
+        }
+        else
+        {
+            better_tau = static_cast<TSample>(tau_estimate);
+        }
     }
 
-    return irr;
+    return better_tau;
 }
 
-// SPECTRAL KURTOSIS
+// FUNDAMENTAL PITCH (YIN ALGORITHM)
+// This overload uses yin_buffer as scratch buffer, avoiding an allocation per call
+// (and the threads of pool for the difference, see yin_difference)
 template <typename Container>
 #if __cplusplus >= 202002L
 requires std::floating_point<typename Container::value_type>
 #endif
-typename Container::value_type kurtosis(const Container& magnitudes,
-                                        typename Container::value_type sample_rate = static_cast<typename Container::value_type>(44100.0),
-                                        std::vector<typename Container::value_type>& precomputed_frequencies = {},
-                                        typename Container::value_type spectral_centroid = static_cast<typename Container::value_type>(-1.0),
-                                        typename Container::value_type spectral_spread = static_cast<typename Container::value_type>(-1.0),
-                                        unsigned int stft_size = 0u)
+typename Container::value_type yin(Container &buffer, typename Container::value_type sample_rate, typename Container::value_type threshold,
+                                   std::vector<typename Container::value_type>& yin_buffer, ReductionPool* pool = nullptr)
 {
     using TSample = typename Container::value_type;
 
-    TSample skurtosis = static_cast<TSample>(0.0);
-    TSample scentroid = spectral_centroid;
-    TSample sspread = spectral_spread;
+    yin_difference(buffer, yin_buffer, pool);
 
-    if (magnitudes.empty())
+    size_t half_buffer_size = yin_buffer.size();
+
+    if (half_buffer_size < 3)
     {
-        return skurtosis;
+        return static_cast<TSample>(-1.0);
     }
 
-    unsigned int fft_size = magnitudes.size();
-    unsigned int bins = stft_size > 0u ? stft_size : (fft_size - 1u) * 2u;
+    TSample pitch_period = yin_refine_tau(yin_buffer, yin_tau(yin_buffer, half_buffer_size, threshold));
 
-    if (precomputed_frequencies.size() < bins)
+    if (pitch_period > 0.0)
     {
-        precomputed_frequencies = precompute_frequencies(bins, sample_rate);
+        return sample_rate / pitch_period;
     }
 
-    if (spectral_centroid < static_cast<TSample>(0.0))
+    return static_cast<TSample>(-1.0);
+}
+
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+typename Container::value_type yin(Container &buffer, typename Container::value_type sample_rate, typename Container::value_type threshold = static_cast<typename Container::value_type>(0.15))
+{
+    std::vector<typename Container::value_type> yin_buffer;
+
+    return yin(buffer, sample_rate, threshold, yin_buffer);
+}
+
+// PROBABILISTIC YIN CANDIDATES
+template <typename TSample>
+struct PitchCandidate
+{
+    TSample frequency = static_cast<TSample>(0.0);
+    TSample probability = static_cast<TSample>(0.0);
+};
+
+// From a cumulative mean normalized difference (see yin_difference), collect the pitch candidates
+// following the probabilistic YIN (pYIN) approach: instead of a single threshold, a Beta(2, 18)
+// distribution of thresholds is used, and each trough accumulates the probability of the thresholds
+// for which it would have been selected. The sum of the probabilities is the voicing probability.
+// Only lags between min_tau and max_tau are considered (0 means up to the end of the buffer) and,
+// if max_candidates is not 0, only the first max_candidates troughs are kept.
+template <typename TSample>
+void yin_candidates(const std::vector<TSample>& yin_buffer, TSample sample_rate,
+                    std::vector<PitchCandidate<TSample>>& candidates,
+                    size_t min_tau = 2, size_t max_tau = 0, size_t max_candidates = 0)
+{
+    static constexpr unsigned int thresholds = 100u;
+    // Probability assigned to the global minimum when no trough is below the threshold
+    static constexpr TSample absolute_min_probability = static_cast<TSample>(0.01);
+
+    static const std::vector<TSample> threshold_distribution = []()
     {
-        scentroid = centroid(magnitudes, sample_rate, precomputed_frequencies);
+        // Beta(2, 18) probability mass over thresholds 0.01, 0.02, ..., 1.0
+        std::vector<TSample> distribution(thresholds, static_cast<TSample>(0.0));
+        TSample total = static_cast<TSample>(0.0);
+        for (auto i = 0u; i < thresholds; i++)
+        {
+            TSample x = static_cast<TSample>(i + 1u) / static_cast<TSample>(thresholds);
+            distribution[i] = x * std::pow(static_cast<TSample>(1.0) - x, static_cast<TSample>(17.0));
+            total += distribution[i];
+        }
+        for (auto &d : distribution)
+        {
+            d /= total;
+        }
+        return distribution;
+    }();
+
+    candidates.clear();
+
+    const size_t half_buffer_size = yin_buffer.size();
+    min_tau = std::max(min_tau, static_cast<size_t>(2));
+    if (max_tau == 0 || max_tau >= half_buffer_size)
+    {
+        max_tau = half_buffer_size > 0 ? half_buffer_size - 1 : 0;
     }
 
-    if (spectral_spread < static_cast<TSample>(0.0))
+    if (half_buffer_size < 3 || min_tau >= max_tau || sample_rate <= static_cast<TSample>(0.0))
     {
-        sspread = spread(magnitudes, sample_rate, precomputed_frequencies, scentroid);
+        return;
+    }
+
+    if (max_candidates == 0)
+    {
+        max_candidates = half_buffer_size;
     }
 
-    TSample magn_sum = static_cast<TSample>(0.0);
-    TSample numerator = static_cast<TSample>(0.0);
+    // Troughs are stored in the candidates themselves: lag in frequency, value in probability,
+    // then converted once the probabilities have been accumulated
+    size_t global_min_tau = min_tau;
+    for (size_t tau = min_tau; tau <= max_tau; ++tau)
+    {
+        if (yin_buffer[tau] < yin_buffer[global_min_tau])
+        {
+            global_min_tau = tau;
+        }
+
+        bool left = tau == min_tau || yin_buffer[tau] < yin_buffer[tau - 1];
+        bool right = tau == max_tau || yin_buffer[tau] <= yin_buffer[tau + 1];
 
-    for (unsigned int k = 0u; k < fft_size; k++)
+        if (left && right && yin_buffer[tau] < static_cast<TSample>(1.0) && candidates.size() < max_candidates)
+        {
+            candidates.push_back({static_cast<TSample>(tau), static_cast<TSample>(0.0)});
+        }
+    }
+
+    bool global_min_listed = false;
+    for (auto &c : candidates)
     {
-        numerator += std::pow(precomputed_frequencies[k] - scentroid, static_cast<TSample>(4.0)) * std::abs(magnitudes[k]);
-        magn_sum += std::abs(magnitudes[k]);
+        global_min_listed |= static_cast<size_t>(c.frequency) == global_min_tau;
+    }
+    if (!global_min_listed && candidates.size() < max_candidates)
+    {
+        candidates.push_back({static_cast<TSample>(global_min_tau), static_cast<TSample>(0.0)});
     }
 
-    if (magn_sum * sspread > static_cast<TSample>(0.0))
+    for (auto i = 0u; i < thresholds; i++)
     {
-        skurtosis = numerator / (magn_sum * std::pow(sspread, static_cast<TSample>(4.0)));
-        skurtosis -= static_cast<TSample>(3.0);
+        const TSample threshold = static_cast<TSample>(i + 1u) / static_cast<TSample>(thresholds);
+        bool assigned = false;
+
+        for (auto &c : candidates)
+        {
+            if (yin_buffer[static_cast<size_t>(c.frequency)] < threshold)
+            {
+                c.probability += threshold_distribution[i];
+                assigned = true;
+                break;
+            }
+        }
+
+        if (!assigned)
+        {
+            for (auto &c : candidates)
+            {
+                if (static_cast<size_t>(c.frequency) == global_min_tau)
+                {
+                    c.probability += absolute_min_probability * threshold_distribution[i];
+                }
+            }
+        }
     }
 
-    return skurtosis;
+    candidates.erase(std::remove_if(candidates.begin(), candidates.end(),
+                                    [](const PitchCandidate<TSample>& c) { return c.probability <= static_cast<TSample>(0.0); }),
+                     candidates.end());
+
+    for (auto &c : candidates)
+    {
+        TSample period = yin_refine_tau(yin_buffer, static_cast<size_t>(c.frequency));
+        c.frequency = period > static_cast<TSample>(0.0) ? sample_rate / period : static_cast<TSample>(0.0);
+    }
 }
 
-// SPECTRAL PEAK
+// ZERO CROSSING RATE
 template <typename Container>
 #if __cplusplus >= 202002L
 requires std::floating_point<typename Container::value_type>
 #endif
-typename Container::value_type peak(const Container& magnitudes,
-                                    typename Container::value_type sample_rate = static_cast<typename Container::value_type>(44100.0),
-                                    std::vector<typename Container::value_type>& precomputed_frequencies = {},
-                                    unsigned int stft_size = 0u)
+typename Container::value_type zerocrossing(const Container& buffer)
 {
     using TSample = typename Container::value_type;
 
-    TSample peak = static_cast<TSample>(0.0);
+    TSample zerocrossingrate = static_cast<TSample>(0.0);
 
-    if (magnitudes.empty())
+    if (buffer.size() < 2)
     {
-        return peak;
+        return zerocrossingrate;
     }
 
-    unsigned int fft_size = magnitudes.size();
-    unsigned int bins = stft_size > 0u ? stft_size : (fft_size - 1u) * 2u;
+    for (auto s = 1u; s < buffer.size(); s++)
+    {
+        zerocrossingrate += std::abs(static_cast<TSample>(!std::signbit(buffer[s])) - static_cast<TSample>(!std::signbit(buffer[s - 1])));
+    }
+
+    zerocrossingrate /= static_cast<TSample>(buffer.size() - 1);
+
+    return zerocrossingrate;
+}
+
+} // namespace Informer::Amplitude
+
+
+/* FREQUENCY DOMAIN DESCRIPTORS */
+
+namespace Frequency
+{
+
+// UTILITY FUNCTION: precompute the frequencies for the given STFT size and sample rate
+template <typename ISize, typename TSample>
+std::vector<TSample> precompute_frequencies(ISize stft_size = static_cast<ISize>(4096), TSample sample_rate = static_cast<TSample>(44100.0))
+{
+    std::vector<TSample> precomputed_frequencies = {};
+    unsigned int size = static_cast<unsigned int>(stft_size);
 
-    if (precomputed_frequencies.size() < bins)
+    if (size > 2u)
     {
-        precomputed_frequencies = precompute_frequencies(bins, sample_rate);
+        TSample fft_bandwidth = static_cast<TSample>(sample_rate) / static_cast<TSample>(size);
+        precomputed_frequencies.resize(size / 2u + 1u, static_cast<TSample>(0.0));
+        for (auto b = 0u; b < size / 2u + 1; b++)
+        {
+            precomputed_frequencies[b] = static_cast<TSample>(b) * fft_bandwidth;
+        }
     }
 
-    unsigned int magn_max_idx = 0;
-    TSample magn_max = static_cast<TSample>(0.0);
+    return precomputed_frequencies;
+}
 
-    for (unsigned int k = 0u; k < fft_size; k++)
+// UTILITY FUNCTION: from a real valued FFT, calculate the magnitudes
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+std::vector<typename Container::value_type> magnitudes(const Container& stft)
+{
+    using TSample = typename Container::value_type;
+
+    INFORMER_PROFILE_SCOPE("magnitudes");
+
+    std::vector<TSample> magnitudes_vector;
+
+    // An even number of values and a size greater than 2 are expected
+    if (stft.size() < 2u || stft.size() % 2)
     {
-        if (std::abs(magnitudes[k]) > magn_max)
+        return magnitudes_vector;
+    }
+
+    magnitudes_vector.assign(stft.size() / 2 + 1, static_cast<TSample>(0.0));
+
+    // DC offset
+    magnitudes_vector[0] = stft[0];
+
+    // Values up to Nyquist bin - 1
+    for (auto b = 2; b < stft.size(); b += 2)
+    {
+        TSample real = stft[b];
+        TSample imag = stft[b + 1];
+        magnitudes_vector[b / 2] = sqrt(real * real + imag * imag) / static_cast<TSample>(stft.size());
+    }
+
+    // Nyquist frequency
+    magnitudes_vector[stft.size() / 2 + 1] = stft[1];
+
+    return magnitudes_vector;
+}
+
+// UTILITY FUNCTION: apply a (Hann or Blackman-Harris) window function to the input signal
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+std::vector<typename Container::value_type> window(const Container& buffer, const bool hann_window = true)
+{
+    using TSample = typename Container::value_type;
+
+    INFORMER_PROFILE_SCOPE("window");
+
+    constexpr TSample m_pi = static_cast<TSample>(3.14159265358979323846);
+    std::vector<TSample> windowed_buffer(buffer.size());
+    for (size_t i = 0; i < buffer.size(); ++i)
+    {
+        TSample x = static_cast<TSample>(i) / static_cast<TSample>(buffer.size() - 1);
+        TSample window = static_cast<TSample>(1.0);
+
+        if (hann_window)
         {
-            magn_max = std::abs(magnitudes[k]);
-            magn_max_idx = k;
+            window = static_cast<TSample>(0.5) * (static_cast<TSample>(1.0) - cos(static_cast<TSample>(2.0) * static_cast<TSample>(m_pi) * x));
+        }
+        else
+        {
+            window = static_cast<TSample>(0.35875) -
+                     static_cast<TSample>(0.48829) * cos(static_cast<TSample>(2.0) *
+                         static_cast<TSample>(m_pi) * x) + static_cast<TSample>(0.14128) *
+                     cos(static_cast<TSample>(4.0) * static_cast<TSample>(m_pi) * x) -
+                     static_cast<TSample>(0.01168) * cos(static_cast<TSample>(6.0) *
+                         static_cast<TSample>(m_pi) * x);
         }
+
+        windowed_buffer[i] = window * buffer[i];
     }
 
-    return precomputed_frequencies[magn_max_idx];
+    return windowed_buffer;
 }
 
-// SPECTRAL ROLLOFF
+// UTILITY STRUCTURE: sparse map from FFT bins to chroma (pitch class) bins
+// Each bin contributes to at most two adjacent chroma bins, so that a chroma vector
+// is obtained with a single pass over the entries
+template <typename TSample>
+struct ChromaMap
+{
+    unsigned int chroma_bins = 12u;
+    std::vector<unsigned int> bins = {};
+    std::vector<unsigned int> classes = {};
+    std::vector<TSample> weights = {};
+};
+
+// UTILITY FUNCTION: precompute the chroma map for the given STFT size and sample rate
+// chroma_bins must be a multiple of 12 (12 for semitones, 36 for thirds of semitone)
+// Chroma bin 0 is centered on C, bins are linearly interpolated on a logarithmic frequency scale
+template <typename ISize, typename TSample>
+ChromaMap<TSample> precompute_chroma_map(ISize stft_size = static_cast<ISize>(4096), TSample sample_rate = static_cast<TSample>(44100.0),
+                                         unsigned int chroma_bins = 12u,
+                                         TSample min_frequency = static_cast<TSample>(50.0),
+                                         TSample max_frequency = static_cast<TSample>(5000.0),
+                                         TSample reference_frequency = static_cast<TSample>(440.0))
+{
+    ChromaMap<TSample> chroma_map;
+    unsigned int size = static_cast<unsigned int>(stft_size);
+
+    if (chroma_bins < 12u || chroma_bins % 12u)
+    {
+        chroma_bins = 12u;
+    }
+
+    chroma_map.chroma_bins = chroma_bins;
+
+    if (size <= 2u || sample_rate <= static_cast<TSample>(0.0) || reference_frequency <= static_cast<TSample>(0.0))
+    {
+        return chroma_map;
+    }
+
+    // Reference C, nine semitones below the tuning frequency
+    const TSample c_frequency = reference_frequency * std::pow(static_cast<TSample>(2.0), static_cast<TSample>(-9.0 / 12.0));
+    const TSample fft_bandwidth = sample_rate / static_cast<TSample>(size);
+
+    for (auto b = 1u; b < size / 2u + 1u; b++)
+    {
+        TSample frequency = static_cast<TSample>(b) * fft_bandwidth;
+
+        if (frequency < min_frequency || frequency > max_frequency)
+        {
+            continue;
+        }
+
+        TSample position = static_cast<TSample>(chroma_bins) * std::log2(frequency / c_frequency);
+        position = std::fmod(position, static_cast<TSample>(chroma_bins));
+        if (position < static_cast<TSample>(0.0))
+        {
+            position += static_cast<TSample>(chroma_bins);
+        }
+
+        unsigned int lower = static_cast<unsigned int>(position) % chroma_bins;
+        TSample fraction = position - std::floor(position);
+
+        if (fraction < static_cast<TSample>(1.0))
+        {
+            chroma_map.bins.push_back(b);
+            chroma_map.classes.push_back(lower);
+            chroma_map.weights.push_back(static_cast<TSample>(1.0) - fraction);
+        }
+
+        if (fraction > static_cast<TSample>(0.0))
+        {
+            chroma_map.bins.push_back(b);
+            chroma_map.classes.push_back((lower + 1u) % chroma_bins);
+            chroma_map.weights.push_back(fraction);
+        }
+    }
+
+    return chroma_map;
+}
+
+// UTILITY STRUCTURE: bins of the 24 critical bands of Zwicker (0 - 15500 Hz), band b covers the
+// bins from first_bins[b] to first_bins[b + 1] excluded, so that the band energies are obtained
+// with a single pass over the magnitudes. The threshold in quiet at the center of each band
+// (as an energy relative to 0 dB SPL) is used by loudness().
+template <typename TSample>
+struct BarkMap
+{
+    static constexpr unsigned int bands = 24u;
+    std::array<unsigned int, bands + 1u> first_bins = {};
+    std::array<TSample, bands> threshold_energies = {};
+};
+
+// UTILITY FUNCTION: precompute the critical band map for the given STFT size and sample rate
+// Bands above Nyquist are left empty
+template <typename ISize, typename TSample>
+BarkMap<TSample> precompute_bark_map(ISize stft_size = static_cast<ISize>(4096), TSample sample_rate = static_cast<TSample>(44100.0))
+{
+    constexpr double edges[BarkMap<TSample>::bands + 1u] =
+    {
+        0.0, 100.0, 200.0, 300.0, 400.0, 510.0, 630.0, 770.0, 920.0, 1080.0, 1270.0, 1480.0, 1720.0,
+        2000.0, 2320.0, 2700.0, 3150.0, 3700.0, 4400.0, 5300.0, 6400.0, 7700.0, 9500.0, 12000.0, 15500.0
+    };
+
+    BarkMap<TSample> bark_map;
+    unsigned int size = static_cast<unsigned int>(stft_size);
+
+    if (size <= 2u || sample_rate <= static_cast<TSample>(0.0))
+    {
+        return bark_map;
+    }
+
+    const double fft_bandwidth = static_cast<double>(sample_rate) / static_cast<double>(size);
+    const unsigned int last_bin = size / 2u + 1u;
+
+    // The DC bin is left out
+    for (unsigned int b = 0u; b <= BarkMap<TSample>::bands; b++)
+    {
+        const unsigned int first_bin = static_cast<unsigned int>(std::ceil(edges[b] / fft_bandwidth));
+        bark_map.first_bins[b] = std::clamp(first_bin, 1u, last_bin);
+    }
+
+    // Terhardt's approximation of the threshold in quiet
+    for (unsigned int b = 0u; b < BarkMap<TSample>::bands; b++)
+    {
+        const double khz = std::max(0.5 * (edges[b] + edges[b + 1u]), 20.0) * 0.001;
+        const double threshold_db = 3.64 * std::pow(khz, -0.8) - 6.5 * std::exp(-0.6 * (khz - 3.3) * (khz - 3.3)) + 0.001 * std::pow(khz, 4.0);
+        bark_map.threshold_energies[b] = static_cast<TSample>(std::pow(10.0, 0.1 * threshold_db));
+    }
+
+    return bark_map;
+}
+
+// SPECTRAL CENTROID
 template <typename Container>
 #if __cplusplus >= 202002L
 requires std::floating_point<typename Container::value_type>
 #endif
-typename Container::value_type rolloff(const Container& magnitudes,
-                                       typename Container::value_type sample_rate = static_cast<typename Container::value_type>(44100.0),
-                                       typename Container::value_type rolloff_point = static_cast<typename Container::value_type>(0.85),
-                                       std::vector<typename Container::value_type>& precomputed_frequencies = {},
-                                       unsigned int stft_size = 0u)
+typename Container::value_type centroid(const Container& magnitudes,
+                                        typename Container::value_type sample_rate = static_cast<typename Container::value_type>(44100.0),
+                                        std::vector<typename Container::value_type>& precomputed_frequencies = {}, unsigned int stft_size = 0u)
 {
     using TSample = typename Container::value_type;
 
+    TSample centroid = static_cast<TSample>(0.0);
+
     if (magnitudes.empty())
     {
-        return static_cast<TSample>(0.0);
-    }
+        return centroid;
+    }
+
+    unsigned int fft_size = magnitudes.size();
+    unsigned int bins = stft_size > 0u ? stft_size : (fft_size - 1u) * 2u;
+
+    if (precomputed_frequencies.size() < bins / 2u + 1u)
+    {
+        precomputed_frequencies = precompute_frequencies(bins, sample_rate);
+    }
+
+    Accumulator<TSample> weighted_sum;
+    Accumulator<TSample> magn_sum;
+
+    for (unsigned int k = 0u; k < fft_size; k++)
+    {
+        weighted_sum += precomputed_frequencies[k] * std::abs(magnitudes[k]);
+        magn_sum += std::abs(magnitudes[k]);
+    }
+
+    if (magn_sum > static_cast<TSample>(0.0))
+    {
+        centroid = weighted_sum;
+        centroid /= magn_sum;
+    }
+
+    return centroid;
+}
+
+// SPECTRAL SPREAD
+// Not in alphabetical order because it is used in the kurtosis and skewness functions
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+typename Container::value_type spread(const Container& magnitudes,
+                                      typename Container::value_type sample_rate = static_cast<typename Container::value_type>(44100.0),
+                                      std::vector<typename Container::value_type>& precomputed_frequencies = {},
+                                      typename Container::value_type spectral_centroid = static_cast<typename Container::value_type>(-1.0),
+                                      unsigned int stft_size = 0u)
+{
+    using TSample = typename Container::value_type;
+
+    TSample sspread = static_cast<TSample>(0.0);
+
+    if (magnitudes.empty())
+    {
+        return sspread;
+    }
+
+    unsigned int fft_size = magnitudes.size();
+    unsigned int bins = stft_size > 0u ? stft_size : (fft_size - 1u) * 2u;
+
+    if (precomputed_frequencies.size() < bins / 2u + 1u)
+    {
+        precomputed_frequencies = precompute_frequencies(bins, sample_rate);
+    }
+
+    if (spectral_centroid < static_cast<TSample>(0.0))
+    {
+        spectral_centroid = centroid(magnitudes, sample_rate, precomputed_frequencies);
+    }
+
+    Accumulator<TSample> numerator;
+    Accumulator<TSample> magn_sum;
+
+    for (unsigned int k = 0u; k < fft_size; k++)
+    {
+        numerator += (precomputed_frequencies[k] - spectral_centroid) * (precomputed_frequencies[k] - spectral_centroid) * std::abs(magnitudes[k]);
+        magn_sum += std::abs(magnitudes[k]);
+    }
+
+    if (magn_sum > static_cast<TSample>(0.0))
+    {
+        sspread = std::sqrt(numerator / magn_sum);
+    }
+    else
+    {
+        sspread = static_cast<TSample>(0.0);
+    }
+
+    return sspread;
+}
+
+// CHROMA (PITCH CLASS PROFILE)
+// The chroma vector is written into chroma_vector, which is resized only when needed,
+// and normalized so that its maximum value is 1
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+void chroma(const Container& magnitudes, const ChromaMap<typename Container::value_type>& chroma_map,
+            std::vector<typename Container::value_type>& chroma_vector)
+{
+    using TSample = typename Container::value_type;
+
+    if (chroma_vector.size() != chroma_map.chroma_bins)
+    {
+        chroma_vector.resize(chroma_map.chroma_bins);
+    }
+
+    std::fill(chroma_vector.begin(), chroma_vector.end(), static_cast<TSample>(0.0));
+
+    const size_t fft_size = magnitudes.size();
+    const size_t entries = chroma_map.bins.size();
+
+    for (size_t e = 0; e < entries; e++)
+    {
+        const unsigned int b = chroma_map.bins[e];
+
+        if (b < fft_size)
+        {
+            chroma_vector[chroma_map.classes[e]] += chroma_map.weights[e] * magnitudes[b] * magnitudes[b];
+        }
+    }
+
+    TSample chroma_max = *std::max_element(chroma_vector.begin(), chroma_vector.end());
+
+    if (chroma_max > static_cast<TSample>(0.0))
+    {
+        TSample inv_max = static_cast<TSample>(1.0) / chroma_max;
+        for (auto &c : chroma_vector)
+        {
+            c *= inv_max;
+        }
+    }
+}
+
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+std::vector<typename Container::value_type> chroma(const Container& magnitudes,
+                                                   const ChromaMap<typename Container::value_type>& chroma_map)
+{
+    std::vector<typename Container::value_type> chroma_vector;
+
+    chroma(magnitudes, chroma_map, chroma_vector);
+
+    return chroma_vector;
+}
+
+// SPECTRAL CREST FACTOR
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+typename Container::value_type crestfactor(const Container& magnitudes)
+{
+    using TSample = typename Container::value_type;
+
+    TSample scf = static_cast<TSample>(0.0);
+
+    if (magnitudes.empty())
+    {
+        return scf;
+    }
+
+    unsigned int fft_size = magnitudes.size();
+
+    TSample magn_max = static_cast<TSample>(0.0);
+    Accumulator<TSample> magn_sum;
+
+    for (unsigned int k = 0u; k < fft_size; k++)
+    {
+        if (std::abs(magnitudes[k]) > magn_max)
+        {
+            magn_max = std::abs(magnitudes[k]);
+        }
+        magn_sum += std::abs(magnitudes[k]);
+    }
+
+    if (magn_sum > static_cast<TSample>(0.0))
+    {
+        scf = magn_max / magn_sum;
+    }
+
+    return scf;
+}
+
+// SPECTRAL DECREASE
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+typename Container::value_type decrease(const Container& magnitudes)
+{
+    using TSample = typename Container::value_type;
+
+    TSample decrease = static_cast<TSample>(0.0);
+
+    if (magnitudes.empty())
+    {
+        return decrease;
+    }
+
+    unsigned int fft_size = magnitudes.size();
+
+    Accumulator<TSample> magn_diff_sum;
+    Accumulator<TSample> magn_sum;
+
+    for (unsigned int k = 1u; k < fft_size; k++)
+    {
+        magn_diff_sum += (std::abs(magnitudes[k]) - std::abs(magnitudes[0])) / static_cast<TSample>(k);
+        magn_sum += std::abs(magnitudes[k]);
+    }
+
+    if (magn_sum > static_cast<TSample>(0.0))
+    {
+        decrease = magn_diff_sum / magn_sum;
+    }
+
+    return decrease;
+}
+
+// ESTIMATED FUNDAMENTAL FREQUENCY, HPS METHOD
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+typename Container::value_type f0_hps(const Container& magnitudes, const unsigned int &max_compression = 5u,
+                                      typename Container::value_type sample_rate = static_cast<typename Container::value_type>(44100.0),
+                                      std::vector<typename Container::value_type>& precomputed_frequencies = {},
+                                      unsigned int stft_size = 0u)
+{
+    using TSample = typename Container::value_type;
+
+    TSample f0 = static_cast<TSample>(0.0);
+
+    if (magnitudes.empty() || max_compression < 2u)
+    {
+        return f0;
+    }
+
+    unsigned int fft_size = magnitudes.size();
+    unsigned int bins = stft_size > 0u ? stft_size : (fft_size - 1u) * 2u;
+
+    if (precomputed_frequencies.size() < bins / 2u + 1u)
+    {
+        precomputed_frequencies = precompute_frequencies(bins, sample_rate);
+    }
+
+    // Consider magnitudes only in the range 50 - 10000 Hz, a contiguous range of bins starting
+    // at filtered_low_bands
+    unsigned int filtered_size = 0u;
+    unsigned int filtered_low_bands = 0u;
+    for (unsigned int b = 0u; b < fft_size; b++)
+    {
+        if (precomputed_frequencies[b] >= 50.0 && precomputed_frequencies[b] <= 10000.0)
+        {
+            ++filtered_size;
+        }
+        else if (precomputed_frequencies[b] < 50.0)
+        {
+            ++filtered_low_bands;
+        }
+    }
+
+    if (filtered_size < max_compression)
+    {
+        return f0;
+    }
+
+    unsigned int hps_length = filtered_size / max_compression;
+
+    if (hps_length < 2u)
+    {
+        return f0;
+    }
+
+    // The product of each bin is computed in turn, keeping the first maximum
+    const auto filtered_magnitudes = magnitudes.begin() + filtered_low_bands;
+    unsigned int k_max = 0u;
+    TSample max_prod = static_cast<TSample>(0.0);
+
+    for (unsigned int k = 0u; k < hps_length; k++)
+    {
+        TSample product = filtered_magnitudes[k];
+
+        for (unsigned int n = 2u; n <= max_compression; n++)
+        {
+            unsigned int original_index = n * k;
+
+            if (original_index < filtered_size)
+            {
+                product *= filtered_magnitudes[original_index];
+            }
+        }
+
+        if (k == 0u || max_prod < product)
+        {
+            max_prod = product;
+            k_max = k;
+        }
+    }
+
+    unsigned int k_peak = k_max + filtered_low_bands;
+
+    f0 = precomputed_frequencies[k_peak];
+
+    return f0;
+}
+
+// SPECTRAL ENTROPY
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+typename Container::value_type entropy(const Container& magnitudes)
+{
+    using TSample = typename Container::value_type;
+
+    TSample h = static_cast<TSample>(0.0);
+
+    if (magnitudes.empty())
+    {
+        return h;
+    }
+
+    unsigned int fft_size = magnitudes.size();
+
+    Accumulator<TSample> power_sum;
+
+    for (unsigned int k = 0u; k < fft_size; k++)
+    {
+        power_sum += magnitudes[k] * magnitudes[k];
+    }
+
+    if (power_sum > static_cast<TSample>(0.0))
+    {
+        const TSample total_power = power_sum;
+        Accumulator<TSample> information;
+
+        for (unsigned int k = 0u; k < fft_size; k++)
+        {
+            TSample p = magnitudes[k] * magnitudes[k] / total_power;
+            if (p > static_cast<TSample>(0.0))
+            {
+                information += p * std::log2(p);
+            }
+        }
+
+        h = information;
+    }
+
+    h /= std::log2(static_cast<TSample>(fft_size));
+    h *= static_cast<TSample>(-1.0);
+
+    return h;
+}
+
+// SPECTRAL FLATNESS
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+typename Container::value_type flatness(const Container& magnitudes)
+{
+    using TSample = typename Container::value_type;
+
+    TSample specflatness = static_cast<TSample>(0.0);
+
+    if (magnitudes.empty())
+    {
+        return specflatness;
+    }
+
+    unsigned int fft_size = magnitudes.size();
+
+    Accumulator<TSample> magn_sum;
+    Accumulator<TSample> ln_magn_sum;
+
+    for (unsigned int k = 0u; k < fft_size; k++)
+    {
+        magn_sum += std::abs(magnitudes[k]);
+        if (std::abs(magnitudes[k]) > static_cast<TSample>(0.0))
+        {
+            ln_magn_sum += std::log(std::abs(magnitudes[k]));
+        }
+        else
+        {
+            ln_magn_sum += std::log(static_cast<TSample>(0.00001));
+        }
+    }
+
+    if (magn_sum > static_cast<TSample>(0.0))
+    {
+        specflatness = std::exp(ln_magn_sum / static_cast<TSample>(fft_size)) / (magn_sum / static_cast<TSample>(fft_size));
+    }
+
+    return specflatness;
+}
+
+// SPECTRAL FLUX
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+typename Container::value_type flux(const Container& magnitudes, const Container& previous_magnitudes)
+{
+    using TSample = typename Container::value_type;
+
+    TSample specflux = static_cast<TSample>(0.0);
+
+    if (magnitudes.size() != previous_magnitudes.size() || magnitudes.empty())
+    {
+        return specflux;
+    }
+
+    unsigned int fft_size = magnitudes.size();
+
+    Accumulator<TSample> square_sum;
+
+    for (unsigned int k = 0u; k < fft_size; k++)
+    {
+        square_sum += std::pow(std::abs(magnitudes[k]) - std::abs(previous_magnitudes[k]), static_cast<TSample>(2.0));
+    }
+
+    specflux = std::sqrt(static_cast<TSample>(square_sum));
+    specflux /= static_cast<TSample>(fft_size);
+
+    return specflux;
+}
+
+// SPECTRAL IRREGULARITY
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+typename Container::value_type irregularity(const Container& magnitudes)
+{
+    using TSample = typename Container::value_type;
+
+    TSample irr = static_cast<TSample>(0.0);
+
+    if (magnitudes.empty())
+    {
+        return irr;
+    }
+
+    unsigned int fft_size = magnitudes.size();
+
+    Accumulator<TSample> magn_sum;
+    Accumulator<TSample> diff_sum;
+
+    for (unsigned int k = 0u; k < fft_size; k++)
+    {
+        magn_sum += std::abs(magnitudes[k]);
+
+        if (k > 0u)
+        {
+            diff_sum += std::abs(magnitudes[k] - magnitudes[k - 1u]);
+        }
+    }
+
+    irr = diff_sum;
+
+    if (magn_sum > static_cast<TSample>(0.0))
+    {
+        irr /= magn_sum;
+    }
+    else
+    {
+        irr = static_cast<TSample>(0.0);
+    }
+
+    return irr;
+}
+
+// KEY STRENGTHS (KRUMHANSL-SCHMUCKLER)
+// Correlations between the chroma vector and the 24 rotated key profiles:
+// indices 0-11 are the major keys from C to B, indices 12-23 the minor ones
+// A chroma vector with more than 12 bins is folded to semitones before the comparison
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+void key_strengths(const Container& chroma_vector, std::array<typename Container::value_type, 24>& strengths)
+{
+    using TSample = typename Container::value_type;
+
+    static constexpr TSample major_profile[12] = {6.35, 2.23, 3.48, 2.33, 4.38, 4.09, 2.52, 5.19, 2.39, 3.66, 2.29, 2.88};
+    static constexpr TSample minor_profile[12] = {6.33, 2.68, 3.52, 5.38, 2.60, 3.53, 2.54, 4.75, 3.98, 2.69, 3.34, 3.17};
+
+    strengths.fill(static_cast<TSample>(0.0));
+
+    const size_t chroma_bins = chroma_vector.size();
+
+    if (chroma_bins < 12u || chroma_bins % 12u)
+    {
+        return;
+    }
+
+    // Fold to semitones, sub-semitone bins are centered on their pitch class
+    const size_t resolution = chroma_bins / 12u;
+    TSample semitones[12] = {};
+    for (size_t c = 0; c < chroma_bins; c++)
+    {
+        semitones[((c + resolution / 2u) / resolution) % 12u] += chroma_vector[c];
+    }
+
+    const TSample chroma_mean = std::accumulate(semitones, semitones + 12, static_cast<TSample>(0.0)) / static_cast<TSample>(12.0);
+    const TSample major_mean = std::accumulate(major_profile, major_profile + 12, static_cast<TSample>(0.0)) / static_cast<TSample>(12.0);
+    const TSample minor_mean = std::accumulate(minor_profile, minor_profile + 12, static_cast<TSample>(0.0)) / static_cast<TSample>(12.0);
+
+    TSample chroma_var = static_cast<TSample>(0.0);
+    TSample major_var = static_cast<TSample>(0.0);
+    TSample minor_var = static_cast<TSample>(0.0);
+
+    for (auto p = 0u; p < 12u; p++)
+    {
+        chroma_var += (semitones[p] - chroma_mean) * (semitones[p] - chroma_mean);
+        major_var += (major_profile[p] - major_mean) * (major_profile[p] - major_mean);
+        minor_var += (minor_profile[p] - minor_mean) * (minor_profile[p] - minor_mean);
+    }
+
+    if (chroma_var <= std::numeric_limits<TSample>::epsilon())
+    {
+        return;
+    }
+
+    for (auto k = 0u; k < 12u; k++)
+    {
+        TSample major_cov = static_cast<TSample>(0.0);
+        TSample minor_cov = static_cast<TSample>(0.0);
+
+        for (auto p = 0u; p < 12u; p++)
+        {
+            const TSample c = semitones[(p + k) % 12u] - chroma_mean;
+            major_cov += c * (major_profile[p] - major_mean);
+            minor_cov += c * (minor_profile[p] - minor_mean);
+        }
+
+        strengths[k] = major_cov / std::sqrt(chroma_var * major_var);
+        strengths[k + 12u] = minor_cov / std::sqrt(chroma_var * minor_var);
+    }
+}
+
+// ESTIMATED KEY
+// Returns the index of the best matching key (see key_strengths) and, if requested,
+// its correlation in key_strength
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+typename Container::value_type key(const Container& chroma_vector, typename Container::value_type* key_strength = nullptr)
+{
+    using TSample = typename Container::value_type;
+
+    std::array<TSample, 24> strengths;
+    key_strengths(chroma_vector, strengths);
+
+    auto max_strength = std::max_element(strengths.begin(), strengths.end());
+
+    if (key_strength != nullptr)
+    {
+        *key_strength = *max_strength;
+    }
+
+    return static_cast<TSample>(std::distance(strengths.begin(), max_strength));
+}
+
+// SPECTRAL KURTOSIS
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+typename Container::value_type kurtosis(const Container& magnitudes,
+                                        typename Container::value_type sample_rate = static_cast<typename Container::value_type>(44100.0),
+                                        std::vector<typename Container::value_type>& precomputed_frequencies = {},
+                                        typename Container::value_type spectral_centroid = static_cast<typename Container::value_type>(-1.0),
+                                        typename Container::value_type spectral_spread = static_cast<typename Container::value_type>(-1.0),
+                                        unsigned int stft_size = 0u)
+{
+    using TSample = typename Container::value_type;
+
+    TSample skurtosis = static_cast<TSample>(0.0);
+    TSample scentroid = spectral_centroid;
+    TSample sspread = spectral_spread;
+
+    if (magnitudes.empty())
+    {
+        return skurtosis;
+    }
+
+    unsigned int fft_size = magnitudes.size();
+    unsigned int bins = stft_size > 0u ? stft_size : (fft_size - 1u) * 2u;
+
+    if (precomputed_frequencies.size() < bins / 2u + 1u)
+    {
+        precomputed_frequencies = precompute_frequencies(bins, sample_rate);
+    }
+
+    if (spectral_centroid < static_cast<TSample>(0.0))
+    {
+        scentroid = centroid(magnitudes, sample_rate, precomputed_frequencies);
+    }
+
+    if (spectral_spread < static_cast<TSample>(0.0))
+    {
+        sspread = spread(magnitudes, sample_rate, precomputed_frequencies, scentroid);
+    }
+
+    Accumulator<TSample> magn_sum;
+    Accumulator<TSample> numerator;
+
+    for (unsigned int k = 0u; k < fft_size; k++)
+    {
+        numerator += std::pow(precomputed_frequencies[k] - scentroid, static_cast<TSample>(4.0)) * std::abs(magnitudes[k]);
+        magn_sum += std::abs(magnitudes[k]);
+    }
+
+    if (magn_sum * sspread > static_cast<TSample>(0.0))
+    {
+        skurtosis = numerator / (magn_sum * std::pow(sspread, static_cast<TSample>(4.0)));
+        skurtosis -= static_cast<TSample>(3.0);
+    }
+
+    return skurtosis;
+}
+
+// SPECTRAL PEAK
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+typename Container::value_type peak(const Container& magnitudes,
+                                    typename Container::value_type sample_rate = static_cast<typename Container::value_type>(44100.0),
+                                    std::vector<typename Container::value_type>& precomputed_frequencies = {},
+                                    unsigned int stft_size = 0u)
+{
+    using TSample = typename Container::value_type;
+
+    TSample peak = static_cast<TSample>(0.0);
+
+    if (magnitudes.empty())
+    {
+        return peak;
+    }
+
+    unsigned int fft_size = magnitudes.size();
+    unsigned int bins = stft_size > 0u ? stft_size : (fft_size - 1u) * 2u;
+
+    if (precomputed_frequencies.size() < bins / 2u + 1u)
+    {
+        precomputed_frequencies = precompute_frequencies(bins, sample_rate);
+    }
+
+    unsigned int magn_max_idx = 0;
+    TSample magn_max = static_cast<TSample>(0.0);
+
+    for (unsigned int k = 0u; k < fft_size; k++)
+    {
+        if (std::abs(magnitudes[k]) > magn_max)
+        {
+            magn_max = std::abs(magnitudes[k]);
+            magn_max_idx = k;
+        }
+    }
+
+    return precomputed_frequencies[magn_max_idx];
+}
+
+// UTILITY STRUCTURE: sinusoidal peak of a spectrum, at the interpolated (fractional) bin
+template <typename TSample>
+struct SpectralPeak
+{
+    TSample frequency = static_cast<TSample>(0.0);
+    TSample magnitude = static_cast<TSample>(0.0);
+    TSample bin = static_cast<TSample>(0.0);
+};
+
+// SPECTRAL PEAKS (SINUSOIDAL COMPONENTS)
+// The max_peaks strongest local maxima, dropping those below threshold times the strongest one,
+// are written into spectral_peaks (which keeps its capacity) sorted by frequency. Frequency and
+// magnitude of each peak are refined with a parabola through the log magnitudes of the maximum and
+// its two neighbours. A single pass over the magnitudes keeps the candidates in a min-heap, the
+// rest of the work depends only on max_peaks.
+// Returns the energy of the spectrum (sum of the squared magnitudes), as needed by harmonics().
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+typename Container::value_type peaks(const Container& magnitudes, std::vector<SpectralPeak<typename Container::value_type>>& spectral_peaks,
+                                     const unsigned int& max_peaks = 20u,
+                                     typename Container::value_type threshold = static_cast<typename Container::value_type>(0.001),
+                                     typename Container::value_type sample_rate = static_cast<typename Container::value_type>(44100.0),
+                                     unsigned int stft_size = 0u)
+{
+    using TSample = typename Container::value_type;
+
+    spectral_peaks.clear();
+
+    if (magnitudes.size() < 3u || max_peaks == 0u)
+    {
+        return static_cast<TSample>(0.0);
+    }
+
+    unsigned int fft_size = magnitudes.size();
+    unsigned int bins = stft_size > 0u ? stft_size : (fft_size - 1u) * 2u;
+    const TSample bandwidth = sample_rate / static_cast<TSample>(bins);
+    const TSample log_floor = std::log(std::numeric_limits<TSample>::min());
+
+    const auto weaker = [](const SpectralPeak<TSample>& a, const SpectralPeak<TSample>& b)
+    {
+        return a.magnitude > b.magnitude;
+    };
+
+    Accumulator<TSample> energy;
+    TSample previous = std::abs(magnitudes[0]);
+    TSample current = std::abs(magnitudes[1]);
+    energy += previous * previous;
+
+    for (unsigned int k = 1u; k + 1u < fft_size; k++)
+    {
+        const TSample next = std::abs(magnitudes[k + 1u]);
+        energy += current * current;
+
+        if (current > previous && current >= next && (spectral_peaks.size() < max_peaks || current > spectral_peaks.front().magnitude))
+        {
+            // Parabola through the log magnitudes: vertex offset (within half a bin) and height
+            const TSample alpha = previous > static_cast<TSample>(0.0) ? std::log(previous) : log_floor;
+            const TSample beta = std::log(current);
+            const TSample gamma = next > static_cast<TSample>(0.0) ? std::log(next) : log_floor;
+            const TSample curvature = alpha - static_cast<TSample>(2.0) * beta + gamma;
+            const TSample offset = curvature < static_cast<TSample>(0.0) ? std::clamp(static_cast<TSample>(0.5) * (alpha - gamma) / curvature, static_cast<TSample>(-0.5), static_cast<TSample>(0.5)) : static_cast<TSample>(0.0);
+
+            SpectralPeak<TSample> peak;
+            peak.bin = static_cast<TSample>(k) + offset;
+            peak.frequency = peak.bin * bandwidth;
+            peak.magnitude = std::exp(beta - static_cast<TSample>(0.25) * (alpha - gamma) * offset);
+
+            if (spectral_peaks.size() == max_peaks)
+            {
+                std::pop_heap(spectral_peaks.begin(), spectral_peaks.end(), weaker);
+                spectral_peaks.back() = peak;
+            }
+            else
+            {
+                spectral_peaks.push_back(peak);
+            }
+
+            std::push_heap(spectral_peaks.begin(), spectral_peaks.end(), weaker);
+        }
+
+        previous = current;
+        current = next;
+    }
+
+    energy += current * current;
+
+    if (!spectral_peaks.empty())
+    {
+        TSample strongest = static_cast<TSample>(0.0);
+        for (const auto& p : spectral_peaks)
+        {
+            strongest = std::max(strongest, p.magnitude);
+        }
+
+        const TSample floor = threshold * strongest;
+        spectral_peaks.erase(std::remove_if(spectral_peaks.begin(), spectral_peaks.end(),
+                                            [floor](const SpectralPeak<TSample>& p) { return p.magnitude < floor; }),
+                             spectral_peaks.end());
+        std::sort(spectral_peaks.begin(), spectral_peaks.end(),
+                  [](const SpectralPeak<TSample>& a, const SpectralPeak<TSample>& b) { return a.bin < b.bin; });
+    }
+
+    return energy;
+}
+
+// UTILITY STRUCTURE: descriptors of the harmonics of a sound, see harmonics()
+template <typename TSample>
+struct HarmonicDescriptors
+{
+    // Energy weighted deviation of the partials from the multiples of f0, in [0, 1]
+    TSample inharmonicity = static_cast<TSample>(0.0);
+    // Energy of the odd harmonics (fundamental included) over that of the even ones
+    TSample odd_even_ratio = static_cast<TSample>(0.0);
+    // Amplitude of the fundamental, of the harmonics 2 to 4 and of the higher ones over the total
+    std::array<TSample, 3> tristimulus = {};
+    // Energy of the harmonics over the rest of the spectrum, in dB (between -100 and 100)
+    TSample harmonic_to_noise = static_cast<TSample>(0.0);
+    unsigned int harmonics = 0u;
+};
+
+// HARMONIC DESCRIPTORS
+// Harmonic h of f0 is the peak nearest to h * f0, if closer than a quarter of f0. The peaks must be
+// sorted by frequency, as written by peaks(), which also returns the energy of the spectrum. The
+// fundamental is first refined with a least squares fit of the matched peaks, so that a coarse
+// estimate (YIN, HPS) does not show up as inharmonicity. The energy of a harmonic is summed over its
+// main lobe (two bins on each side of the peak, as for the Hann window), so the magnitudes are read
+// only around the harmonics. Everything is 0 for an unvoiced frame (f0 not positive).
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+HarmonicDescriptors<typename Container::value_type> harmonics(const Container& magnitudes,
+                                                              const std::vector<SpectralPeak<typename Container::value_type>>& spectral_peaks,
+                                                              typename Container::value_type f0,
+                                                              typename Container::value_type energy,
+                                                              const unsigned int& max_harmonics = 20u)
+{
+    using TSample = typename Container::value_type;
+
+    HarmonicDescriptors<TSample> descriptors;
+
+    if (f0 <= static_cast<TSample>(0.0) || spectral_peaks.empty() || energy <= static_cast<TSample>(0.0))
+    {
+        return descriptors;
+    }
+
+    // Nearest peak to each harmonic within a quarter of f0, calling matched(h, peak) for each match.
+    // Peaks are sorted, so the nearest one is found moving forward only.
+    const auto match = [&spectral_peaks, &max_harmonics](const TSample& fundamental, auto&& matched)
+    {
+        const TSample tolerance = static_cast<TSample>(0.25) * fundamental;
+        size_t p = 0;
+
+        for (unsigned int h = 1u; h <= max_harmonics; h++)
+        {
+            const TSample target = static_cast<TSample>(h) * fundamental;
+
+            while (p + 1u < spectral_peaks.size() && std::abs(spectral_peaks[p + 1u].frequency - target) <= std::abs(spectral_peaks[p].frequency - target))
+            {
+                ++p;
+            }
+
+            if (std::abs(spectral_peaks[p].frequency - target) <= tolerance)
+            {
+                matched(h, spectral_peaks[p]);
+            }
+            else if (spectral_peaks[p].frequency < target && p + 1u == spectral_peaks.size())
+            {
+                break;
+            }
+        }
+    };
+
+    // f0 minimizing sum(a_h^2 * (f_h - h * f0)^2)
+    TSample fit_numerator = static_cast<TSample>(0.0);
+    TSample fit_denominator = static_cast<TSample>(0.0);
+    match(f0, [&](const unsigned int& h, const SpectralPeak<TSample>& peak)
+    {
+        const TSample a2 = peak.magnitude * peak.magnitude;
+        fit_numerator += static_cast<TSample>(h) * peak.frequency * a2;
+        fit_denominator += static_cast<TSample>(h * h) * a2;
+    });
+
+    if (fit_denominator > static_cast<TSample>(0.0))
+    {
+        f0 = fit_numerator / fit_denominator;
+    }
+
+    constexpr unsigned int lobe = 2u;
+    const unsigned int fft_size = magnitudes.size();
+    unsigned int summed_until = 0u;
+    TSample amplitude_sum = static_cast<TSample>(0.0);
+    TSample harmonic_energy = static_cast<TSample>(0.0);
+    TSample odd_energy = static_cast<TSample>(0.0);
+    TSample even_energy = static_cast<TSample>(0.0);
+    TSample deviation = static_cast<TSample>(0.0);
+    Accumulator<TSample> lobe_energy;
+
+    match(f0, [&](const unsigned int& h, const SpectralPeak<TSample>& peak)
+    {
+        const TSample a = peak.magnitude;
+        const TSample a2 = a * a;
+
+        descriptors.harmonics++;
+        amplitude_sum += a;
+        harmonic_energy += a2;
+        deviation += std::abs(peak.frequency - static_cast<TSample>(h) * f0) * a2;
+        (h % 2u == 1u ? odd_energy : even_energy) += a2;
+        descriptors.tristimulus[h == 1u ? 0u : (h <= 4u ? 1u : 2u)] += a;
+
+        const unsigned int center = static_cast<unsigned int>(peak.bin + static_cast<TSample>(0.5));
+        for (unsigned int k = std::max(center > lobe ? center - lobe : 0u, summed_until); k <= std::min(center + lobe, fft_size - 1u); k++)
+        {
+            lobe_energy += magnitudes[k] * magnitudes[k];
+            summed_until = k + 1u;
+        }
+    });
+
+    if (descriptors.harmonics == 0u)
+    {
+        descriptors.harmonic_to_noise = static_cast<TSample>(-100.0);
+
+        return descriptors;
+    }
+
+    descriptors.inharmonicity = std::min(static_cast<TSample>(2.0) * deviation / (f0 * harmonic_energy), static_cast<TSample>(1.0));
+    descriptors.odd_even_ratio = even_energy > static_cast<TSample>(0.0) ? odd_energy / even_energy : static_cast<TSample>(0.0);
+
+    for (auto& t : descriptors.tristimulus)
+    {
+        t /= amplitude_sum;
+    }
+
+    const TSample limit = static_cast<TSample>(1e-10) * energy;
+    const TSample harmonic = std::min(static_cast<TSample>(lobe_energy), energy);
+    descriptors.harmonic_to_noise = static_cast<TSample>(10.0) * std::log10(std::max(harmonic, limit) / std::max(energy - harmonic, limit));
+
+    return descriptors;
+}
+
+// CRITICAL BAND (BARK) ENERGIES
+// Sum of the squared magnitudes of each band of bark_map, written into band_energies
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+void bark_bands(const Container& magnitudes, const BarkMap<typename Container::value_type>& bark_map,
+                std::array<typename Container::value_type, BarkMap<typename Container::value_type>::bands>& band_energies)
+{
+    using TSample = typename Container::value_type;
+
+    const unsigned int fft_size = magnitudes.size();
+
+    for (unsigned int b = 0u; b < BarkMap<TSample>::bands; b++)
+    {
+        Accumulator<TSample> energy;
+        const unsigned int last = std::min(bark_map.first_bins[b + 1u], fft_size);
+
+        for (unsigned int k = bark_map.first_bins[b]; k < last; k++)
+        {
+            energy += magnitudes[k] * magnitudes[k];
+        }
+
+        band_energies[b] = energy;
+    }
+}
+
+// LOUDNESS (ZWICKER)
+// Specific loudness of each critical band (sone/bark), written into specific_loudness, and total
+// loudness (sone) returned. reference_energy is the band energy of a 0 dB SPL sound, to relate the
+// digital levels to the threshold in quiet of bark_map. The excitation is the band energy itself,
+// without the spreading of the masking between bands of the full Zwicker model (ISO 532-1), so
+// loud narrow band sounds read lower than with the standard.
+template <typename TSample>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+TSample loudness(const std::array<TSample, BarkMap<TSample>::bands>& band_energies, const BarkMap<TSample>& bark_map,
+                 const TSample& reference_energy, std::array<TSample, BarkMap<TSample>::bands>& specific_loudness)
+{
+    TSample total = static_cast<TSample>(0.0);
+
+    for (unsigned int b = 0u; b < BarkMap<TSample>::bands; b++)
+    {
+        // Threshold and excitation relative to 0 dB SPL
+        const TSample threshold = bark_map.threshold_energies[b];
+        const TSample excitation = reference_energy > static_cast<TSample>(0.0) ? band_energies[b] / reference_energy : static_cast<TSample>(0.0);
+        const TSample n = static_cast<TSample>(0.08) * std::pow(threshold, static_cast<TSample>(0.23)) *
+                          (std::pow(static_cast<TSample>(0.5) + static_cast<TSample>(0.5) * excitation / threshold, static_cast<TSample>(0.23)) - static_cast<TSample>(1.0));
+
+        specific_loudness[b] = std::max(n, static_cast<TSample>(0.0));
+        total += specific_loudness[b];
+    }
+
+    return total;
+}
+
+// SHARPNESS
+// Zwicker's sharpness (acum): centroid of the specific loudness on the bark scale, with the
+// weight of the bands above 15.8 bark growing exponentially
+template <typename TSample>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+TSample sharpness(const std::array<TSample, BarkMap<TSample>::bands>& specific_loudness)
+{
+    TSample weighted = static_cast<TSample>(0.0);
+    TSample total = static_cast<TSample>(0.0);
+
+    for (unsigned int b = 0u; b < BarkMap<TSample>::bands; b++)
+    {
+        const TSample z = static_cast<TSample>(b) + static_cast<TSample>(0.5);
+        const TSample g = z > static_cast<TSample>(15.8) ? static_cast<TSample>(0.066) * std::exp(static_cast<TSample>(0.171) * z) : static_cast<TSample>(1.0);
+        weighted += specific_loudness[b] * g * z;
+        total += specific_loudness[b];
+    }
+
+    return total > static_cast<TSample>(0.0) ? static_cast<TSample>(0.11) * weighted / total : static_cast<TSample>(0.0);
+}
+
+// ROUGHNESS (SETHARES)
+// Sum of the sensory dissonance of each pair of peaks (sorted by frequency, as written by peaks()),
+// with amplitudes relative to the strongest peak, so the result does not depend on the level. The
+// dissonance of a pair vanishes a few critical bandwidths apart: for each peak only the following
+// ones within that distance are visited, so the cost grows with the peaks in each critical band
+// rather than with all the pairs.
+template <typename TSample>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+TSample roughness(const std::vector<SpectralPeak<TSample>>& spectral_peaks)
+{
+    constexpr TSample b1 = static_cast<TSample>(3.5);
+    constexpr TSample b2 = static_cast<TSample>(5.75);
+    constexpr TSample d_max = static_cast<TSample>(0.24);
+    constexpr TSample s1 = static_cast<TSample>(0.0207);
+    constexpr TSample s2 = static_cast<TSample>(18.96);
+    // Beyond it the curve is below 0.5% of its maximum
+    constexpr TSample cutoff = static_cast<TSample>(2.0);
+
+    TSample strongest = static_cast<TSample>(0.0);
+    for (const auto& p : spectral_peaks)
+    {
+        strongest = std::max(strongest, p.magnitude);
+    }
+
+    if (strongest <= static_cast<TSample>(0.0))
+    {
+        return static_cast<TSample>(0.0);
+    }
+
+    const TSample inv_strongest = static_cast<TSample>(1.0) / strongest;
+    Accumulator<TSample> dissonance;
+
+    for (size_t i = 0; i < spectral_peaks.size(); i++)
+    {
+        const TSample s = d_max / (s1 * spectral_peaks[i].frequency + s2);
+
+        for (size_t j = i + 1u; j < spectral_peaks.size(); j++)
+        {
+            const TSample x = s * (spectral_peaks[j].frequency - spectral_peaks[i].frequency);
+
+            if (x > cutoff)
+            {
+                break;
+            }
+
+            const TSample a = std::min(spectral_peaks[i].magnitude, spectral_peaks[j].magnitude) * inv_strongest;
+            dissonance += a * (std::exp(-b1 * x) - std::exp(-b2 * x));
+        }
+    }
+
+    return dissonance;
+}
+
+// SPECTRAL ROLLOFF
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+typename Container::value_type rolloff(const Container& magnitudes,
+                                       typename Container::value_type sample_rate = static_cast<typename Container::value_type>(44100.0),
+                                       typename Container::value_type rolloff_point = static_cast<typename Container::value_type>(0.85),
+                                       std::vector<typename Container::value_type>& precomputed_frequencies = {},
+                                       unsigned int stft_size = 0u)
+{
+    using TSample = typename Container::value_type;
+
+    if (magnitudes.empty())
+    {
+        return static_cast<TSample>(0.0);
+    }
+
+    unsigned int fft_size = magnitudes.size();
+    unsigned int bins = stft_size > 0u ? stft_size : (fft_size - 1u) * 2u;
+
+    if (precomputed_frequencies.size() < bins / 2u + 1u)
+    {
+        precomputed_frequencies = precompute_frequencies(bins, sample_rate);
+    }
+
+    Accumulator<TSample> magn_sum;
+
+    for (unsigned int k = 0u; k < fft_size; k++)
+    {
+        magn_sum += std::abs(magnitudes[k]);
+    }
+
+    TSample rolloff_thresh = rolloff_point * magn_sum;
+    Accumulator<TSample> cumul_magn;
+    unsigned int rolloff_idx = fft_size - 1u;
+
+    for (unsigned int k = 0u; k < fft_size; k++)
+    {
+        cumul_magn += std::abs(magnitudes[k]);
+
+        if (cumul_magn >= rolloff_thresh)
+        {
+            rolloff_idx = k;
+            break;
+        }
+    }
+
+    return precomputed_frequencies[rolloff_idx];
+}
+
+// SPECTRAL SKEWNESS
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+typename Container::value_type skewness(const Container& magnitudes,
+                                        typename Container::value_type sample_rate = static_cast<typename Container::value_type>(44100.0),
+                                        std::vector<typename Container::value_type>& precomputed_frequencies = {},
+                                        typename Container::value_type spectral_centroid = static_cast<typename Container::value_type>(-1.0),
+                                        typename Container::value_type spectral_spread = static_cast<typename Container::value_type>(-1.0),
+                                        unsigned int stft_size = 0u)
+{
+    using TSample = typename Container::value_type;
+
+    TSample sskewness = static_cast<TSample>(0.0);
+    TSample scentroid = spectral_centroid;
+    TSample sspread = spectral_spread;
+
+    if (magnitudes.empty())
+    {
+        return sskewness;
+    }
+
+    unsigned int fft_size = magnitudes.size();
+    unsigned int bins = stft_size > 0u ? stft_size : (fft_size - 1u) * 2u;
+
+    if (precomputed_frequencies.size() < bins / 2u + 1u)
+    {
+        precomputed_frequencies = precompute_frequencies(bins, sample_rate);
+    }
+
+    if (spectral_centroid < static_cast<TSample>(0.0))
+    {
+        scentroid = centroid(magnitudes, sample_rate, precomputed_frequencies);
+    }
+
+    if (spectral_spread < static_cast<TSample>(0.0))
+    {
+        sspread = spread(magnitudes, sample_rate, precomputed_frequencies, scentroid);
+    }
+
+    Accumulator<TSample> magn_sum;
+    Accumulator<TSample> numerator;
+
+    for (unsigned int k = 0u; k < fft_size; k++)
+    {
+        numerator += std::pow(precomputed_frequencies[k] - scentroid, static_cast<TSample>(3.0)) * std::abs(magnitudes[k]);
+        magn_sum += std::abs(magnitudes[k]);
+    }
+
+    if (magn_sum * sspread > static_cast<TSample>(0.0))
+    {
+        sskewness = numerator / (magn_sum * std::pow(sspread, static_cast<TSample>(3.0)));
+    }
+
+    return sskewness;
+}
+
+// SPECTRAL SLOPE
+template <typename Container>
+#if __cplusplus >= 202002L
+requires std::floating_point<typename Container::value_type>
+#endif
+typename Container::value_type slope(const Container& magnitudes,
+                                     typename Container::value_type sample_rate = static_cast<typename Container::value_type>(44100.0),
+                                     std::vector<typename Container::value_type>& precomputed_frequencies = {},
+                                     unsigned int stft_size = 0u)
+{
+    using TSample = typename Container::value_type;
+
+    TSample sslope = static_cast<TSample>(0.0);
+
+    if (magnitudes.empty())
+    {
+        return sslope;
+    }
+
+    unsigned int fft_size = magnitudes.size();
+    unsigned int bins = stft_size > 0u ? stft_size : (fft_size - 1u) * 2u;
+
+    if (precomputed_frequencies.size() < bins / 2u + 1u)
+    {
+        precomputed_frequencies = precompute_frequencies(bins, sample_rate);
+    }
+
+    TSample mean_frequency = sum(precomputed_frequencies) / static_cast<TSample>(fft_size);
+    Accumulator<TSample> magn_sum_weighted;
+
+    for (unsigned int k = 0u; k < fft_size; k++)
+    {
+        magn_sum_weighted += std::abs(magnitudes[k]);
+    }
+
+    const TSample magn_mean = magn_sum_weighted / static_cast<TSample>(fft_size);
+
+    Accumulator<TSample> numerator;
+    Accumulator<TSample> denominator;
+
+    for (unsigned int k = 0u; k < fft_size; k++)
+    {
+        numerator += (precomputed_frequencies[k] - mean_frequency) * (std::abs(magnitudes[k]) - magn_mean);
+        denominator += std::pow(precomputed_frequencies[k] - mean_frequency, static_cast<TSample>(2.0));
+    }
+
+    if (denominator > static_cast<TSample>(0.0))
+    {
+        sslope = numerator / denominator;
+    }
+
+    return sslope;
+}
+
+} // namespace Informer::Frequency
+
+
+/* PITCH TRACKING */
+
+template <typename TSample>
+struct PitchEstimate
+{
+    TSample frequency = static_cast<TSample>(-1.0);
+    TSample voicing_probability = static_cast<TSample>(0.0);
+    bool voiced = false;
+};
+
+// Streaming pitch tracker: the probabilistic YIN candidates of each frame (optionally supported
+// by an HPS estimate) are decoded with an online Viterbi algorithm over a fixed pitch grid,
+// with voiced and unvoiced states. The decoding uses a fixed lag, so each call to process()
+// returns the estimate of the frame received latency frames before.
+// All the buffers are allocated when the parameters are set, not when a frame is processed.
+template <typename TSample>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+class PitchTracker
+{
+public:
+    PitchTracker(const TSample& sample_rate = static_cast<TSample>(44100.0),
+                 const TSample& min_frequency = static_cast<TSample>(60.0),
+                 const TSample& max_frequency = static_cast<TSample>(1200.0),
+                 const unsigned int& steps_per_semitone = 5u,
+                 const unsigned int& latency = 8u)
+    {
+        set_sample_rate(sample_rate);
+        set_range(min_frequency, max_frequency, steps_per_semitone);
+        set_latency(latency);
+    }
+
+    ~PitchTracker() = default;
+
+    bool set_sample_rate(const TSample& sample_rate)
+    {
+        if (sample_rate > static_cast<TSample>(0.0))
+        {
+            sample_rate_ = sample_rate;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    bool set_range(const TSample& min_frequency, const TSample& max_frequency, const unsigned int& steps_per_semitone = 5u)
+    {
+        if (min_frequency > static_cast<TSample>(0.0) && max_frequency > min_frequency && steps_per_semitone > 0u)
+        {
+            min_frequency_ = min_frequency;
+            max_frequency_ = max_frequency;
+            steps_per_semitone_ = steps_per_semitone;
+            pitch_states_ = static_cast<unsigned int>(std::floor(static_cast<TSample>(12u * steps_per_semitone_) *
+                                                      std::log2(max_frequency_ / min_frequency_))) + 1u;
+            allocate_();
+
+            return true;
+        }
+
+        return false;
+    }
+
+    bool set_latency(const unsigned int& latency)
+    {
+        latency_ = latency;
+        allocate_();
+
+        return true;
+    }
+
+    // Maximum pitch change between consecutive frames
+    bool set_max_jump(const TSample& semitones)
+    {
+        if (semitones > static_cast<TSample>(0.0))
+        {
+            max_jump_semitones_ = semitones;
+            allocate_();
+
+            return true;
+        }
+
+        return false;
+    }
+
+    // Probability of switching between voiced and unvoiced states between consecutive frames
+    bool set_switch_probability(const TSample& probability)
+    {
+        if (probability > static_cast<TSample>(0.0) && probability < static_cast<TSample>(1.0))
+        {
+            switch_probability_ = probability;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    // How much the YIN candidates that agree (within a semitone) with the HPS estimate are favored
+    bool set_hps_weight(const TSample& weight)
+    {
+        if (weight >= static_cast<TSample>(0.0))
+        {
+            hps_weight_ = weight;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    void reset()
+    {
+        std::fill(delta_.begin(), delta_.end(), static_cast<TSample>(0.0));
+        frames_ = 0u;
+    }
+
+    TSample get_sample_rate() const
+    {
+        return sample_rate_;
+    }
+
+    unsigned int get_latency() const
+    {
+        return latency_;
+    }
+
+    unsigned int get_pitch_states() const
+    {
+        return pitch_states_;
+    }
+
+    TSample get_state_frequency(const unsigned int& state) const
+    {
+        return min_frequency_ * std::pow(static_cast<TSample>(2.0), static_cast<TSample>(state) / static_cast<TSample>(12u * steps_per_semitone_));
+    }
+
+    // Candidates of the last processed frame
+    const std::vector<Amplitude::PitchCandidate<TSample>>& get_candidates() const
+    {
+        return candidates_.at(last_slot_);
+    }
+
+    // Process a new audio frame (hps_f0 <= 0 means no HPS estimate is available)
+    template <typename Container>
+    PitchEstimate<TSample> process(const Container& buffer, const TSample& hps_f0 = static_cast<TSample>(-1.0))
+    {
+        Amplitude::yin_difference(buffer, yin_buffer_);
+
+        return process_difference(yin_buffer_, hps_f0);
+    }
+
+    // Process a cumulative mean normalized difference already computed for the current frame
+    PitchEstimate<TSample> process_difference(const std::vector<TSample>& yin_buffer, const TSample& hps_f0 = static_cast<TSample>(-1.0))
+    {
+        const unsigned int slot = frames_ % (latency_ + 1u);
+        auto& candidates = candidates_.at(slot);
+
+        size_t min_tau = static_cast<size_t>(std::floor(sample_rate_ / max_frequency_));
+        size_t max_tau = static_cast<size_t>(std::ceil(sample_rate_ / min_frequency_));
+        Amplitude::yin_candidates(yin_buffer, sample_rate_, candidates, min_tau, max_tau, max_candidates_);
+
+        TSample voicing = static_cast<TSample>(0.0);
+        for (const auto &c : candidates)
+        {
+            voicing += c.probability;
+        }
+
+        if (hps_f0 > static_cast<TSample>(0.0) && hps_weight_ > static_cast<TSample>(0.0) && voicing > static_cast<TSample>(0.0))
+        {
+            TSample boosted = static_cast<TSample>(0.0);
+            for (auto &c : candidates)
+            {
+                if (c.frequency > static_cast<TSample>(0.0) &&
+                    std::abs(static_cast<TSample>(12.0) * std::log2(c.frequency / hps_f0)) < static_cast<TSample>(1.0))
+                {
+                    c.probability *= static_cast<TSample>(1.0) + hps_weight_;
+                }
+                boosted += c.probability;
+            }
+            // The HPS estimate reshapes the candidates, but does not change the voicing probability
+            for (auto &c : candidates)
+            {
+                c.probability *= voicing / boosted;
+            }
+        }
+
+        voicing = std::min(voicing, static_cast<TSample>(1.0));
+        voicings_.at(slot) = voicing;
+
+        // Observation probabilities
+        const unsigned int states = pitch_states_;
+        std::fill(emissions_.begin(), emissions_.begin() + states, static_cast<TSample>(0.0));
+        for (const auto &c : candidates)
+        {
+            if (c.frequency >= min_frequency_ && c.frequency <= max_frequency_)
+            {
+                unsigned int state = frequency_to_state_(c.frequency);
+                emissions_[state] += c.probability;
+            }
+        }
+
+        const TSample floor_probability = static_cast<TSample>(1e-9);
+        const TSample unvoiced_log = std::log(std::max((static_cast<TSample>(1.0) - voicing) / static_cast<TSample>(states), floor_probability));
+        for (auto m = 0u; m < states; m++)
+        {
+            emissions_[m] = std::log(std::max(emissions_[m], floor_probability));
+        }
+
+        // Viterbi step, limited to a band of jump_ states around each pitch
+        auto& backpointers = backpointers_.at(slot);
+        const TSample stay_log = std::log(static_cast<TSample>(1.0) - switch_probability_);
+        const TSample switch_log = std::log(switch_probability_);
+
+        if (frames_ == 0u)
+        {
+            for (auto m = 0u; m < states; m++)
+            {
+                next_delta_[m] = emissions_[m];
+                next_delta_[m + states] = unvoiced_log;
+                backpointers[m] = m;
+                backpointers[m + states] = m + states;
+            }
+        }
+        else
+        {
+            for (auto m = 0u; m < states; m++)
+            {
+                TSample best_voiced = -std::numeric_limits<TSample>::infinity();
+                TSample best_unvoiced = -std::numeric_limits<TSample>::infinity();
+                unsigned int arg_voiced = m;
+                unsigned int arg_unvoiced = m + states;
+
+                const unsigned int first = m > jump_ ? m - jump_ : 0u;
+                const unsigned int last = std::min(m + jump_, states - 1u);
+
+                for (auto p = first; p <= last; p++)
+                {
+                    const unsigned int distance = p > m ? p - m : m - p;
+                    const TSample transition = jump_log_[distance];
+
+                    const TSample from_voiced = delta_[p] + transition;
+                    const TSample from_unvoiced = delta_[p + states] + transition;
+
+                    if (from_voiced + stay_log > best_voiced)
+                    {
+                        best_voiced = from_voiced + stay_log;
+                        arg_voiced = p;
+                    }
+                    if (from_unvoiced + switch_log > best_voiced)
+                    {
+                        best_voiced = from_unvoiced + switch_log;
+                        arg_voiced = p + states;
+                    }
+                    if (from_unvoiced + stay_log > best_unvoiced)
+                    {
+                        best_unvoiced = from_unvoiced + stay_log;
+                        arg_unvoiced = p + states;
+                    }
+                    if (from_voiced + switch_log > best_unvoiced)
+                    {
+                        best_unvoiced = from_voiced + switch_log;
+                        arg_unvoiced = p;
+                    }
+                }
+
+                next_delta_[m] = best_voiced + emissions_[m];
+                next_delta_[m + states] = best_unvoiced + unvoiced_log;
+                backpointers[m] = arg_voiced;
+                backpointers[m + states] = arg_unvoiced;
+            }
+        }
+
+        // Keep the log probabilities in range
+        const TSample delta_max = *std::max_element(next_delta_.begin(), next_delta_.end());
+        unsigned int state = 0u;
+        for (auto s = 0u; s < 2u * states; s++)
+        {
+            delta_[s] = next_delta_[s] - delta_max;
+            if (delta_[s] == static_cast<TSample>(0.0))
+            {
+                state = s;
+            }
+        }
+
+        last_slot_ = slot;
+        ++frames_;
+
+        // Trace back to the frame latency_ frames ago (or to the first one)
+        const unsigned int steps = std::min(latency_, frames_ - 1u);
+        unsigned int current = slot;
+        for (auto s = 0u; s < steps; s++)
+        {
+            state = backpointers_.at(current)[state];
+            current = current == 0u ? latency_ : current - 1u;
+        }
+
+        PitchEstimate<TSample> estimate;
+
+        if (frames_ <= latency_)
+        {
+            return estimate;
+        }
+
+        estimate.voicing_probability = voicings_.at(current);
+        estimate.voiced = state < states;
+
+        const TSample grid_frequency = get_state_frequency(state % states);
+        estimate.frequency = estimate.voiced ? grid_frequency : -grid_frequency;
+
+        // Refine with the closest candidate of the decoded frame, if it falls inside the same grid step
+        for (const auto &c : candidates_.at(current))
+        {
+            if (c.frequency > static_cast<TSample>(0.0) &&
+                std::abs(static_cast<TSample>(12u * steps_per_semitone_) * std::log2(c.frequency / grid_frequency)) <= static_cast<TSample>(0.5))
+            {
+                estimate.frequency = estimate.voiced ? c.frequency : -c.frequency;
+                break;
+            }
+        }
+
+        return estimate;
+    }
+
+private:
+    TSample sample_rate_ = static_cast<TSample>(44100.0);
+    TSample min_frequency_ = static_cast<TSample>(60.0);
+    TSample max_frequency_ = static_cast<TSample>(1200.0);
+    TSample max_jump_semitones_ = static_cast<TSample>(2.0);
+    TSample switch_probability_ = static_cast<TSample>(0.01);
+    TSample hps_weight_ = static_cast<TSample>(1.0);
+    unsigned int steps_per_semitone_ = 5u;
+    unsigned int pitch_states_ = 0u;
+    unsigned int latency_ = 8u;
+    unsigned int jump_ = 10u;
+    unsigned int frames_ = 0u;
+    unsigned int last_slot_ = 0u;
+    size_t max_candidates_ = 32u;
+
+    std::vector<TSample> yin_buffer_ = {};
+    std::vector<TSample> emissions_ = {};
+    std::vector<TSample> delta_ = {};
+    std::vector<TSample> next_delta_ = {};
+    std::vector<TSample> jump_log_ = {};
+    std::vector<TSample> voicings_ = {};
+    std::vector<std::vector<unsigned int>> backpointers_ = {};
+    std::vector<std::vector<Amplitude::PitchCandidate<TSample>>> candidates_ = {};
+
+    inline unsigned int frequency_to_state_(const TSample& frequency) const
+    {
+        TSample position = static_cast<TSample>(12u * steps_per_semitone_) * std::log2(frequency / min_frequency_);
+        unsigned int state = static_cast<unsigned int>(std::max(std::round(position), static_cast<TSample>(0.0)));
+
+        return std::min(state, pitch_states_ - 1u);
+    }
+
+    inline void allocate_()
+    {
+        if (pitch_states_ == 0u)
+        {
+            return;
+        }
+
+        jump_ = std::max(1u, static_cast<unsigned int>(std::round(max_jump_semitones_ * static_cast<TSample>(steps_per_semitone_))));
+
+        // Triangular pitch transition weights, normalized over the band
+        jump_log_.assign(jump_ + 1u, static_cast<TSample>(0.0));
+        TSample total = static_cast<TSample>(0.0);
+        for (auto d = 0u; d <= jump_; d++)
+        {
+            jump_log_[d] = static_cast<TSample>(jump_ + 1u - d);
+            total += d == 0u ? jump_log_[d] : static_cast<TSample>(2.0) * jump_log_[d];
+        }
+        for (auto &j : jump_log_)
+        {
+            j = std::log(j / total);
+        }
+
+        emissions_.assign(pitch_states_, static_cast<TSample>(0.0));
+        delta_.assign(2u * pitch_states_, static_cast<TSample>(0.0));
+        next_delta_.assign(2u * pitch_states_, static_cast<TSample>(0.0));
+        voicings_.assign(latency_ + 1u, static_cast<TSample>(0.0));
+        backpointers_.assign(latency_ + 1u, std::vector<unsigned int>(2u * pitch_states_, 0u));
+        candidates_.resize(latency_ + 1u);
+        for (auto &c : candidates_)
+        {
+            c.clear();
+            c.reserve(max_candidates_ + 1u);
+        }
+        last_slot_ = 0u;
+        frames_ = 0u;
+    }
+};
+
+
+/* SPECTRAL HISTORY */
+
+// Fixed capacity ring of the last spectra, the newest (current) one first. A new spectrum is
+// copied (or swapped, see push()) into the slot of the oldest one and the ring only moves its
+// head, so no vector is copied or reallocated once the size is stable. With the statistics
+// enabled, per bin sums and the energy weighted age of the frames are updated incrementally, so
+// that multi-frame descriptors (stationarity, temporal centroid, average spectrum) cost O(bins)
+// or less per frame; otherwise they are computed from the frames when requested.
+// Frames not received yet are zeros and are not counted by the statistics.
+template <typename TSample>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+class MagnitudeHistory
+{
+public:
+    MagnitudeHistory(const size_t& capacity = 2u, const bool& statistics = true) : statistics_(statistics)
+    {
+        set_capacity(capacity);
+    }
+
+    ~MagnitudeHistory() = default;
+
+    // At least two frames (the current and the previous one), clears the history
+    bool set_capacity(const size_t& capacity)
+    {
+        if (capacity < 2u)
+        {
+            return false;
+        }
+
+        capacity_ = capacity;
+        slots_.assign(capacity_, std::vector<TSample>(bins_, static_cast<TSample>(0.0)));
+        energies_.assign(capacity_, static_cast<TSample>(0.0));
+        clear();
+
+        return true;
+    }
+
+    // Incremental statistics, worth it when stationarity(), temporal_centroid() or mean()
+    // are called on most frames
+    void set_statistics(const bool& enable)
+    {
+        if (enable && !statistics_)
+        {
+            statistics_ = true;
+            resum_();
+        }
+
+        statistics_ = enable;
+    }
+
+    void clear()
+    {
+        for (auto& slot : slots_)
+        {
+            std::fill(slot.begin(), slot.end(), static_cast<TSample>(0.0));
+        }
+
+        std::fill(energies_.begin(), energies_.end(), static_cast<TSample>(0.0));
+        sum_.assign(bins_, static_cast<TSample>(0.0));
+        square_sum_.assign(bins_, static_cast<TSample>(0.0));
+        energy_sum_ = static_cast<TSample>(0.0);
+        weighted_energy_ = static_cast<TSample>(0.0);
+        head_ = 0u;
+        frames_ = 0u;
+        pushes_ = 0u;
+    }
+
+    // Copy a new spectrum over the oldest one, which becomes the current one.
+    // A spectrum of a different size clears the history.
+    void push(const TSample* magnitudes, const size_t& size)
+    {
+        std::vector<TSample>& slot = evict_(size);
+        add_statistics_(slot, magnitudes);
+        std::copy(magnitudes, magnitudes + bins_, slot.begin());
+        pushed_();
+    }
+
+    // Same as above, swapping the vector with the slot of the oldest frame instead of copying
+    // it (magnitudes is left with the storage of the evicted frame)
+    void push(std::vector<TSample>&& magnitudes)
+    {
+        std::vector<TSample>& slot = evict_(magnitudes.size());
+        add_statistics_(slot, magnitudes.data());
+        slot.swap(magnitudes);
+        pushed_();
+    }
+
+    // Push a frame of zeros without reading any spectrum, e.g. for a silent frame
+    void push_silence()
+    {
+        std::vector<TSample>& slot = evict_(bins_);
+
+        if (statistics_)
+        {
+            for (size_t k = 0; k < bins_; k++)
+            {
+                const TSample old_m = std::abs(slot[k]);
+                sum_[k] -= old_m;
+                square_sum_[k] -= old_m * old_m;
+            }
+
+            energies_[head_] = static_cast<TSample>(0.0);
+        }
+
+        std::fill(slot.begin(), slot.end(), static_cast<TSample>(0.0));
+        pushed_();
+    }
+
+    // Overwrite the frame of the given age (0 is the current one), of the same size
+    bool replace(const size_t& age, const TSample* magnitudes, const size_t& size)
+    {
+        if (age >= capacity_ || size != bins_)
+        {
+            return false;
+        }
+
+        frames_ = std::max(frames_, age + 1u);
+        std::vector<TSample>& slot = slots_[slot_index_(age)];
+        std::copy(magnitudes, magnitudes + size, slot.begin());
+
+        if (statistics_)
+        {
+            resum_();
+        }
+
+        return true;
+    }
+
+    // Frame of the given age, 0 for the current one, up to capacity - 1
+    const std::vector<TSample>& frame(const size_t& age) const
+    {
+        return slots_[slot_index_(std::min(age, capacity_ - 1u))];
+    }
+
+    const std::vector<TSample>& current() const
+    {
+        return slots_[head_];
+    }
+
+    size_t capacity() const
+    {
+        return capacity_;
+    }
+
+    // Frames received, up to the capacity
+    size_t frames() const
+    {
+        return frames_;
+    }
+
+    size_t bins() const
+    {
+        return bins_;
+    }
+
+    bool get_statistics() const
+    {
+        return statistics_;
+    }
+
+    // Spectral flux of the current frame against the frame of the given age
+    // (Frequency::flux(), with the same accumulation)
+    TSample flux(const size_t& age = 1u) const
+    {
+        return Frequency::flux(current(), frame(age));
+    }
+
+    // Average of the magnitudes of the frames received (a smoothed spectrum)
+    void mean(std::vector<TSample>& average) const
+    {
+        average.resize(bins_);
+        const TSample inv_frames = frames_ > 0u ? static_cast<TSample>(1.0) / static_cast<TSample>(frames_) : static_cast<TSample>(0.0);
+        TSample square_sum = static_cast<TSample>(0.0);
+
+        for (size_t k = 0; k < bins_; k++)
+        {
+            average[k] = (statistics_ ? sum_[k] : bin_sums_(k, square_sum)) * inv_frames;
+        }
+    }
+
+    // Energy of the average spectrum over the average energy of the frames: 1 when all
+    // the frames are equal, lower the more the magnitudes fluctuate from frame to frame
+    TSample stationarity() const
+    {
+        TSample mean_energy = static_cast<TSample>(0.0);
+        TSample energy = static_cast<TSample>(0.0);
+
+        for (size_t k = 0; k < bins_; k++)
+        {
+            TSample square_sum = statistics_ ? square_sum_[k] : static_cast<TSample>(0.0);
+            const TSample sum = statistics_ ? sum_[k] : bin_sums_(k, square_sum);
+            mean_energy += sum * sum;
+            energy += square_sum;
+        }
+
+        if (frames_ == 0u || energy <= static_cast<TSample>(0.0))
+        {
+            return static_cast<TSample>(1.0);
+        }
+
+        return std::clamp(mean_energy / (static_cast<TSample>(frames_) * energy), static_cast<TSample>(0.0), static_cast<TSample>(1.0));
+    }
+
+    // Energy weighted mean age of the frames, in frames before the current one
+    TSample temporal_centroid() const
+    {
+        TSample energy_sum = energy_sum_;
+        TSample weighted_energy = weighted_energy_;
+
+        if (!statistics_)
+        {
+            energy_sum = static_cast<TSample>(0.0);
+            weighted_energy = static_cast<TSample>(0.0);
+
+            for (size_t age = 0; age < frames_; age++)
+            {
+                TSample energy = static_cast<TSample>(0.0);
+
+                for (const auto& m : slots_[slot_index_(age)])
+                {
+                    energy += m * m;
+                }
+
+                energy_sum += energy;
+                weighted_energy += static_cast<TSample>(age) * energy;
+            }
+        }
+
+        return energy_sum > static_cast<TSample>(0.0) ? std::max(weighted_energy / energy_sum, static_cast<TSample>(0.0)) : static_cast<TSample>(0.0);
+    }
+
+private:
+    std::vector<std::vector<TSample>> slots_ = {};
+    std::vector<TSample> energies_ = {};
+    std::vector<TSample> sum_ = {};
+    std::vector<TSample> square_sum_ = {};
+    TSample energy_sum_ = static_cast<TSample>(0.0);
+    TSample weighted_energy_ = static_cast<TSample>(0.0);
+    size_t capacity_ = 2u;
+    size_t bins_ = 0u;
+    size_t head_ = 0u;
+    size_t frames_ = 0u;
+    size_t pushes_ = 0u;
+    bool statistics_ = true;
+
+    inline size_t slot_index_(const size_t& age) const
+    {
+        return (head_ + age) % capacity_;
+    }
+
+    // Move the head to the slot of the oldest frame and return it
+    std::vector<TSample>& evict_(const size_t& size)
+    {
+        if (size != bins_)
+        {
+            bins_ = size;
+            set_capacity(capacity_);
+        }
+
+        head_ = head_ == 0u ? capacity_ - 1u : head_ - 1u;
+
+        if (statistics_)
+        {
+            // The evicted frame would get age capacity, the others one more than before
+            const TSample evicted_energy = energies_[head_];
+            weighted_energy_ += energy_sum_ - static_cast<TSample>(capacity_) * evicted_energy;
+            energy_sum_ -= evicted_energy;
+        }
+
+        return slots_[head_];
+    }
+
+    // Replace the evicted frame (still in slot) with the new one in the running sums
+    inline void add_statistics_(const std::vector<TSample>& slot, const TSample* magnitudes)
+    {
+        if (!statistics_)
+        {
+            return;
+        }
+
+        TSample energy = static_cast<TSample>(0.0);
+
+        for (size_t k = 0; k < bins_; k++)
+        {
+            const TSample old_m = std::abs(slot[k]);
+            const TSample m = std::abs(magnitudes[k]);
+            sum_[k] += m - old_m;
+            square_sum_[k] += m * m - old_m * old_m;
+            energy += m * m;
+        }
+
+        energies_[head_] = energy;
+        energy_sum_ += energy;
+    }
+
+    inline void pushed_()
+    {
+        frames_ = std::min(frames_ + 1u, capacity_);
+
+        // Recompute the running sums from time to time, so that rounding errors do not accumulate
+        if (statistics_ && ++pushes_ % 256u == 0u)
+        {
+            resum_();
+        }
+    }
+
+    // Sum and sum of squares of the magnitudes of a bin over the frames received
+    inline TSample bin_sums_(const size_t& k, TSample& square_sum) const
+    {
+        TSample sum = static_cast<TSample>(0.0);
+        square_sum = static_cast<TSample>(0.0);
+
+        for (size_t age = 0; age < frames_; age++)
+        {
+            const TSample m = std::abs(slots_[slot_index_(age)][k]);
+            sum += m;
+            square_sum += m * m;
+        }
+
+        return sum;
+    }
+
+    inline void resum_()
+    {
+        sum_.assign(bins_, static_cast<TSample>(0.0));
+        square_sum_.assign(bins_, static_cast<TSample>(0.0));
+        std::fill(energies_.begin(), energies_.end(), static_cast<TSample>(0.0));
+        energy_sum_ = static_cast<TSample>(0.0);
+        weighted_energy_ = static_cast<TSample>(0.0);
+
+        for (size_t age = 0; age < frames_; age++)
+        {
+            const std::vector<TSample>& slot = slots_[slot_index_(age)];
+            TSample energy = static_cast<TSample>(0.0);
+
+            for (size_t k = 0; k < bins_; k++)
+            {
+                const TSample m = std::abs(slot[k]);
+                sum_[k] += m;
+                square_sum_[k] += m * m;
+                energy += m * m;
+            }
+
+            energies_[slot_index_(age)] = energy;
+            energy_sum_ += energy;
+            weighted_energy_ += static_cast<TSample>(age) * energy;
+        }
+    }
+};
+
+} // namespace Informer
+
+#include "informer_hpss.h"
+
+namespace Informer
+{
+
+/* PARTIAL TRACKING */
+
+// Sinusoidal partial: a spectral peak followed across frames. The id stays the same as long as
+// the partial is found again in the next frame; age counts the frames it has been followed for.
+template <typename TSample>
+struct Partial
+{
+    TSample frequency = static_cast<TSample>(0.0);
+    TSample magnitude = static_cast<TSample>(0.0);
+    unsigned int id = 0u;
+    unsigned int age = 0u;
+};
+
+// Frame to frame continuation of the peaks of Frequency::peaks() (McAulay-Quatieri like): a peak
+// continues the partial of the previous frame nearest in frequency, if within max_deviation (a
+// fraction of the frequency) and if no other peak is nearer to that partial; the others start new
+// partials. Both lists are sorted by frequency, so the matching costs O(peaks), and the buffers
+// are allocated only when max_partials changes.
+template <typename TSample>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+class PartialTracker
+{
+public:
+    PartialTracker(const size_t& max_partials = 20u, const TSample& max_deviation = static_cast<TSample>(0.03))
+    {
+        set_max_partials(max_partials);
+        set_max_deviation(max_deviation);
+    }
+
+    ~PartialTracker() = default;
+
+    bool set_max_partials(const size_t& max_partials)
+    {
+        if (max_partials < 1u)
+        {
+            return false;
+        }
+
+        max_partials_ = max_partials;
+        partials_.reserve(max_partials_);
+        previous_.reserve(max_partials_);
+        nearest_.reserve(max_partials_);
+        claims_.reserve(max_partials_);
+
+        return true;
+    }
+
+    // Largest relative frequency change of a partial between two frames (0.03 is about half a semitone)
+    bool set_max_deviation(const TSample& max_deviation)
+    {
+        if (max_deviation <= static_cast<TSample>(0.0))
+        {
+            return false;
+        }
+
+        max_deviation_ = max_deviation;
+
+        return true;
+    }
+
+    void reset()
+    {
+        partials_.clear();
+        previous_.clear();
+        next_id_ = 0u;
+    }
+
+    // Peaks sorted by frequency, only the first max_partials are used
+    const std::vector<Partial<TSample>>& update(const std::vector<Frequency::SpectralPeak<TSample>>& spectral_peaks)
+    {
+        INFORMER_PROFILE_SCOPE("partial_tracking");
+
+        std::swap(previous_, partials_);
+        partials_.clear();
+
+        const size_t count = std::min(spectral_peaks.size(), max_partials_);
+        const size_t none = previous_.size();
+        nearest_.assign(count, none);
+        claims_.assign(previous_.size(), count);
+
+        // Nearest previous partial of each peak, then the nearest peak claiming each partial
+        size_t j = 0;
+        for (size_t i = 0; i < count && !previous_.empty(); i++)
+        {
+            const TSample f = spectral_peaks[i].frequency;
+
+            while (j + 1u < previous_.size() && std::abs(previous_[j + 1u].frequency - f) <= std::abs(previous_[j].frequency - f))
+            {
+                ++j;
+            }
+
+            if (std::abs(previous_[j].frequency - f) <= max_deviation_ * f)
+            {
+                nearest_[i] = j;
+
+                if (claims_[j] == count || std::abs(spectral_peaks[claims_[j]].frequency - previous_[j].frequency) > std::abs(f - previous_[j].frequency))
+                {
+                    claims_[j] = i;
+                }
+            }
+        }
+
+        for (size_t i = 0; i < count; i++)
+        {
+            Partial<TSample> partial;
+            partial.frequency = spectral_peaks[i].frequency;
+            partial.magnitude = spectral_peaks[i].magnitude;
+
+            if (nearest_[i] != none && claims_[nearest_[i]] == i)
+            {
+                partial.id = previous_[nearest_[i]].id;
+                partial.age = previous_[nearest_[i]].age + 1u;
+            }
+            else
+            {
+                partial.id = next_id_++;
+            }
+
+            partials_.push_back(partial);
+        }
+
+        return partials_;
+    }
+
+    const std::vector<Partial<TSample>>& get_partials() const
+    {
+        return partials_;
+    }
+
+    size_t get_max_partials() const
+    {
+        return max_partials_;
+    }
+
+    TSample get_max_deviation() const
+    {
+        return max_deviation_;
+    }
+
+private:
+    std::vector<Partial<TSample>> partials_ = {};
+    std::vector<Partial<TSample>> previous_ = {};
+    std::vector<size_t> nearest_ = {};
+    std::vector<size_t> claims_ = {};
+    size_t max_partials_ = 20u;
+    TSample max_deviation_ = static_cast<TSample>(0.03);
+    unsigned int next_id_ = 0u;
+};
+
+} // namespace Informer
+
+#include "informer_tempo.h"
+#include "informer_gate.h"
+
+namespace Informer
+{
+
+/* NORMALIZATION */
+
+// Mapping of the descriptors to the [0, 1] range, driven by a table with one rule per
+// descriptor:
+// - Static: clamp((x + offset) * scale, low, high), the scale being divided by a unit that
+//   depends on the analysis (Nyquist frequency, half frame size or history length);
+// - RunningMinMax: position of x between a minimum and a maximum that follow the signal,
+//   relaxing towards it by 1 - decay each frame;
+// - RunningZScore: 0.5 + z / (2 * range), clamped, with z from an exponentially weighted
+//   mean and variance (time constant of 1 / (1 - decay) frames).
+// The default tables hold the heuristic ranges shared by all the front ends, some of them
+// are guesses: use the results for artistic purposes.
+enum class NormalizationMode : unsigned char
+{
+    None = 0,
+    Static,
+    RunningMinMax,
+    RunningZScore
+};
+
+enum class NormalizationUnit : unsigned char
+{
+    One = 0,
+    Nyquist,
+    HalfFrame,
+    HistoryLength
+};
+
+template <typename TSample>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+struct NormalizationRule
+{
+    NormalizationMode mode = NormalizationMode::None;
+    TSample offset = static_cast<TSample>(0.0);
+    TSample scale = static_cast<TSample>(1.0);
+    NormalizationUnit unit = NormalizationUnit::One;
+    TSample low = -std::numeric_limits<TSample>::infinity();
+    TSample high = std::numeric_limits<TSample>::infinity();
+    TSample decay = static_cast<TSample>(0.99);
+    TSample range = static_cast<TSample>(3.0);
+};
+
+// Static rule, clamped to [0, 1] unless clamped is false
+template <typename TSample>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+constexpr NormalizationRule<TSample> static_normalization(const TSample& offset, const TSample& scale,
+                                                          const NormalizationUnit& unit = NormalizationUnit::One,
+                                                          const bool& clamped = true)
+{
+    NormalizationRule<TSample> rule;
+    rule.mode = NormalizationMode::Static;
+    rule.offset = offset;
+    rule.scale = scale;
+    rule.unit = unit;
+
+    if (clamped)
+    {
+        rule.low = static_cast<TSample>(0.0);
+        rule.high = static_cast<TSample>(1.0);
+    }
+
+    return rule;
+}
+
+// Default rules, in the order of TimeDescriptor
+template <typename TSample>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+constexpr std::array<NormalizationRule<TSample>, static_cast<size_t>(TimeDescriptor::Count)> time_normalization_rules()
+{
+    std::array<NormalizationRule<TSample>, static_cast<size_t>(TimeDescriptor::Count)> rules = {};
+
+    rules[static_cast<size_t>(TimeDescriptor::Kurtosis)] = static_normalization(static_cast<TSample>(2.0), static_cast<TSample>(0.25));
+    rules[static_cast<size_t>(TimeDescriptor::Skewness)] = static_normalization(static_cast<TSample>(5.0), static_cast<TSample>(0.1));
+
+    return rules;
+}
+
+// Default rules, in the order of FrequencyDescriptor
+template <typename TSample>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+constexpr std::array<NormalizationRule<TSample>, static_cast<size_t>(FrequencyDescriptor::Count)> frequency_normalization_rules()
+{
+    std::array<NormalizationRule<TSample>, static_cast<size_t>(FrequencyDescriptor::Count)> rules = {};
+    const TSample zero = static_cast<TSample>(0.0);
+    const TSample one = static_cast<TSample>(1.0);
+
+    rules[static_cast<size_t>(FrequencyDescriptor::Centroid)] = static_normalization(zero, one, NormalizationUnit::Nyquist, false);
+    rules[static_cast<size_t>(FrequencyDescriptor::Spread)] = static_normalization(zero, static_cast<TSample>(0.5), NormalizationUnit::Nyquist, false);
+    rules[static_cast<size_t>(FrequencyDescriptor::Decrease)] = static_normalization(static_cast<TSample>(0.05), static_cast<TSample>(10.0));
+    rules[static_cast<size_t>(FrequencyDescriptor::Flux)] = static_normalization(zero, one, NormalizationUnit::HalfFrame);
+    rules[static_cast<size_t>(FrequencyDescriptor::Irregularity)] = static_normalization(zero, static_cast<TSample>(0.5));
+    rules[static_cast<size_t>(FrequencyDescriptor::Kurtosis)] = static_normalization(static_cast<TSample>(2.0), static_cast<TSample>(0.025));
+    rules[static_cast<size_t>(FrequencyDescriptor::Peak)] = static_normalization(zero, one, NormalizationUnit::Nyquist, false);
+    rules[static_cast<size_t>(FrequencyDescriptor::Rolloff)] = static_normalization(zero, one, NormalizationUnit::Nyquist, false);
+    rules[static_cast<size_t>(FrequencyDescriptor::Skewness)] = static_normalization(static_cast<TSample>(5.0), static_cast<TSample>(0.1));
+    rules[static_cast<size_t>(FrequencyDescriptor::Slope)] = static_normalization(one, static_cast<TSample>(0.5));
+
+    return rules;
+}
+
+// Applies a table of Size rules to a contiguous block of Size results. The scales of the
+// static rules are resolved when the rules or the analysis parameters change, so a frame
+// costs one branch free pass over the block (plus one step per running rule).
+template <typename TSample, size_t Size>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+class Normalizer
+{
+public:
+    Normalizer() = default;
+
+    explicit Normalizer(const std::array<NormalizationRule<TSample>, Size>& rules)
+    {
+        set_rules(rules);
+    }
+
+    void set_rules(const std::array<NormalizationRule<TSample>, Size>& rules)
+    {
+        rules_ = rules;
+        resolve_();
+        reset();
+    }
+
+    bool set_rule(const size_t& index, const NormalizationRule<TSample>& rule)
+    {
+        if (index >= Size)
+        {
+            return false;
+        }
+
+        rules_[index] = rule;
+        resolve_();
+        states_[index] = {};
+
+        return true;
+    }
+
+    // Same mode for all the rules (e.g. a running normalization of every descriptor)
+    bool set_mode(const NormalizationMode& mode, const TSample& decay = static_cast<TSample>(0.99))
+    {
+        if (decay < static_cast<TSample>(0.0) || decay >= static_cast<TSample>(1.0))
+        {
+            return false;
+        }
+
+        for (auto& rule : rules_)
+        {
+            rule.mode = mode;
+            rule.decay = decay;
+        }
+
+        resolve_();
+        reset();
+
+        return true;
+    }
+
+    // Analysis parameters the units of the static rules refer to
+    bool set_context(const TSample& sample_rate, const size_t& frame_size, const size_t& history_length = 2u)
+    {
+        if (sample_rate <= static_cast<TSample>(0.0) || frame_size < 2u)
+        {
+            return false;
+        }
+
+        sample_rate_ = sample_rate;
+        frame_size_ = frame_size;
+        history_length_ = history_length;
+        resolve_();
+
+        return true;
+    }
+
+    const std::array<NormalizationRule<TSample>, Size>& get_rules() const
+    {
+        return rules_;
+    }
+
+    // Forget the running ranges and statistics
+    void reset()
+    {
+        states_.fill({});
+    }
+
+    // Normalize Size values in place
+    void process(TSample* values)
+    {
+        INFORMER_PROFILE_SCOPE("normalize");
+
+        for (size_t i = 0; i < Size; i++)
+        {
+            values[i] = std::clamp((values[i] + offset_[i]) * scale_[i], low_[i], high_[i]);
+        }
+
+        for (size_t r = 0; r < running_count_; r++)
+        {
+            const size_t i = running_[r];
+            values[i] = running_step_(i, values[i]);
+        }
+    }
+
+    void process(std::array<TSample, Size>& values)
+    {
+        process(values.data());
+    }
+
+    // Normalize a single value, for results not stored in a block
+    TSample process(const size_t& index, const TSample& value)
+    {
+        if (index >= Size)
+        {
+            return value;
+        }
+
+        const TSample mapped = std::clamp((value + offset_[index]) * scale_[index], low_[index], high_[index]);
+
+        return running_slot_(index) ? running_step_(index, mapped) : mapped;
+    }
+
+private:
+    struct RunningState_
+    {
+        TSample a = static_cast<TSample>(0.0);
+        TSample b = static_cast<TSample>(0.0);
+        bool primed = false;
+    };
+
+    std::array<NormalizationRule<TSample>, Size> rules_ = {};
+    std::array<TSample, Size> offset_ = {};
+    std::array<TSample, Size> scale_ = {};
+    std::array<TSample, Size> low_ = {};
+    std::array<TSample, Size> high_ = {};
+    std::array<size_t, Size> running_ = {};
+    size_t running_count_ = 0u;
+    std::array<RunningState_, Size> states_ = {};
+    TSample sample_rate_ = static_cast<TSample>(44100.0);
+    size_t frame_size_ = 4096u;
+    size_t history_length_ = 2u;
+
+    bool running_slot_(const size_t& index) const
+    {
+        return rules_[index].mode == NormalizationMode::RunningMinMax || rules_[index].mode == NormalizationMode::RunningZScore;
+    }
+
+    TSample unit_(const NormalizationUnit& unit) const
+    {
+        switch (unit)
+        {
+        case NormalizationUnit::Nyquist:
+            return sample_rate_ * static_cast<TSample>(0.5);
+        case NormalizationUnit::HalfFrame:
+            return static_cast<TSample>(frame_size_) * static_cast<TSample>(0.5);
+        case NormalizationUnit::HistoryLength:
+            return history_length_ > 1u ? static_cast<TSample>(history_length_ - 1u) : static_cast<TSample>(1.0);
+        default:
+            return static_cast<TSample>(1.0);
+        }
+    }
+
+    // Static rules get their parameters, the others pass the values through the first pass
+    void resolve_()
+    {
+        running_count_ = 0u;
+
+        for (size_t i = 0; i < Size; i++)
+        {
+            const auto& rule = rules_[i];
+            const bool is_static = rule.mode == NormalizationMode::Static;
+
+            offset_[i] = is_static ? rule.offset : static_cast<TSample>(0.0);
+            scale_[i] = is_static ? rule.scale / unit_(rule.unit) : static_cast<TSample>(1.0);
+            low_[i] = is_static ? rule.low : -std::numeric_limits<TSample>::infinity();
+            high_[i] = is_static ? rule.high : std::numeric_limits<TSample>::infinity();
+
+            if (running_slot_(i))
+            {
+                running_[running_count_++] = i;
+            }
+        }
+    }
+
+    TSample running_step_(const size_t& index, const TSample& value)
+    {
+        const auto& rule = rules_[index];
+        auto& state = states_[index];
+        const TSample alpha = static_cast<TSample>(1.0) - rule.decay;
+
+        if (!std::isfinite(value))
+        {
+            return static_cast<TSample>(0.5);
+        }
+
+        if (!state.primed)
+        {
+            state.a = value;
+            state.b = rule.mode == NormalizationMode::RunningMinMax ? value : static_cast<TSample>(0.0);
+            state.primed = true;
+        }
+
+        if (rule.mode == NormalizationMode::RunningMinMax)
+        {
+            // a is the minimum, b the maximum
+            state.a = std::min(value, state.a + (value - state.a) * alpha);
+            state.b = std::max(value, state.b + (value - state.b) * alpha);
+
+            return state.b > state.a ? (value - state.a) / (state.b - state.a) : static_cast<TSample>(0.5);
+        }
+
+        // a is the mean, b the variance
+        const TSample delta = value - state.a;
+        state.a += alpha * delta;
+        state.b = (static_cast<TSample>(1.0) - alpha) * (state.b + alpha * delta * delta);
+
+        const TSample deviation = std::sqrt(state.b);
+
+        if (deviation <= std::numeric_limits<TSample>::epsilon() || rule.range <= static_cast<TSample>(0.0))
+        {
+            return static_cast<TSample>(0.5);
+        }
+
+        const TSample z = (value - state.a) / deviation;
+
+        return std::clamp(static_cast<TSample>(0.5) + z / (static_cast<TSample>(2.0) * rule.range),
+                          static_cast<TSample>(0.0), static_cast<TSample>(1.0));
+    }
+};
+
+
+/* CLASS INTERFACE */
+
+template <typename TSample>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+class Informer
+{
+public:
+    static constexpr size_t time_normalization_slots = static_cast<size_t>(TimeDescriptor::Count) + 2u;
+    static constexpr size_t frequency_normalization_slots = static_cast<size_t>(FrequencyDescriptor::Count) + 16u;
+
+    Informer(const std::vector<TSample>& buffer = {},
+             const std::vector<TSample>& magnitudes = {},
+             const TSample& sample_rate = static_cast<TSample>(44100.0),
+             const TSample& rolloff_point = static_cast<TSample>(0.85),
+             const std::vector<TSample>& previous_magnitudes = {},
+             const unsigned int& stft_size = 0u,
+             const bool& compute = true)
+    {
+        if (!buffer.empty())
+        {
+            set_buffer(buffer);
+        }
+
+        set_sample_rate(sample_rate);
+
+        if (!magnitudes.empty())
+        {
+            set_magnitudes(magnitudes);
+        }
+
+        if (stft_size > 2u)
+        {
+            set_stft_size(stft_size);
+        }
+        else if (magnitudes.size() > 2u)
+        {
+            set_stft_size((history_.bins() - 1u) * 2u);
+        }
+        else
+        {
+            set_stft_size(4096u);
+        }
+
+        if (!previous_magnitudes.empty())
+        {
+            set_previous_magnitudes(previous_magnitudes);
+        }
+
+        set_rolloff_point(rolloff_point);
+
+        if (compute)
+        {
+            compute_descriptors();
+        }
+    }
+
+    ~Informer() = default;
+
+    bool set_sample_rate(const TSample& sample_rate)
+    {
+        if (sample_rate > static_cast<TSample>(0.0))
+        {
+            sample_rate_ = sample_rate;
+            pitch_tracker_.set_sample_rate(sample_rate_);
+            update_normalization_context_();
+
+            if (stft_size_ > 2)
+            {
+                precomputed_frequencies_ = Frequency::precompute_frequencies(stft_size_, sample_rate_);
+                chroma_map_ = Frequency::precompute_chroma_map(stft_size_, sample_rate_, chroma_bins_);
+                bark_map_ = Frequency::precompute_bark_map(stft_size_, sample_rate_);
+            }
+
+            return true;
+        }
+
+        return false;
+    }
+
+    bool set_rolloff_point(const TSample& rolloff)
+    {
+        if (rolloff > static_cast<TSample>(0.0) && rolloff < static_cast<TSample>(1.0))
+        {
+            rolloff_point_ = rolloff;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    bool set_stft_size(const unsigned int& stft_size)
+    {
+        if (stft_size > 2u)
+        {
+            stft_size_ = stft_size;
+            update_normalization_context_();
+
+            precomputed_frequencies_ = Frequency::precompute_frequencies(stft_size_, sample_rate_);
+            chroma_map_ = Frequency::precompute_chroma_map(stft_size_, sample_rate_, chroma_bins_);
+            bark_map_ = Frequency::precompute_bark_map(stft_size_, sample_rate_);
+
+            return true;
+        }
+
+        return false;
+    }
+
+    // When enabled, compute_descriptors() also runs the streaming pitch tracker (see PitchTracker)
+    void set_pitch_tracking(const bool& enable)
+    {
+        if (enable && !pitch_tracking_)
+        {
+            pitch_tracker_.reset();
+        }
+
+        pitch_tracking_ = enable;
+    }
+
+    PitchTracker<TSample>& get_pitch_tracker()
+    {
+        return pitch_tracker_;
+    }
+
+    // When enabled, compute_descriptors() also computes the chroma vector (see get_chroma()) and
+    // the "key" and "keystrength" descriptors
+    void set_chroma_key(const bool& enable)
+    {
+        chroma_key_ = enable;
+    }
+
+    // When enabled, compute_descriptors() also splits the magnitudes into a harmonic and a
+    // percussive part (see HarmonicPercussive) and computes the spectral descriptors of each
+    void set_harmonic_percussive(const bool& enable)
+    {
+        if (enable && !harmonic_percussive_)
+        {
+            harmonic_percussive_separator_.clear();
+            harmonic_normalizer_.reset();
+            percussive_normalizer_.reset();
+        }
+
+        harmonic_percussive_ = enable;
+    }
+
+    HarmonicPercussive<TSample>& get_harmonic_percussive()
+    {
+        return harmonic_percussive_separator_;
+    }
+
+    // When enabled, compute_descriptors() also extracts the sinusoidal peaks of the spectrum, follows
+    // them across frames (see PartialTracker) and computes the harmonic descriptors "inharmonicity",
+    // "oddevenratio", "tristimulus1", "tristimulus2", "tristimulus3" and "hnr" (harmonic to noise
+    // ratio, in dB) of the tracked pitch, of the YIN or of the HPS estimate, the first one available
+    void set_harmonic_analysis(const bool& enable)
+    {
+        if (enable && !harmonic_analysis_)
+        {
+            partial_tracker_.reset();
+        }
+
+        harmonic_analysis_ = enable;
+    }
+
+    // Maximum number of peaks (and partials) per frame
+    bool set_peak_count(const unsigned int& peak_count)
+    {
+        if (peak_count > 0u && partial_tracker_.set_max_partials(peak_count))
+        {
+            peak_count_ = peak_count;
+            peaks_.reserve(peak_count_);
+
+            return true;
+        }
+
+        return false;
+    }
+
+    // Peaks weaker than threshold times the strongest one are ignored (0.001 is -60 dB)
+    bool set_peak_threshold(const TSample& threshold)
+    {
+        if (threshold >= static_cast<TSample>(0.0) && threshold <= static_cast<TSample>(1.0))
+        {
+            peak_threshold_ = threshold;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    // When enabled, compute_descriptors() also computes the psychoacoustic descriptors "loudness"
+    // (Zwicker, in sone), "sharpness" (in acum) and "roughness" (Sethares, over the peaks, see
+    // set_peak_count()), and the specific loudness of the 24 critical bands
+    void set_psychoacoustic_analysis(const bool& enable)
+    {
+        psychoacoustic_analysis_ = enable;
+    }
+
+    // Level in dB SPL of a full scale sinusoid and its peak in the magnitudes: 0.25 for a
+    // Frequency::window() frame and Frequency::magnitudes(), half the frame size for an
+    // unnormalized FFT of a frame windowed with unit mean
+    bool set_loudness_calibration(const TSample& full_scale_magnitude, const TSample& full_scale_db = static_cast<TSample>(100.0))
+    {
+        if (full_scale_magnitude > static_cast<TSample>(0.0))
+        {
+            // A Hann main lobe holds 1.5 times the squared peak
+            loudness_reference_ = static_cast<TSample>(1.5) * full_scale_magnitude * full_scale_magnitude /
+                                  std::pow(static_cast<TSample>(10.0), static_cast<TSample>(0.1) * full_scale_db);
+
+            return true;
+        }
+
+        return false;
+    }
+
+    // Specific loudness (sone/bark) of the critical bands of the last frame
+    const std::array<TSample, Frequency::BarkMap<TSample>::bands>& get_specific_loudness() const
+    {
+        return specific_loudness_;
+    }
+
+    // Peaks of the last frame, sorted by frequency
+    const std::vector<Frequency::SpectralPeak<TSample>>& get_peaks() const
+    {
+        return peaks_;
+    }
+
+    PartialTracker<TSample>& get_partial_tracker()
+    {
+        return partial_tracker_;
+    }
+
+    // When enabled, compute_descriptors() also feeds the onset strength of each frame to the
+    // tempo tracker and stores "tempo" (BPM), "beatphase" (0 on a beat, towards 1 before the next
+    // one) and "beat" (1 on the frame of a beat, 0 otherwise). The frames are expected at regular
+    // hops: set the frame rate (sample rate over hop size) with get_tempo_tracker().set_frame_rate()
+    void set_tempo_tracking(const bool& enable)
+    {
+        if (enable && !tempo_tracking_)
+        {
+            tempo_tracker_.reset();
+        }
+
+        tempo_tracking_ = enable;
+    }
+
+    TempoTracker<TSample>& get_tempo_tracker()
+    {
+        return tempo_tracker_;
+    }
+
+    // When enabled, each set_buffer() runs the activity gate on the new frame. On a silent frame
+    // compute_descriptors() skips the analysis and a zero spectrum enters the history and the
+    // medians of the harmonic-percussive separation: levels and shape descriptors are 0, f0 (both
+    // domains) and f0tracked are -1, the key holds its last value with keystrength 0, and flux,
+    // stationarity, temporal centroid and tempo follow the history.
+    // On a held frame the descriptors of the last analyzed frame are kept.
+    // Check get_activity() after set_buffer() to skip the FFT and set_magnitudes() as well.
+    void set_activity_gating(const bool& enable)
+    {
+        if (enable && !activity_gating_)
+        {
+            activity_gate_.reset();
+        }
+
+        activity_gating_ = enable;
+        activity_ = Activity::Active;
+    }
+
+    ActivityGate<TSample>& get_activity_gate()
+    {
+        return activity_gate_;
+    }
+
+    // Activity of the last buffer, always Active when the gating is disabled
+    Activity get_activity() const
+    {
+        return activity_;
+    }
+
+    // Spectra of at least large_frame_size bins get their spectral descriptors from one fused
+    // pass over tiles that fit in the L1 cache (see TiledSpectrum, flux apart), and with more than
+    // one reduction thread the tiles, as well as the YIN lags of buffers of at least
+    // large_frame_size samples, are split over the threads. 0 disables both (default 16384).
+    void set_large_frame_size(const size_t& large_frame_size)
+    {
+        large_frame_size_ = large_frame_size;
+    }
+
+    size_t get_large_frame_size() const
+    {
+        return large_frame_size_;
+    }
+
+    // Threads of the large frame reductions, the caller included: 1 (default) up to
+    // ReductionPool::max_threads. The descriptors do not depend on it.
+    bool set_reduction_threads(const unsigned int& threads)
+    {
+        return reduction_pool_.set_threads(threads);
+    }
+
+    unsigned int get_reduction_threads() const
+    {
+        return reduction_pool_.get_threads();
+    }
+
+    // Chroma resolution, 12 (semitones) or any multiple of 12 (e.g. 36, thirds of semitone)
+    bool set_chroma_bins(const unsigned int& chroma_bins)
+    {
+        if (chroma_bins >= 12u && chroma_bins % 12u == 0u)
+        {
+            chroma_bins_ = chroma_bins;
+
+            if (stft_size_ > 2u)
+            {
+                chroma_map_ = Frequency::precompute_chroma_map(stft_size_, sample_rate_, chroma_bins_);
+            }
+
+            return true;
+        }
+
+        return false;
+    }
+
+    bool set_magnitudes_from_stft(const std::vector<TSample>& stft)
+    {
+        if (stft.size() > 2u)
+        {
+            set_magnitudes(Frequency::magnitudes(stft), true);
+
+            return true;
+        }
+
+        return false;
+    }
+
+    bool set_previous_magnitudes_from_stft(const std::vector<TSample>& previous_stft)
+    {
+        if (previous_stft.size() > 2u)
+        {
+            set_previous_magnitudes(Frequency::magnitudes(previous_stft));
+
+            return true;
+        }
+
+        return false;
+    }
+
+    // The new magnitudes are copied into the history ring (see MagnitudeHistory), where the
+    // current ones become the previous ones without any copy
+    bool set_magnitudes(const std::vector<TSample>& magnitudes, bool update_stft_size = false)
+    {
+        return set_magnitudes(magnitudes.data(), magnitudes.size(), update_stft_size);
+    }
+
+    // Same as above, swapping the vector into the history instead of copying it (magnitudes is
+    // left with the storage of the oldest frame)
+    bool set_magnitudes(std::vector<TSample>&& magnitudes, bool update_stft_size = false)
+    {
+        if (magnitudes.size() > 2)
+        {
+            const bool size_changed = magnitudes.size() != history_.bins();
+            history_.push(std::move(magnitudes));
+            hps_f0_current_ = false;
+
+            if (size_changed && update_stft_size)
+            {
+                set_stft_size((history_.bins() - 1u) * 2u);
+            }
+
+            return true;
+        }
+
+        return false;
+    }
+
+    // Same as above, copying from a raw array (no allocation once the size is stable)
+    bool set_magnitudes(const TSample* magnitudes, const size_t& size, bool update_stft_size = false)
+    {
+        if (magnitudes != nullptr && size > 2)
+        {
+            const bool size_changed = size != history_.bins();
+            history_.push(magnitudes, size);
+            hps_f0_current_ = false;
+
+            if (size_changed && update_stft_size)
+            {
+                set_stft_size((size - 1u) * 2u);
+            }
+
+            return true;
+        }
+
+        return false;
+    }
+
+    bool set_previous_magnitudes(const std::vector<TSample>& previous_magnitudes)
+    {
+        return history_.replace(1u, previous_magnitudes.data(), previous_magnitudes.size());
+    }
+
+    // Number of spectra kept, the current one included (at least 2, default 2). With more than
+    // 2 frames compute_descriptors() also computes the "stationarity" and "temporalcentroid"
+    // descriptors over the history. Changing it clears the history.
+    bool set_history_size(const size_t& frames)
+    {
+        if (!history_.set_capacity(frames))
+        {
+            return false;
+        }
+
+        // The running sums are needed only by the descriptors over more than two frames
+        history_.set_statistics(frames > 2u);
+        flux_lag_ = std::min(flux_lag_, static_cast<unsigned int>(frames - 1u));
+        update_normalization_context_();
+
+        return true;
+    }
+
+    // Age of the frame the flux is computed against, 1 (the previous one, default) up to history size - 1
+    bool set_flux_lag(const unsigned int& lag)
+    {
+        if (lag >= 1u && lag < history_.capacity())
+        {
+            flux_lag_ = lag;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    const MagnitudeHistory<TSample>& get_history() const
+    {
+        return history_;
+    }
+
+    bool set_buffer(const std::vector<TSample>& buffer)
+    {
+        if (!buffer.empty())
+        {
+            buffer_ = buffer;
+            yin_buffer_current_ = false;
+            gate_buffer_();
+
+            return true;
+        }
+
+        return false;
+    }
+
+    bool set_buffer(const TSample* buffer, const size_t& size)
+    {
+        if (buffer != nullptr && size > 0)
+        {
+            buffer_.assign(buffer, buffer + size);
+            yin_buffer_current_ = false;
+            gate_buffer_();
+
+            return true;
+        }
+
+        return false;
+    }
+
+    bool compute_descriptors(bool compute_time = true, bool compute_freq = true)
+    {
+        INFORMER_PROFILE_SCOPE("compute_descriptors");
+
+        if (activity_ != Activity::Active)
+        {
+            skip_descriptors_(compute_time, compute_freq);
+
+            return true;
+        }
+
+        // Time domain descriptors
+        if (!buffer_.empty() && compute_time)
+        {
+            amp_peak();
+            amp_rms();
+            amp_variance();
+            amp_kurtosis();
+            amp_skewness();
+            amp_f0yin();
+            amp_zerocrossing();
+        }
+
+        // Frequency domain descriptors
+        if (history_.bins() > 2 && compute_freq)
+        {
+            if (large_frame_(history_.bins()))
+            {
+                spectral_tiled();
+                spectral_flux();
+            }
+            else
+            {
+                spectral_centroid();
+                spectral_spread();
+                spectral_crestfactor();
+                spectral_decrease();
+                spectral_entropy();
+                spectral_flatness();
+                spectral_flux();
+                spectral_irregularity();
+                spectral_kurtosis();
+                spectral_peak();
+                spectral_rolloff();
+                spectral_skewness();
+                spectral_slope();
+            }
+
+            if (history_.capacity() > 2u)
+            {
+                spectral_stationarity();
+                spectral_temporalcentroid();
+            }
+
+            fundamental_pitch();
+
+            if (chroma_key_)
+            {
+                spectral_chroma();
+                spectral_key();
+            }
+
+            if (harmonic_analysis_ || psychoacoustic_analysis_)
+            {
+                spectral_peaks();
+            }
+
+            if (harmonic_analysis_)
+            {
+                spectral_harmonics();
+            }
+
+            if (psychoacoustic_analysis_)
+            {
+                spectral_psychoacoustics();
+            }
+
+            if (harmonic_percussive_)
+            {
+                spectral_harmonic_percussive();
+            }
+
+            if (tempo_tracking_)
+            {
+                spectral_tempo();
+            }
+        }
+
+        // The tracker weighs the HPS estimate of the same frame, so it runs after the frequency
+        // domain descriptors
+        if (pitch_tracking_ && !buffer_.empty() && compute_time)
+        {
+            amp_f0tracked();
+        }
+
+        return true;
+    }
+
+    // Normalize descriptors inside [0, 1] range, with the rules of the normalizers (by
+    // default the heuristic ranges of time_normalization_rules() and frequency_normalization_rules(),
+    // use only for artistic purposes). The descriptors of the harmonic and percussive parts
+    // have normalizers of their own, as their running rules follow other signals.
+    void normalize_descriptors()
+    {
+        normalize_map_(time_descriptors_, time_normalization_keys_, time_slots_, time_slots_bound_, time_normalizer_);
+        normalize_map_(frequency_descriptors_, frequency_normalization_keys_, frequency_slots_, frequency_slots_bound_, frequency_normalizer_);
+
+        if (harmonic_percussive_)
+        {
+            normalize_map_(harmonic_descriptors_, frequency_normalization_keys_, harmonic_slots_, harmonic_slots_bound_, harmonic_normalizer_);
+            normalize_map_(percussive_descriptors_, frequency_normalization_keys_, percussive_slots_, percussive_slots_bound_, percussive_normalizer_);
+        }
+    }
+
+    // Rule of a single descriptor, e.g. a running normalization of "centroid"
+    bool set_time_normalization(const std::string& descriptor, const NormalizationRule<TSample>& rule)
+    {
+        return time_normalizer_.set_rule(normalization_slot_(time_normalization_keys_, descriptor), rule);
+    }
+
+    // Also the rule of the descriptor of the harmonic and percussive parts
+    bool set_frequency_normalization(const std::string& descriptor, const NormalizationRule<TSample>& rule)
+    {
+        const size_t slot = normalization_slot_(frequency_normalization_keys_, descriptor);
+        harmonic_normalizer_.set_rule(slot, rule);
+        percussive_normalizer_.set_rule(slot, rule);
+
+        return frequency_normalizer_.set_rule(slot, rule);
+    }
+
+    // Normalizers of the time and frequency descriptors, in the order of TimeDescriptor and
+    // FrequencyDescriptor followed by the descriptors of this class only (see the keys below)
+    Normalizer<TSample, time_normalization_slots>& get_time_normalizer()
+    {
+        return time_normalizer_;
+    }
+
+    Normalizer<TSample, frequency_normalization_slots>& get_frequency_normalizer()
+    {
+        return frequency_normalizer_;
+    }
+
+    // Normalizers of the harmonic and percussive parts, with the slots of the frequency descriptors
+    Normalizer<TSample, frequency_normalization_slots>& get_harmonic_normalizer()
+    {
+        return harmonic_normalizer_;
+    }
+
+    Normalizer<TSample, frequency_normalization_slots>& get_percussive_normalizer()
+    {
+        return percussive_normalizer_;
+    }
+
+    std::vector<TSample> get_magnitudes() const
+    {
+        return history_.current();
+    }
+
+    std::vector<TSample> get_previous_magnitudes() const
+    {
+        return history_.frame(1u);
+    }
+
+    std::vector<TSample> get_buffer() const
+    {
+        return buffer_;
+    }
+
+    unsigned int get_stft_size() const
+    {
+        return stft_size_;
+    }
+
+    TSample get_sample_rate() const
+    {
+        return sample_rate_;
+    }
+
+    TSample get_rolloff_point() const
+    {
+        return rolloff_point_;
+    }
+
+    std::vector<TSample> get_precomputed_frequencies() const
+    {
+        return precomputed_frequencies_;
+    }
+
+    unsigned int get_chroma_bins() const
+    {
+        return chroma_bins_;
+    }
+
+    // Correlations of the last chroma vector with the 24 keys (see Frequency::key_strengths())
+    const std::array<TSample, 24>& get_key_strengths() const
+    {
+        return key_strengths_;
+    }
+
+    const std::vector<TSample>& get_chroma() const
+    {
+        return chroma_;
+    }
+
+    TSample get_time_descriptor(const std::string& descriptor) const
+    {
+        if (time_descriptors_.find(descriptor) != time_descriptors_.end())
+        {
+            return time_descriptors_.at(descriptor);
+        }
+
+        return static_cast<TSample>(0.0);
+    }
+
+    TSample get_frequency_descriptor(const std::string& descriptor) const
+    {
+        if (frequency_descriptors_.find(descriptor) != frequency_descriptors_.end())
+        {
+            return frequency_descriptors_.at(descriptor);
+        }
+
+        return static_cast<TSample>(0.0);
+    }
+
+    const std::unordered_map<std::string, TSample>& get_time_descriptors() const
+    {
+        return time_descriptors_;
+    }
+
+    const std::unordered_map<std::string, TSample>& get_frequency_descriptors() const
+    {
+        return frequency_descriptors_;
+    }
+
+    // Spectral descriptors of the harmonic and percussive parts (see set_harmonic_percussive())
+    TSample get_harmonic_descriptor(const std::string& descriptor) const
+    {
+        if (harmonic_descriptors_.find(descriptor) != harmonic_descriptors_.end())
+        {
+            return harmonic_descriptors_.at(descriptor);
+        }
+
+        return static_cast<TSample>(0.0);
+    }
+
+    TSample get_percussive_descriptor(const std::string& descriptor) const
+    {
+        if (percussive_descriptors_.find(descriptor) != percussive_descriptors_.end())
+        {
+            return percussive_descriptors_.at(descriptor);
+        }
+
+        return static_cast<TSample>(0.0);
+    }
+
+    const std::unordered_map<std::string, TSample>& get_harmonic_descriptors() const
+    {
+        return harmonic_descriptors_;
+    }
+
+    const std::unordered_map<std::string, TSample>& get_percussive_descriptors() const
+    {
+        return percussive_descriptors_;
+    }
+
+    // It is advisable to call compute_descriptors() instead of the single wrapper functions that follow
+
+    // Time domain descriptors
+    TSample amp_peak()
+    {
+        INFORMER_PROFILE_SCOPE("amp_peak");
+
+        time_descriptors_["peak"] = Amplitude::peak(buffer_);
+
+        return time_descriptors_["peak"];
+    }
+
+    TSample amp_rms()
+    {
+        INFORMER_PROFILE_SCOPE("amp_rms");
+
+        time_descriptors_["rms"] = Amplitude::rms(buffer_);
+
+        return time_descriptors_["rms"];
+    }
+
+    TSample amp_variance()
+    {
+        INFORMER_PROFILE_SCOPE("amp_variance");
+
+        time_descriptors_["variance"] = Amplitude::variance(buffer_);
+
+        return time_descriptors_["variance"];
+    }
+
+    TSample amp_kurtosis()
+    {
+        INFORMER_PROFILE_SCOPE("amp_kurtosis");
+
+        TSample mean = sum(buffer_) / static_cast<TSample>(buffer_.size());
+        TSample amp_variance = Amplitude::variance(buffer_);
+
+        time_descriptors_["kurtosis"] = Amplitude::kurtosis(buffer_, mean, amp_variance);
+
+        return time_descriptors_["kurtosis"];
+    }
+
+    TSample amp_skewness()
+    {
+        INFORMER_PROFILE_SCOPE("amp_skewness");
+
+        TSample mean = sum(buffer_) / static_cast<TSample>(buffer_.size());
+        TSample amp_variance = Amplitude::variance(buffer_);
+
+        time_descriptors_["skewness"] = Amplitude::skewness(buffer_, mean, amp_variance);
+
+        return time_descriptors_["skewness"];
+    }
+
+    TSample amp_f0yin()
+    {
+        INFORMER_PROFILE_SCOPE("amp_f0yin");
+
+        time_descriptors_["f0"] = Amplitude::yin(buffer_, sample_rate_, static_cast<TSample>(0.15), yin_buffer_,
+                                                 large_frame_(buffer_.size()) ? &reduction_pool_ : nullptr);
+        yin_buffer_current_ = true;
+
+        return time_descriptors_["f0"];
+    }
+
+    // Tracked pitch, delayed by the latency of the tracker (negative when unvoiced), and voicing probability
+    // When called after amp_f0yin() on the same buffer, the YIN difference function is not computed again
+    TSample amp_f0tracked()
+    {
+        INFORMER_PROFILE_SCOPE("amp_f0tracked");
+
+        if (!yin_buffer_current_)
+        {
+            Amplitude::yin_difference(buffer_, yin_buffer_, large_frame_(buffer_.size()) ? &reduction_pool_ : nullptr);
+            yin_buffer_current_ = true;
+        }
+
+        // Only the HPS estimate of the current magnitudes, never the one of a previous frame
+        TSample hps_f0 = static_cast<TSample>(-1.0);
+        if (hps_f0_current_ && frequency_descriptors_.find("f0") != frequency_descriptors_.end())
+        {
+            hps_f0 = frequency_descriptors_.at("f0");
+        }
+
+        auto estimate = pitch_tracker_.process_difference(yin_buffer_, hps_f0);
+
+        time_descriptors_["f0tracked"] = estimate.frequency;
+        time_descriptors_["voicing"] = estimate.voicing_probability;
+
+        return time_descriptors_["f0tracked"];
+    }
+
+    TSample amp_zerocrossing()
+    {
+        INFORMER_PROFILE_SCOPE("amp_zerocrossing");
+
+        time_descriptors_["zerocrossing"] = Amplitude::zerocrossing(buffer_);
+
+        return time_descriptors_["zerocrossing"];
+    }
+
+    // Frequency domain descriptors
+    TSample spectral_centroid()
+    {
+        INFORMER_PROFILE_SCOPE("spectral_centroid");
+
+        frequency_descriptors_["centroid"] = Frequency::centroid(history_.current(), sample_rate_,
+                                             precomputed_frequencies_);
+
+        return frequency_descriptors_["centroid"];
+    }
+
+    TSample spectral_crestfactor()
+    {
+        INFORMER_PROFILE_SCOPE("spectral_crestfactor");
+
+        frequency_descriptors_["crestfactor"] = Frequency::crestfactor(history_.current());
+
+        return frequency_descriptors_["crestfactor"];
+    }
+
+    TSample spectral_decrease()
+    {
+        INFORMER_PROFILE_SCOPE("spectral_decrease");
+
+        frequency_descriptors_["decrease"] = Frequency::decrease(history_.current());
+
+        return frequency_descriptors_["decrease"];
+    }
+
+    TSample spectral_entropy()
+    {
+        INFORMER_PROFILE_SCOPE("spectral_entropy");
+
+        frequency_descriptors_["entropy"] = Frequency::entropy(history_.current());
+
+        return frequency_descriptors_["entropy"];
+    }
+
+    TSample spectral_flatness()
+    {
+        INFORMER_PROFILE_SCOPE("spectral_flatness");
+
+        frequency_descriptors_["flatness"] = Frequency::flatness(history_.current());
+
+        return frequency_descriptors_["flatness"];
+    }
+
+    TSample spectral_flux()
+    {
+        INFORMER_PROFILE_SCOPE("spectral_flux");
+
+        frequency_descriptors_["flux"] = history_.flux(flux_lag_);
+
+        return frequency_descriptors_["flux"];
+    }
+
+    TSample spectral_irregularity()
+    {
+        INFORMER_PROFILE_SCOPE("spectral_irregularity");
+
+        frequency_descriptors_["irregularity"] = Frequency::irregularity(history_.current());
+
+        return frequency_descriptors_["irregularity"];
+    }
+
+    // Multi-frame descriptors over the magnitude history (see set_history_size())
+    TSample spectral_stationarity()
+    {
+        INFORMER_PROFILE_SCOPE("spectral_stationarity");
+
+        frequency_descriptors_["stationarity"] = history_.stationarity();
+
+        return frequency_descriptors_["stationarity"];
+    }
+
+    TSample spectral_temporalcentroid()
+    {
+        INFORMER_PROFILE_SCOPE("spectral_temporalcentroid");
+
+        frequency_descriptors_["temporalcentroid"] = history_.temporal_centroid();
+
+        return frequency_descriptors_["temporalcentroid"];
+    }
+
+    TSample spectral_kurtosis()
+    {
+        INFORMER_PROFILE_SCOPE("spectral_kurtosis");
+
+        if (frequency_descriptors_.find("centroid") == frequency_descriptors_.end())
+        {
+            spectral_centroid();
+        }
+
+        if (frequency_descriptors_.find("spread") == frequency_descriptors_.end())
+        {
+            spectral_spread();
+        }
+
+        frequency_descriptors_["kurtosis"] = Frequency::kurtosis(history_.current(), sample_rate_,
+                                             precomputed_frequencies_, frequency_descriptors_["centroid"],
+                                             frequency_descriptors_["spread"]);
+
+        return frequency_descriptors_["kurtosis"];
+    }
+
+    TSample spectral_peak()
+    {
+        INFORMER_PROFILE_SCOPE("spectral_peak");
+
+        frequency_descriptors_["peak"] = Frequency::peak(history_.current(), sample_rate_,
+                                         precomputed_frequencies_);
+
+        return frequency_descriptors_["peak"];
+    }
+
+    TSample spectral_rolloff()
+    {
+        INFORMER_PROFILE_SCOPE("spectral_rolloff");
+
+        frequency_descriptors_["rolloff"] = Frequency::rolloff(history_.current(), sample_rate_,
+                                            rolloff_point_, precomputed_frequencies_);
+
+        return frequency_descriptors_["rolloff"];
+    }
+
+    TSample spectral_skewness()
+    {
+        INFORMER_PROFILE_SCOPE("spectral_skewness");
+
+        if (frequency_descriptors_.find("centroid") == frequency_descriptors_.end())
+        {
+            spectral_centroid();
+        }
+
+        if (frequency_descriptors_.find("spread") == frequency_descriptors_.end())
+        {
+            spectral_spread();
+        }
+
+        frequency_descriptors_["skewness"] = Frequency::skewness(history_.current(), sample_rate_, precomputed_frequencies_,
+                                             frequency_descriptors_["centroid"], frequency_descriptors_["spread"]);
+
+        return frequency_descriptors_["skewness"];
+    }
+
+    TSample spectral_slope()
+    {
+        INFORMER_PROFILE_SCOPE("spectral_slope");
 
-    unsigned int fft_size = magnitudes.size();
-    unsigned int bins = stft_size > 0u ? stft_size : (fft_size - 1u) * 2u;
+        frequency_descriptors_["slope"] = Frequency::slope(history_.current(), sample_rate_,
+                                          precomputed_frequencies_);
 
-    if (precomputed_frequencies.size() < bins)
-    {
-        precomputed_frequencies = precompute_frequencies(bins, sample_rate);
+        return frequency_descriptors_["slope"];
     }
 
-    TSample magn_sum = static_cast<TSample>(0.0);
-
-    for (unsigned int k = 0u; k < fft_size; k++)
+    // The descriptors of the wrappers from spectral_centroid() to spectral_spread(), flux apart,
+    // in one fused pass (used by compute_descriptors() for large frames, see set_large_frame_size())
+    void spectral_tiled()
     {
-        magn_sum += std::abs(magnitudes[k]);
-    }
+        INFORMER_PROFILE_SCOPE("spectral_tiled");
 
-    TSample rolloff_thresh = rolloff_point * magn_sum;
-    TSample cumul_magn = static_cast<TSample>(0.0);
-    unsigned int rolloff_idx = fft_size - 1u;
+        const auto& d = tiled_spectrum_.process(history_.current().data(), history_.bins(), sample_rate_,
+                                                rolloff_point_, &reduction_pool_);
+        frequency_descriptors_["centroid"] = d.centroid;
+        frequency_descriptors_["spread"] = d.spread;
+        frequency_descriptors_["crestfactor"] = d.crestfactor;
+        frequency_descriptors_["decrease"] = d.decrease;
+        frequency_descriptors_["entropy"] = d.entropy;
+        frequency_descriptors_["flatness"] = d.flatness;
+        frequency_descriptors_["irregularity"] = d.irregularity;
+        frequency_descriptors_["kurtosis"] = d.kurtosis;
+        frequency_descriptors_["peak"] = d.peak;
+        frequency_descriptors_["rolloff"] = d.rolloff;
+        frequency_descriptors_["skewness"] = d.skewness;
+        frequency_descriptors_["slope"] = d.slope;
+    }
 
-    for (unsigned int k = 0u; k < fft_size; k++)
+    TSample spectral_spread()
     {
-        cumul_magn += std::abs(magnitudes[k]);
+        INFORMER_PROFILE_SCOPE("spectral_spread");
 
-        if (cumul_magn >= rolloff_thresh)
+        if (frequency_descriptors_.find("centroid") == frequency_descriptors_.end())
         {
-            rolloff_idx = k;
-            break;
+            spectral_centroid();
         }
-    }
 
-    return precomputed_frequencies[rolloff_idx];
-}
-
-// SPECTRAL SKEWNESS
-template <typename Container>
-#if __cplusplus >= 202002L
-requires std::floating_point<typename Container::value_type>
-#endif
-typename Container::value_type skewness(const Container& magnitudes,
-                                        typename Container::value_type sample_rate = static_cast<typename Container::value_type>(44100.0),
-                                        std::vector<typename Container::value_type>& precomputed_frequencies = {},
-                                        typename Container::value_type spectral_centroid = static_cast<typename Container::value_type>(-1.0),
-                                        typename Container::value_type spectral_spread = static_cast<typename Container::value_type>(-1.0),
-                                        unsigned int stft_size = 0u)
-{
-    using TSample = typename Container::value_type;
+        frequency_descriptors_["spread"] = Frequency::spread(history_.current(), sample_rate_,
+                                           precomputed_frequencies_, frequency_descriptors_["centroid"]);
 
-    TSample sskewness = static_cast<TSample>(0.0);
-    TSample scentroid = spectral_centroid;
-    TSample sspread = spectral_spread;
+        return frequency_descriptors_["spread"];
+    }
 
-    if (magnitudes.empty())
+    TSample fundamental_pitch()
     {
-        return sskewness;
-    }
+        INFORMER_PROFILE_SCOPE("fundamental_pitch");
 
-    unsigned int fft_size = magnitudes.size();
-    unsigned int bins = stft_size > 0u ? stft_size : (fft_size - 1u) * 2u;
+        frequency_descriptors_["f0"] = Frequency::f0_hps(history_.current(), 5u, sample_rate_,
+                                                         precomputed_frequencies_);
+        hps_f0_current_ = true;
 
-    if (precomputed_frequencies.size() < bins)
-    {
-        precomputed_frequencies = precompute_frequencies(bins, sample_rate);
+        return frequency_descriptors_["f0"];
     }
 
-    if (spectral_centroid < static_cast<TSample>(0.0))
+    const std::vector<TSample>& spectral_chroma()
     {
-        scentroid = centroid(magnitudes, sample_rate, precomputed_frequencies);
+        INFORMER_PROFILE_SCOPE("spectral_chroma");
+
+        Frequency::chroma(history_.current(), chroma_map_, chroma_);
+
+        return chroma_;
     }
 
-    if (spectral_spread < static_cast<TSample>(0.0))
+    TSample spectral_key()
     {
-        sspread = spread(magnitudes, sample_rate, precomputed_frequencies, scentroid);
-    }
+        INFORMER_PROFILE_SCOPE("spectral_key");
+
+        if (chroma_.size() != chroma_bins_)
+        {
+            spectral_chroma();
+        }
 
-    TSample magn_sum = static_cast<TSample>(0.0);
-    TSample numerator = static_cast<TSample>(0.0);
+        Frequency::key_strengths(chroma_, key_strengths_);
+        const auto max_strength = std::max_element(key_strengths_.begin(), key_strengths_.end());
 
-    for (unsigned int k = 0u; k < fft_size; k++)
-    {
-        numerator += std::pow(precomputed_frequencies[k] - scentroid, static_cast<TSample>(3.0)) * std::abs(magnitudes[k]);
-        magn_sum += std::abs(magnitudes[k]);
+        frequency_descriptors_["key"] = static_cast<TSample>(std::distance(key_strengths_.begin(), max_strength));
+        frequency_descriptors_["keystrength"] = *max_strength;
+
+        return frequency_descriptors_["key"];
     }
 
-    if (magn_sum * sspread > static_cast<TSample>(0.0))
+    // Peaks and partials shared by the harmonic and psychoacoustic descriptors
+    void spectral_peaks()
     {
-        sskewness = numerator / (magn_sum * std::pow(sspread, static_cast<TSample>(3.0)));
-    }
+        INFORMER_PROFILE_SCOPE("spectral_peaks");
 
-    return sskewness;
-}
+        peaks_energy_ = Frequency::peaks(history_.current(), peaks_, peak_count_, peak_threshold_, sample_rate_, stft_size_);
+        partial_tracker_.update(peaks_);
+    }
 
-// SPECTRAL SLOPE
-template <typename Container>
-#if __cplusplus >= 202002L
-requires std::floating_point<typename Container::value_type>
-#endif
-typename Container::value_type slope(const Container& magnitudes,
-                                     typename Container::value_type sample_rate = static_cast<typename Container::value_type>(44100.0),
-                                     std::vector<typename Container::value_type>& precomputed_frequencies = {},
-                                     unsigned int stft_size = 0u)
-{
-    using TSample = typename Container::value_type;
+    TSample spectral_harmonics()
+    {
+        INFORMER_PROFILE_SCOPE("spectral_harmonics");
 
-    TSample sslope = static_cast<TSample>(0.0);
+        const auto harmonics = Frequency::harmonics(history_.current(), peaks_, harmonic_f0_(), peaks_energy_);
+        frequency_descriptors_["inharmonicity"] = harmonics.inharmonicity;
+        frequency_descriptors_["oddevenratio"] = harmonics.odd_even_ratio;
+        frequency_descriptors_["tristimulus1"] = harmonics.tristimulus[0];
+        frequency_descriptors_["tristimulus2"] = harmonics.tristimulus[1];
+        frequency_descriptors_["tristimulus3"] = harmonics.tristimulus[2];
+        frequency_descriptors_["hnr"] = harmonics.harmonic_to_noise;
 
-    if (magnitudes.empty())
-    {
-        return sslope;
+        return frequency_descriptors_["inharmonicity"];
     }
 
-    unsigned int fft_size = magnitudes.size();
-    unsigned int bins = stft_size > 0u ? stft_size : (fft_size - 1u) * 2u;
-
-    if (precomputed_frequencies.size() < bins)
+    TSample spectral_psychoacoustics()
     {
-        precomputed_frequencies = precompute_frequencies(bins, sample_rate);
-    }
+        INFORMER_PROFILE_SCOPE("spectral_psychoacoustics");
 
-    TSample mean_frequency = std::accumulate(precomputed_frequencies.begin(), precomputed_frequencies.end(), static_cast<TSample>(0.0)) / static_cast<TSample>(fft_size);
-    TSample magn_sum_weighted = static_cast<TSample>(0.0);
+        Frequency::bark_bands(history_.current(), bark_map_, band_energies_);
+        frequency_descriptors_["loudness"] = Frequency::loudness(band_energies_, bark_map_, loudness_reference_, specific_loudness_);
+        frequency_descriptors_["sharpness"] = Frequency::sharpness(specific_loudness_);
+        frequency_descriptors_["roughness"] = Frequency::roughness(peaks_);
 
-    for (unsigned int k = 0u; k < fft_size; k++)
-    {
-        magn_sum_weighted += std::abs(magnitudes[k]);
+        return frequency_descriptors_["loudness"];
     }
 
-    magn_sum_weighted /= static_cast<TSample>(fft_size);
+    TSample spectral_tempo()
+    {
+        INFORMER_PROFILE_SCOPE("spectral_tempo");
 
-    TSample numerator = static_cast<TSample>(0.0);
-    TSample denominator = static_cast<TSample>(0.0);
+        const auto& estimate = tempo_tracker_.process(history_.current().data(), history_.bins());
+        frequency_descriptors_["tempo"] = estimate.tempo;
+        frequency_descriptors_["beatphase"] = estimate.phase;
+        frequency_descriptors_["beat"] = estimate.beat ? static_cast<TSample>(1.0) : static_cast<TSample>(0.0);
 
-    for (unsigned int k = 0u; k < fft_size; k++)
-    {
-        numerator += (precomputed_frequencies[k] - mean_frequency) * (std::abs(magnitudes[k]) - magn_sum_weighted);
-        denominator += std::pow(precomputed_frequencies[k] - mean_frequency, static_cast<TSample>(2.0));
+        return frequency_descriptors_["tempo"];
     }
 
-    if (denominator > static_cast<TSample>(0.0))
+    void spectral_harmonic_percussive()
     {
-        sslope = numerator / denominator;
-    }
+        INFORMER_PROFILE_SCOPE("spectral_harmonic_percussive");
 
-    return sslope;
-}
+        harmonic_percussive_separator_.process(history_.current().data(), history_.bins());
 
-} // namespace Informer::Frequency
+        component_descriptors_(harmonic_percussive_separator_.get_harmonic(), previous_harmonic_, harmonic_descriptors_);
+        component_descriptors_(harmonic_percussive_separator_.get_percussive(), previous_percussive_, percussive_descriptors_);
+    }
 
+private:
+    std::vector<TSample> precomputed_frequencies_ = {};
+    MagnitudeHistory<TSample> history_{2u, false};
+    unsigned int flux_lag_ = 1u;
+    std::vector<TSample> buffer_ = {};
+    std::vector<TSample> yin_buffer_ = {};
+    PitchTracker<TSample> pitch_tracker_;
+    bool yin_buffer_current_ = false;
+    bool hps_f0_current_ = false;
+    bool pitch_tracking_ = false;
+    Frequency::ChromaMap<TSample> chroma_map_ = {};
+    std::vector<TSample> chroma_ = {};
+    std::array<TSample, 24> key_strengths_ = {};
+    unsigned int chroma_bins_ = 12u;
+    bool chroma_key_ = false;
+    unsigned int stft_size_ = 0u;
+    TSample sample_rate_ = static_cast<TSample>(44100.0);
+    TSample rolloff_point_ = static_cast<TSample>(0.85);
+    std::unordered_map<std::string, TSample> time_descriptors_;
+    std::unordered_map<std::string, TSample> frequency_descriptors_;
+    bool harmonic_analysis_ = false;
+    unsigned int peak_count_ = 20u;
+    TSample peak_threshold_ = static_cast<TSample>(0.001);
+    std::vector<Frequency::SpectralPeak<TSample>> peaks_ = {};
+    TSample peaks_energy_ = static_cast<TSample>(0.0);
+    PartialTracker<TSample> partial_tracker_;
+    bool psychoacoustic_analysis_ = false;
+    Frequency::BarkMap<TSample> bark_map_ = {};
+    std::array<TSample, Frequency::BarkMap<TSample>::bands> band_energies_ = {};
+    std::array<TSample, Frequency::BarkMap<TSample>::bands> specific_loudness_ = {};
+    // Band energy of 0 dB SPL, for a full scale sinusoid of 100 dB SPL with peak 0.25
+    TSample loudness_reference_ = static_cast<TSample>(1.5 * 0.25 * 0.25 * 1e-10);
+    TempoTracker<TSample> tempo_tracker_;
+    bool tempo_tracking_ = false;
+    ActivityGate<TSample> activity_gate_;
+    bool activity_gating_ = false;
+    Activity activity_ = Activity::Active;
+    TiledSpectrum<TSample> tiled_spectrum_;
+    ReductionPool reduction_pool_;
+    size_t large_frame_size_ = 16384u;
+    HarmonicPercussive<TSample> harmonic_percussive_separator_;
+    bool harmonic_percussive_ = false;
+    std::vector<TSample> previous_harmonic_ = {};
+    std::vector<TSample> previous_percussive_ = {};
+    std::unordered_map<std::string, TSample> harmonic_descriptors_;
+    std::unordered_map<std::string, TSample> percussive_descriptors_;
+
+    // Normalization: the slots point to the values in the maps (never erased, so the pointers
+    // stay valid) and are bound again only when new descriptors appear
+    static constexpr std::array<const char*, time_normalization_slots> time_normalization_keys_ =
+    {
+        "peak", "rms", "variance", "kurtosis", "skewness", "f0", "zerocrossing", "f0tracked", "voicing"
+    };
+
+    static constexpr std::array<const char*, frequency_normalization_slots> frequency_normalization_keys_ =
+    {
+        "centroid", "spread", "crestfactor", "decrease", "entropy", "flatness", "flux", "irregularity",
+        "kurtosis", "peak", "rolloff", "skewness", "slope", "f0", "stationarity", "temporalcentroid",
+        "key", "keystrength", "inharmonicity", "oddevenratio", "tristimulus1", "tristimulus2", "tristimulus3", "hnr",
+        "loudness", "sharpness", "roughness", "tempo", "beatphase", "beat"
+    };
+
+    Normalizer<TSample, time_normalization_slots> time_normalizer_{default_time_normalization_()};
+    Normalizer<TSample, frequency_normalization_slots> frequency_normalizer_{default_frequency_normalization_()};
+    Normalizer<TSample, frequency_normalization_slots> harmonic_normalizer_{default_frequency_normalization_()};
+    Normalizer<TSample, frequency_normalization_slots> percussive_normalizer_{default_frequency_normalization_()};
+    std::array<TSample*, time_normalization_slots> time_slots_ = {};
+    std::array<TSample*, frequency_normalization_slots> frequency_slots_ = {};
+    std::array<TSample*, frequency_normalization_slots> harmonic_slots_ = {};
+    std::array<TSample*, frequency_normalization_slots> percussive_slots_ = {};
+    size_t time_slots_bound_ = 0u;
+    size_t frequency_slots_bound_ = 0u;
+    size_t harmonic_slots_bound_ = 0u;
+    size_t percussive_slots_bound_ = 0u;
+
+    static std::array<NormalizationRule<TSample>, time_normalization_slots> default_time_normalization_()
+    {
+        std::array<NormalizationRule<TSample>, time_normalization_slots> rules = {};
+        const auto common = time_normalization_rules<TSample>();
+        std::copy(common.begin(), common.end(), rules.begin());
+
+        return rules;
+    }
+
+    static std::array<NormalizationRule<TSample>, frequency_normalization_slots> default_frequency_normalization_()
+    {
+        std::array<NormalizationRule<TSample>, frequency_normalization_slots> rules = {};
+        const auto common = frequency_normalization_rules<TSample>();
+        std::copy(common.begin(), common.end(), rules.begin());
+
+        // Descriptors of this class only, by name (the others keep the default rule)
+        const std::pair<const char*, NormalizationRule<TSample>> extra_rules[] =
+        {
+            {"temporalcentroid", static_normalization(static_cast<TSample>(0.0), static_cast<TSample>(1.0), NormalizationUnit::HistoryLength, false)},
+            {"key", static_normalization(static_cast<TSample>(0.0), static_cast<TSample>(1.0 / 23.0), NormalizationUnit::One, false)},
+            {"keystrength", static_normalization(static_cast<TSample>(1.0), static_cast<TSample>(0.5), NormalizationUnit::One, false)},
+            {"inharmonicity", static_normalization(static_cast<TSample>(0.0), static_cast<TSample>(1.0))},
+            {"oddevenratio", static_normalization(static_cast<TSample>(0.0), static_cast<TSample>(0.1))},
+            {"tristimulus1", static_normalization(static_cast<TSample>(0.0), static_cast<TSample>(1.0))},
+            {"tristimulus2", static_normalization(static_cast<TSample>(0.0), static_cast<TSample>(1.0))},
+            {"tristimulus3", static_normalization(static_cast<TSample>(0.0), static_cast<TSample>(1.0))},
+            {"hnr", static_normalization(static_cast<TSample>(20.0), static_cast<TSample>(1.0 / 60.0))},
+            {"loudness", static_normalization(static_cast<TSample>(0.0), static_cast<TSample>(1.0 / 64.0))},
+            {"sharpness", static_normalization(static_cast<TSample>(0.0), static_cast<TSample>(0.25))},
+            {"roughness", static_normalization(static_cast<TSample>(0.0), static_cast<TSample>(0.5))},
+            {"tempo", static_normalization(static_cast<TSample>(-40.0), static_cast<TSample>(1.0 / 200.0))},
+            {"beatphase", static_normalization(static_cast<TSample>(0.0), static_cast<TSample>(1.0))},
+            {"beat", static_normalization(static_cast<TSample>(0.0), static_cast<TSample>(1.0))}
+        };
+
+        for (const auto& rule : extra_rules)
+        {
+            const size_t slot = normalization_slot_(frequency_normalization_keys_, rule.first);
 
-/* CLASS INTERFACE */
+            if (slot < rules.size())
+            {
+                rules[slot] = rule.second;
+            }
+        }
 
-template <typename TSample>
-#if __cplusplus >= 202002L
-requires std::floating_point<TSample>
-#endif
-class Informer
-{
-public:
-    Informer(const std::vector<TSample>& buffer = {},
-             const std::vector<TSample>& magnitudes = {},
-             const TSample& sample_rate = static_cast<TSample>(44100.0),
-             const TSample& rolloff_point = static_cast<TSample>(0.85),
-             const std::vector<TSample>& previous_magnitudes = {},
-             const unsigned int& stft_size = 0u,
-             const bool& compute = true)
+        return rules;
+    }
+
+    void gate_buffer_()
     {
-        if (!buffer.empty())
+        if (activity_gating_)
         {
-            set_buffer(buffer);
+            activity_ = activity_gate_.process(buffer_.data(), buffer_.size());
         }
+    }
 
-        set_sample_rate(sample_rate);
+    bool large_frame_(const size_t& size) const
+    {
+        return large_frame_size_ > 0u && size >= large_frame_size_;
+    }
 
-        if (!magnitudes.empty())
+    // Descriptors of a frame skipped by the activity gate. A silent frame writes every descriptor
+    // that compute_descriptors() would write, so the keys exist from the first frame on: the levels
+    // and the shape descriptors are 0, both f0 are -1 (no period, as YIN on an aperiodic frame),
+    // "key" holds the last estimate with "keystrength" 0, and the descriptors over the history
+    // (flux, stationarity, temporal centroid, tempo) are computed as usual on the zero spectrum
+    void skip_descriptors_(const bool& compute_time, const bool& compute_freq)
+    {
+        if (activity_ == Activity::Silent)
         {
-            set_magnitudes(magnitudes);
-        }
+            if (compute_time)
+            {
+                for (const auto& name : time_descriptor_names)
+                {
+                    time_descriptors_[name] = static_cast<TSample>(0.0);
+                }
+
+                time_descriptors_["f0"] = static_cast<TSample>(-1.0);
+
+                if (pitch_tracking_)
+                {
+                    time_descriptors_["f0tracked"] = static_cast<TSample>(-1.0);
+                    time_descriptors_["voicing"] = static_cast<TSample>(0.0);
+                }
+            }
 
-        if (stft_size > 2u)
-        {
-            set_stft_size(stft_size);
+            if (compute_freq)
+            {
+                history_.push_silence();
+
+                for (const auto& name : frequency_descriptor_names)
+                {
+                    frequency_descriptors_[name] = static_cast<TSample>(0.0);
+                }
+
+                frequency_descriptors_["f0"] = static_cast<TSample>(-1.0);
+                spectral_flux();
+
+                if (history_.capacity() > 2u)
+                {
+                    spectral_stationarity();
+                    spectral_temporalcentroid();
+                }
+
+                if (chroma_key_)
+                {
+                    std::fill(chroma_.begin(), chroma_.end(), static_cast<TSample>(0.0));
+                    key_strengths_.fill(static_cast<TSample>(0.0));
+                    frequency_descriptors_.try_emplace("key", static_cast<TSample>(0.0));
+                    frequency_descriptors_["keystrength"] = static_cast<TSample>(0.0);
+                }
+
+                if (harmonic_analysis_ || psychoacoustic_analysis_)
+                {
+                    peaks_.clear();
+                }
+
+                if (harmonic_analysis_)
+                {
+                    for (const char* name : {"inharmonicity", "oddevenratio", "tristimulus1", "tristimulus2", "tristimulus3", "hnr"})
+                    {
+                        frequency_descriptors_[name] = static_cast<TSample>(0.0);
+                    }
+                }
+
+                if (psychoacoustic_analysis_)
+                {
+                    specific_loudness_.fill(static_cast<TSample>(0.0));
+                    frequency_descriptors_["loudness"] = static_cast<TSample>(0.0);
+                    frequency_descriptors_["sharpness"] = static_cast<TSample>(0.0);
+                    frequency_descriptors_["roughness"] = static_cast<TSample>(0.0);
+                }
+
+                if (harmonic_percussive_)
+                {
+                    harmonic_percussive_separator_.push_silence();
+                    silent_component_(previous_harmonic_, harmonic_descriptors_);
+                    silent_component_(previous_percussive_, percussive_descriptors_);
+                }
+
+                // The tempo tracker needs a value per frame, here the onset of the zero spectrum
+                if (tempo_tracking_)
+                {
+                    spectral_tempo();
+                }
+            }
         }
-        else if (magnitudes.size() > 2u)
+        else if (compute_freq && tempo_tracking_)
         {
-            set_stft_size((magnitudes_.size() - 1u) * 2u);
+            // A held frame adds no onset
+            const auto& estimate = tempo_tracker_.push(static_cast<TSample>(0.0));
+            frequency_descriptors_["tempo"] = estimate.tempo;
+            frequency_descriptors_["beatphase"] = estimate.phase;
+            frequency_descriptors_["beat"] = estimate.beat ? static_cast<TSample>(1.0) : static_cast<TSample>(0.0);
         }
-        else
+    }
+
+    // Harmonic or percussive part of a silent frame: all 0 but the flux against the previous part
+    void silent_component_(std::vector<TSample>& previous, std::unordered_map<std::string, TSample>& descriptors)
+    {
+        for (size_t d = 0; d < static_cast<size_t>(FrequencyDescriptor::F0); d++)
         {
-            set_stft_size(4096u);
+            descriptors[frequency_descriptor_names[d]] = static_cast<TSample>(0.0);
         }
 
-        if (!previous_magnitudes.empty())
+        if (!previous.empty())
         {
-            set_previous_magnitudes(previous_magnitudes);
-        }
+            Accumulator<TSample> square_sum;
 
-        set_rolloff_point(rolloff_point);
+            for (const auto& m : previous)
+            {
+                square_sum += m * m;
+            }
 
-        if (compute)
-        {
-            compute_descriptors();
+            descriptors["flux"] = std::sqrt(static_cast<TSample>(square_sum)) / static_cast<TSample>(previous.size());
+            std::fill(previous.begin(), previous.end(), static_cast<TSample>(0.0));
         }
     }
 
-    ~Informer() = default;
+    template <size_t Slots>
+    static size_t normalization_slot_(const std::array<const char*, Slots>& keys, const std::string& descriptor)
+    {
+        return static_cast<size_t>(std::find(keys.begin(), keys.end(), descriptor) - keys.begin());
+    }
 
-    bool set_sample_rate(const TSample& sample_rate)
+    void update_normalization_context_()
     {
-        if (sample_rate > static_cast<TSample>(0.0))
-        {
-            sample_rate_ = sample_rate;
+        const size_t frame_size = stft_size_ > 1u ? stft_size_ : 4096u;
+        time_normalizer_.set_context(sample_rate_, frame_size, history_.capacity());
+        frequency_normalizer_.set_context(sample_rate_, frame_size, history_.capacity());
+        harmonic_normalizer_.set_context(sample_rate_, frame_size, history_.capacity());
+        percussive_normalizer_.set_context(sample_rate_, frame_size, history_.capacity());
+    }
 
-            if (stft_size_ > 2)
+    template <size_t Slots>
+    static void normalize_map_(std::unordered_map<std::string, TSample>& descriptors, const std::array<const char*, Slots>& keys,
+                               std::array<TSample*, Slots>& slots, size_t& bound, Normalizer<TSample, Slots>& normalizer)
+    {
+        if (bound != descriptors.size())
+        {
+            for (size_t k = 0; k < Slots; k++)
             {
-                precomputed_frequencies_ = Frequency::precompute_frequencies(stft_size_, sample_rate_);
+                const auto it = descriptors.find(keys[k]);
+                slots[k] = it != descriptors.end() ? &it->second : nullptr;
             }
 
-            return true;
+            bound = descriptors.size();
         }
 
-        return false;
-    }
-
-    bool set_rolloff_point(const TSample& rolloff)
-    {
-        if (rolloff > static_cast<TSample>(0.0) && rolloff < static_cast<TSample>(1.0))
+        std::array<TSample, Slots> values = {};
+        for (size_t k = 0; k < Slots; k++)
         {
-            rolloff_point_ = rolloff;
-
-            return true;
+            values[k] = slots[k] != nullptr ? *slots[k] : static_cast<TSample>(0.0);
         }
 
-        return false;
-    }
+        normalizer.process(values);
 
-    bool set_stft_size(const unsigned int& stft_size)
-    {
-        if (stft_size > 2u)
+        for (size_t k = 0; k < Slots; k++)
         {
-            stft_size_ = stft_size;
-
-            precomputed_frequencies_ = Frequency::precompute_frequencies(stft_size_, sample_rate_);
-
-            return true;
+            if (slots[k] != nullptr)
+            {
+                *slots[k] = values[k];
+            }
         }
-
-        return false;
     }
 
-    bool set_magnitudes_from_stft(const std::vector<TSample>& stft)
+    // Fundamental for the harmonic descriptors: tracked pitch, YIN or HPS estimate
+    TSample harmonic_f0_() const
     {
-        if (stft.size() > 2u)
-        {
-            set_magnitudes(Frequency::magnitudes(stft), true);
+        const TSample tracked = pitch_tracking_ ? get_time_descriptor("f0tracked") : static_cast<TSample>(0.0);
+        const TSample yin = get_time_descriptor("f0");
 
-            return true;
+        if (tracked > static_cast<TSample>(0.0))
+        {
+            return tracked;
         }
 
-        return false;
+        return yin > static_cast<TSample>(0.0) ? yin : get_frequency_descriptor("f0");
     }
 
-    bool set_previous_magnitudes_from_stft(const std::vector<TSample>& previous_stft)
+    // Single frame spectral descriptors of a harmonic or percussive part, the flux against
+    // the previous part (kept in previous, copied without reallocation once sized)
+    void component_descriptors_(const std::vector<TSample>& magnitudes, std::vector<TSample>& previous,
+                                std::unordered_map<std::string, TSample>& descriptors)
     {
-        if (previous_stft.size() > 2u)
-        {
-            set_previous_magnitudes(Frequency::magnitudes(previous_stft));
+        TSample& centroid = descriptors["centroid"];
+        TSample& spread = descriptors["spread"];
 
-            return true;
-        }
+        centroid = Frequency::centroid(magnitudes, sample_rate_, precomputed_frequencies_);
+        spread = Frequency::spread(magnitudes, sample_rate_, precomputed_frequencies_, centroid);
+        descriptors["crestfactor"] = Frequency::crestfactor(magnitudes);
+        descriptors["decrease"] = Frequency::decrease(magnitudes);
+        descriptors["entropy"] = Frequency::entropy(magnitudes);
+        descriptors["flatness"] = Frequency::flatness(magnitudes);
+        descriptors["flux"] = Frequency::flux(magnitudes, previous);
+        descriptors["irregularity"] = Frequency::irregularity(magnitudes);
+        descriptors["kurtosis"] = Frequency::kurtosis(magnitudes, sample_rate_, precomputed_frequencies_, centroid, spread);
+        descriptors["peak"] = Frequency::peak(magnitudes, sample_rate_, precomputed_frequencies_);
+        descriptors["rolloff"] = Frequency::rolloff(magnitudes, sample_rate_, rolloff_point_, precomputed_frequencies_);
+        descriptors["skewness"] = Frequency::skewness(magnitudes, sample_rate_, precomputed_frequencies_, centroid, spread);
+        descriptors["slope"] = Frequency::slope(magnitudes, sample_rate_, precomputed_frequencies_);
 
-        return false;
+        previous.assign(magnitudes.begin(), magnitudes.end());
     }
+};
 
-    bool set_magnitudes(const std::vector<TSample>& magnitudes, bool update_stft_size = false)
-    {
-        if (magnitudes.size() > 2)
-        {
-            if (!magnitudes_.empty())
-            {
-                set_previous_magnitudes(magnitudes_);
-            }
-            else
-            {
-                previous_magnitudes_.resize(magnitudes_.size(), static_cast<TSample>(0.0));
-            }
 
-            if (magnitudes.size() != magnitudes_.size() && update_stft_size)
-            {
-                magnitudes_ = magnitudes;
-                set_stft_size((magnitudes_.size() - 1u) * 2u);
-            }
-            else
-            {
-                magnitudes_ = magnitudes;
-            }
+/* FIXED SIZE CLASS INTERFACE */
 
-            return true;
-        }
+// Informer with a frame size known at compile time: all the storage is held in std::array members
+// (no heap allocation at all), the bin grid and the window are constexpr tables and every loop
+// has a compile-time bound. Descriptors share fused passes over the buffer and the magnitudes and
+// follow the same definitions of the functions in the Amplitude and Frequency namespaces.
+// Magnitudes are expected to be FrameSize / 2 + 1 values, as returned by Frequency::magnitudes().
+template <typename TSample, size_t FrameSize, bool HannWindow = true>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+class FixedInformer
+{
+public:
+    static_assert(FrameSize >= 8u && FrameSize % 2u == 0u, "FrameSize must be an even number of at least 8 samples");
 
-        return false;
+    static constexpr size_t frame_size = FrameSize;
+    static constexpr size_t bins = FrameSize / 2u + 1u;
+
+    FixedInformer(const TSample& sample_rate = static_cast<TSample>(44100.0),
+                  const TSample& rolloff_point = static_cast<TSample>(0.85))
+    {
+        set_sample_rate(sample_rate);
+        set_rolloff_point(rolloff_point);
     }
 
-    bool set_previous_magnitudes(const std::vector<TSample>& previous_magnitudes)
+    ~FixedInformer() = default;
+
+    bool set_sample_rate(const TSample& sample_rate)
     {
-        if (previous_magnitudes.size() == magnitudes_.size())
+        if (sample_rate > static_cast<TSample>(0.0))
         {
-            previous_magnitudes_ = previous_magnitudes;
+            sample_rate_ = sample_rate;
+            fft_bandwidth_ = sample_rate_ / static_cast<TSample>(FrameSize);
+            time_normalizer_.set_context(sample_rate_, FrameSize);
+            frequency_normalizer_.set_context(sample_rate_, FrameSize);
 
             return true;
         }
@@ -1315,11 +5520,11 @@ public:
         return false;
     }
 
-    bool set_buffer(const std::vector<TSample>& buffer)
+    bool set_rolloff_point(const TSample& rolloff)
     {
-        if (!buffer.empty())
+        if (rolloff > static_cast<TSample>(0.0) && rolloff < static_cast<TSample>(1.0))
         {
-            buffer_ = buffer;
+            rolloff_point_ = rolloff;
 
             return true;
         }
@@ -1327,144 +5532,58 @@ public:
         return false;
     }
 
-    bool compute_descriptors(bool compute_time = true, bool compute_freq = true)
+    // Copy FrameSize samples
+    void set_buffer(const TSample* buffer)
     {
-        // Time domain descriptors
-        if (!buffer_.empty() && compute_time)
-        {
-            amp_peak();
-            amp_rms();
-            amp_variance();
-            amp_kurtosis();
-            amp_skewness();
-            amp_f0yin();
-            amp_zerocrossing();
-        }
-
-        // Frequency domain descriptors
-        if (magnitudes_.size() > 2 && compute_freq)
-        {
-            spectral_centroid();
-            spectral_spread();
-            spectral_crestfactor();
-            spectral_decrease();
-            spectral_entropy();
-            spectral_flatness();
-            spectral_flux();
-            spectral_irregularity();
-            spectral_kurtosis();
-            spectral_peak();
-            spectral_rolloff();
-            spectral_skewness();
-            spectral_slope();
-            fundamental_pitch();
-        }
-
-        return true;
+        std::copy(buffer, buffer + FrameSize, buffer_.begin());
     }
 
-    // Normalize descriptors inside [0, 1] range, some normalizations are performed
-    // on euristic bases, use only for artistic purposes
-    void normalize_descriptors()
+    void set_buffer(const std::array<TSample, FrameSize>& buffer)
     {
-        if (time_descriptors_.find("kurtosis") != time_descriptors_.end())
-        {
-            time_descriptors_.at("kurtosis") += static_cast<TSample>(2.0);
-            time_descriptors_.at("kurtosis") = std::clamp(time_descriptors_.at("kurtosis"), static_cast<TSample>(0.0), static_cast<TSample>(4.0));
-            time_descriptors_.at("kurtosis") *= static_cast<TSample>(0.25);
-        }
-
-        if (time_descriptors_.find("skewness") != time_descriptors_.end())
-        {
-            time_descriptors_.at("skewness") = std::clamp(time_descriptors_.at("skewness"), static_cast<TSample>(-5.0), static_cast<TSample>(5.0));
-            time_descriptors_.at("skewness") += static_cast<TSample>(5.0);
-            time_descriptors_.at("skewness") *= static_cast<TSample>(0.1);
-        }
-
-        if (frequency_descriptors_.find("kurtosis") != frequency_descriptors_.end())
-        {
-            frequency_descriptors_.at("kurtosis") += static_cast<TSample>(2.0);
-            frequency_descriptors_.at("kurtosis") = std::clamp(frequency_descriptors_.at("kurtosis"), static_cast<TSample>(0.0), static_cast<TSample>(40.0));
-            frequency_descriptors_.at("kurtosis") *= static_cast<TSample>(0.025);
-        }
-
-        TSample invNyquist = static_cast<TSample>(1.0) / (sample_rate_ * 0.5);
-
-        if (frequency_descriptors_.find("centroid") != frequency_descriptors_.end())
-        {
-            frequency_descriptors_.at("centroid") *= invNyquist;
-        }
-
-        if (frequency_descriptors_.find("decrease") != frequency_descriptors_.end())
-        {
-            frequency_descriptors_.at("decrease") += static_cast<TSample>(0.05);
-            frequency_descriptors_.at("decrease") *= static_cast<TSample>(10.0);
-            frequency_descriptors_.at("decrease") = std::clamp(frequency_descriptors_.at("decrease"), static_cast<TSample>(0.0), static_cast<TSample>(1.0));
-        }
-
-        if (frequency_descriptors_.find("flux") != frequency_descriptors_.end())
-        {
-            if (stft_size_ > 1u)
-            {
-                frequency_descriptors_.at("flux") /= static_cast<TSample>(stft_size_) * static_cast<TSample>(0.5);
-                frequency_descriptors_.at("flux") = std::clamp(frequency_descriptors_.at("flux"), static_cast<TSample>(0.0), static_cast<TSample>(1.0));
-            }
-        }
-
-        if (frequency_descriptors_.find("irregularity") != frequency_descriptors_.end())
-        {
-            frequency_descriptors_.at("irregularity") *= static_cast<TSample>(0.5);
-            frequency_descriptors_.at("irregularity") = std::clamp(frequency_descriptors_.at("irregularity"), static_cast<TSample>(0.0), static_cast<TSample>(1.0));
-        }
-
-        if (frequency_descriptors_.find("peak") != frequency_descriptors_.end())
-        {
-            frequency_descriptors_.at("peak") *= invNyquist;
-        }
+        buffer_ = buffer;
+    }
 
-        if (frequency_descriptors_.find("rolloff") != frequency_descriptors_.end())
-        {
-            frequency_descriptors_.at("rolloff") *= invNyquist;
-        }
+    // Copy bins magnitudes, the current ones become the previous ones without copying
+    void set_magnitudes(const TSample* magnitudes)
+    {
+        current_ ^= 1u;
+        std::copy(magnitudes, magnitudes + bins, magnitudes_[current_].begin());
+    }
 
-        if (frequency_descriptors_.find("skewness") != frequency_descriptors_.end())
-        {
-            frequency_descriptors_.at("skewness") = std::clamp(frequency_descriptors_.at("skewness"), static_cast<TSample>(-5.0), static_cast<TSample>(5.0));
-            frequency_descriptors_.at("skewness") += static_cast<TSample>(5.0);
-            frequency_descriptors_.at("skewness") *= static_cast<TSample>(0.1);
-        }
+    void set_magnitudes(const std::array<TSample, bins>& magnitudes)
+    {
+        set_magnitudes(magnitudes.data());
+    }
 
-        if (frequency_descriptors_.find("slope") != frequency_descriptors_.end())
-        {
-            frequency_descriptors_.at("slope") += static_cast<TSample>(1.0);
-            frequency_descriptors_.at("slope") *= static_cast<TSample>(0.5);
-            frequency_descriptors_.at("slope") = std::clamp(frequency_descriptors_.at("slope"), static_cast<TSample>(0.0), static_cast<TSample>(1.0));
-        }
+    // Multiply a frame by the precomputed window, in place
+    static void apply_window(TSample* frame)
+    {
+        INFORMER_PROFILE_SCOPE("fixed_window");
 
-        if (frequency_descriptors_.find("spread") != frequency_descriptors_.end())
+        for (size_t i = 0; i < FrameSize; i++)
         {
-            frequency_descriptors_.at("spread") *= invNyquist * static_cast<TSample>(0.5);
+            frame[i] *= window_[i];
         }
     }
 
-    std::vector<TSample> get_magnitudes() const
+    static constexpr const std::array<TSample, FrameSize>& get_window()
     {
-        return magnitudes_;
+        return window_;
     }
 
-    std::vector<TSample> get_previous_magnitudes() const
+    const std::array<TSample, FrameSize>& get_buffer() const
     {
-        return previous_magnitudes_;
+        return buffer_;
     }
 
-    std::vector<TSample> get_buffer() const
+    const std::array<TSample, bins>& get_magnitudes() const
     {
-        return buffer_;
+        return magnitudes_[current_];
     }
 
-    unsigned int get_stft_size() const
+    const std::array<TSample, bins>& get_previous_magnitudes() const
     {
-        return stft_size_;
+        return magnitudes_[current_ ^ 1u];
     }
 
     TSample get_sample_rate() const
@@ -1477,16 +5596,24 @@ public:
         return rolloff_point_;
     }
 
-    std::vector<TSample> get_precomputed_frequencies() const
+    TSample get_time_descriptor(const TimeDescriptor& descriptor) const
     {
-        return precomputed_frequencies_;
+        return time_descriptors_[static_cast<size_t>(descriptor)];
+    }
+
+    TSample get_frequency_descriptor(const FrequencyDescriptor& descriptor) const
+    {
+        return frequency_descriptors_[static_cast<size_t>(descriptor)];
     }
 
     TSample get_time_descriptor(const std::string& descriptor) const
     {
-        if (time_descriptors_.find(descriptor) != time_descriptors_.end())
+        for (size_t d = 0; d < time_descriptors_.size(); d++)
         {
-            return time_descriptors_.at(descriptor);
+            if (descriptor == time_descriptor_names[d])
+            {
+                return time_descriptors_[d];
+            }
         }
 
         return static_cast<TSample>(0.0);
@@ -1494,227 +5621,366 @@ public:
 
     TSample get_frequency_descriptor(const std::string& descriptor) const
     {
-        if (frequency_descriptors_.find(descriptor) != frequency_descriptors_.end())
+        for (size_t d = 0; d < frequency_descriptors_.size(); d++)
         {
-            return frequency_descriptors_.at(descriptor);
+            if (descriptor == frequency_descriptor_names[d])
+            {
+                return frequency_descriptors_[d];
+            }
         }
 
         return static_cast<TSample>(0.0);
     }
 
-    std::unordered_map<std::string, TSample> get_time_descriptors() const
+    const std::array<TSample, static_cast<size_t>(TimeDescriptor::Count)>& get_time_descriptors() const
     {
         return time_descriptors_;
     }
 
-    std::unordered_map<std::string, TSample> get_frequency_descriptors() const
+    const std::array<TSample, static_cast<size_t>(FrequencyDescriptor::Count)>& get_frequency_descriptors() const
     {
         return frequency_descriptors_;
     }
 
-    // It is advisable to call compute_descriptors() instead of the single wrapper functions that follow
-
-    // Time domain descriptors
-    TSample amp_peak()
+    bool compute_descriptors(bool compute_time = true, bool compute_freq = true)
     {
-        time_descriptors_["peak"] = Amplitude::peak(buffer_);
-
-        return time_descriptors_["peak"];
-    }
+        if (compute_time)
+        {
+            compute_time_descriptors_();
+        }
 
-    TSample amp_rms()
-    {
-        time_descriptors_["rms"] = Amplitude::rms(buffer_);
+        if (compute_freq)
+        {
+            compute_frequency_descriptors_();
+        }
 
-        return time_descriptors_["rms"];
+        return true;
     }
 
-    TSample amp_variance()
+    // Normalize the results inside [0, 1] range, with the rules of the normalizers (by default
+    // the same heuristic ranges of Informer::normalize_descriptors())
+    void normalize_descriptors()
     {
-        time_descriptors_["variance"] = Amplitude::variance(buffer_);
-
-        return time_descriptors_["variance"];
+        time_normalizer_.process(time_descriptors_);
+        frequency_normalizer_.process(frequency_descriptors_);
     }
 
-    TSample amp_kurtosis()
+    Normalizer<TSample, static_cast<size_t>(TimeDescriptor::Count)>& get_time_normalizer()
     {
-        TSample mean = std::accumulate(buffer_.begin(), buffer_.end(),
-                                       static_cast<TSample>(0.0)) / static_cast<TSample>(buffer_.size());
-        TSample amp_variance = Amplitude::variance(buffer_);
-
-        time_descriptors_["kurtosis"] = Amplitude::kurtosis(buffer_, mean, amp_variance);
-
-        return time_descriptors_["kurtosis"];
+        return time_normalizer_;
     }
 
-    TSample amp_skewness()
+    Normalizer<TSample, static_cast<size_t>(FrequencyDescriptor::Count)>& get_frequency_normalizer()
     {
-        TSample mean = std::accumulate(buffer_.begin(), buffer_.end(),
-                                       static_cast<TSample>(0.0)) / static_cast<TSample>(buffer_.size());
-        TSample amp_variance = Amplitude::variance(buffer_);
+        return frequency_normalizer_;
+    }
 
-        time_descriptors_["skewness"] = Amplitude::skewness(buffer_, mean, amp_variance);
+private:
+    static constexpr size_t half_frame_ = FrameSize / 2u;
+
+    std::array<TSample, FrameSize> buffer_ = {};
+    std::array<std::array<TSample, bins>, 2> magnitudes_ = {};
+    std::array<TSample, half_frame_> yin_buffer_ = {};
+    std::array<TSample, static_cast<size_t>(TimeDescriptor::Count)> time_descriptors_ = {};
+    std::array<TSample, static_cast<size_t>(FrequencyDescriptor::Count)> frequency_descriptors_ = {};
+    unsigned int current_ = 0u;
+    TSample sample_rate_ = static_cast<TSample>(44100.0);
+    TSample fft_bandwidth_ = static_cast<TSample>(44100.0) / static_cast<TSample>(FrameSize);
+    TSample rolloff_point_ = static_cast<TSample>(0.85);
+    Normalizer<TSample, static_cast<size_t>(TimeDescriptor::Count)> time_normalizer_{time_normalization_rules<TSample>()};
+    Normalizer<TSample, static_cast<size_t>(FrequencyDescriptor::Count)> frequency_normalizer_{frequency_normalization_rules<TSample>()};
 
-        return time_descriptors_["skewness"];
+    static constexpr size_t td_(const TimeDescriptor& d)
+    {
+        return static_cast<size_t>(d);
     }
 
-    TSample amp_f0yin()
+    static constexpr size_t fd_(const FrequencyDescriptor& d)
     {
-        time_descriptors_["f0"] = Amplitude::yin(buffer_, sample_rate_);
-
-        return time_descriptors_["f0"];
+        return static_cast<size_t>(d);
     }
 
-    TSample amp_zerocrossing()
+    // Compile-time cosine (range reduction and Taylor series), used only to build the tables
+    static constexpr double constexpr_cos_(double x)
     {
-        time_descriptors_["zerocrossing"] = Amplitude::zerocrossing(buffer_);
-
-        return time_descriptors_["zerocrossing"];
+        constexpr double two_pi = 6.28318530717958647692;
+        x -= two_pi * static_cast<double>(static_cast<long long>(x / two_pi));
+        if (x > two_pi * 0.5)
+        {
+            x -= two_pi;
+        }
+        double term = 1.0;
+        double sum = 1.0;
+        for (int n = 1; n < 24; n++)
+        {
+            term *= -x * x / static_cast<double>((2 * n - 1) * (2 * n));
+            sum += term;
+        }
+        return sum;
     }
 
-    // Frequency domain descriptors
-    TSample spectral_centroid()
+    static constexpr std::array<TSample, FrameSize> make_window_()
     {
-        frequency_descriptors_["centroid"] = Frequency::centroid(magnitudes_, sample_rate_,
-                                             precomputed_frequencies_);
-
-        return frequency_descriptors_["centroid"];
+        constexpr double two_pi = 6.28318530717958647692;
+        std::array<TSample, FrameSize> window = {};
+        for (size_t i = 0; i < FrameSize; i++)
+        {
+            double x = two_pi * static_cast<double>(i) / static_cast<double>(FrameSize - 1u);
+            if (HannWindow)
+            {
+                window[i] = static_cast<TSample>(0.5 * (1.0 - constexpr_cos_(x)));
+            }
+            else
+            {
+                window[i] = static_cast<TSample>(0.35875 - 0.48829 * constexpr_cos_(x) +
+                                                 0.14128 * constexpr_cos_(2.0 * x) - 0.01168 * constexpr_cos_(3.0 * x));
+            }
+        }
+        return window;
     }
 
-    TSample spectral_crestfactor()
+    // Bin indices (the frequency grid in units of the FFT bandwidth) and their reciprocals
+    static constexpr std::array<TSample, bins> make_grid_()
     {
-        frequency_descriptors_["crestfactor"] = Frequency::crestfactor(magnitudes_);
-
-        return frequency_descriptors_["crestfactor"];
+        std::array<TSample, bins> grid = {};
+        for (size_t k = 0; k < bins; k++)
+        {
+            grid[k] = static_cast<TSample>(k);
+        }
+        return grid;
     }
 
-    TSample spectral_decrease()
+    static constexpr std::array<TSample, bins> make_inverse_grid_()
     {
-        frequency_descriptors_["decrease"] = Frequency::decrease(magnitudes_);
-
-        return frequency_descriptors_["decrease"];
+        std::array<TSample, bins> inverse_grid = {};
+        for (size_t k = 1; k < bins; k++)
+        {
+            inverse_grid[k] = static_cast<TSample>(1.0 / static_cast<double>(k));
+        }
+        return inverse_grid;
     }
 
-    TSample spectral_entropy()
+    static constexpr std::array<TSample, FrameSize> window_ = make_window_();
+    static constexpr std::array<TSample, bins> grid_ = make_grid_();
+    static constexpr std::array<TSample, bins> inverse_grid_ = make_inverse_grid_();
+    static constexpr TSample grid_mean_ = static_cast<TSample>(bins - 1u) * static_cast<TSample>(0.5);
+    // Sum of the squared deviations of the bin indices from their mean
+    static constexpr TSample grid_deviation_ = static_cast<TSample>(static_cast<double>(bins) * (static_cast<double>(bins) * static_cast<double>(bins) - 1.0) / 12.0);
+
+    inline void compute_time_descriptors_()
     {
-        frequency_descriptors_["entropy"] = Frequency::entropy(magnitudes_);
+        INFORMER_PROFILE_SCOPE("fixed_time_descriptors");
 
-        return frequency_descriptors_["entropy"];
-    }
+        auto& t = time_descriptors_;
+        const TSample count = static_cast<TSample>(FrameSize);
 
-    TSample spectral_flatness()
-    {
-        frequency_descriptors_["flatness"] = Frequency::flatness(magnitudes_);
+        TSample peak = static_cast<TSample>(0.0);
+        Accumulator<TSample> sum;
+        Accumulator<TSample> square_sum;
+        TSample crossings = static_cast<TSample>(0.0);
 
-        return frequency_descriptors_["flatness"];
-    }
+        for (size_t i = 0; i < FrameSize; i++)
+        {
+            const TSample s = buffer_[i];
+            peak = std::max(peak, std::abs(s));
+            sum += s;
+            square_sum += s * s;
+            if (i > 0)
+            {
+                crossings += std::signbit(s) != std::signbit(buffer_[i - 1]) ? static_cast<TSample>(1.0) : static_cast<TSample>(0.0);
+            }
+        }
 
-    TSample spectral_flux()
-    {
-        frequency_descriptors_["flux"] = Frequency::flux(magnitudes_, previous_magnitudes_);
+        const TSample mean = sum / count;
+        Accumulator<TSample> m2;
+        Accumulator<TSample> m3;
+        Accumulator<TSample> m4;
 
-        return frequency_descriptors_["flux"];
-    }
+        for (size_t i = 0; i < FrameSize; i++)
+        {
+            const TSample d = buffer_[i] - mean;
+            const TSample d2 = d * d;
+            m2 += d2;
+            m3 += d2 * d;
+            m4 += d2 * d2;
+        }
 
-    TSample spectral_irregularity()
-    {
-        frequency_descriptors_["irregularity"] = Frequency::irregularity(magnitudes_);
+        const TSample variance = m2 / count;
 
-        return frequency_descriptors_["irregularity"];
-    }
+        t[td_(TimeDescriptor::Peak)] = peak;
+        t[td_(TimeDescriptor::Rms)] = std::sqrt(square_sum / count);
+        t[td_(TimeDescriptor::Variance)] = variance;
+        t[td_(TimeDescriptor::ZeroCrossing)] = crossings / static_cast<TSample>(FrameSize - 1u);
 
-    TSample spectral_kurtosis()
-    {
-        if (frequency_descriptors_.find("centroid") == frequency_descriptors_.end())
+        if (variance <= std::numeric_limits<TSample>::epsilon())
         {
-            spectral_centroid();
+            t[td_(TimeDescriptor::Kurtosis)] = static_cast<TSample>(0.0);
+            t[td_(TimeDescriptor::Skewness)] = static_cast<TSample>(0.0);
         }
-
-        if (frequency_descriptors_.find("spread") == frequency_descriptors_.end())
+        else
         {
-            spectral_spread();
+            t[td_(TimeDescriptor::Kurtosis)] = m4 / count / (variance * variance) - static_cast<TSample>(3.0);
+            t[td_(TimeDescriptor::Skewness)] = m3 / count / std::pow(std::sqrt(variance), static_cast<TSample>(3.0));
         }
 
-        frequency_descriptors_["kurtosis"] = Frequency::kurtosis(magnitudes_, sample_rate_,
-                                             precomputed_frequencies_, frequency_descriptors_["centroid"],
-                                             frequency_descriptors_["spread"]);
-
-        return frequency_descriptors_["kurtosis"];
+        Amplitude::yin_difference(buffer_, yin_buffer_, half_frame_);
+        const TSample pitch_period = Amplitude::yin_refine_tau(yin_buffer_, Amplitude::yin_tau(yin_buffer_, half_frame_, static_cast<TSample>(0.15)));
+        t[td_(TimeDescriptor::F0)] = pitch_period > static_cast<TSample>(0.0) ? sample_rate_ / pitch_period : static_cast<TSample>(-1.0);
     }
 
-    TSample spectral_peak()
+    inline void compute_frequency_descriptors_()
     {
-        frequency_descriptors_["peak"] = Frequency::peak(magnitudes_, sample_rate_,
-                                         precomputed_frequencies_);
+        INFORMER_PROFILE_SCOPE("fixed_frequency_descriptors");
 
-        return frequency_descriptors_["peak"];
-    }
+        auto& f = frequency_descriptors_;
+        const auto& magnitudes = magnitudes_[current_];
+        const auto& previous_magnitudes = magnitudes_[current_ ^ 1u];
 
-    TSample spectral_rolloff()
-    {
-        frequency_descriptors_["rolloff"] = Frequency::rolloff(magnitudes_, sample_rate_,
-                                            rolloff_point_, precomputed_frequencies_);
+        // First pass: all the sums that do not depend on other descriptors
+        Accumulator<TSample> magn_sum;
+        Accumulator<TSample> weighted_sum;
+        Accumulator<TSample> power_sum;
+        Accumulator<TSample> ln_magn_sum;
+        Accumulator<TSample> magn_diff_sum;
+        Accumulator<TSample> irregularity;
+        Accumulator<TSample> flux;
+        TSample magn_max = static_cast<TSample>(0.0);
+        size_t magn_max_idx = 0;
+        const TSample magn_first = std::abs(magnitudes[0]);
+        const TSample ln_floor = std::log(static_cast<TSample>(0.00001));
 
-        return frequency_descriptors_["rolloff"];
-    }
+        for (size_t k = 0; k < bins; k++)
+        {
+            const TSample m = std::abs(magnitudes[k]);
+            magn_sum += m;
+            weighted_sum += grid_[k] * m;
+            power_sum += magnitudes[k] * magnitudes[k];
+            ln_magn_sum += m > static_cast<TSample>(0.0) ? std::log(m) : ln_floor;
+            magn_diff_sum += (m - magn_first) * inverse_grid_[k];
+            const TSample d = m - std::abs(previous_magnitudes[k]);
+            flux += d * d;
+            if (k > 0)
+            {
+                irregularity += std::abs(magnitudes[k] - magnitudes[k - 1u]);
+            }
+            if (m > magn_max)
+            {
+                magn_max = m;
+                magn_max_idx = k;
+            }
+        }
 
-    TSample spectral_skewness()
-    {
-        if (frequency_descriptors_.find("centroid") == frequency_descriptors_.end())
+        const TSample inv_bins = static_cast<TSample>(1.0) / static_cast<TSample>(bins);
+        const bool has_energy = magn_sum > static_cast<TSample>(0.0);
+        const TSample centroid_bin = has_energy ? weighted_sum / magn_sum : static_cast<TSample>(0.0);
+
+        // Second pass: central moments, entropy and rolloff
+        Accumulator<TSample> m2;
+        Accumulator<TSample> m3;
+        Accumulator<TSample> m4;
+        Accumulator<TSample> entropy;
+        Accumulator<TSample> cumul_magn;
+        const TSample rolloff_thresh = rolloff_point_ * magn_sum;
+        size_t rolloff_idx = bins - 1u;
+        bool rolloff_found = false;
+        const TSample inv_power_sum = power_sum > static_cast<TSample>(0.0) ? static_cast<TSample>(1.0) / power_sum : static_cast<TSample>(0.0);
+
+        for (size_t k = 0; k < bins; k++)
         {
-            spectral_centroid();
+            const TSample m = std::abs(magnitudes[k]);
+            const TSample d = grid_[k] - centroid_bin;
+            const TSample d2 = d * d;
+            m2 += d2 * m;
+            m3 += d2 * d * m;
+            m4 += d2 * d2 * m;
+
+            const TSample p = magnitudes[k] * magnitudes[k] * inv_power_sum;
+            if (p > static_cast<TSample>(0.0))
+            {
+                entropy += p * std::log2(p);
+            }
+
+            cumul_magn += m;
+            if (!rolloff_found && cumul_magn >= rolloff_thresh)
+            {
+                rolloff_idx = k;
+                rolloff_found = true;
+            }
         }
 
-        if (frequency_descriptors_.find("spread") == frequency_descriptors_.end())
+        const TSample spread_bin = has_energy ? std::sqrt(m2 / magn_sum) : static_cast<TSample>(0.0);
+
+        f[fd_(FrequencyDescriptor::Centroid)] = centroid_bin * fft_bandwidth_;
+        f[fd_(FrequencyDescriptor::Spread)] = spread_bin * fft_bandwidth_;
+        f[fd_(FrequencyDescriptor::CrestFactor)] = has_energy ? magn_max / magn_sum : static_cast<TSample>(0.0);
+        f[fd_(FrequencyDescriptor::Decrease)] = magn_sum - magn_first > static_cast<TSample>(0.0) ? magn_diff_sum / (magn_sum - magn_first) : static_cast<TSample>(0.0);
+        f[fd_(FrequencyDescriptor::Entropy)] = -entropy / std::log2(static_cast<TSample>(bins));
+        f[fd_(FrequencyDescriptor::Flatness)] = has_energy ? std::exp(ln_magn_sum * inv_bins) / (magn_sum * inv_bins) : static_cast<TSample>(0.0);
+        f[fd_(FrequencyDescriptor::Flux)] = std::sqrt(static_cast<TSample>(flux)) * inv_bins;
+        f[fd_(FrequencyDescriptor::Irregularity)] = has_energy ? irregularity / magn_sum : static_cast<TSample>(0.0);
+        f[fd_(FrequencyDescriptor::Peak)] = static_cast<TSample>(magn_max_idx) * fft_bandwidth_;
+        f[fd_(FrequencyDescriptor::Rolloff)] = static_cast<TSample>(rolloff_idx) * fft_bandwidth_;
+
+        // Central moments are scale invariant, so they can be computed on the bin grid
+        if (has_energy && spread_bin > static_cast<TSample>(0.0))
         {
-            spectral_spread();
+            const TSample spread_2 = spread_bin * spread_bin;
+            f[fd_(FrequencyDescriptor::Kurtosis)] = m4 / (magn_sum * spread_2 * spread_2) - static_cast<TSample>(3.0);
+            f[fd_(FrequencyDescriptor::Skewness)] = m3 / (magn_sum * spread_2 * spread_bin);
+        }
+        else
+        {
+            f[fd_(FrequencyDescriptor::Kurtosis)] = static_cast<TSample>(0.0);
+            f[fd_(FrequencyDescriptor::Skewness)] = static_cast<TSample>(0.0);
         }
 
-        frequency_descriptors_["skewness"] = Frequency::skewness(magnitudes_, sample_rate_, precomputed_frequencies_,
-                                             frequency_descriptors_["centroid"], frequency_descriptors_["spread"]);
+        // Slope: sum((k - mean_k) * (m - mean_m)) = sum(k * m) - bins * mean_k * mean_m
+        const TSample slope_numerator = static_cast<TSample>(weighted_sum.precise_result() - grid_mean_ * magn_sum.precise_result());
+        f[fd_(FrequencyDescriptor::Slope)] = slope_numerator / (grid_deviation_ * fft_bandwidth_);
 
-        return frequency_descriptors_["skewness"];
+        f[fd_(FrequencyDescriptor::F0)] = f0_hps_(magnitudes);
     }
 
-    TSample spectral_slope()
+    // Same as Frequency::f0_hps() with a compression of 5, without the filtered copy of the magnitudes
+    inline TSample f0_hps_(const std::array<TSample, bins>& magnitudes) const
     {
-        frequency_descriptors_["slope"] = Frequency::slope(magnitudes_, sample_rate_,
-                                          precomputed_frequencies_);
+        constexpr size_t max_compression = 5u;
 
-        return frequency_descriptors_["slope"];
-    }
+        size_t low_bin = static_cast<size_t>(std::ceil(static_cast<TSample>(50.0) / fft_bandwidth_));
+        size_t high_bin = std::min(static_cast<size_t>(std::floor(static_cast<TSample>(10000.0) / fft_bandwidth_)), bins - 1u);
 
-    TSample spectral_spread()
-    {
-        if (frequency_descriptors_.find("centroid") == frequency_descriptors_.end())
+        if (high_bin < low_bin || high_bin - low_bin + 1u < max_compression)
         {
-            spectral_centroid();
+            return static_cast<TSample>(0.0);
         }
 
-        frequency_descriptors_["spread"] = Frequency::spread(magnitudes_, sample_rate_,
-                                           precomputed_frequencies_, frequency_descriptors_["centroid"]);
+        const size_t filtered_size = high_bin - low_bin + 1u;
+        const size_t hps_length = filtered_size / max_compression;
 
-        return frequency_descriptors_["spread"];
-    }
+        if (hps_length < 2u)
+        {
+            return static_cast<TSample>(0.0);
+        }
 
-    TSample fundamental_pitch()
-    {
-        frequency_descriptors_["f0"] = Frequency::f0_hps(magnitudes_, 5u, sample_rate_,
-                                                         precomputed_frequencies_);
+        TSample max_product = -std::numeric_limits<TSample>::infinity();
+        size_t k_peak = 0;
 
-        return frequency_descriptors_["f0"];
-    }
+        for (size_t k = 0; k < hps_length; k++)
+        {
+            TSample product = magnitudes[low_bin + k];
+            for (size_t n = 2u; n <= max_compression; n++)
+            {
+                product *= magnitudes[low_bin + n * k];
+            }
+            if (product > max_product)
+            {
+                max_product = product;
+                k_peak = k;
+            }
+        }
 
-private:
-    std::vector<TSample> precomputed_frequencies_ = {};
-    std::vector<TSample> magnitudes_ = {};
-    std::vector<TSample> previous_magnitudes_ = {};
-    std::vector<TSample> buffer_ = {};
-    unsigned int stft_size_ = 0u;
-    TSample sample_rate_ = static_cast<TSample>(44100.0);
-    TSample rolloff_point_ = static_cast<TSample>(0.85);
-    std::unordered_map<std::string, TSample> time_descriptors_;
-    std::unordered_map<std::string, TSample> frequency_descriptors_;
+        return static_cast<TSample>(k_peak + low_bin) * fft_bandwidth_;
+    }
 };
 
 } // namespace Informer
@@ -0,0 +1,607 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef INFORMER_CODEC_H_
+#define INFORMER_CODEC_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <vector>
+
+#if __cplusplus >= 202002L
+#include <bit>
+#endif
+
+namespace Informer
+{
+
+/* LOSSLESS COMPRESSION OF DESCRIPTOR TRACKS */
+
+// Each column (a run of float32 values of one descriptor) is encoded on its own,
+// so any column of any block can be decoded without touching the others.
+// Three encodings are available, encode() keeps the smallest one:
+//   Xor:   Gorilla-style XOR of each value with the previous one, storing only
+//          the meaningful bits, best for smooth tracks
+//   Delta: delta + zigzag + bit packing in groups of 64 values, on the values
+//          themselves when they are all integers (e.g. key, counts), otherwise on
+//          an order preserving integer mapping of the float bits
+//   Raw:   the values verbatim, when nothing better is found
+// All of them reproduce the input bits exactly, NaN included.
+// Optionally a column can be quantized to a multiple of a step before encoding
+// (the only lossy stage): the integer multiples are then delta + bit packed.
+namespace Compression
+{
+
+enum class ColumnEncoding : uint32_t
+{
+    Raw = 0,
+    Xor = 1,
+    DeltaInteger = 2,
+    DeltaBits = 3,
+    DeltaQuantized = 4
+};
+
+constexpr size_t delta_group_size = 64u;
+
+inline unsigned int count_leading_zeros(const uint32_t& x)
+{
+#if __cplusplus >= 202002L
+    return static_cast<unsigned int>(std::countl_zero(x));
+#elif defined(__GNUC__) || defined(__clang__)
+    return x == 0u ? 32u : static_cast<unsigned int>(__builtin_clz(x));
+#else
+    unsigned int n = 0u;
+    for (uint32_t bit = 0x80000000u; bit != 0u && !(x & bit); bit >>= 1)
+    {
+        n++;
+    }
+    return n;
+#endif
+}
+
+inline unsigned int count_trailing_zeros(const uint32_t& x)
+{
+#if __cplusplus >= 202002L
+    return static_cast<unsigned int>(std::countr_zero(x));
+#elif defined(__GNUC__) || defined(__clang__)
+    return x == 0u ? 32u : static_cast<unsigned int>(__builtin_ctz(x));
+#else
+    unsigned int n = 0u;
+    for (uint32_t bit = 1u; bit != 0u && !(x & bit); bit <<= 1)
+    {
+        n++;
+    }
+    return n;
+#endif
+}
+
+inline unsigned int bit_width(const uint64_t& x)
+{
+    unsigned int width = 0u;
+    for (uint64_t v = x; v != 0u; v >>= 1)
+    {
+        width++;
+    }
+    return width;
+}
+
+// UTILITY CLASS: LSB first bit stream writer
+class BitWriter
+{
+public:
+    explicit BitWriter(std::vector<uint8_t>& bytes) : bytes_(bytes)
+    {
+    }
+
+    // Up to 57 bits per call
+    void write(const uint64_t& value, const unsigned int& bits)
+    {
+        if (bits == 0u)
+        {
+            return;
+        }
+
+        accumulator_ |= (value & (bits == 64u ? ~0ull : ((1ull << bits) - 1u))) << filled_;
+        filled_ += bits;
+
+        while (filled_ >= 8u)
+        {
+            bytes_.push_back(static_cast<uint8_t>(accumulator_));
+            accumulator_ >>= 8;
+            filled_ -= 8u;
+        }
+    }
+
+    void write_wide(const uint64_t& value, const unsigned int& bits)
+    {
+        if (bits > 32u)
+        {
+            write(value, 32u);
+            write(value >> 32, bits - 32u);
+        }
+        else
+        {
+            write(value, bits);
+        }
+    }
+
+    void flush()
+    {
+        if (filled_ > 0u)
+        {
+            bytes_.push_back(static_cast<uint8_t>(accumulator_));
+            accumulator_ = 0u;
+            filled_ = 0u;
+        }
+    }
+
+private:
+    std::vector<uint8_t>& bytes_;
+    uint64_t accumulator_ = 0u;
+    unsigned int filled_ = 0u;
+};
+
+// UTILITY CLASS: LSB first bit stream reader, reading past the end returns zeros
+// and sets the overrun flag
+class BitReader
+{
+public:
+    BitReader(const uint8_t* bytes, const size_t& size) : bytes_(bytes), size_(size)
+    {
+    }
+
+    // Up to 57 bits per call
+    uint64_t read(const unsigned int& bits)
+    {
+        if (bits == 0u)
+        {
+            return 0u;
+        }
+
+        while (filled_ < bits)
+        {
+            uint64_t byte = 0u;
+
+            if (position_ < size_)
+            {
+                byte = bytes_[position_];
+            }
+            else
+            {
+                overrun_ = true;
+            }
+
+            position_++;
+            accumulator_ |= byte << filled_;
+            filled_ += 8u;
+        }
+
+        const uint64_t value = accumulator_ & ((1ull << bits) - 1u);
+        accumulator_ >>= bits;
+        filled_ -= bits;
+
+        return value;
+    }
+
+    uint64_t read_wide(const unsigned int& bits)
+    {
+        if (bits > 32u)
+        {
+            const uint64_t low = read(32u);
+
+            return low | (read(bits - 32u) << 32);
+        }
+
+        return read(bits);
+    }
+
+    bool overrun() const
+    {
+        return overrun_;
+    }
+
+private:
+    const uint8_t* bytes_;
+    size_t size_;
+    size_t position_ = 0u;
+    uint64_t accumulator_ = 0u;
+    unsigned int filled_ = 0u;
+    bool overrun_ = false;
+};
+
+inline uint32_t float_bits(const float& value)
+{
+    uint32_t bits;
+    std::memcpy(&bits, &value, sizeof(float));
+    return bits;
+}
+
+inline float bits_float(const uint32_t& bits)
+{
+    float value;
+    std::memcpy(&value, &bits, sizeof(float));
+    return value;
+}
+
+// Monotonic mapping of the float bits: close values get close integers
+inline uint32_t ordered_bits(const uint32_t& bits)
+{
+    return (bits & 0x80000000u) ? ~bits : bits | 0x80000000u;
+}
+
+inline uint32_t unordered_bits(const uint32_t& key)
+{
+    return (key & 0x80000000u) ? key & 0x7fffffffu : ~key;
+}
+
+inline uint64_t zigzag(const int64_t& value)
+{
+    return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+inline int64_t unzigzag(const uint64_t& value)
+{
+    return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1u);
+}
+
+// XOR (GORILLA) ENCODING
+inline void encode_xor(const float* values, const size_t& count, std::vector<uint8_t>& payload)
+{
+    payload.clear();
+
+    if (count == 0u)
+    {
+        return;
+    }
+
+    BitWriter writer(payload);
+    uint32_t previous = float_bits(values[0]);
+    unsigned int previous_leading = 33u;
+    unsigned int previous_trailing = 0u;
+
+    writer.write(previous, 32u);
+
+    for (size_t i = 1; i < count; i++)
+    {
+        const uint32_t current = float_bits(values[i]);
+        const uint32_t x = current ^ previous;
+
+        if (x == 0u)
+        {
+            writer.write(0u, 1u);
+        }
+        else
+        {
+            const unsigned int leading = std::min(count_leading_zeros(x), 31u);
+            const unsigned int trailing = count_trailing_zeros(x);
+
+            if (previous_leading <= leading && previous_trailing <= trailing)
+            {
+                // Meaningful bits fit in the previous window
+                writer.write(0b01u, 2u);
+                writer.write(x >> previous_trailing, 32u - previous_leading - previous_trailing);
+            }
+            else
+            {
+                const unsigned int length = 32u - leading - trailing;
+                writer.write(0b11u, 2u);
+                writer.write(leading, 5u);
+                writer.write(length - 1u, 5u);
+                writer.write(x >> trailing, length);
+                previous_leading = leading;
+                previous_trailing = trailing;
+            }
+        }
+
+        previous = current;
+    }
+
+    writer.flush();
+}
+
+inline bool decode_xor(const uint8_t* payload, const size_t& size, const size_t& count, float* values)
+{
+    if (count == 0u)
+    {
+        return true;
+    }
+
+    BitReader reader(payload, size);
+    uint32_t previous = static_cast<uint32_t>(reader.read(32u));
+    unsigned int leading = 0u;
+    unsigned int trailing = 0u;
+
+    values[0] = bits_float(previous);
+
+    for (size_t i = 1; i < count; i++)
+    {
+        if (reader.read(1u) != 0u)
+        {
+            if (reader.read(1u) != 0u)
+            {
+                leading = static_cast<unsigned int>(reader.read(5u));
+                const unsigned int length = static_cast<unsigned int>(reader.read(5u)) + 1u;
+
+                if (leading + length > 32u)
+                {
+                    return false;
+                }
+
+                trailing = 32u - leading - length;
+            }
+
+            previous ^= static_cast<uint32_t>(reader.read(32u - leading - trailing)) << trailing;
+        }
+
+        values[i] = bits_float(previous);
+    }
+
+    return !reader.overrun();
+}
+
+// DELTA + ZIGZAG + BIT PACKING ENCODING
+// Stream: first key (64 bits), then for each group of up to delta_group_size
+// deltas a 6 bit width followed by the zigzagged deltas packed at that width
+inline void encode_delta_keys(const int64_t* keys, const size_t& count, std::vector<uint8_t>& payload)
+{
+    payload.clear();
+
+    if (count == 0u)
+    {
+        return;
+    }
+
+    BitWriter writer(payload);
+    writer.write_wide(static_cast<uint64_t>(keys[0]), 64u);
+
+    std::array<uint64_t, delta_group_size> group;
+
+    for (size_t start = 1; start < count; start += delta_group_size)
+    {
+        const size_t group_count = std::min(delta_group_size, count - start);
+        uint64_t group_or = 0u;
+
+        for (size_t i = 0; i < group_count; i++)
+        {
+            group[i] = zigzag(keys[start + i] - keys[start + i - 1u]);
+            group_or |= group[i];
+        }
+
+        const unsigned int width = bit_width(group_or);
+        writer.write(width, 6u);
+
+        for (size_t i = 0; i < group_count; i++)
+        {
+            writer.write_wide(group[i], width);
+        }
+    }
+
+    writer.flush();
+}
+
+inline bool decode_delta_keys(const uint8_t* payload, const size_t& size, const size_t& count, int64_t* keys)
+{
+    if (count == 0u)
+    {
+        return true;
+    }
+
+    BitReader reader(payload, size);
+    keys[0] = static_cast<int64_t>(reader.read_wide(64u));
+
+    for (size_t start = 1; start < count; start += delta_group_size)
+    {
+        const size_t group_count = std::min(delta_group_size, count - start);
+        const unsigned int width = static_cast<unsigned int>(reader.read(6u));
+
+        // Unpack the group first, then prefix sum it: the first loop has no
+        // dependency between iterations
+        for (size_t i = 0; i < group_count; i++)
+        {
+            keys[start + i] = unzigzag(reader.read_wide(width));
+        }
+
+        for (size_t i = 0; i < group_count; i++)
+        {
+            keys[start + i] += keys[start + i - 1u];
+        }
+    }
+
+    return !reader.overrun();
+}
+
+// Integer valued columns are exactly representable as int64 only within the float mantissa range
+inline bool is_integer_column(const float* values, const size_t& count)
+{
+    constexpr float limit = 16777216.0f;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        if (!(std::abs(values[i]) <= limit) || std::floor(values[i]) != values[i] ||
+            (values[i] == 0.0f && std::signbit(values[i])))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+inline void encode_delta(const float* values, const size_t& count, const bool& integer, std::vector<uint8_t>& payload)
+{
+    std::vector<int64_t> keys(count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        keys[i] = integer ? static_cast<int64_t>(values[i]) : static_cast<int64_t>(ordered_bits(float_bits(values[i])));
+    }
+
+    encode_delta_keys(keys.data(), count, payload);
+}
+
+inline bool decode_delta(const uint8_t* payload, const size_t& size, const size_t& count, const bool& integer, float* values)
+{
+    std::vector<int64_t> keys(count);
+
+    if (!decode_delta_keys(payload, size, count, keys.data()))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        values[i] = integer ? static_cast<float>(keys[i]) : bits_float(unordered_bits(static_cast<uint32_t>(keys[i])));
+    }
+
+    return true;
+}
+
+// QUANTIZED DELTA ENCODING
+// Stream: the step (32 bits) followed by the delta encoded multiples of the step.
+// Only finite values within +-2^53 steps can be quantized.
+inline bool encode_quantized(const float* values, const size_t& count, const float& step, std::vector<uint8_t>& payload)
+{
+    if (!(step > 0.0f) || !std::isfinite(step))
+    {
+        return false;
+    }
+
+    std::vector<int64_t> keys(count);
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const double multiple = std::round(static_cast<double>(values[i]) / static_cast<double>(step));
+
+        if (!(std::abs(multiple) < 9007199254740992.0))
+        {
+            return false;
+        }
+
+        keys[i] = static_cast<int64_t>(multiple);
+    }
+
+    std::vector<uint8_t> deltas;
+    encode_delta_keys(keys.data(), count, deltas);
+
+    payload.resize(sizeof(float));
+    std::memcpy(payload.data(), &step, sizeof(float));
+    payload.insert(payload.end(), deltas.begin(), deltas.end());
+
+    return true;
+}
+
+inline bool decode_quantized(const uint8_t* payload, const size_t& size, const size_t& count, float* values)
+{
+    if (size < sizeof(float))
+    {
+        return false;
+    }
+
+    float step;
+    std::memcpy(&step, payload, sizeof(float));
+    std::vector<int64_t> keys(count);
+
+    if (!decode_delta_keys(payload + sizeof(float), size - sizeof(float), count, keys.data()))
+    {
+        return false;
+    }
+
+    for (size_t i = 0; i < count; i++)
+    {
+        values[i] = static_cast<float>(static_cast<double>(keys[i]) * static_cast<double>(step));
+    }
+
+    return true;
+}
+
+// Encode a column with the smallest of the available encodings. With a positive
+// quantization step, the column is quantized when all its values are finite.
+inline ColumnEncoding encode(const float* values, const size_t& count, std::vector<uint8_t>& payload,
+                             const float& quantization_step = 0.0f)
+{
+    if (quantization_step > 0.0f && encode_quantized(values, count, quantization_step, payload))
+    {
+        return ColumnEncoding::DeltaQuantized;
+    }
+
+    std::vector<uint8_t> candidate;
+    ColumnEncoding encoding = ColumnEncoding::Raw;
+
+    payload.resize(count * sizeof(float));
+    if (count > 0u)
+    {
+        std::memcpy(payload.data(), values, count * sizeof(float));
+    }
+
+    encode_xor(values, count, candidate);
+    if (candidate.size() < payload.size())
+    {
+        payload.swap(candidate);
+        encoding = ColumnEncoding::Xor;
+    }
+
+    const bool integer = is_integer_column(values, count);
+    encode_delta(values, count, integer, candidate);
+    if (candidate.size() < payload.size())
+    {
+        payload.swap(candidate);
+        encoding = integer ? ColumnEncoding::DeltaInteger : ColumnEncoding::DeltaBits;
+    }
+
+    return encoding;
+}
+
+inline bool decode(const ColumnEncoding& encoding, const uint8_t* payload, const size_t& size, const size_t& count, float* values)
+{
+    switch (encoding)
+    {
+    case ColumnEncoding::Raw:
+        if (size != count * sizeof(float))
+        {
+            return false;
+        }
+        if (count > 0u)
+        {
+            std::memcpy(values, payload, size);
+        }
+        return true;
+    case ColumnEncoding::Xor:
+        return decode_xor(payload, size, count, values);
+    case ColumnEncoding::DeltaInteger:
+        return decode_delta(payload, size, count, true, values);
+    case ColumnEncoding::DeltaBits:
+        return decode_delta(payload, size, count, false, values);
+    case ColumnEncoding::DeltaQuantized:
+        return decode_quantized(payload, size, count, values);
+    default:
+        return false;
+    }
+}
+
+} // namespace Informer::Compression
+
+} // namespace Informer
+
+#endif // INFORMER_CODEC_H_
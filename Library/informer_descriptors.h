@@ -0,0 +1,81 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef INFORMER_DESCRIPTORS_H_
+#define INFORMER_DESCRIPTORS_H_
+
+#include <cstddef>
+
+// Indices and names of the descriptors, without the rest of informer.h, so that the
+// fixed-point descriptors can be built for targets without threads or a heap
+namespace Informer
+{
+
+/* DESCRIPTOR INDICES */
+
+// Descriptor identifiers, in the order used by the result arrays of FixedInformer
+enum class TimeDescriptor : size_t
+{
+    Peak = 0,
+    Rms,
+    Variance,
+    Kurtosis,
+    Skewness,
+    F0,
+    ZeroCrossing,
+    Count
+};
+
+enum class FrequencyDescriptor : size_t
+{
+    Centroid = 0,
+    Spread,
+    CrestFactor,
+    Decrease,
+    Entropy,
+    Flatness,
+    Flux,
+    Irregularity,
+    Kurtosis,
+    Peak,
+    Rolloff,
+    Skewness,
+    Slope,
+    F0,
+    Count
+};
+
+// Names of the descriptors, matching the keys used by the Informer class
+static constexpr const char* time_descriptor_names[static_cast<size_t>(TimeDescriptor::Count)] =
+{
+    "peak", "rms", "variance", "kurtosis", "skewness", "f0", "zerocrossing"
+};
+
+static constexpr const char* frequency_descriptor_names[static_cast<size_t>(FrequencyDescriptor::Count)] =
+{
+    "centroid", "spread", "crestfactor", "decrease", "entropy", "flatness", "flux",
+    "irregularity", "kurtosis", "peak", "rolloff", "skewness", "slope", "f0"
+};
+
+} // namespace Informer
+
+#endif // INFORMER_DESCRIPTORS_H_
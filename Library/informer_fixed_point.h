@@ -0,0 +1,717 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef INFORMER_FIXED_POINT_H_
+#define INFORMER_FIXED_POINT_H_
+
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <limits>
+
+#if __cplusplus >= 202002L
+#include <bit>
+#include<concepts>
+#endif
+
+#include "informer_descriptors.h"
+
+namespace Informer
+{
+
+/* FIXED-POINT DESCRIPTORS */
+
+// Descriptors of Q15 (int16_t) or Q31 (int32_t) frames and magnitudes, for cores
+// with a weak or no FPU. Only integer arithmetic is used (64-bit accumulators,
+// saturating where a sum can overflow), following the definitions of
+// FixedInformer. Results are int32_t values in a fixed-point format per
+// descriptor (see time_descriptor_bits and frequency_descriptor_bits):
+// - peak, rms, variance, flux: Q31, in the units of the input;
+// - frequencies (centroid, spread, peak, rolloff and both f0): Q16.16 Hz;
+// - all the other descriptors: Q16.16;
+// - slope: Q31, as the change of magnitude from 0 Hz to Nyquist along the regression
+//   line (the float slope is value / 2^31 / (sample_rate / 2)).
+// Values out of range saturate. to_float() converts the results back.
+//
+// The moments of a frame are computed on the frame scaled up to the full range
+// (block floating point), so they keep their precision on quiet signals. The time
+// domain f0 (YIN) works on 16-bit samples, the spectral f0 compares sums of
+// logarithms instead of products of magnitudes.
+namespace FixedPoint
+{
+
+template <typename TInt>
+struct QFormat;
+
+template <>
+struct QFormat<int16_t>
+{
+    static constexpr unsigned int fraction_bits = 15u;
+};
+
+template <>
+struct QFormat<int32_t>
+{
+    static constexpr unsigned int fraction_bits = 31u;
+};
+
+constexpr int32_t q16_one = 65536;
+
+// Fraction bits of each result, in the order of TimeDescriptor and FrequencyDescriptor
+constexpr unsigned int time_descriptor_bits[static_cast<size_t>(TimeDescriptor::Count)] =
+{
+    31u, 31u, 31u, 16u, 16u, 16u, 16u
+};
+
+constexpr unsigned int frequency_descriptor_bits[static_cast<size_t>(FrequencyDescriptor::Count)] =
+{
+    16u, 16u, 16u, 16u, 16u, 16u, 31u, 16u, 16u, 16u, 16u, 16u, 31u, 16u
+};
+
+// UTILITY FUNCTIONS: integer arithmetic
+
+inline unsigned int bit_width(const uint64_t& x)
+{
+#if __cplusplus >= 202002L
+    return static_cast<unsigned int>(std::bit_width(x));
+#elif defined(__GNUC__) || defined(__clang__)
+    return x == 0u ? 0u : 64u - static_cast<unsigned int>(__builtin_clzll(x));
+#else
+    unsigned int width = 0u;
+    for (uint64_t v = x; v != 0u; v >>= 1)
+    {
+        width++;
+    }
+    return width;
+#endif
+}
+
+inline uint64_t magnitude(const int64_t& x)
+{
+    return x < 0 ? static_cast<uint64_t>(0) - static_cast<uint64_t>(x) : static_cast<uint64_t>(x);
+}
+
+inline int32_t saturate_int32(const int64_t& x)
+{
+    return static_cast<int32_t>(std::clamp(x, static_cast<int64_t>(std::numeric_limits<int32_t>::min()),
+                                           static_cast<int64_t>(std::numeric_limits<int32_t>::max())));
+}
+
+inline int64_t saturating_add(const int64_t& a, const int64_t& b)
+{
+    if (b > 0 && a > std::numeric_limits<int64_t>::max() - b)
+    {
+        return std::numeric_limits<int64_t>::max();
+    }
+
+    if (b < 0 && a < std::numeric_limits<int64_t>::min() - b)
+    {
+        return std::numeric_limits<int64_t>::min();
+    }
+
+    return a + b;
+}
+
+inline int64_t saturating_multiply(const int64_t& a, const int64_t& b)
+{
+    if (bit_width(magnitude(a)) + bit_width(magnitude(b)) > 62u)
+    {
+        return (a < 0) != (b < 0) ? std::numeric_limits<int64_t>::min() : std::numeric_limits<int64_t>::max();
+    }
+
+    return a * b;
+}
+
+// Multiply by 2^shift (negative shifts divide, rounding towards minus infinity)
+inline int64_t scale(const int64_t& x, const int& shift)
+{
+    if (shift >= 0)
+    {
+        return saturating_multiply(x, static_cast<int64_t>(1) << std::min(shift, 62));
+    }
+
+    return shift <= -63 ? (x < 0 ? -1 : 0) : x >> -shift;
+}
+
+// Floor of the square root
+inline uint64_t isqrt(const uint64_t& x)
+{
+    uint64_t root = 0u;
+    uint64_t remainder = x;
+    uint64_t bit = static_cast<uint64_t>(1) << 62;
+
+    while (bit > remainder)
+    {
+        bit >>= 2;
+    }
+
+    while (bit != 0u)
+    {
+        if (remainder >= root + bit)
+        {
+            remainder -= root + bit;
+            root = (root >> 1) + bit;
+        }
+        else
+        {
+            root >>= 1;
+        }
+
+        bit >>= 2;
+    }
+
+    return root;
+}
+
+// num * 2^bits / den, saturating. Denominators too large for the remainder to be
+// shifted are scaled down together with the numerator.
+inline int64_t ratio(const int64_t& num, const int64_t& den, const unsigned int& bits)
+{
+    if (den <= 0)
+    {
+        return 0;
+    }
+
+    uint64_t n = magnitude(num);
+    uint64_t d = static_cast<uint64_t>(den);
+    const unsigned int max_width = 63u - bits;
+
+    if (bit_width(d) > max_width)
+    {
+        const unsigned int excess = bit_width(d) - max_width;
+        n >>= excess;
+        d >>= excess;
+    }
+
+    const uint64_t quotient = n / d;
+    const uint64_t remainder = n % d;
+
+    if (bit_width(quotient) + bits > 62u)
+    {
+        return num < 0 ? std::numeric_limits<int64_t>::min() : std::numeric_limits<int64_t>::max();
+    }
+
+    const int64_t result = static_cast<int64_t>((quotient << bits) + (remainder << bits) / d);
+
+    return num < 0 ? -result : result;
+}
+
+// log2(1 + i / 64) in Q16.16
+constexpr int32_t log2_table_[65] =
+{
+    0, 1466, 2909, 4331, 5732, 7112, 8473, 9814, 11136, 12440,
+    13727, 14996, 16248, 17484, 18704, 19909, 21098, 22272, 23433, 24579,
+    25711, 26830, 27936, 29029, 30109, 31178, 32234, 33279, 34312, 35334,
+    36346, 37346, 38336, 39316, 40286, 41246, 42196, 43137, 44068, 44990,
+    45904, 46809, 47705, 48593, 49472, 50344, 51207, 52063, 52911, 53751,
+    54584, 55410, 56229, 57040, 57845, 58643, 59434, 60219, 60997, 61769,
+    62534, 63294, 64047, 64794, 65536
+};
+
+// 2^(i / 64) in Q2.30
+constexpr uint32_t exp2_table_[65] =
+{
+    1073741824u, 1085434106u, 1097253708u, 1109202018u, 1121280436u, 1133490379u,
+    1145833280u, 1158310587u, 1170923762u, 1183674286u, 1196563654u, 1209593378u,
+    1222764986u, 1236080024u, 1249540052u, 1263146652u, 1276901417u, 1290805962u,
+    1304861917u, 1319070932u, 1333434672u, 1347954824u, 1362633090u, 1377471191u,
+    1392470869u, 1407633882u, 1422962010u, 1438457051u, 1454120821u, 1469955159u,
+    1485961921u, 1502142985u, 1518500250u, 1535035634u, 1551751076u, 1568648537u,
+    1585730000u, 1602997467u, 1620452965u, 1638098541u, 1655936265u, 1673968228u,
+    1692196547u, 1710623359u, 1729250827u, 1748081133u, 1767116489u, 1786359126u,
+    1805811301u, 1825475297u, 1845353420u, 1865448001u, 1885761398u, 1906295993u,
+    1927054196u, 1948038440u, 1969251188u, 1990694927u, 2012372174u, 2034285470u,
+    2056437387u, 2078830522u, 2101467502u, 2124350982u, 2147483648u
+};
+
+// log2(x) in Q16.16 (x > 0), by table with linear interpolation (error below 1e-4)
+inline int32_t log2_q16(const uint64_t& x)
+{
+    if (x == 0u)
+    {
+        return std::numeric_limits<int32_t>::min();
+    }
+
+    const unsigned int exponent = bit_width(x) - 1u;
+    // Mantissa in [1, 2) as Q0.32 fraction
+    const uint64_t fraction = exponent >= 32u ? (x >> (exponent - 32u)) & 0xFFFFFFFFu : (x << (32u - exponent)) & 0xFFFFFFFFu;
+    const uint32_t index = static_cast<uint32_t>(fraction >> 26);
+    const int64_t weight = static_cast<int64_t>(fraction & 0x3FFFFFFu);
+    const int64_t interpolated = log2_table_[index] + (((log2_table_[index + 1u] - log2_table_[index]) * weight) >> 26);
+
+    return static_cast<int32_t>(static_cast<int64_t>(exponent) * q16_one + interpolated);
+}
+
+// 2^x in Q16.16 for x in Q16.16, saturating
+inline int32_t exp2_q16(const int32_t& x)
+{
+    const int32_t integer = x >> 16;
+    const uint32_t fraction = static_cast<uint32_t>(x) & 0xFFFFu;
+    const uint32_t index = fraction >> 10;
+    const uint64_t weight = fraction & 0x3FFu;
+    const uint64_t mantissa = exp2_table_[index] + (((static_cast<uint64_t>(exp2_table_[index + 1u]) - exp2_table_[index]) * weight) >> 10);
+
+    // mantissa is Q2.30, the result Q16.16
+    return saturate_int32(scale(static_cast<int64_t>(mantissa), integer - 14));
+}
+
+// Saturating conversions, for hosts and tests
+template <typename TInt>
+#if __cplusplus >= 202002L
+requires std::same_as<TInt, int16_t> || std::same_as<TInt, int32_t>
+#endif
+TInt from_float(const double& x)
+{
+    const double scaled = x * static_cast<double>(static_cast<int64_t>(1) << QFormat<TInt>::fraction_bits);
+    const double clamped = std::clamp(scaled, static_cast<double>(std::numeric_limits<TInt>::min()), static_cast<double>(std::numeric_limits<TInt>::max()));
+
+    return static_cast<TInt>(clamped < 0.0 ? clamped - 0.5 : clamped + 0.5);
+}
+
+inline double to_float(const TimeDescriptor& descriptor, const int32_t& value)
+{
+    return static_cast<double>(value) / static_cast<double>(static_cast<int64_t>(1) << time_descriptor_bits[static_cast<size_t>(descriptor)]);
+}
+
+inline double to_float(const FrequencyDescriptor& descriptor, const int32_t& value, const double& sample_rate)
+{
+    const double result = static_cast<double>(value) / static_cast<double>(static_cast<int64_t>(1) << frequency_descriptor_bits[static_cast<size_t>(descriptor)]);
+
+    return descriptor == FrequencyDescriptor::Slope ? result / (sample_rate * 0.5) : result;
+}
+
+// UTILITY FUNCTION: YIN period (in samples, Q16.16) of a frame, with the scratch
+// buffer holding count / 2 values. Same steps as Amplitude::yin_difference(),
+// yin_tau() and yin_refine_tau(), on 16-bit samples.
+template <typename TInt>
+#if __cplusplus >= 202002L
+requires std::same_as<TInt, int16_t> || std::same_as<TInt, int32_t>
+#endif
+int64_t yin_period(const TInt* samples, const size_t& count, int32_t* yin_buffer)
+{
+    constexpr unsigned int reduction = QFormat<TInt>::fraction_bits - 15u;
+    constexpr int32_t threshold = 9830; // 0.15
+    const size_t half = count / 2u;
+
+    if (half < 3u)
+    {
+        return 0;
+    }
+
+    yin_buffer[0] = q16_one;
+    int64_t running_sum = 0;
+
+    for (size_t tau = 1; tau < half; tau++)
+    {
+        int64_t difference = 0;
+
+        for (size_t i = 0; i < half; i++)
+        {
+            const int64_t delta = static_cast<int64_t>(samples[i] >> reduction) - static_cast<int64_t>(samples[i + tau] >> reduction);
+            difference += delta * delta;
+        }
+
+        running_sum += difference;
+        yin_buffer[tau] = running_sum > 0 ? saturate_int32(ratio(difference * static_cast<int64_t>(tau), running_sum, 16u)) : q16_one;
+    }
+
+    size_t tau_estimate = 0;
+    for (size_t tau = 2; tau < half; tau++)
+    {
+        if (yin_buffer[tau] < threshold)
+        {
+            while (tau + 1 < half && yin_buffer[tau + 1] < yin_buffer[tau])
+            {
+                tau++;
+            }
+
+            tau_estimate = tau;
+            break;
+        }
+    }
+
+    if (tau_estimate == 0)
+    {
+        tau_estimate = static_cast<size_t>(std::min_element(yin_buffer + 2, yin_buffer + half) - yin_buffer);
+    }
+
+    // Parabolic interpolation, with the edge cases of Amplitude::yin_refine_tau()
+    const size_t x0 = tau_estimate < 1 ? tau_estimate : tau_estimate - 1;
+    const size_t x2 = tau_estimate + 1 >= half ? tau_estimate : tau_estimate + 1;
+    const int64_t tau_q16 = static_cast<int64_t>(tau_estimate) * q16_one;
+
+    if (x0 == tau_estimate)
+    {
+        return yin_buffer[tau_estimate] <= yin_buffer[x2] ? tau_q16 : static_cast<int64_t>(x2) * q16_one;
+    }
+
+    if (x2 == tau_estimate)
+    {
+        return yin_buffer[tau_estimate] <= yin_buffer[x0] ? tau_q16 : static_cast<int64_t>(x0) * q16_one;
+    }
+
+    const int64_t s0 = yin_buffer[x0];
+    const int64_t s1 = yin_buffer[tau_estimate];
+    const int64_t s2 = yin_buffer[x2];
+    const int64_t denominator = 2 * (s2 - 2 * s1 + s0);
+
+    if (denominator == 0)
+    {
+        return tau_q16;
+    }
+
+    const int64_t offset = denominator > 0 ? ratio(s0 - s2, denominator, 16u) : -ratio(s0 - s2, -denominator, 16u);
+
+    return tau_q16 + offset;
+}
+
+// TIME DOMAIN DESCRIPTORS: all the results of FixedInformer::compute_descriptors(true, false).
+// f0 needs a scratch buffer of count / 2 values, without it the result is -1.
+template <typename TInt>
+#if __cplusplus >= 202002L
+requires std::same_as<TInt, int16_t> || std::same_as<TInt, int32_t>
+#endif
+void compute_time_descriptors(const TInt* samples, const size_t& count,
+                              std::array<int32_t, static_cast<size_t>(TimeDescriptor::Count)>& descriptors,
+                              int32_t* yin_buffer = nullptr, const uint32_t& sample_rate = 44100u)
+{
+    constexpr int fraction_bits = static_cast<int>(QFormat<TInt>::fraction_bits);
+    constexpr int work_bits = 28;
+    constexpr int64_t half_lsb = static_cast<int64_t>(1) << (work_bits - 1);
+    auto& t = descriptors;
+
+    t.fill(0);
+    t[static_cast<size_t>(TimeDescriptor::F0)] = -q16_one;
+
+    if (count == 0u)
+    {
+        return;
+    }
+
+    // First pass: peak, sum and zero crossings
+    uint64_t peak = 0u;
+    int64_t sum = 0;
+    uint32_t crossings = 0u;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const int64_t s = samples[i];
+        peak = std::max(peak, magnitude(s));
+        sum += s;
+        if (i > 0)
+        {
+            crossings += (s < 0) != (samples[i - 1] < 0) ? 1u : 0u;
+        }
+    }
+
+    const uint64_t full_scale = (static_cast<uint64_t>(1) << fraction_bits) - 1u;
+    t[static_cast<size_t>(TimeDescriptor::Peak)] = saturate_int32(scale(static_cast<int64_t>(std::min(peak, full_scale)), 31 - fraction_bits));
+    t[static_cast<size_t>(TimeDescriptor::ZeroCrossing)] = count > 1u ? saturate_int32(ratio(crossings, static_cast<int64_t>(count - 1u), 16u)) : 0;
+
+    if (yin_buffer != nullptr && sample_rate > 0u)
+    {
+        const int64_t period = yin_period(samples, count, yin_buffer);
+        t[static_cast<size_t>(TimeDescriptor::F0)] = period > 0 ? saturate_int32(ratio(sample_rate, period, 32u)) : -q16_one;
+    }
+
+    if (peak == 0u)
+    {
+        return;
+    }
+
+    // Block floating point: the frame is scaled by 2^headroom to use the full range, and the
+    // moments are computed with 28 fraction bits
+    const int headroom = std::max(fraction_bits - static_cast<int>(bit_width(peak)), 0);
+    const int to_work = headroom + work_bits - fraction_bits;
+    const int64_t n = static_cast<int64_t>(count);
+    const int64_t mean = to_work >= 0 ? scale(sum / n, to_work) + scale(sum % n, to_work) / n : scale(sum, to_work) / n;
+
+    int64_t m2 = 0;
+    int64_t m3 = 0;
+    int64_t m4 = 0;
+
+    for (size_t i = 0; i < count; i++)
+    {
+        const int64_t d = scale(samples[i], to_work) - mean;
+        const int64_t d2 = (d * d + half_lsb) >> work_bits;
+        m2 += d2;
+        m3 += (d2 * d + half_lsb) >> work_bits;
+        m4 = saturating_add(m4, (d2 * d2 + half_lsb) >> work_bits);
+    }
+
+    const int64_t variance = m2 / n;
+    const int64_t mean_square = variance + ((mean * mean) >> work_bits);
+    const int64_t rms = static_cast<int64_t>(isqrt(static_cast<uint64_t>(mean_square) << work_bits));
+
+    // Back to the original scale, in Q31
+    t[static_cast<size_t>(TimeDescriptor::Rms)] = saturate_int32(scale(rms, 31 - work_bits - headroom));
+    t[static_cast<size_t>(TimeDescriptor::Variance)] = saturate_int32(scale(variance, 31 - work_bits - 2 * headroom));
+
+    // Same threshold of the float version (the float epsilon, 2^-23, on the unscaled variance)
+    const int epsilon_shift = work_bits - 23 + 2 * headroom;
+    if (epsilon_shift < 62 && variance > (static_cast<int64_t>(1) << epsilon_shift))
+    {
+        const int64_t deviation = static_cast<int64_t>(isqrt(static_cast<uint64_t>(variance) << work_bits));
+        t[static_cast<size_t>(TimeDescriptor::Kurtosis)] = saturate_int32(ratio(ratio(m4 / n, variance, work_bits), variance, 16u) - 3 * q16_one);
+        t[static_cast<size_t>(TimeDescriptor::Skewness)] = saturate_int32(ratio(ratio(m3 / n, variance, work_bits), deviation, 16u));
+    }
+}
+
+// FREQUENCY DOMAIN DESCRIPTORS: all the results of FixedInformer::compute_descriptors(false, true),
+// from bins = fft_size / 2 + 1 magnitudes in [0, 1). The previous magnitudes (for the flux) can be
+// null. The rolloff point is in Q16.16.
+template <typename TInt>
+#if __cplusplus >= 202002L
+requires std::same_as<TInt, int16_t> || std::same_as<TInt, int32_t>
+#endif
+void compute_frequency_descriptors(const TInt* magnitudes, const TInt* previous_magnitudes, const size_t& bins,
+                                   const uint32_t& sample_rate,
+                                   std::array<int32_t, static_cast<size_t>(FrequencyDescriptor::Count)>& descriptors,
+                                   const int32_t& rolloff_point = 55706)
+{
+    constexpr int64_t log2_floor = -1088530; // log2(0.00001)
+    auto& f = descriptors;
+
+    f.fill(0);
+
+    if (bins < 3u || sample_rate == 0u)
+    {
+        return;
+    }
+
+    // Block floating point: magnitudes are used with at most 24 significant bits, so that the
+    // sums fit 64 bits
+    uint64_t raw_max = 0u;
+    for (size_t k = 0; k < bins; k++)
+    {
+        raw_max = std::max(raw_max, magnitude(magnitudes[k]));
+        if (previous_magnitudes != nullptr)
+        {
+            raw_max = std::max(raw_max, magnitude(previous_magnitudes[k]));
+        }
+    }
+
+    const unsigned int width = std::min(bit_width(raw_max), 24u);
+    const unsigned int reduction = bit_width(raw_max) - width;
+    const int magnitude_bits = static_cast<int>(QFormat<TInt>::fraction_bits - reduction);
+    const int64_t fft_size = 2 * static_cast<int64_t>(bins - 1u);
+    auto magnitude_at = [&](const TInt* values, const size_t& k) -> int64_t
+    {
+        return static_cast<int64_t>(magnitude(values[k]) >> reduction);
+    };
+    auto to_hz = [&](const int64_t& bin_q16) -> int32_t
+    {
+        return saturate_int32(saturating_multiply(bin_q16, sample_rate) / fft_size);
+    };
+
+    // First pass: all the sums that do not depend on other descriptors
+    int64_t magn_sum = 0;
+    int64_t weighted_sum = 0;
+    int64_t power_sum = 0;
+    int64_t log_sum = 0;
+    int64_t decrease_sum = 0;
+    int64_t irregularity = 0;
+    int64_t flux = 0;
+    int64_t magn_max = 0;
+    size_t magn_max_idx = 0;
+    const int64_t magn_first = magnitude_at(magnitudes, 0);
+    // Differences with the first bin are scaled to about 30 bits before the division by the bin index
+    const int decrease_bits = 30 - static_cast<int>(width);
+
+    for (size_t k = 0; k < bins; k++)
+    {
+        const int64_t m = magnitude_at(magnitudes, k);
+        magn_sum += m;
+        weighted_sum += static_cast<int64_t>(k) * m;
+        power_sum += m * m;
+        const uint64_t full = magnitude(magnitudes[k]);
+        log_sum += full > 0u ? static_cast<int64_t>(log2_q16(full)) - static_cast<int64_t>(QFormat<TInt>::fraction_bits) * q16_one : log2_floor;
+        if (k > 0)
+        {
+            decrease_sum += static_cast<int64_t>(static_cast<int32_t>((m - magn_first) * (static_cast<int64_t>(1) << decrease_bits)) / static_cast<int32_t>(k));
+            irregularity += magnitude(m - magnitude_at(magnitudes, k - 1u));
+        }
+        if (previous_magnitudes != nullptr)
+        {
+            const int64_t d = m - magnitude_at(previous_magnitudes, k);
+            flux += d * d;
+        }
+        if (m > magn_max)
+        {
+            magn_max = m;
+            magn_max_idx = k;
+        }
+    }
+
+    const bool has_energy = magn_sum > 0;
+
+    // Flux: sqrt(sum(d^2)) / bins, the root taken with extra fraction bits
+    const int flux_shift = std::max(0, (61 - static_cast<int>(bit_width(static_cast<uint64_t>(flux)))) / 2);
+    const int64_t flux_root = static_cast<int64_t>(isqrt(static_cast<uint64_t>(flux) << (2 * flux_shift)));
+    f[static_cast<size_t>(FrequencyDescriptor::Flux)] = saturate_int32(scale(ratio(flux_root, static_cast<int64_t>(bins), 24u), 7 - magnitude_bits - flux_shift));
+    f[static_cast<size_t>(FrequencyDescriptor::Peak)] = to_hz(static_cast<int64_t>(magn_max_idx) * q16_one);
+
+    // Harmonic product spectrum (compression 5) as a sum of logarithms, between 50 Hz and 10 kHz
+    constexpr size_t max_compression = 5u;
+    const size_t low_bin = static_cast<size_t>((50 * fft_size + sample_rate - 1u) / sample_rate);
+    const size_t high_bin = std::min(static_cast<size_t>(10000 * fft_size / sample_rate), bins - 1u);
+
+    if (high_bin >= low_bin && high_bin - low_bin + 1u >= max_compression && (high_bin - low_bin + 1u) / max_compression >= 2u)
+    {
+        const size_t hps_length = (high_bin - low_bin + 1u) / max_compression;
+        int64_t max_product = std::numeric_limits<int64_t>::min();
+        size_t k_peak = 0;
+
+        for (size_t k = 0; k < hps_length; k++)
+        {
+            int64_t product = 0;
+            for (size_t h = 1u; h <= max_compression; h++)
+            {
+                const uint64_t m = magnitude(magnitudes[low_bin + h * k]);
+                product += m > 0u ? log2_q16(m) : -(static_cast<int64_t>(1) << 32);
+            }
+            if (product > max_product)
+            {
+                max_product = product;
+                k_peak = k;
+            }
+        }
+
+        f[static_cast<size_t>(FrequencyDescriptor::F0)] = to_hz(static_cast<int64_t>(k_peak + low_bin) * q16_one);
+    }
+    const int log2_bins = log2_q16(bins);
+
+    if (!has_energy)
+    {
+        return;
+    }
+
+    const int64_t centroid_q16 = ratio(weighted_sum, magn_sum, 16u);
+    // Weights with 24 fraction bits (their sum is about 2^24), from a single division
+    const int64_t inverse_sum = (static_cast<int64_t>(1) << 62) / magn_sum;
+    const int64_t centroid_q4 = centroid_q16 >> 12;
+    const int64_t centroid_q8 = centroid_q16 >> 8;
+
+    // Second pass: spread, entropy and rolloff
+    int64_t weight_sum = 0;
+    int64_t spread_sum = 0;
+    const unsigned int power_shift = static_cast<unsigned int>(std::max(0, static_cast<int>(bit_width(static_cast<uint64_t>(power_sum))) - 40));
+    int64_t entropy_weight = 0;
+    int64_t entropy_sum = 0;
+    const int64_t rolloff_threshold = saturating_multiply(magn_sum, rolloff_point);
+    int64_t cumul_magn = 0;
+    size_t rolloff_idx = bins - 1u;
+    bool rolloff_found = false;
+
+    for (size_t k = 0; k < bins; k++)
+    {
+        const int64_t m = magnitude_at(magnitudes, k);
+        const int64_t w = (m * inverse_sum) >> 38;
+        const int64_t d = static_cast<int64_t>(k) * 16 - centroid_q4;
+        weight_sum += w;
+        spread_sum += w * d * d;
+
+        const int64_t power = m * m;
+        if (power > 0)
+        {
+            const int64_t reduced = power >> power_shift;
+            entropy_weight += reduced;
+            entropy_sum += reduced * log2_q16(static_cast<uint64_t>(power));
+        }
+
+        cumul_magn += m;
+        if (!rolloff_found && cumul_magn * q16_one >= rolloff_threshold)
+        {
+            rolloff_idx = k;
+            rolloff_found = true;
+        }
+    }
+
+    f[static_cast<size_t>(FrequencyDescriptor::Rolloff)] = to_hz(static_cast<int64_t>(rolloff_idx) * q16_one);
+
+    // Entropy of the power distribution, normalized by log2(bins)
+    if (entropy_weight > 0)
+    {
+        const int64_t entropy_bits = static_cast<int64_t>(log2_q16(static_cast<uint64_t>(power_sum))) - ratio(entropy_sum, entropy_weight, 0u);
+        f[static_cast<size_t>(FrequencyDescriptor::Entropy)] = saturate_int32(ratio(entropy_bits, log2_bins, 16u));
+    }
+
+    // spread_sum has 8 fraction bits (d has 4) over the weights
+    const int64_t variance_q32 = ratio(spread_sum, std::max<int64_t>(weight_sum, 1), 24u);
+    const int64_t spread_q16 = static_cast<int64_t>(isqrt(static_cast<uint64_t>(variance_q32)));
+
+    f[static_cast<size_t>(FrequencyDescriptor::Centroid)] = to_hz(centroid_q16);
+    f[static_cast<size_t>(FrequencyDescriptor::Spread)] = to_hz(spread_q16);
+    f[static_cast<size_t>(FrequencyDescriptor::CrestFactor)] = saturate_int32(ratio(magn_max, magn_sum, 16u));
+    f[static_cast<size_t>(FrequencyDescriptor::Irregularity)] = saturate_int32(ratio(irregularity, magn_sum, 16u));
+
+    if (magn_sum - magn_first > 0)
+    {
+        f[static_cast<size_t>(FrequencyDescriptor::Decrease)] = saturate_int32(scale(ratio(decrease_sum, magn_sum - magn_first, 16u), -decrease_bits));
+    }
+
+    // Flatness: geometric over arithmetic mean, as 2^(mean log2 m - log2 mean m)
+    const int64_t mean_log = log_sum / static_cast<int64_t>(bins);
+    const int64_t log_mean = static_cast<int64_t>(log2_q16(static_cast<uint64_t>(magn_sum))) - log2_bins - magnitude_bits * static_cast<int64_t>(q16_one);
+    f[static_cast<size_t>(FrequencyDescriptor::Flatness)] = exp2_q16(saturate_int32(std::min<int64_t>(mean_log - log_mean, 14 * static_cast<int64_t>(q16_one))));
+
+    // Third pass: standardized moments, with z = d / spread in Q10 (from one division)
+    if (spread_q16 > 0)
+    {
+        const int64_t inverse_spread = (static_cast<int64_t>(1) << 42) / spread_q16;
+        int64_t skewness_sum = 0;
+        int64_t kurtosis_sum = 0;
+
+        for (size_t k = 0; k < bins; k++)
+        {
+            const int64_t m = magnitude_at(magnitudes, k);
+            const int64_t w = (m * inverse_sum) >> 38;
+
+            if (w == 0)
+            {
+                continue;
+            }
+
+            const int64_t d = static_cast<int64_t>(k) * 256 - centroid_q8;
+            const int64_t z = std::clamp<int64_t>(saturating_multiply(d, inverse_spread) >> 24, -(static_cast<int64_t>(1) << 22), static_cast<int64_t>(1) << 22);
+            const int64_t z2 = (z * z + 512) >> 10;
+            const int64_t z3 = (z2 * z + 512) >> 10;
+            const int64_t z4 = (z2 * z2 + 512) >> 10;
+            skewness_sum = saturating_add(skewness_sum, saturating_multiply(w, z3));
+            kurtosis_sum = saturating_add(kurtosis_sum, saturating_multiply(w, z4));
+        }
+
+        f[static_cast<size_t>(FrequencyDescriptor::Skewness)] = saturate_int32(ratio(skewness_sum, weight_sum, 6u));
+        f[static_cast<size_t>(FrequencyDescriptor::Kurtosis)] = saturate_int32(ratio(kurtosis_sum, weight_sum, 6u) - 3 * q16_one);
+    }
+
+    // Slope: 6 * (2 sum(k m) - (bins - 1) sum(m)) / (bins (bins + 1)), scaled to Q31 over the whole spectrum
+    const int64_t slope_numerator = 6 * (2 * weighted_sum - static_cast<int64_t>(bins - 1u) * magn_sum);
+    f[static_cast<size_t>(FrequencyDescriptor::Slope)] = saturate_int32(ratio(slope_numerator, static_cast<int64_t>(bins) * static_cast<int64_t>(bins + 1u), static_cast<unsigned int>(31 - magnitude_bits)));
+
+}
+
+} // namespace Informer::FixedPoint
+
+} // namespace Informer
+
+#endif // INFORMER_FIXED_POINT_H_
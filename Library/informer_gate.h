@@ -0,0 +1,208 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+// Part of informer.h, which includes it before the Informer class
+#include "informer.h"
+
+#ifndef INFORMER_GATE_H_
+#define INFORMER_GATE_H_
+
+#include <algorithm>
+#include <cmath>
+
+#if __cplusplus >= 202002L
+#include<concepts>
+#endif
+
+namespace Informer
+{
+
+/* ACTIVITY GATING */
+
+enum class Activity
+{
+    // Analyze the frame
+    Active,
+    // Below the level threshold: skip the analysis, the descriptors are those of silence
+    Silent,
+    // Too close to the last active frame: skip the analysis, the descriptors are held
+    Held
+};
+
+// Cheap decision on a time domain frame, before any FFT: a single pass computes its mean square
+// and zero crossing rate. Frames with a mean square below the threshold (in dB relative to a full
+// scale DC) are silent. With a change threshold above 0, frames whose mean square and zero
+// crossing rate both stay within that relative distance from the last active frame are held,
+// for at most max_held_frames frames in a row. The change test is disabled by default, so that
+// the frames above the threshold are always analyzed.
+template <typename TSample>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+class ActivityGate
+{
+public:
+    ActivityGate(const TSample& threshold_db = static_cast<TSample>(-100.0),
+                 const TSample& change_threshold = static_cast<TSample>(0.0),
+                 const unsigned int& max_held_frames = 16u)
+    {
+        set_threshold(threshold_db);
+        set_change_threshold(change_threshold);
+        set_max_held_frames(max_held_frames);
+    }
+
+    ~ActivityGate() = default;
+
+    bool set_threshold(const TSample& threshold_db)
+    {
+        if (std::isnan(threshold_db))
+        {
+            return false;
+        }
+
+        threshold_db_ = threshold_db;
+        threshold_ = std::pow(static_cast<TSample>(10.0), static_cast<TSample>(0.1) * threshold_db);
+
+        return true;
+    }
+
+    // 0 disables the change test, 0.05 holds frames within 5% of the last active one
+    bool set_change_threshold(const TSample& change_threshold)
+    {
+        if (change_threshold >= static_cast<TSample>(0.0))
+        {
+            change_threshold_ = change_threshold;
+
+            return true;
+        }
+
+        return false;
+    }
+
+    bool set_max_held_frames(const unsigned int& max_held_frames)
+    {
+        max_held_frames_ = max_held_frames;
+
+        return true;
+    }
+
+    void reset()
+    {
+        activity_ = Activity::Active;
+        mean_square_ = static_cast<TSample>(0.0);
+        reference_mean_square_ = static_cast<TSample>(0.0);
+        reference_crossings_ = static_cast<TSample>(0.0);
+        has_reference_ = false;
+        held_frames_ = 0u;
+    }
+
+    Activity process(const TSample* buffer, const size_t& size)
+    {
+        INFORMER_PROFILE_SCOPE("activity_gate");
+
+        if (buffer == nullptr || size == 0u)
+        {
+            return activity_;
+        }
+
+        Accumulator<TSample> energy;
+        size_t crossings = 0u;
+
+        for (size_t n = 0; n < size; n++)
+        {
+            energy += buffer[n] * buffer[n];
+
+            if (n > 0u && std::signbit(buffer[n]) != std::signbit(buffer[n - 1u]))
+            {
+                crossings++;
+            }
+        }
+
+        mean_square_ = static_cast<TSample>(energy) / static_cast<TSample>(size);
+        const TSample crossing_rate = static_cast<TSample>(crossings) / static_cast<TSample>(size);
+
+        if (mean_square_ < threshold_)
+        {
+            activity_ = Activity::Silent;
+            has_reference_ = false;
+        }
+        else if (change_threshold_ > static_cast<TSample>(0.0) && has_reference_ && held_frames_ < max_held_frames_ &&
+                 std::abs(mean_square_ - reference_mean_square_) <= change_threshold_ * reference_mean_square_ &&
+                 std::abs(crossing_rate - reference_crossings_) <= change_threshold_ * std::max(reference_crossings_, static_cast<TSample>(1.0) / static_cast<TSample>(size)))
+        {
+            activity_ = Activity::Held;
+            held_frames_++;
+        }
+        else
+        {
+            activity_ = Activity::Active;
+            reference_mean_square_ = mean_square_;
+            reference_crossings_ = crossing_rate;
+            has_reference_ = true;
+            held_frames_ = 0u;
+        }
+
+        return activity_;
+    }
+
+    Activity get_activity() const
+    {
+        return activity_;
+    }
+
+    // Mean square of the last frame
+    TSample get_mean_square() const
+    {
+        return mean_square_;
+    }
+
+    TSample get_threshold() const
+    {
+        return threshold_db_;
+    }
+
+    TSample get_change_threshold() const
+    {
+        return change_threshold_;
+    }
+
+    unsigned int get_max_held_frames() const
+    {
+        return max_held_frames_;
+    }
+
+private:
+    TSample threshold_db_ = static_cast<TSample>(-100.0);
+    TSample threshold_ = static_cast<TSample>(1e-10);
+    TSample change_threshold_ = static_cast<TSample>(0.0);
+    unsigned int max_held_frames_ = 16u;
+    Activity activity_ = Activity::Active;
+    TSample mean_square_ = static_cast<TSample>(0.0);
+    TSample reference_mean_square_ = static_cast<TSample>(0.0);
+    TSample reference_crossings_ = static_cast<TSample>(0.0);
+    bool has_reference_ = false;
+    unsigned int held_frames_ = 0u;
+};
+
+} // namespace Informer
+
+#endif // INFORMER_GATE_H_
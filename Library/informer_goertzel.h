@@ -0,0 +1,384 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef INFORMER_GOERTZEL_H_
+#define INFORMER_GOERTZEL_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if __cplusplus >= 202002L
+#include<concepts>
+#endif
+
+#include "informer.h"
+
+namespace Informer
+{
+
+/* SPARSE BANDS */
+
+// Energy at a few frequencies or narrow bands of a frame, without an FFT: a Goertzel filter per
+// probe frequency, O(frame size * probes). The probes are updated together sample by sample, so
+// the inner loop runs across the probes and is vectorized. Each band holds the probes between its
+// edges, spaced by the frame resolution (sample rate / frame size), and at least the one at its
+// center; set_frequencies() makes a band of a single probe per frequency. The magnitudes have the
+// scale of an unnormalized FFT of the frame windowed with Frequency::window(), so the descriptors
+// of get_frequency_descriptors() can be compared with those computed on the full spectrum.
+// The filter states are kept in WideSample, since the recursion is ill conditioned at low
+// frequencies (e.g. mains hum) in float. Memory is allocated only by the setters.
+template <typename TSample>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+class GoertzelBank
+{
+public:
+    GoertzelBank(const TSample& sample_rate = static_cast<TSample>(44100.0), const size_t& frame_size = 4096u)
+    {
+        sample_rate_ = sample_rate > static_cast<TSample>(0.0) ? sample_rate : static_cast<TSample>(44100.0);
+        frame_size_ = frame_size > 1u ? frame_size : 4096u;
+        allocate_();
+    }
+
+    ~GoertzelBank() = default;
+
+    bool set_sample_rate(const TSample& sample_rate)
+    {
+        if (sample_rate <= static_cast<TSample>(0.0))
+        {
+            return false;
+        }
+
+        sample_rate_ = sample_rate;
+        allocate_();
+
+        return true;
+    }
+
+    // Frames given to process() must have this size
+    bool set_frame_size(const size_t& frame_size)
+    {
+        if (frame_size < 2u)
+        {
+            return false;
+        }
+
+        frame_size_ = frame_size;
+        allocate_();
+
+        return true;
+    }
+
+    // One band of a single probe for each frequency (in Hz, up to Nyquist)
+    bool set_frequencies(const std::vector<TSample>& frequencies)
+    {
+        std::vector<std::array<TSample, 2>> bands;
+
+        for (const auto& f : frequencies)
+        {
+            if (f < static_cast<TSample>(0.0) || f > static_cast<TSample>(0.5) * sample_rate_)
+            {
+                return false;
+            }
+
+            bands.push_back({f, f});
+        }
+
+        bands_ = bands;
+        allocate_();
+
+        return true;
+    }
+
+    // Bands as {low, high} edges in Hz, low <= high <= Nyquist
+    bool set_bands(const std::vector<std::array<TSample, 2>>& bands)
+    {
+        for (const auto& band : bands)
+        {
+            if (band[0] < static_cast<TSample>(0.0) || band[1] < band[0] || band[1] > static_cast<TSample>(0.5) * sample_rate_)
+            {
+                return false;
+            }
+        }
+
+        bands_ = bands;
+        allocate_();
+
+        return true;
+    }
+
+    bool set_hann_window(const bool& hann)
+    {
+        hann_window_ = hann;
+        allocate_();
+
+        return true;
+    }
+
+    // Analyze a frame of frame_size samples
+    bool process(const TSample* frame, const size_t& size)
+    {
+        INFORMER_PROFILE_SCOPE("goertzel_bank");
+
+        if (frame == nullptr || size != frame_size_)
+        {
+            return false;
+        }
+
+        const size_t probes = coefficients_.size();
+        std::fill(state_1_.begin(), state_1_.end(), static_cast<WideSample<TSample>>(0.0));
+        std::fill(state_2_.begin(), state_2_.end(), static_cast<WideSample<TSample>>(0.0));
+
+        WideSample<TSample>* s1 = state_1_.data();
+        WideSample<TSample>* s2 = state_2_.data();
+        const WideSample<TSample>* c = coefficients_.data();
+
+        for (size_t n = 0; n < frame_size_; n++)
+        {
+            const WideSample<TSample> x = static_cast<WideSample<TSample>>(hann_window_ ? frame[n] * window_[n] : frame[n]);
+
+            for (size_t p = 0; p < probes; p++)
+            {
+                const WideSample<TSample> s0 = x + c[p] * s1[p] - s2[p];
+                s2[p] = s1[p];
+                s1[p] = s0;
+            }
+        }
+
+        previous_magnitudes_.swap(magnitudes_);
+
+        for (size_t p = 0; p < probes; p++)
+        {
+            const WideSample<TSample> power = s1[p] * s1[p] + s2[p] * s2[p] - c[p] * s1[p] * s2[p];
+            magnitudes_[p] = static_cast<TSample>(std::sqrt(std::max(power, static_cast<WideSample<TSample>>(0.0))));
+        }
+
+        compute_descriptors_();
+
+        return true;
+    }
+
+    bool process(const std::vector<TSample>& frame)
+    {
+        return process(frame.data(), frame.size());
+    }
+
+    // Sum of the squared magnitudes of the probes of each band
+    const std::vector<TSample>& get_band_energies() const
+    {
+        return band_energies_;
+    }
+
+    TSample get_band_energy(const size_t& band) const
+    {
+        return band < band_energies_.size() ? band_energies_[band] : static_cast<TSample>(0.0);
+    }
+
+    // Magnitudes of the probes, band after band
+    const std::vector<TSample>& get_magnitudes() const
+    {
+        return magnitudes_;
+    }
+
+    // Frequencies of the probes, band after band
+    const std::vector<TSample>& get_frequencies() const
+    {
+        return frequencies_;
+    }
+
+    // Descriptors over the probes, with the names of Informer: "centroid", "spread",
+    // "crestfactor", "flatness", "flux", "peak" (frequency of the strongest probe) and
+    // "energy" (of all the bands)
+    const std::unordered_map<std::string, TSample>& get_frequency_descriptors() const
+    {
+        return descriptors_;
+    }
+
+    TSample get_frequency_descriptor(const std::string& descriptor) const
+    {
+        const auto d = descriptors_.find(descriptor);
+
+        return d != descriptors_.end() ? d->second : static_cast<TSample>(0.0);
+    }
+
+private:
+    TSample sample_rate_ = static_cast<TSample>(44100.0);
+    size_t frame_size_ = 4096u;
+    bool hann_window_ = true;
+    std::vector<std::array<TSample, 2>> bands_ = {};
+    std::vector<size_t> band_probes_ = {};
+    std::vector<TSample> frequencies_ = {};
+    std::vector<WideSample<TSample>> coefficients_ = {};
+    std::vector<WideSample<TSample>> state_1_ = {};
+    std::vector<WideSample<TSample>> state_2_ = {};
+    std::vector<TSample> window_ = {};
+    std::vector<TSample> magnitudes_ = {};
+    std::vector<TSample> previous_magnitudes_ = {};
+    std::vector<TSample> band_energies_ = {};
+    std::unordered_map<std::string, TSample> descriptors_ = {};
+
+    void allocate_()
+    {
+        constexpr WideSample<TSample> two_pi = static_cast<WideSample<TSample>>(6.28318530717958647692);
+        const TSample resolution = sample_rate_ / static_cast<TSample>(frame_size_);
+
+        frequencies_.clear();
+        band_probes_.clear();
+
+        for (const auto& band : bands_)
+        {
+            const size_t first = static_cast<size_t>(std::ceil(band[0] / resolution));
+            const size_t last = static_cast<size_t>(std::floor(band[1] / resolution));
+
+            if (first <= last && band[1] > band[0])
+            {
+                for (size_t k = first; k <= last; k++)
+                {
+                    frequencies_.push_back(static_cast<TSample>(k) * resolution);
+                }
+
+                band_probes_.push_back(last - first + 1u);
+            }
+            else
+            {
+                frequencies_.push_back(static_cast<TSample>(0.5) * (band[0] + band[1]));
+                band_probes_.push_back(1u);
+            }
+        }
+
+        coefficients_.resize(frequencies_.size());
+        for (size_t p = 0; p < frequencies_.size(); p++)
+        {
+            coefficients_[p] = static_cast<WideSample<TSample>>(2.0) *
+                               std::cos(two_pi * static_cast<WideSample<TSample>>(frequencies_[p]) / static_cast<WideSample<TSample>>(sample_rate_));
+        }
+
+        // Same window as Frequency::window()
+        window_.assign(frame_size_, static_cast<TSample>(1.0));
+        if (hann_window_)
+        {
+            for (size_t n = 0; n < frame_size_; n++)
+            {
+                const WideSample<TSample> x = static_cast<WideSample<TSample>>(n) / static_cast<WideSample<TSample>>(frame_size_ - 1u);
+                window_[n] = static_cast<TSample>(0.5 * (1.0 - std::cos(two_pi * x)));
+            }
+        }
+
+        state_1_.assign(frequencies_.size(), static_cast<WideSample<TSample>>(0.0));
+        state_2_.assign(frequencies_.size(), static_cast<WideSample<TSample>>(0.0));
+        magnitudes_.assign(frequencies_.size(), static_cast<TSample>(0.0));
+        previous_magnitudes_.assign(frequencies_.size(), static_cast<TSample>(0.0));
+        band_energies_.assign(band_probes_.size(), static_cast<TSample>(0.0));
+
+        for (const char* name : {"centroid", "spread", "crestfactor", "flatness", "flux", "peak", "energy"})
+        {
+            descriptors_[name] = static_cast<TSample>(0.0);
+        }
+    }
+
+    void compute_descriptors_()
+    {
+        const size_t probes = magnitudes_.size();
+
+        Accumulator<TSample> magn_sum;
+        Accumulator<TSample> weighted_sum;
+        Accumulator<TSample> ln_magn_sum;
+        Accumulator<TSample> flux;
+        TSample magn_max = static_cast<TSample>(0.0);
+        size_t magn_max_idx = 0u;
+        const TSample ln_floor = std::log(static_cast<TSample>(0.00001));
+
+        for (size_t p = 0, b = 0; b < band_probes_.size(); b++)
+        {
+            Accumulator<TSample> energy;
+
+            for (size_t end = p + band_probes_[b]; p < end; p++)
+            {
+                const TSample m = magnitudes_[p];
+                const TSample d = m - previous_magnitudes_[p];
+                magn_sum += m;
+                weighted_sum += m * frequencies_[p];
+                ln_magn_sum += m > static_cast<TSample>(0.0) ? std::log(m) : ln_floor;
+                flux += d * d;
+                energy += m * m;
+
+                if (m > magn_max)
+                {
+                    magn_max = m;
+                    magn_max_idx = p;
+                }
+            }
+
+            band_energies_[b] = energy;
+        }
+
+        auto& f = descriptors_;
+
+        if (probes == 0u)
+        {
+            return;
+        }
+
+        // The flux of a silent frame measures how much signal has gone
+        const TSample inv_probes = static_cast<TSample>(1.0) / static_cast<TSample>(probes);
+        f["flux"] = std::sqrt(static_cast<TSample>(flux)) * inv_probes;
+
+        if (magn_sum <= static_cast<TSample>(0.0))
+        {
+            for (auto& d : f)
+            {
+                if (d.first != "flux")
+                {
+                    d.second = static_cast<TSample>(0.0);
+                }
+            }
+
+            return;
+        }
+
+        const TSample centroid = weighted_sum / magn_sum;
+        Accumulator<TSample> spread;
+
+        for (size_t p = 0; p < probes; p++)
+        {
+            const TSample d = frequencies_[p] - centroid;
+            spread += d * d * magnitudes_[p];
+        }
+
+        f["centroid"] = centroid;
+        f["spread"] = std::sqrt(spread / magn_sum);
+        f["crestfactor"] = magn_max / magn_sum;
+        f["flatness"] = std::exp(ln_magn_sum * inv_probes) / (magn_sum * inv_probes);
+        f["peak"] = frequencies_[magn_max_idx];
+        f["energy"] = std::accumulate(band_energies_.begin(), band_energies_.end(), static_cast<TSample>(0.0));
+    }
+};
+
+} // namespace Informer
+
+#endif // INFORMER_GOERTZEL_H_
@@ -0,0 +1,326 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+// Part of informer.h, which includes it before the Informer class
+#include "informer.h"
+
+#ifndef INFORMER_HPSS_H_
+#define INFORMER_HPSS_H_
+
+#include <algorithm>
+#include <cmath>
+#include <utility>
+#include <vector>
+
+#if __cplusplus >= 202002L
+#include<concepts>
+#endif
+
+namespace Informer
+{
+
+/* HARMONIC-PERCUSSIVE SEPARATION */
+
+// Median of the last length values pushed (the window starts full of zeros). The window is
+// also kept sorted, so a push removes the oldest value and inserts the new one with a binary
+// search and a shift: O(length) and no allocation, instead of a partial sort at every step.
+template <typename TSample>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+class SlidingMedian
+{
+public:
+    SlidingMedian(const size_t& length = 1u)
+    {
+        set_length(length);
+    }
+
+    ~SlidingMedian() = default;
+
+    // Clears the window
+    bool set_length(const size_t& length)
+    {
+        if (length < 1u)
+        {
+            return false;
+        }
+
+        ring_.assign(length, static_cast<TSample>(0.0));
+        sorted_.assign(length, static_cast<TSample>(0.0));
+        head_ = 0u;
+
+        return true;
+    }
+
+    void clear()
+    {
+        std::fill(ring_.begin(), ring_.end(), static_cast<TSample>(0.0));
+        std::fill(sorted_.begin(), sorted_.end(), static_cast<TSample>(0.0));
+        head_ = 0u;
+    }
+
+    TSample push(const TSample& value)
+    {
+        const TSample oldest = ring_[head_];
+        ring_[head_] = value;
+        head_ = head_ + 1u == ring_.size() ? 0u : head_ + 1u;
+
+        auto position = std::lower_bound(sorted_.begin(), sorted_.end(), oldest);
+        auto insertion = std::lower_bound(sorted_.begin(), sorted_.end(), value);
+
+        // Shift the values between the removed and the inserted one by a slot
+        if (insertion > position)
+        {
+            --insertion;
+            std::move(position + 1, insertion + 1, position);
+        }
+        else
+        {
+            std::move_backward(insertion, position, position + 1);
+        }
+
+        *insertion = value;
+
+        return median();
+    }
+
+    // Upper median for even lengths
+    TSample median() const
+    {
+        return sorted_[sorted_.size() / 2u];
+    }
+
+    size_t length() const
+    {
+        return ring_.size();
+    }
+
+private:
+    std::vector<TSample> ring_ = {};
+    std::vector<TSample> sorted_ = {};
+    size_t head_ = 0u;
+};
+
+// Real-time harmonic-percussive separation of a magnitude spectrum (Fitzgerald's median
+// filtering): sustained tones are smooth across time, transients across frequency. The
+// harmonic enhanced spectrum is the median of each bin over the last time_length frames, the
+// percussive enhanced one the median over frequency_length neighbouring bins of the current
+// frame. Their soft (Wiener) masks, summing to 1, split the current magnitudes. The time median
+// only looks at past frames, so no latency is added, at the cost of the harmonic part of an
+// onset being recognized (time_length - 1) / 2 frames late. Memory is allocated only when a
+// length or the spectrum size changes.
+template <typename TSample>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+class HarmonicPercussive
+{
+public:
+    HarmonicPercussive(const size_t& time_length = 17u, const size_t& frequency_length = 17u)
+    {
+        set_time_length(time_length);
+        set_frequency_length(frequency_length);
+    }
+
+    ~HarmonicPercussive() = default;
+
+    // Odd lengths, in frames and in bins; both clear the state
+    bool set_time_length(const size_t& frames)
+    {
+        if (frames < 1u || frames % 2u == 0u)
+        {
+            return false;
+        }
+
+        time_length_ = frames;
+        resize_(bins_);
+
+        return true;
+    }
+
+    bool set_frequency_length(const size_t& bins)
+    {
+        if (bins < 1u || bins % 2u == 0u)
+        {
+            return false;
+        }
+
+        frequency_median_.set_length(bins);
+
+        return true;
+    }
+
+    // Exponent of the masks: 2 (default) for Wiener masks, higher values for a harder separation
+    bool set_power(const TSample& power)
+    {
+        if (power <= static_cast<TSample>(0.0))
+        {
+            return false;
+        }
+
+        power_ = power;
+
+        return true;
+    }
+
+    void clear()
+    {
+        for (auto& median : time_medians_)
+        {
+            median.clear();
+        }
+    }
+
+    // Separate a new spectrum; a spectrum of a different size clears the state
+    void process(const TSample* magnitudes, const size_t& size)
+    {
+        INFORMER_PROFILE_SCOPE("harmonic_percussive");
+
+        if (size != bins_)
+        {
+            resize_(size);
+        }
+
+        if (bins_ == 0u)
+        {
+            return;
+        }
+
+        for (size_t k = 0; k < bins_; k++)
+        {
+            harmonic_mask_[k] = time_medians_[k].push(std::abs(magnitudes[k]));
+        }
+
+        // Centered median over frequency, with zeros beyond the edges
+        const size_t half_length = frequency_median_.length() / 2u;
+        frequency_median_.clear();
+
+        for (size_t k = 0; k < bins_ + half_length; k++)
+        {
+            const TSample median = frequency_median_.push(k < bins_ ? std::abs(magnitudes[k]) : static_cast<TSample>(0.0));
+
+            if (k >= half_length)
+            {
+                percussive_mask_[k - half_length] = median;
+            }
+        }
+
+        for (size_t k = 0; k < bins_; k++)
+        {
+            TSample harmonic = harmonic_mask_[k];
+            TSample percussive = percussive_mask_[k];
+
+            if (power_ == static_cast<TSample>(2.0))
+            {
+                harmonic *= harmonic;
+                percussive *= percussive;
+            }
+            else
+            {
+                harmonic = std::pow(harmonic, power_);
+                percussive = std::pow(percussive, power_);
+            }
+
+            const TSample total = harmonic + percussive;
+            harmonic_mask_[k] = total > static_cast<TSample>(0.0) ? harmonic / total : static_cast<TSample>(0.5);
+            percussive_mask_[k] = static_cast<TSample>(1.0) - harmonic_mask_[k];
+            harmonic_[k] = magnitudes[k] * harmonic_mask_[k];
+            percussive_[k] = magnitudes[k] * percussive_mask_[k];
+        }
+    }
+
+    // A frame of zeros, e.g. a silent frame: the time medians move on, so the harmonic part
+    // of the sound that follows is not estimated from the frames before the silence
+    void push_silence()
+    {
+        for (auto& median : time_medians_)
+        {
+            median.push(static_cast<TSample>(0.0));
+        }
+
+        std::fill(harmonic_mask_.begin(), harmonic_mask_.end(), static_cast<TSample>(0.5));
+        std::fill(percussive_mask_.begin(), percussive_mask_.end(), static_cast<TSample>(0.5));
+        std::fill(harmonic_.begin(), harmonic_.end(), static_cast<TSample>(0.0));
+        std::fill(percussive_.begin(), percussive_.end(), static_cast<TSample>(0.0));
+    }
+
+    const std::vector<TSample>& get_harmonic() const
+    {
+        return harmonic_;
+    }
+
+    const std::vector<TSample>& get_percussive() const
+    {
+        return percussive_;
+    }
+
+    const std::vector<TSample>& get_harmonic_mask() const
+    {
+        return harmonic_mask_;
+    }
+
+    const std::vector<TSample>& get_percussive_mask() const
+    {
+        return percussive_mask_;
+    }
+
+    size_t get_time_length() const
+    {
+        return time_length_;
+    }
+
+    size_t get_frequency_length() const
+    {
+        return frequency_median_.length();
+    }
+
+    TSample get_power() const
+    {
+        return power_;
+    }
+
+private:
+    std::vector<SlidingMedian<TSample>> time_medians_ = {};
+    SlidingMedian<TSample> frequency_median_;
+    std::vector<TSample> harmonic_mask_ = {};
+    std::vector<TSample> percussive_mask_ = {};
+    std::vector<TSample> harmonic_ = {};
+    std::vector<TSample> percussive_ = {};
+    size_t time_length_ = 17u;
+    size_t bins_ = 0u;
+    TSample power_ = static_cast<TSample>(2.0);
+
+    inline void resize_(const size_t& bins)
+    {
+        bins_ = bins;
+        time_medians_.assign(bins_, SlidingMedian<TSample>(time_length_));
+        harmonic_mask_.assign(bins_, static_cast<TSample>(0.0));
+        percussive_mask_.assign(bins_, static_cast<TSample>(0.0));
+        harmonic_.assign(bins_, static_cast<TSample>(0.0));
+        percussive_.assign(bins_, static_cast<TSample>(0.0));
+    }
+};
+
+} // namespace Informer
+
+#endif // INFORMER_HPSS_H_
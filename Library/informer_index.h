@@ -0,0 +1,719 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef INFORMER_INDEX_H_
+#define INFORMER_INDEX_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <numeric>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#if __cplusplus >= 202002L
+#include<concepts>
+#endif
+
+namespace Informer
+{
+
+/* NEAREST NEIGHBOUR INDEX */
+
+// Index over descriptor frames, to find the frames of a corpus closest to a
+// descriptor vector (e.g. for concatenative synthesis). Each entry is a vector
+// with one value per descriptor, plus a user id (e.g. the frame number in the
+// corpus). The distance is the weighted squared euclidean distance
+// sum(weight[d] * (a[d] - b[d])^2), so the descriptors should be normalized
+// (Informer::normalize_descriptors()) or scaled through the weights.
+//
+// Entries are stored in a KD-tree, whose leaves are contiguous runs of vectors.
+// Inserted entries are kept in a pending run, scanned linearly by the queries,
+// until the tree is rebuilt (by build(), or automatically when the pending run
+// grows past a quarter of the indexed entries). Queries do not allocate once
+// the results vector has capacity for k matches, and can run concurrently with
+// each other but not with inserts.
+namespace Index
+{
+
+constexpr char file_magic[8] = {'I', 'N', 'F', 'O', 'I', 'D', 'X', '\0'};
+constexpr uint32_t format_version = 1u;
+constexpr uint32_t endian_tag = 0x01020304u;
+constexpr size_t name_size = 64u;
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t endian;
+    uint32_t sample_size;
+    uint32_t dimensions;
+    uint64_t entry_count;
+    uint64_t indexed_count;
+    uint64_t node_count;
+    uint32_t leaf_size;
+    uint32_t reserved[3];
+};
+
+static_assert(sizeof(FileHeader) == 64u, "Unexpected FileHeader padding");
+
+template <typename TSample = float>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+class DescriptorIndex
+{
+public:
+    struct Match
+    {
+        uint64_t id;
+        TSample distance;
+    };
+
+    // Descriptor names follow the track files convention: "time::" or "freq::"
+    // followed by the descriptor name (e.g. "freq::centroid") when vectors are
+    // gathered from an analyzer, any name otherwise.
+    explicit DescriptorIndex(const std::vector<std::string>& descriptor_names = {}, const uint32_t& leaf_size = 32u)
+    {
+        set_descriptors(descriptor_names);
+        set_leaf_size(leaf_size);
+    }
+
+    // Changing the descriptors clears the index
+    bool set_descriptors(const std::vector<std::string>& descriptor_names)
+    {
+        for (const auto& name : descriptor_names)
+        {
+            if (name.empty() || name.size() >= name_size)
+            {
+                return false;
+            }
+        }
+
+        names_ = descriptor_names;
+        name_lookup_.clear();
+        domains_.assign(names_.size(), Domain::Other);
+        keys_.assign(names_.size(), "");
+
+        for (size_t d = 0; d < names_.size(); d++)
+        {
+            name_lookup_[names_[d]] = d;
+
+            if (names_[d].rfind("time::", 0) == 0)
+            {
+                domains_[d] = Domain::Time;
+                keys_[d] = names_[d].substr(6);
+            }
+            else if (names_[d].rfind("freq::", 0) == 0)
+            {
+                domains_[d] = Domain::Frequency;
+                keys_[d] = names_[d].substr(6);
+            }
+        }
+
+        weights_.assign(names_.size(), static_cast<TSample>(1.0));
+        clear();
+
+        return true;
+    }
+
+    bool set_leaf_size(const uint32_t& leaf_size)
+    {
+        if (leaf_size == 0u)
+        {
+            return false;
+        }
+
+        leaf_size_ = leaf_size;
+
+        return true;
+    }
+
+    bool set_weight(const std::string& descriptor_name, const TSample& weight)
+    {
+        auto d = name_lookup_.find(descriptor_name);
+
+        if (d == name_lookup_.end() || !(weight >= static_cast<TSample>(0.0)))
+        {
+            return false;
+        }
+
+        weights_[d->second] = weight;
+
+        return true;
+    }
+
+    bool set_weights(const std::vector<TSample>& weights)
+    {
+        if (weights.size() != names_.size())
+        {
+            return false;
+        }
+
+        for (const auto& w : weights)
+        {
+            if (!(w >= static_cast<TSample>(0.0)))
+            {
+                return false;
+            }
+        }
+
+        weights_ = weights;
+
+        return true;
+    }
+
+    // With auto build off, the tree is rebuilt only by build()
+    void set_auto_build(const bool& auto_build)
+    {
+        auto_build_ = auto_build;
+    }
+
+    const std::vector<std::string>& get_descriptors() const
+    {
+        return names_;
+    }
+
+    const std::vector<TSample>& get_weights() const
+    {
+        return weights_;
+    }
+
+    size_t get_dimensions() const
+    {
+        return names_.size();
+    }
+
+    size_t size() const
+    {
+        return ids_.size();
+    }
+
+    // Entries not yet in the tree
+    size_t get_pending() const
+    {
+        return ids_.size() - indexed_;
+    }
+
+    void clear()
+    {
+        values_.clear();
+        ids_.clear();
+        nodes_.clear();
+        indexed_ = 0u;
+    }
+
+    void reserve(const size_t& entries)
+    {
+        values_.reserve(entries * names_.size());
+        ids_.reserve(entries);
+    }
+
+    // Copy the descriptors of an analyzer (Informer or FixedInformer) into values,
+    // one per descriptor in index order. Descriptors without a "time::" or "freq::"
+    // prefix are left untouched.
+    template <typename TAnalyzer>
+    void gather(const TAnalyzer& analyzer, TSample* values) const
+    {
+        for (size_t d = 0; d < names_.size(); d++)
+        {
+            if (domains_[d] == Domain::Time)
+            {
+                values[d] = static_cast<TSample>(analyzer.get_time_descriptor(keys_[d]));
+            }
+            else if (domains_[d] == Domain::Frequency)
+            {
+                values[d] = static_cast<TSample>(analyzer.get_frequency_descriptor(keys_[d]));
+            }
+        }
+    }
+
+    // Copy the descriptors found in a map, as returned by Informer::get_*_descriptors(),
+    // with an optional prefix added to the keys
+    template <typename TValue>
+#if __cplusplus >= 202002L
+    requires std::floating_point<TValue>
+#endif
+    void gather(const std::unordered_map<std::string, TValue>& descriptors, TSample* values, const std::string& prefix = "") const
+    {
+        for (const auto& [name, value] : descriptors)
+        {
+            auto d = name_lookup_.find(prefix + name);
+
+            if (d != name_lookup_.end())
+            {
+                values[d->second] = static_cast<TSample>(value);
+            }
+        }
+    }
+
+    // Add an entry, values holds one value per descriptor. Vectors with
+    // non finite values are rejected.
+    bool insert(const TSample* values, const uint64_t& id)
+    {
+        if (values == nullptr || names_.empty())
+        {
+            return false;
+        }
+
+        for (size_t d = 0; d < names_.size(); d++)
+        {
+            if (!std::isfinite(values[d]))
+            {
+                return false;
+            }
+        }
+
+        values_.insert(values_.end(), values, values + names_.size());
+        ids_.push_back(id);
+
+        if (auto_build_ && get_pending() > std::max(static_cast<size_t>(leaf_size_) * 32u, indexed_ / 4u))
+        {
+            build();
+        }
+
+        return true;
+    }
+
+    bool insert(const std::vector<TSample>& values, const uint64_t& id)
+    {
+        return values.size() == names_.size() && insert(values.data(), id);
+    }
+
+    template <typename TAnalyzer>
+    bool insert_analyzer(const TAnalyzer& analyzer, const uint64_t& id)
+    {
+        scratch_.assign(names_.size(), static_cast<TSample>(0.0));
+        gather(analyzer, scratch_.data());
+
+        return insert(scratch_.data(), id);
+    }
+
+    // (Re)build the tree over all the entries
+    void build()
+    {
+        const size_t dims = names_.size();
+        const size_t count = ids_.size();
+
+        nodes_.clear();
+        indexed_ = 0u;
+
+        if (count == 0u)
+        {
+            return;
+        }
+
+        std::vector<uint32_t> order(count);
+        std::iota(order.begin(), order.end(), 0u);
+        nodes_.reserve(2u * (count / leaf_size_ + 1u));
+        build_node_(order, 0u, static_cast<uint32_t>(count));
+
+        // Store the entries in tree order, so that each leaf is contiguous
+        std::vector<TSample> values(count * dims);
+        std::vector<uint64_t> ids(count);
+        for (size_t i = 0; i < count; i++)
+        {
+            std::memcpy(values.data() + i * dims, values_.data() + order[i] * dims, dims * sizeof(TSample));
+            ids[i] = ids_[order[i]];
+        }
+
+        values_.swap(values);
+        ids_.swap(ids);
+        indexed_ = count;
+    }
+
+    // The k nearest entries to query (one value per descriptor), closest first
+    void search(const TSample* query, const size_t& k, std::vector<Match>& results) const
+    {
+        results.clear();
+
+        if (query == nullptr || k == 0u || ids_.empty())
+        {
+            return;
+        }
+
+        if (!nodes_.empty())
+        {
+            search_node_(0u, query, k, results);
+        }
+
+        scan_(indexed_, ids_.size(), query, k, results);
+        std::sort_heap(results.begin(), results.end(), closer_);
+    }
+
+    void search(const std::vector<TSample>& query, const size_t& k, std::vector<Match>& results) const
+    {
+        if (query.size() != names_.size())
+        {
+            results.clear();
+            return;
+        }
+
+        search(query.data(), k, results);
+    }
+
+    template <typename TAnalyzer>
+    void search_analyzer(const TAnalyzer& analyzer, const size_t& k, std::vector<Match>& results)
+    {
+        scratch_.assign(names_.size(), static_cast<TSample>(0.0));
+        gather(analyzer, scratch_.data());
+        search(scratch_.data(), k, results);
+    }
+
+    // Exhaustive search, useful for small corpora, for weights that make the tree
+    // inefficient (e.g. most of them at zero) or to check the tree results
+    void search_brute_force(const TSample* query, const size_t& k, std::vector<Match>& results) const
+    {
+        results.clear();
+
+        if (query == nullptr || k == 0u)
+        {
+            return;
+        }
+
+        scan_(0u, ids_.size(), query, k, results);
+        std::sort_heap(results.begin(), results.end(), closer_);
+    }
+
+    // PERSISTENCE
+    // The index is saved with its tree, so loading does not rebuild it
+    bool save(const std::string& path) const
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::out | std::ios::trunc);
+
+        if (!file)
+        {
+            return false;
+        }
+
+        FileHeader header;
+        std::memset(&header, 0, sizeof(FileHeader));
+        std::memcpy(header.magic, file_magic, sizeof(file_magic));
+        header.version = format_version;
+        header.endian = endian_tag;
+        header.sample_size = static_cast<uint32_t>(sizeof(TSample));
+        header.dimensions = static_cast<uint32_t>(names_.size());
+        header.entry_count = ids_.size();
+        header.indexed_count = indexed_;
+        header.node_count = nodes_.size();
+        header.leaf_size = leaf_size_;
+
+        std::vector<char> schema(names_.size() * name_size, '\0');
+        for (size_t d = 0; d < names_.size(); d++)
+        {
+            std::memcpy(schema.data() + d * name_size, names_[d].data(), names_[d].size());
+        }
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(FileHeader));
+        file.write(schema.data(), static_cast<std::streamsize>(schema.size()));
+        file.write(reinterpret_cast<const char*>(weights_.data()), static_cast<std::streamsize>(weights_.size() * sizeof(TSample)));
+        file.write(reinterpret_cast<const char*>(values_.data()), static_cast<std::streamsize>(values_.size() * sizeof(TSample)));
+        file.write(reinterpret_cast<const char*>(ids_.data()), static_cast<std::streamsize>(ids_.size() * sizeof(uint64_t)));
+        file.write(reinterpret_cast<const char*>(nodes_.data()), static_cast<std::streamsize>(nodes_.size() * sizeof(Node)));
+
+        return static_cast<bool>(file);
+    }
+
+    // On failure the index is left empty
+    bool load(const std::string& path)
+    {
+        set_descriptors({});
+
+        std::ifstream file(path, std::ios::binary | std::ios::in | std::ios::ate);
+
+        if (!file)
+        {
+            return false;
+        }
+
+        const uint64_t file_size = static_cast<uint64_t>(file.tellg());
+        file.seekg(0);
+
+        FileHeader header;
+        if (file_size < sizeof(FileHeader) ||
+            !file.read(reinterpret_cast<char*>(&header), sizeof(FileHeader)) ||
+            std::memcmp(header.magic, file_magic, sizeof(file_magic)) != 0 ||
+            header.version != format_version || header.endian != endian_tag ||
+            header.sample_size != sizeof(TSample) || header.leaf_size == 0u ||
+            header.indexed_count > header.entry_count)
+        {
+            return false;
+        }
+
+        const uint64_t dims = header.dimensions;
+        const uint64_t expected = sizeof(FileHeader) + dims * name_size + dims * sizeof(TSample) +
+                                  header.entry_count * (dims * sizeof(TSample) + sizeof(uint64_t)) +
+                                  header.node_count * sizeof(Node);
+
+        if (expected != file_size)
+        {
+            return false;
+        }
+
+        std::vector<char> schema(dims * name_size);
+        file.read(schema.data(), static_cast<std::streamsize>(schema.size()));
+
+        std::vector<std::string> names(dims);
+        for (size_t d = 0; d < dims; d++)
+        {
+            const char* name = schema.data() + d * name_size;
+            names[d] = std::string(name, strnlen(name, name_size));
+        }
+
+        if (!set_descriptors(names) || !set_leaf_size(header.leaf_size))
+        {
+            return false;
+        }
+
+        std::vector<TSample> weights(dims);
+        values_.resize(header.entry_count * dims);
+        ids_.resize(header.entry_count);
+        nodes_.resize(header.node_count);
+        file.read(reinterpret_cast<char*>(weights.data()), static_cast<std::streamsize>(weights.size() * sizeof(TSample)));
+        file.read(reinterpret_cast<char*>(values_.data()), static_cast<std::streamsize>(values_.size() * sizeof(TSample)));
+        file.read(reinterpret_cast<char*>(ids_.data()), static_cast<std::streamsize>(ids_.size() * sizeof(uint64_t)));
+        file.read(reinterpret_cast<char*>(nodes_.data()), static_cast<std::streamsize>(nodes_.size() * sizeof(Node)));
+        indexed_ = header.indexed_count;
+
+        if (!file || !set_weights(weights) || !validate_())
+        {
+            set_descriptors({});
+            return false;
+        }
+
+        return true;
+    }
+
+private:
+    enum class Domain : uint8_t
+    {
+        Other = 0,
+        Time = 1,
+        Frequency = 2
+    };
+
+    // A leaf has split_dimension == leaf_node and holds the entries [begin, end),
+    // an inner node has its children at left and right
+    struct Node
+    {
+        uint32_t begin;
+        uint32_t end;
+        uint32_t split_dimension;
+        uint32_t left;
+        uint32_t right;
+        uint32_t reserved;
+        double split;
+    };
+
+    static constexpr uint32_t leaf_node = std::numeric_limits<uint32_t>::max();
+
+    static bool closer_(const Match& a, const Match& b)
+    {
+        return a.distance < b.distance;
+    }
+
+    const TSample* entry_(const size_t& i) const
+    {
+        return values_.data() + i * names_.size();
+    }
+
+    // Stops as soon as the distance exceeds bound
+    TSample distance_(const TSample* a, const TSample* b, const TSample& bound) const
+    {
+        TSample distance = static_cast<TSample>(0.0);
+
+        for (size_t d = 0; d < names_.size() && distance <= bound; d++)
+        {
+            const TSample diff = a[d] - b[d];
+            distance += weights_[d] * diff * diff;
+        }
+
+        return distance;
+    }
+
+    // Results are kept as a max heap on the distance while searching
+    void offer_(const uint64_t& id, const TSample& distance, const size_t& k, std::vector<Match>& results) const
+    {
+        if (results.size() < k)
+        {
+            results.push_back({id, distance});
+            std::push_heap(results.begin(), results.end(), closer_);
+        }
+        else if (distance < results.front().distance)
+        {
+            std::pop_heap(results.begin(), results.end(), closer_);
+            results.back() = {id, distance};
+            std::push_heap(results.begin(), results.end(), closer_);
+        }
+    }
+
+    void scan_(const size_t& begin, const size_t& end, const TSample* query, const size_t& k, std::vector<Match>& results) const
+    {
+        for (size_t i = begin; i < end; i++)
+        {
+            const TSample bound = results.size() < k ? std::numeric_limits<TSample>::max() : results.front().distance;
+            const TSample distance = distance_(entry_(i), query, bound);
+
+            if (results.size() < k || distance < results.front().distance)
+            {
+                offer_(ids_[i], distance, k, results);
+            }
+        }
+    }
+
+    void search_node_(const uint32_t& n, const TSample* query, const size_t& k, std::vector<Match>& results) const
+    {
+        const Node& node = nodes_[n];
+
+        if (node.split_dimension == leaf_node)
+        {
+            scan_(node.begin, node.end, query, k, results);
+            return;
+        }
+
+        const TSample offset = query[node.split_dimension] - static_cast<TSample>(node.split);
+        const uint32_t near = offset < static_cast<TSample>(0.0) ? node.left : node.right;
+        const uint32_t far = offset < static_cast<TSample>(0.0) ? node.right : node.left;
+
+        search_node_(near, query, k, results);
+
+        if (results.size() < k || weights_[node.split_dimension] * offset * offset < results.front().distance)
+        {
+            search_node_(far, query, k, results);
+        }
+    }
+
+    // Split on the dimension with the largest weighted spread, at the median
+    uint32_t build_node_(std::vector<uint32_t>& order, const uint32_t& begin, const uint32_t& end)
+    {
+        const uint32_t n = static_cast<uint32_t>(nodes_.size());
+        nodes_.push_back({begin, end, leaf_node, 0u, 0u, 0u, 0.0});
+
+        if (end - begin <= leaf_size_)
+        {
+            return n;
+        }
+
+        const size_t dims = names_.size();
+        uint32_t split_dimension = 0u;
+        TSample largest_spread = static_cast<TSample>(-1.0);
+
+        for (size_t d = 0; d < dims; d++)
+        {
+            TSample low = std::numeric_limits<TSample>::max();
+            TSample high = std::numeric_limits<TSample>::lowest();
+
+            for (uint32_t i = begin; i < end; i++)
+            {
+                const TSample value = values_[order[i] * dims + d];
+                low = std::min(low, value);
+                high = std::max(high, value);
+            }
+
+            const TSample spread = (high - low) * std::sqrt(weights_[d]);
+
+            if (spread > largest_spread)
+            {
+                largest_spread = spread;
+                split_dimension = static_cast<uint32_t>(d);
+            }
+        }
+
+        const uint32_t middle = begin + (end - begin) / 2u;
+        std::nth_element(order.begin() + begin, order.begin() + middle, order.begin() + end,
+                         [&](const uint32_t& a, const uint32_t& b)
+                         {
+                             return values_[a * dims + split_dimension] < values_[b * dims + split_dimension];
+                         });
+
+        // Entries on the left are <= split, those on the right >= split
+        const double split = static_cast<double>(values_[order[middle] * dims + split_dimension]);
+        const uint32_t left = build_node_(order, begin, middle);
+        const uint32_t right = build_node_(order, middle, end);
+
+        nodes_[n].split_dimension = split_dimension;
+        nodes_[n].split = split;
+        nodes_[n].left = left;
+        nodes_[n].right = right;
+
+        return n;
+    }
+
+    bool validate_() const
+    {
+        for (const auto& value : values_)
+        {
+            if (!std::isfinite(value))
+            {
+                return false;
+            }
+        }
+
+        if (nodes_.empty())
+        {
+            return indexed_ == 0u;
+        }
+
+        for (size_t n = 0; n < nodes_.size(); n++)
+        {
+            const Node& node = nodes_[n];
+
+            if (node.begin > node.end || node.end > indexed_)
+            {
+                return false;
+            }
+
+            if (node.split_dimension != leaf_node &&
+                (node.split_dimension >= names_.size() || node.left <= n || node.right <= n ||
+                 node.left >= nodes_.size() || node.right >= nodes_.size()))
+            {
+                return false;
+            }
+        }
+
+        return nodes_.front().begin == 0u && nodes_.front().end == indexed_;
+    }
+
+    std::vector<std::string> names_;
+    std::unordered_map<std::string, size_t> name_lookup_;
+    std::vector<Domain> domains_;
+    std::vector<std::string> keys_;
+    std::vector<TSample> weights_;
+
+    std::vector<TSample> values_;
+    std::vector<uint64_t> ids_;
+    std::vector<Node> nodes_;
+    std::vector<TSample> scratch_;
+    size_t indexed_ = 0u;
+    uint32_t leaf_size_ = 32u;
+    bool auto_build_ = true;
+};
+
+} // namespace Informer::Index
+
+} // namespace Informer
+
+#endif // INFORMER_INDEX_H_
@@ -0,0 +1,597 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+// Part of informer.h, which includes it before the Informer class
+#include "informer.h"
+
+#ifndef INFORMER_LARGE_FRAMES_H_
+#define INFORMER_LARGE_FRAMES_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#ifndef INFORMER_NO_THREADS
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+#endif
+#if __cplusplus >= 202002L
+#include<concepts>
+#endif
+
+namespace Informer
+{
+
+/* LARGE FRAMES */
+
+// Frames of tens of thousands of samples or bins (informer.bufferdesc, informer.freqdesc~...)
+// no longer fit in the L2 cache, and the YIN difference grows with the square of their size.
+// TiledSpectrum computes all the spectral sums in two passes over tiles that fit in the L1 cache,
+// and a ReductionPool can split such reductions, or the YIN lags, over a few threads. The
+// partial results are combined in a fixed order, so the descriptors do not depend on the
+// number of threads.
+
+// UTILITY STRUCTURE: threads that take part in the reductions of a frame. The caller thread
+// runs tasks too, then spins until the others are done, falling back to a blocking wait only
+// if they are late (a worker that was descheduled). Waking the workers still takes a mutex, so
+// the pool is meant for offline front ends: the default of one thread never touches it. Builds
+// defining INFORMER_NO_THREADS run every task on the caller.
+class ReductionPool
+{
+public:
+    static constexpr unsigned int max_threads = 16u;
+    // Checks of the finished workers before the caller blocks
+    static constexpr unsigned int spin_checks = 1u << 16;
+
+    // threads includes the caller, so 1 (default) means no worker thread
+    explicit ReductionPool(const unsigned int& threads = 1u)
+    {
+        set_threads(threads);
+    }
+
+    // A copy has its own workers
+    ReductionPool(const ReductionPool& other) : ReductionPool(other.threads_)
+    {
+    }
+
+    ReductionPool& operator=(const ReductionPool& other)
+    {
+        set_threads(other.threads_);
+
+        return *this;
+    }
+
+    ~ReductionPool()
+    {
+        stop_();
+    }
+
+    // The workers are started by the first run() that needs them
+    bool set_threads(const unsigned int& threads)
+    {
+        if (threads < 1u || threads > max_threads)
+        {
+            return false;
+        }
+
+#ifdef INFORMER_NO_THREADS
+        return threads == 1u;
+#else
+        if (threads != threads_)
+        {
+            stop_();
+            threads_ = threads;
+        }
+
+        return true;
+#endif
+    }
+
+    unsigned int get_threads() const
+    {
+        return threads_;
+    }
+
+    // Call task(t) for every t in [0, tasks), returning when all of them are done. A pool serves
+    // a single caller at a time.
+    template <typename Task>
+    void run(const size_t& tasks, Task& task)
+    {
+#ifndef INFORMER_NO_THREADS
+        if (threads_ > 1u && tasks > 1u)
+        {
+            start_();
+
+            {
+                std::lock_guard<std::mutex> lock(mutex_);
+                task_ = static_cast<void*>(&task);
+                invoke_ = [](void* context, const size_t& t)
+                {
+                    (*static_cast<Task*>(context))(t);
+                };
+                tasks_ = tasks;
+                next_.store(0u);
+                finished_.store(0u);
+                generation_++;
+            }
+
+            wake_.notify_all();
+            work_();
+
+            // No worker touches the task once all of them are finished
+            for (unsigned int s = 0u; s < spin_checks; s++)
+            {
+                if (finished_.load(std::memory_order_acquire) == workers_.size())
+                {
+                    return;
+                }
+            }
+
+            std::unique_lock<std::mutex> lock(mutex_);
+            done_.wait(lock, [this]()
+            {
+                return finished_.load(std::memory_order_acquire) == workers_.size();
+            });
+
+            return;
+        }
+#endif
+
+        for (size_t t = 0; t < tasks; t++)
+        {
+            task(t);
+        }
+    }
+
+private:
+    unsigned int threads_ = 1u;
+
+#ifndef INFORMER_NO_THREADS
+    std::vector<std::thread> workers_;
+    std::mutex mutex_;
+    std::condition_variable wake_;
+    std::condition_variable done_;
+    void* task_ = nullptr;
+    void (*invoke_)(void*, const size_t&) = nullptr;
+    size_t tasks_ = 0u;
+    std::atomic<size_t> next_ {0u};
+    std::atomic<size_t> finished_ {0u};
+    size_t generation_ = 0u;
+    bool stopping_ = false;
+
+    void start_()
+    {
+        if (workers_.size() + 1u == threads_)
+        {
+            return;
+        }
+
+        stopping_ = false;
+
+        for (unsigned int w = 1u; w < threads_; w++)
+        {
+            workers_.emplace_back([this, seen = generation_]() mutable
+            {
+                while (true)
+                {
+                    {
+                        std::unique_lock<std::mutex> lock(mutex_);
+                        wake_.wait(lock, [this, &seen]()
+                        {
+                            return stopping_ || generation_ != seen;
+                        });
+
+                        if (stopping_)
+                        {
+                            return;
+                        }
+
+                        seen = generation_;
+                    }
+
+                    work_();
+                    finished_.fetch_add(1u, std::memory_order_release);
+
+                    // Taking the mutex orders the notification after a caller that is
+                    // about to block, so it cannot be lost
+                    {
+                        std::lock_guard<std::mutex> lock(mutex_);
+                    }
+
+                    done_.notify_one();
+                }
+            });
+        }
+    }
+
+    void work_()
+    {
+        for (size_t t = next_.fetch_add(1u); t < tasks_; t = next_.fetch_add(1u))
+        {
+            invoke_(task_, t);
+        }
+    }
+
+    void stop_()
+    {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stopping_ = true;
+        }
+
+        wake_.notify_all();
+
+        for (auto& worker : workers_)
+        {
+            worker.join();
+        }
+
+        workers_.clear();
+    }
+#else
+    void stop_()
+    {
+    }
+#endif
+};
+
+// Spectral descriptors of TiledSpectrum, with the same definitions as the functions of the
+// Frequency namespace
+template <typename TSample>
+struct TiledDescriptors
+{
+    TSample centroid = static_cast<TSample>(0.0);
+    TSample spread = static_cast<TSample>(0.0);
+    TSample crestfactor = static_cast<TSample>(0.0);
+    TSample decrease = static_cast<TSample>(0.0);
+    TSample entropy = static_cast<TSample>(0.0);
+    TSample flatness = static_cast<TSample>(0.0);
+    TSample irregularity = static_cast<TSample>(0.0);
+    TSample kurtosis = static_cast<TSample>(0.0);
+    TSample peak = static_cast<TSample>(0.0);
+    TSample rolloff = static_cast<TSample>(0.0);
+    TSample skewness = static_cast<TSample>(0.0);
+    TSample slope = static_cast<TSample>(0.0);
+};
+
+// Fused spectral descriptors of a large frame, in two passes over tiles of tile_bins bins instead
+// of one pass per descriptor. The first pass sums what depends on the magnitudes only (magnitude,
+// weighted, power and logarithm sums, decrease, irregularity, maximum), the second one what also
+// depends on the centroid and on the total power (central moments, entropy, slope). The tiles are
+// summed with the accumulation policy, their sums are combined in WideSample and in tile order.
+// The frequencies are those of Frequency::precompute_frequencies() for the number of bins.
+template <typename TSample>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+class TiledSpectrum
+{
+public:
+    // 8 KiB of magnitudes per tile (2048 bins in float), so that a tile stays in the L1 cache while it is summed
+    static constexpr size_t tile_bins = 8192u / sizeof(TSample);
+
+    // With a pool, the tiles of each pass are split over its threads
+    const TiledDescriptors<TSample>& process(const TSample* magnitudes, const size_t& size, const TSample& sample_rate,
+                                             const TSample& rolloff_point = static_cast<TSample>(0.85),
+                                             ReductionPool* pool = nullptr)
+    {
+        descriptors_ = TiledDescriptors<TSample>();
+
+        if (magnitudes == nullptr || size < 2u || sample_rate <= static_cast<TSample>(0.0))
+        {
+            return descriptors_;
+        }
+
+        magnitudes_ = magnitudes;
+        size_ = size;
+        bandwidth_ = sample_rate / static_cast<TSample>((size - 1u) * 2u);
+        tiles_.resize((size + tile_bins - 1u) / tile_bins);
+
+        run_tiles_(pool, [this](const size_t& t)
+        {
+            first_pass_(t);
+        });
+
+        Wide magn_sum = static_cast<Wide>(0.0);
+        Wide weighted_sum = static_cast<Wide>(0.0);
+        Wide power_sum = static_cast<Wide>(0.0);
+        Wide ln_sum = static_cast<Wide>(0.0);
+        Wide decrease_sum = static_cast<Wide>(0.0);
+        Wide irregularity_sum = static_cast<Wide>(0.0);
+        TSample magn_max = static_cast<TSample>(0.0);
+        size_t magn_max_idx = 0u;
+
+        for (const auto& tile : tiles_)
+        {
+            magn_sum += tile.magn_sum;
+            weighted_sum += tile.weighted_sum;
+            power_sum += tile.power_sum;
+            ln_sum += tile.ln_sum;
+            decrease_sum += tile.decrease_sum;
+            irregularity_sum += tile.irregularity_sum;
+
+            if (tile.magn_max > magn_max)
+            {
+                magn_max = tile.magn_max;
+                magn_max_idx = tile.magn_max_idx;
+            }
+        }
+
+        if (magn_sum <= static_cast<Wide>(0.0))
+        {
+            return descriptors_;
+        }
+
+        const Wide bins = static_cast<Wide>(size);
+        centroid_ = static_cast<TSample>(weighted_sum / magn_sum);
+        power_ = static_cast<TSample>(power_sum);
+        mean_frequency_ = static_cast<TSample>(static_cast<Wide>(bandwidth_) * static_cast<Wide>(size - 1u) * static_cast<Wide>(0.5));
+        magn_mean_ = static_cast<TSample>(magn_sum / bins);
+
+        run_tiles_(pool, [this](const size_t& t)
+        {
+            second_pass_(t);
+        });
+
+        Wide spread_sum = static_cast<Wide>(0.0);
+        Wide skewness_sum = static_cast<Wide>(0.0);
+        Wide kurtosis_sum = static_cast<Wide>(0.0);
+        Wide information_sum = static_cast<Wide>(0.0);
+        Wide slope_sum = static_cast<Wide>(0.0);
+        Wide slope_denominator = static_cast<Wide>(0.0);
+
+        for (const auto& tile : tiles_)
+        {
+            spread_sum += tile.spread_sum;
+            skewness_sum += tile.skewness_sum;
+            kurtosis_sum += tile.kurtosis_sum;
+            information_sum += tile.information_sum;
+            slope_sum += tile.slope_sum;
+            slope_denominator += tile.slope_denominator;
+        }
+
+        auto& d = descriptors_;
+        const Wide spread = std::sqrt(spread_sum / magn_sum);
+        d.centroid = centroid_;
+        d.spread = static_cast<TSample>(spread);
+        d.crestfactor = static_cast<TSample>(static_cast<Wide>(magn_max) / magn_sum);
+        d.flatness = static_cast<TSample>(std::exp(ln_sum / bins) / (magn_sum / bins));
+        d.irregularity = static_cast<TSample>(irregularity_sum / magn_sum);
+        d.peak = static_cast<TSample>(magn_max_idx) * bandwidth_;
+        d.rolloff = static_cast<TSample>(rolloff_bin_(static_cast<Wide>(rolloff_point) * magn_sum)) * bandwidth_;
+
+        // The decrease leaves the DC bin out of the magnitude sum
+        const Wide decrease_magn_sum = magn_sum - static_cast<Wide>(std::abs(magnitudes_[0]));
+        if (decrease_magn_sum > static_cast<Wide>(0.0))
+        {
+            d.decrease = static_cast<TSample>(decrease_sum / decrease_magn_sum);
+        }
+
+        if (power_sum > static_cast<Wide>(0.0))
+        {
+            d.entropy = static_cast<TSample>(-information_sum / std::log2(bins));
+        }
+
+        if (spread > static_cast<Wide>(0.0))
+        {
+            d.skewness = static_cast<TSample>(skewness_sum / (magn_sum * spread * spread * spread));
+            d.kurtosis = static_cast<TSample>(kurtosis_sum / (magn_sum * spread * spread * spread * spread) - static_cast<Wide>(3.0));
+        }
+
+        if (slope_denominator > static_cast<Wide>(0.0))
+        {
+            d.slope = static_cast<TSample>(slope_sum / slope_denominator);
+        }
+
+        return descriptors_;
+    }
+
+    const TiledDescriptors<TSample>& get_descriptors() const
+    {
+        return descriptors_;
+    }
+
+private:
+    using Wide = WideSample<TSample>;
+
+    struct Tile
+    {
+        Wide magn_sum = static_cast<Wide>(0.0);
+        Wide weighted_sum = static_cast<Wide>(0.0);
+        Wide power_sum = static_cast<Wide>(0.0);
+        Wide ln_sum = static_cast<Wide>(0.0);
+        Wide decrease_sum = static_cast<Wide>(0.0);
+        Wide irregularity_sum = static_cast<Wide>(0.0);
+        TSample magn_max = static_cast<TSample>(0.0);
+        size_t magn_max_idx = 0u;
+        Wide spread_sum = static_cast<Wide>(0.0);
+        Wide skewness_sum = static_cast<Wide>(0.0);
+        Wide kurtosis_sum = static_cast<Wide>(0.0);
+        Wide information_sum = static_cast<Wide>(0.0);
+        Wide slope_sum = static_cast<Wide>(0.0);
+        Wide slope_denominator = static_cast<Wide>(0.0);
+    };
+
+    std::vector<Tile> tiles_;
+    TiledDescriptors<TSample> descriptors_;
+    const TSample* magnitudes_ = nullptr;
+    size_t size_ = 0u;
+    TSample bandwidth_ = static_cast<TSample>(0.0);
+    TSample centroid_ = static_cast<TSample>(0.0);
+    TSample power_ = static_cast<TSample>(0.0);
+    TSample mean_frequency_ = static_cast<TSample>(0.0);
+    TSample magn_mean_ = static_cast<TSample>(0.0);
+
+    // UTILITY FUNCTION: a few consecutive tiles per task, so that a task reads contiguous memory
+    template <typename Pass>
+    void run_tiles_(ReductionPool* pool, Pass pass)
+    {
+        const size_t tiles = tiles_.size();
+        const size_t tasks = pool != nullptr ? std::min(tiles, static_cast<size_t>(pool->get_threads()) * 4u) : 1u;
+        const size_t tiles_per_task = (tiles + tasks - 1u) / tasks;
+
+        auto task = [&](const size_t& t)
+        {
+            for (size_t tile = t * tiles_per_task; tile < std::min(tiles, (t + 1u) * tiles_per_task); tile++)
+            {
+                pass(tile);
+            }
+        };
+
+        if (tasks > 1u)
+        {
+            pool->run(tasks, task);
+        }
+        else
+        {
+            task(0u);
+        }
+    }
+
+    void first_pass_(const size_t& t)
+    {
+        const size_t begin = t * tile_bins;
+        const size_t end = std::min(begin + tile_bins, size_);
+        const TSample ln_floor = std::log(static_cast<TSample>(0.00001));
+        const TSample first = std::abs(magnitudes_[0]);
+
+        Accumulator<TSample> magn_sum;
+        Accumulator<TSample> weighted_sum;
+        Accumulator<TSample> power_sum;
+        Accumulator<TSample> ln_sum;
+        Accumulator<TSample> decrease_sum;
+        Accumulator<TSample> irregularity_sum;
+        Tile& tile = tiles_[t];
+        tile.magn_max = static_cast<TSample>(0.0);
+        tile.magn_max_idx = begin;
+
+        for (size_t k = begin; k < end; k++)
+        {
+            const TSample m = std::abs(magnitudes_[k]);
+            magn_sum += m;
+            weighted_sum += static_cast<TSample>(k) * bandwidth_ * m;
+            power_sum += magnitudes_[k] * magnitudes_[k];
+            ln_sum += m > static_cast<TSample>(0.0) ? std::log(m) : ln_floor;
+
+            // The decrease and the irregularity start from the second bin
+            if (k > 0u)
+            {
+                decrease_sum += (m - first) / static_cast<TSample>(k);
+                irregularity_sum += std::abs(magnitudes_[k] - magnitudes_[k - 1u]);
+            }
+
+            if (m > tile.magn_max)
+            {
+                tile.magn_max = m;
+                tile.magn_max_idx = k;
+            }
+        }
+
+        tile.magn_sum = static_cast<Wide>(magn_sum.precise_result());
+        tile.weighted_sum = static_cast<Wide>(weighted_sum.precise_result());
+        tile.power_sum = static_cast<Wide>(power_sum.precise_result());
+        tile.ln_sum = static_cast<Wide>(ln_sum.precise_result());
+        tile.decrease_sum = static_cast<Wide>(decrease_sum.precise_result());
+        tile.irregularity_sum = static_cast<Wide>(irregularity_sum.precise_result());
+    }
+
+    void second_pass_(const size_t& t)
+    {
+        const size_t begin = t * tile_bins;
+        const size_t end = std::min(begin + tile_bins, size_);
+
+        Accumulator<TSample> spread_sum;
+        Accumulator<TSample> skewness_sum;
+        Accumulator<TSample> kurtosis_sum;
+        Accumulator<TSample> information_sum;
+        Accumulator<TSample> slope_sum;
+        Accumulator<TSample> slope_denominator;
+
+        for (size_t k = begin; k < end; k++)
+        {
+            const TSample m = std::abs(magnitudes_[k]);
+            const TSample frequency = static_cast<TSample>(k) * bandwidth_;
+            const TSample deviation = frequency - centroid_;
+            const TSample deviation_2 = deviation * deviation;
+            spread_sum += deviation_2 * m;
+            skewness_sum += deviation_2 * deviation * m;
+            kurtosis_sum += deviation_2 * deviation_2 * m;
+
+            const TSample p = magnitudes_[k] * magnitudes_[k] / power_;
+            if (p > static_cast<TSample>(0.0))
+            {
+                information_sum += p * std::log2(p);
+            }
+
+            const TSample centered = frequency - mean_frequency_;
+            slope_sum += centered * (m - magn_mean_);
+            slope_denominator += centered * centered;
+        }
+
+        Tile& tile = tiles_[t];
+        tile.spread_sum = static_cast<Wide>(spread_sum.precise_result());
+        tile.skewness_sum = static_cast<Wide>(skewness_sum.precise_result());
+        tile.kurtosis_sum = static_cast<Wide>(kurtosis_sum.precise_result());
+        tile.information_sum = static_cast<Wide>(information_sum.precise_result());
+        tile.slope_sum = static_cast<Wide>(slope_sum.precise_result());
+        tile.slope_denominator = static_cast<Wide>(slope_denominator.precise_result());
+    }
+
+    // UTILITY FUNCTION: first bin where the cumulative magnitude reaches the threshold, found
+    // through the tile sums and then inside the tile
+    size_t rolloff_bin_(const Wide& threshold) const
+    {
+        Wide cumulative = static_cast<Wide>(0.0);
+
+        for (size_t t = 0; t < tiles_.size(); t++)
+        {
+            if (cumulative + tiles_[t].magn_sum >= threshold)
+            {
+                const size_t begin = t * tile_bins;
+                const size_t end = std::min(begin + tile_bins, size_);
+
+                for (size_t k = begin; k < end; k++)
+                {
+                    cumulative += static_cast<Wide>(std::abs(magnitudes_[k]));
+
+                    if (cumulative >= threshold)
+                    {
+                        return k;
+                    }
+                }
+
+                return end - 1u;
+            }
+
+            cumulative += tiles_[t].magn_sum;
+        }
+
+        return size_ - 1u;
+    }
+};
+
+} // namespace Informer
+
+#endif // INFORMER_LARGE_FRAMES_H_
@@ -0,0 +1,679 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef INFORMER_MULTIRES_H_
+#define INFORMER_MULTIRES_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+#if __cplusplus >= 202002L
+#include<concepts>
+#endif
+
+#include "informer.h"
+
+namespace Informer
+{
+
+/* MULTI-RESOLUTION ANALYSIS */
+
+// Descriptors of the same stream at several frame sizes at once (e.g. 512 for
+// the transients, 2048 and 8192 for the bass pitch), all updated every hop_size
+// samples on frames ending at the last sample received.
+//
+// The work is shared among the resolutions:
+// - a single mirrored ring buffer, as long as the largest frame, holds the
+//   history, and every frame is a contiguous view into it (nothing is copied);
+// - the statistics of the time descriptors (peak, moments and zero crossings)
+//   are reduced once per block of hop_size samples, when the block is complete,
+//   and merged from the newest block backwards, so the coarser resolutions are
+//   derived from the finer ones instead of scanning their frames again;
+// - the Hann windows are the constexpr tables of FixedInformer, and the real
+//   FFTs of all the resolutions use one twiddle table, built for the largest.
+//
+// A windowed spectrum cannot be derived exactly from shorter windowed spectra,
+// so each resolution still runs its own (real, radix-2) FFT. The time domain f0
+// (YIN) is the most expensive descriptor and is computed only at the
+// resolution chosen with set_pitch_frame_size(), the others report -1.
+//
+// Descriptors are the same of FixedInformer (moments and zero crossings up to
+// rounding). Magnitudes are |X(k)| / frame_size, as Frequency::magnitudes().
+// The object holds all its storage in std::array members, so it should be
+// allocated on the heap.
+namespace MultiResolution
+{
+
+template <typename TSample, size_t... FrameSizes>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+class MultiResolutionInformer
+{
+public:
+    static constexpr size_t resolutions = sizeof...(FrameSizes);
+    static constexpr std::array<size_t, resolutions> frame_sizes = {FrameSizes...};
+
+private:
+    static constexpr bool check_frame_sizes_()
+    {
+        for (size_t r = 0; r < resolutions; r++)
+        {
+            if (frame_sizes[r] < 16u || (frame_sizes[r] & (frame_sizes[r] - 1u)) != 0u)
+            {
+                return false;
+            }
+
+            if (r > 0 && frame_sizes[r] <= frame_sizes[r - 1])
+            {
+                return false;
+            }
+        }
+
+        return resolutions > 0;
+    }
+
+public:
+    static_assert(check_frame_sizes_(), "FrameSizes must be increasing powers of two, of at least 16 samples");
+
+    static constexpr size_t min_frame_size = frame_sizes[0];
+    static constexpr size_t max_frame_size = frame_sizes[resolutions - 1u];
+
+    MultiResolutionInformer(const TSample& sample_rate = static_cast<TSample>(44100.0),
+                            const size_t& hop_size = min_frame_size / 2u)
+    {
+        set_sample_rate(sample_rate);
+
+        if (!set_hop_size(hop_size))
+        {
+            set_hop_size(min_frame_size / 2u);
+        }
+
+        // Time domain pitch at the largest frame up to 4096 samples, as the plugin at 44.1 and 48 kHz
+        for (const auto& size : frame_sizes)
+        {
+            if (size <= 4096u || pitch_frame_size_ == 0u)
+            {
+                pitch_frame_size_ = size;
+            }
+        }
+
+        for (size_t j = 0; j < max_frame_size / 2u; j++)
+        {
+            const double phase = -6.28318530717958647692 * static_cast<double>(j) / static_cast<double>(max_frame_size);
+            twiddles_[2u * j] = static_cast<TSample>(std::cos(phase));
+            twiddles_[2u * j + 1u] = static_cast<TSample>(std::sin(phase));
+        }
+
+        for_each_resolution_([&](auto& resolution)
+        {
+            resolution.prepare();
+        });
+    }
+
+    ~MultiResolutionInformer() = default;
+
+    bool set_sample_rate(const TSample& sample_rate)
+    {
+        if (sample_rate > static_cast<TSample>(0.0))
+        {
+            sample_rate_ = sample_rate;
+
+            for_each_resolution_([&](auto& resolution)
+            {
+                resolution.informer.set_sample_rate(sample_rate);
+            });
+
+            return true;
+        }
+
+        return false;
+    }
+
+    bool set_rolloff_point(const TSample& rolloff)
+    {
+        if (rolloff > static_cast<TSample>(0.0) && rolloff < static_cast<TSample>(1.0))
+        {
+            for_each_resolution_([&](auto& resolution)
+            {
+                resolution.informer.set_rolloff_point(rolloff);
+            });
+
+            return true;
+        }
+
+        return false;
+    }
+
+    // The hop must be a power of two not greater than the smallest frame,
+    // changing it clears the history
+    bool set_hop_size(const size_t& hop_size)
+    {
+        if (hop_size == 0u || hop_size > min_frame_size || (hop_size & (hop_size - 1u)) != 0u)
+        {
+            return false;
+        }
+
+        hop_size_ = hop_size;
+        reset();
+
+        return true;
+    }
+
+    // Frame size used for the time domain f0, 0 to skip it
+    bool set_pitch_frame_size(const size_t& frame_size)
+    {
+        if (frame_size != 0u && std::find(frame_sizes.begin(), frame_sizes.end(), frame_size) == frame_sizes.end())
+        {
+            return false;
+        }
+
+        pitch_frame_size_ = frame_size;
+
+        return true;
+    }
+
+    void set_descriptor_domains(const bool& time, const bool& frequency)
+    {
+        compute_time_ = time;
+        compute_frequency_ = frequency;
+    }
+
+    // Clear the history, as if silence had been received
+    void reset()
+    {
+        std::fill(history_.begin(), history_.end(), static_cast<TSample>(0.0));
+        BlockStats_ silence;
+        silence.count = static_cast<TSample>(hop_size_);
+        std::fill(blocks_.begin(), blocks_.end(), silence);
+        write_position_ = 0u;
+        block_fill_ = 0u;
+        newest_block_ = 0u;
+
+        for_each_resolution_([&](auto& resolution)
+        {
+            resolution.clear();
+        });
+    }
+
+    // Append count samples, analyzing every resolution each hop_size samples.
+    // After each analysis on_frame(*this) is called, so that the descriptors can
+    // be read. Returns the number of analyses.
+    template <typename Callback>
+    size_t process(const TSample* samples, const size_t& count, Callback&& on_frame)
+    {
+        size_t analyses = 0u;
+
+        for (size_t s = 0; s < count; s++)
+        {
+            const TSample sample = samples[s];
+
+            history_[write_position_] = sample;
+            history_[write_position_ + max_frame_size] = sample;
+            write_position_ = write_position_ + 1u == max_frame_size ? 0u : write_position_ + 1u;
+
+            block_fill_++;
+
+            if (block_fill_ == hop_size_)
+            {
+                newest_block_ = newest_block_ + 1u == blocks_count_() ? 0u : newest_block_ + 1u;
+                blocks_[newest_block_] = reduce_(history_.data() + write_position_ + max_frame_size - hop_size_, hop_size_);
+                block_fill_ = 0u;
+
+                analyze_();
+                on_frame(*this);
+                analyses++;
+            }
+        }
+
+        return analyses;
+    }
+
+    size_t process(const TSample* samples, const size_t& count)
+    {
+        return process(samples, count, [](const MultiResolutionInformer&) {});
+    }
+
+    // Last frame_size samples received, oldest first
+    template <size_t FrameSize>
+    const TSample* get_frame() const
+    {
+        return history_.data() + write_position_ + max_frame_size - FrameSize;
+    }
+
+    template <size_t FrameSize>
+    const std::array<TSample, FrameSize / 2u + 1u>& get_magnitudes() const
+    {
+        return std::get<index_of_<FrameSize>()>(resolutions_).informer.get_magnitudes();
+    }
+
+    template <size_t FrameSize>
+    const std::array<TSample, static_cast<size_t>(TimeDescriptor::Count)>& get_time_descriptors() const
+    {
+        return std::get<index_of_<FrameSize>()>(resolutions_).time;
+    }
+
+    template <size_t FrameSize>
+    const std::array<TSample, static_cast<size_t>(FrequencyDescriptor::Count)>& get_frequency_descriptors() const
+    {
+        return std::get<index_of_<FrameSize>()>(resolutions_).informer.get_frequency_descriptors();
+    }
+
+    // Descriptors by frame size known at run time, 0 for a size not analyzed
+    TSample get_time_descriptor(const size_t& frame_size, const TimeDescriptor& descriptor) const
+    {
+        TSample value = static_cast<TSample>(0.0);
+
+        for_each_resolution_([&](const auto& resolution)
+        {
+            if (resolution.frame_size == frame_size)
+            {
+                value = resolution.time[static_cast<size_t>(descriptor)];
+            }
+        });
+
+        return value;
+    }
+
+    TSample get_frequency_descriptor(const size_t& frame_size, const FrequencyDescriptor& descriptor) const
+    {
+        TSample value = static_cast<TSample>(0.0);
+
+        for_each_resolution_([&](const auto& resolution)
+        {
+            if (resolution.frame_size == frame_size)
+            {
+                value = resolution.informer.get_frequency_descriptor(descriptor);
+            }
+        });
+
+        return value;
+    }
+
+    // All the descriptors, tagged with their resolution as time::<name>@<frame size>
+    // and freq::<name>@<frame size> (e.g. time::rms@512, freq::centroid@8192)
+    void get_descriptors(std::unordered_map<std::string, TSample>& descriptors) const
+    {
+        for_each_resolution_([&](const auto& resolution)
+        {
+            const std::string tag = "@" + std::to_string(resolution.frame_size);
+
+            for (size_t d = 0; d < static_cast<size_t>(TimeDescriptor::Count); d++)
+            {
+                descriptors[std::string("time::") + time_descriptor_names[d] + tag] = resolution.time[d];
+            }
+
+            const auto& frequency = resolution.informer.get_frequency_descriptors();
+            for (size_t d = 0; d < static_cast<size_t>(FrequencyDescriptor::Count); d++)
+            {
+                descriptors[std::string("freq::") + frequency_descriptor_names[d] + tag] = frequency[d];
+            }
+        });
+    }
+
+    TSample get_sample_rate() const
+    {
+        return sample_rate_;
+    }
+
+    size_t get_hop_size() const
+    {
+        return hop_size_;
+    }
+
+    size_t get_pitch_frame_size() const
+    {
+        return pitch_frame_size_;
+    }
+
+private:
+    // Count, mean, central moment sums (M2, M3, M4), peak and zero crossings of a
+    // run of samples, with the first and last sample to count the crossings at the joints
+    struct BlockStats_
+    {
+        TSample count = static_cast<TSample>(0.0);
+        TSample mean = static_cast<TSample>(0.0);
+        TSample m2 = static_cast<TSample>(0.0);
+        TSample m3 = static_cast<TSample>(0.0);
+        TSample m4 = static_cast<TSample>(0.0);
+        TSample peak = static_cast<TSample>(0.0);
+        TSample crossings = static_cast<TSample>(0.0);
+        TSample first = static_cast<TSample>(0.0);
+        TSample last = static_cast<TSample>(0.0);
+    };
+
+    // Two pass reduction of a block, as in FixedInformer
+    static BlockStats_ reduce_(const TSample* samples, const size_t& count)
+    {
+        BlockStats_ stats;
+        stats.count = static_cast<TSample>(count);
+        stats.first = samples[0];
+        stats.last = samples[count - 1u];
+
+        TSample sum = static_cast<TSample>(0.0);
+        for (size_t i = 0; i < count; i++)
+        {
+            const TSample s = samples[i];
+            stats.peak = std::max(stats.peak, std::abs(s));
+            sum += s;
+            if (i > 0)
+            {
+                stats.crossings += std::signbit(s) != std::signbit(samples[i - 1u]) ? static_cast<TSample>(1.0) : static_cast<TSample>(0.0);
+            }
+        }
+
+        stats.mean = sum / stats.count;
+
+        for (size_t i = 0; i < count; i++)
+        {
+            const TSample d = samples[i] - stats.mean;
+            const TSample d2 = d * d;
+            stats.m2 += d2;
+            stats.m3 += d2 * d;
+            stats.m4 += d2 * d2;
+        }
+
+        return stats;
+    }
+
+    // Pairwise combination of the moments (Chan et al., Pebay), a before b in time
+    static BlockStats_ merge_(const BlockStats_& a, const BlockStats_& b)
+    {
+        BlockStats_ m;
+        const TSample na = a.count;
+        const TSample nb = b.count;
+        const TSample n = na + nb;
+        const TSample delta = b.mean - a.mean;
+        const TSample delta_n = delta / n;
+        const TSample delta_n2 = delta_n * delta_n;
+        const TSample term = delta * delta_n * na * nb;
+
+        m.count = n;
+        m.mean = a.mean + delta_n * nb;
+        m.m2 = a.m2 + b.m2 + term;
+        m.m3 = a.m3 + b.m3 + term * delta_n * (na - nb) + static_cast<TSample>(3.0) * delta_n * (na * b.m2 - nb * a.m2);
+        m.m4 = a.m4 + b.m4 + term * delta_n2 * (na * na - na * nb + nb * nb) +
+               static_cast<TSample>(6.0) * delta_n2 * (na * na * b.m2 + nb * nb * a.m2) +
+               static_cast<TSample>(4.0) * delta_n * (na * b.m3 - nb * a.m3);
+        m.peak = std::max(a.peak, b.peak);
+        m.crossings = a.crossings + b.crossings + (std::signbit(a.last) != std::signbit(b.first) ? static_cast<TSample>(1.0) : static_cast<TSample>(0.0));
+        m.first = a.first;
+        m.last = b.last;
+
+        return m;
+    }
+
+    template <size_t FrameSize>
+    struct Resolution_
+    {
+        static constexpr size_t frame_size = FrameSize;
+        static constexpr size_t bins = FrameSize / 2u + 1u;
+        static constexpr size_t half = FrameSize / 2u;
+
+        FixedInformer<TSample, FrameSize> informer;
+        std::array<TSample, static_cast<size_t>(TimeDescriptor::Count)> time = {};
+        std::array<uint32_t, half> bit_reversal = {};
+        // Interleaved real and imaginary parts of the half size complex FFT
+        std::array<TSample, FrameSize> spectrum = {};
+        std::array<TSample, bins> magnitudes = {};
+
+        void prepare()
+        {
+            unsigned int bits = 0u;
+            while ((static_cast<size_t>(1u) << bits) < half)
+            {
+                bits++;
+            }
+
+            for (size_t i = 0; i < half; i++)
+            {
+                uint32_t reversed = 0u;
+                for (unsigned int b = 0u; b < bits; b++)
+                {
+                    reversed |= ((static_cast<uint32_t>(i) >> b) & 1u) << (bits - 1u - b);
+                }
+                bit_reversal[i] = reversed;
+            }
+        }
+
+        void clear()
+        {
+            time.fill(static_cast<TSample>(0.0));
+            magnitudes.fill(static_cast<TSample>(0.0));
+            informer.set_magnitudes(magnitudes.data());
+            informer.set_magnitudes(magnitudes.data());
+        }
+    };
+
+    std::tuple<Resolution_<FrameSizes>...> resolutions_;
+    // Twice the largest frame, every sample written twice so that any frame is contiguous
+    std::array<TSample, 2u * max_frame_size> history_ = {};
+    std::array<BlockStats_, max_frame_size> blocks_ = {};
+    // exp(-2 pi i j / max_frame_size), interleaved, for j < max_frame_size / 2
+    std::array<TSample, max_frame_size> twiddles_ = {};
+    size_t write_position_ = 0u;
+    size_t block_fill_ = 0u;
+    size_t newest_block_ = 0u;
+    size_t hop_size_ = min_frame_size / 2u;
+    size_t pitch_frame_size_ = 0u;
+    TSample sample_rate_ = static_cast<TSample>(44100.0);
+    bool compute_time_ = true;
+    bool compute_frequency_ = true;
+
+    template <size_t FrameSize>
+    static constexpr size_t index_of_()
+    {
+        size_t index = resolutions;
+        for (size_t r = 0; r < resolutions; r++)
+        {
+            if (frame_sizes[r] == FrameSize)
+            {
+                index = r;
+            }
+        }
+
+        return index;
+    }
+
+    template <typename Function>
+    void for_each_resolution_(Function&& function)
+    {
+        std::apply([&](auto&... resolution)
+        {
+            (function(resolution), ...);
+        }, resolutions_);
+    }
+
+    template <typename Function>
+    void for_each_resolution_(Function&& function) const
+    {
+        std::apply([&](const auto&... resolution)
+        {
+            (function(resolution), ...);
+        }, resolutions_);
+    }
+
+    size_t blocks_count_() const
+    {
+        return max_frame_size / hop_size_;
+    }
+
+    void analyze_()
+    {
+        if (compute_time_)
+        {
+            analyze_time_();
+        }
+
+        if (compute_frequency_)
+        {
+            for_each_resolution_([&](auto& resolution)
+            {
+                analyze_frequency_(resolution);
+            });
+        }
+    }
+
+    // The blocks are merged from the newest backwards, and each resolution takes
+    // the statistics when the merged run reaches its frame size
+    void analyze_time_()
+    {
+        INFORMER_PROFILE_SCOPE("multires_time_descriptors");
+
+        BlockStats_ run = blocks_[newest_block_];
+        size_t block = newest_block_;
+        size_t run_size = hop_size_;
+
+        for_each_resolution_([&](auto& resolution)
+        {
+            while (run_size < resolution.frame_size)
+            {
+                block = block == 0u ? blocks_count_() - 1u : block - 1u;
+                run = merge_(blocks_[block], run);
+                run_size += hop_size_;
+            }
+
+            auto& t = resolution.time;
+            const TSample count = static_cast<TSample>(resolution.frame_size);
+            const TSample variance = run.m2 / count;
+
+            t[static_cast<size_t>(TimeDescriptor::Peak)] = run.peak;
+            t[static_cast<size_t>(TimeDescriptor::Rms)] = std::sqrt(std::max(variance + run.mean * run.mean, static_cast<TSample>(0.0)));
+            t[static_cast<size_t>(TimeDescriptor::Variance)] = variance;
+            t[static_cast<size_t>(TimeDescriptor::ZeroCrossing)] = run.crossings / static_cast<TSample>(resolution.frame_size - 1u);
+
+            if (variance <= std::numeric_limits<TSample>::epsilon())
+            {
+                t[static_cast<size_t>(TimeDescriptor::Kurtosis)] = static_cast<TSample>(0.0);
+                t[static_cast<size_t>(TimeDescriptor::Skewness)] = static_cast<TSample>(0.0);
+            }
+            else
+            {
+                t[static_cast<size_t>(TimeDescriptor::Kurtosis)] = run.m4 / count / (variance * variance) - static_cast<TSample>(3.0);
+                t[static_cast<size_t>(TimeDescriptor::Skewness)] = run.m3 / count / std::pow(std::sqrt(variance), static_cast<TSample>(3.0));
+            }
+
+            t[static_cast<size_t>(TimeDescriptor::F0)] = static_cast<TSample>(-1.0);
+            if (resolution.frame_size == pitch_frame_size_)
+            {
+                resolution.informer.set_buffer(get_frame<std::remove_reference_t<decltype(resolution)>::frame_size>());
+                resolution.informer.compute_descriptors(true, false);
+                t[static_cast<size_t>(TimeDescriptor::F0)] = resolution.informer.get_time_descriptor(TimeDescriptor::F0);
+            }
+        });
+    }
+
+    template <typename Resolution>
+    void analyze_frequency_(Resolution& resolution)
+    {
+        INFORMER_PROFILE_SCOPE("multires_frequency_descriptors");
+
+        constexpr size_t frame_size = Resolution::frame_size;
+        constexpr size_t half = Resolution::half;
+        constexpr size_t stride = max_frame_size / frame_size;
+
+        const TSample* frame = get_frame<frame_size>();
+        const auto& window = FixedInformer<TSample, frame_size>::get_window();
+        auto& z = resolution.spectrum;
+
+        // Even and odd samples as the real and imaginary parts of a half size
+        // complex sequence, windowed and stored in bit reversed order
+        for (size_t n = 0; n < half; n++)
+        {
+            const size_t r = resolution.bit_reversal[n];
+            z[2u * r] = frame[2u * n] * window[2u * n];
+            z[2u * r + 1u] = frame[2u * n + 1u] * window[2u * n + 1u];
+        }
+
+        // Radix-2 butterflies, the twiddles of a span taken from the shared table
+        for (size_t span = 2u; span <= half; span *= 2u)
+        {
+            const size_t step = stride * (frame_size / span);
+
+            for (size_t start = 0; start < half; start += span)
+            {
+                for (size_t j = 0; j < span / 2u; j++)
+                {
+                    const TSample cr = twiddles_[2u * j * step];
+                    const TSample ci = twiddles_[2u * j * step + 1u];
+                    const size_t a = 2u * (start + j);
+                    const size_t b = 2u * (start + j + span / 2u);
+                    const TSample br = z[b] * cr - z[b + 1u] * ci;
+                    const TSample bi = z[b] * ci + z[b + 1u] * cr;
+                    z[b] = z[a] - br;
+                    z[b + 1u] = z[a + 1u] - bi;
+                    z[a] += br;
+                    z[a + 1u] += bi;
+                }
+            }
+        }
+
+        // Split into the spectrum of the real frame:
+        // X(k) = (Z(k) + Z*(half - k)) / 2 - i W^k (Z(k) - Z*(half - k)) / 2
+        auto& magnitudes = resolution.magnitudes;
+        const TSample scale = static_cast<TSample>(1.0) / static_cast<TSample>(frame_size);
+
+        magnitudes[0] = std::abs(z[0] + z[1]) * scale;
+        magnitudes[half] = std::abs(z[0] - z[1]) * scale;
+
+        for (size_t k = 1; k < half; k++)
+        {
+            const TSample zr = z[2u * k];
+            const TSample zi = z[2u * k + 1u];
+            const TSample cr = z[2u * (half - k)];
+            const TSample ci = -z[2u * (half - k) + 1u];
+
+            const TSample er = static_cast<TSample>(0.5) * (zr + cr);
+            const TSample ei = static_cast<TSample>(0.5) * (zi + ci);
+            const TSample dr = static_cast<TSample>(0.5) * (zr - cr);
+            const TSample di = static_cast<TSample>(0.5) * (zi - ci);
+
+            const TSample wr = twiddles_[2u * k * stride];
+            const TSample wi = twiddles_[2u * k * stride + 1u];
+
+            // O(k) = -i (Z(k) - Z*(half - k)) / 2, times W^k
+            const TSample orr = di;
+            const TSample oi = -dr;
+            const TSample xr = er + orr * wr - oi * wi;
+            const TSample xi = ei + orr * wi + oi * wr;
+
+            magnitudes[k] = std::sqrt(xr * xr + xi * xi) * scale;
+        }
+
+        resolution.informer.set_magnitudes(magnitudes.data());
+        resolution.informer.compute_descriptors(false, true);
+    }
+};
+
+} // namespace MultiResolution
+
+} // namespace Informer
+
+#endif // INFORMER_MULTIRES_H_
@@ -0,0 +1,482 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef INFORMER_SLIDING_DFT_H_
+#define INFORMER_SLIDING_DFT_H_
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <complex>
+#include <vector>
+
+#if __cplusplus >= 202002L
+#include<concepts>
+#endif
+
+#include "informer.h"
+
+namespace Informer
+{
+
+/* SLIDING DFT */
+
+// Descriptors of the selected bins, updated by SlidingDft
+template <typename TSample>
+struct SlidingDescriptors
+{
+    // Magnitude weighted mean frequency of the selected bins, in Hz
+    TSample centroid = static_cast<TSample>(0.0);
+    // Spectral flux against the previous update, over the selected bins
+    TSample flux = static_cast<TSample>(0.0);
+    // Energy (sum of the squared magnitudes) of the selected bins
+    TSample energy = static_cast<TSample>(0.0);
+};
+
+// Recursive DFT of the last size samples on a subset of bins, for descriptors updated every
+// few samples. Each new sample updates every bin with
+//     X[k] = (X[k] + x[n] - x[n - size]) * exp(2 pi i k / size),
+// i.e. O(bins) per sample instead of an FFT per frame. The Hann window is applied in the
+// frequency domain (0.5 X[k] - 0.25 (X[k - 1] + X[k + 1]), a periodic Hann window), so the
+// neighbours of the selected bins are tracked too. The magnitudes have the scale of an
+// unnormalized FFT, as those given to Informer::set_magnitudes() by the plugin.
+// The rounding errors of the recursion grow slowly, so the bins are computed again from the
+// samples (a direct DFT, O(size) per bin) every resynchronization interval (by default the
+// window size, so the amortized cost stays O(bins) per sample), or from a full FFT of the
+// same window through resynchronize(spectrum).
+// The bins are grouped in bands: set_bins() makes a band of each bin, set_bands() groups the
+// bins between edge frequencies. Memory is allocated only by the setters.
+template <typename TSample>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+class SlidingDft
+{
+public:
+    SlidingDft(const TSample& sample_rate = static_cast<TSample>(44100.0), const size_t& size = 2048u)
+    {
+        sample_rate_ = sample_rate > static_cast<TSample>(0.0) ? sample_rate : static_cast<TSample>(44100.0);
+        size_ = size >= 4u && size % 2u == 0u ? size : 2048u;
+        allocate_();
+    }
+
+    ~SlidingDft() = default;
+
+    // All the setters but set_update_interval() clear the samples and the spectrum
+    bool set_sample_rate(const TSample& sample_rate)
+    {
+        if (sample_rate <= static_cast<TSample>(0.0))
+        {
+            return false;
+        }
+
+        sample_rate_ = sample_rate;
+        allocate_();
+
+        return true;
+    }
+
+    // Even, at least 4; the selection goes back to all the bins
+    bool set_size(const size_t& size)
+    {
+        if (size < 4u || size % 2u != 0u)
+        {
+            return false;
+        }
+
+        size_ = size;
+        band_ranges_.clear();
+        allocate_();
+
+        return true;
+    }
+
+    // One band for each bin, in [0, size / 2] (no bins for all of them)
+    bool set_bins(const std::vector<size_t>& bins)
+    {
+        std::vector<std::array<size_t, 2>> ranges;
+
+        for (const auto& b : bins)
+        {
+            if (b > size_ / 2u)
+            {
+                return false;
+            }
+
+            ranges.push_back({b, b});
+        }
+
+        band_ranges_ = ranges;
+        allocate_();
+
+        return true;
+    }
+
+    // Bands between consecutive edges (in Hz, increasing): a bin belongs to the band of its center
+    // frequency, edges[b] <= f < edges[b + 1]. Bands without bins take the bin nearest to their center.
+    bool set_bands(const std::vector<TSample>& edges)
+    {
+        if (edges.size() < 2u || !std::is_sorted(edges.begin(), edges.end()) || edges.front() < static_cast<TSample>(0.0))
+        {
+            return false;
+        }
+
+        const TSample bandwidth = sample_rate_ / static_cast<TSample>(size_);
+        const size_t last_bin = size_ / 2u;
+        std::vector<std::array<size_t, 2>> ranges;
+
+        for (size_t b = 0; b + 1u < edges.size(); b++)
+        {
+            size_t first = static_cast<size_t>(std::ceil(edges[b] / bandwidth));
+            size_t last = static_cast<size_t>(std::max(std::ceil(edges[b + 1u] / bandwidth) - static_cast<TSample>(1.0), static_cast<TSample>(0.0)));
+
+            if (first > last)
+            {
+                first = last = static_cast<size_t>(std::round(static_cast<TSample>(0.5) * (edges[b] + edges[b + 1u]) / bandwidth));
+            }
+
+            ranges.push_back({std::min(first, last_bin), std::min(last, last_bin)});
+        }
+
+        band_ranges_ = ranges;
+        allocate_();
+
+        return true;
+    }
+
+    // Samples between two resynchronizations from the samples (0 disables them)
+    bool set_resync_interval(const size_t& samples)
+    {
+        resync_interval_ = samples;
+        resync_default_ = false;
+        clear();
+
+        return true;
+    }
+
+    // Samples between two updates of the descriptors (1 for every sample)
+    bool set_update_interval(const size_t& samples)
+    {
+        if (samples == 0u)
+        {
+            return false;
+        }
+
+        update_interval_ = samples;
+
+        return true;
+    }
+
+    bool set_hann_window(const bool& hann)
+    {
+        hann_window_ = hann;
+        clear();
+
+        return true;
+    }
+
+    void clear()
+    {
+        std::fill(samples_.begin(), samples_.end(), static_cast<TSample>(0.0));
+        std::fill(spectrum_.begin(), spectrum_.end(), std::complex<TSample>(0.0, 0.0));
+        std::fill(magnitudes_.begin(), magnitudes_.end(), static_cast<TSample>(0.0));
+        std::fill(band_energies_.begin(), band_energies_.end(), static_cast<TSample>(0.0));
+        descriptors_ = SlidingDescriptors<TSample>();
+        position_ = 0u;
+        since_resync_ = 0u;
+        since_update_ = 0u;
+    }
+
+    // Update the bins with a block of samples, and the descriptors every update interval
+    void process(const TSample* samples, const size_t& count)
+    {
+        process(samples, count, [](const SlidingDescriptors<TSample>&) {});
+    }
+
+    // Same as above, calling on_update(descriptors) after each update of the descriptors
+    template <typename Callback>
+    void process(const TSample* samples, const size_t& count, Callback&& on_update)
+    {
+        INFORMER_PROFILE_SCOPE("sliding_dft");
+
+        for (size_t n = 0; n < count; n++)
+        {
+            push_(samples[n]);
+
+            if (++since_update_ >= update_interval_)
+            {
+                since_update_ = 0u;
+                update_descriptors();
+                on_update(static_cast<const SlidingDescriptors<TSample>&>(descriptors_));
+            }
+        }
+    }
+
+    // Compute the tracked bins again from the last size samples
+    void resynchronize()
+    {
+        INFORMER_PROFILE_SCOPE("sliding_dft_resync");
+
+        for (size_t r = 0; r < bins_.size(); r++)
+        {
+            Accumulator<TSample> real;
+            Accumulator<TSample> imag;
+            size_t phase = 0u;
+            size_t index = position_;
+
+            // Sample n of the window (the oldest is n = 0) rotates by -2 pi k n / size
+            for (size_t n = 0; n < size_; n++)
+            {
+                real += samples_[index] * roots_[phase].real();
+                imag += samples_[index] * roots_[phase].imag();
+                index = index + 1u == size_ ? 0u : index + 1u;
+                phase += bins_[r];
+                phase -= phase >= size_ ? size_ : 0u;
+            }
+
+            spectrum_[r] = std::complex<TSample>(real, imag);
+        }
+
+        since_resync_ = 0u;
+    }
+
+    // Take the tracked bins from a full, unwindowed FFT of the last size samples
+    // (size / 2 + 1 complex bins at least)
+    bool resynchronize(const std::complex<TSample>* spectrum, const size_t& bins)
+    {
+        if (spectrum == nullptr || bins <= size_ / 2u)
+        {
+            return false;
+        }
+
+        for (size_t r = 0; r < bins_.size(); r++)
+        {
+            spectrum_[r] = spectrum[bins_[r]];
+        }
+
+        since_resync_ = 0u;
+
+        return true;
+    }
+
+    // Magnitudes of the selected bins, band energies and descriptors from the current bins
+    // (process() calls it every update interval)
+    void update_descriptors()
+    {
+        Accumulator<TSample> magn_sum;
+        Accumulator<TSample> weighted_sum;
+        Accumulator<TSample> energy;
+        Accumulator<TSample> flux;
+        size_t s = 0u;
+
+        for (size_t b = 0; b < band_ranges_.size(); b++)
+        {
+            Accumulator<TSample> band_energy;
+
+            for (size_t k = band_ranges_[b][0]; k <= band_ranges_[b][1]; k++, s++)
+            {
+                const Tap& tap = taps_[s];
+                std::complex<TSample> value = spectrum_[tap.centre];
+
+                if (hann_window_)
+                {
+                    const std::complex<TSample> left = tap.conjugate_left ? std::conj(spectrum_[tap.left]) : spectrum_[tap.left];
+                    const std::complex<TSample> right = tap.conjugate_right ? std::conj(spectrum_[tap.right]) : spectrum_[tap.right];
+                    value = static_cast<TSample>(0.5) * value - static_cast<TSample>(0.25) * (left + right);
+                }
+
+                const TSample m = std::sqrt(value.real() * value.real() + value.imag() * value.imag());
+                const TSample d = m - magnitudes_[s];
+                flux += d * d;
+                magnitudes_[s] = m;
+                magn_sum += m;
+                weighted_sum += m * static_cast<TSample>(k);
+                band_energy += m * m;
+            }
+
+            band_energies_[b] = band_energy;
+            energy += band_energies_[b];
+        }
+
+        const TSample bandwidth = sample_rate_ / static_cast<TSample>(size_);
+        descriptors_.centroid = magn_sum > static_cast<TSample>(0.0) ? bandwidth * weighted_sum / magn_sum : static_cast<TSample>(0.0);
+        descriptors_.flux = s > 0u ? std::sqrt(static_cast<TSample>(flux)) / static_cast<TSample>(s) : static_cast<TSample>(0.0);
+        descriptors_.energy = energy;
+    }
+
+    const SlidingDescriptors<TSample>& get_descriptors() const
+    {
+        return descriptors_;
+    }
+
+    // One energy per band
+    const std::vector<TSample>& get_band_energies() const
+    {
+        return band_energies_;
+    }
+
+    // Windowed magnitudes of the bins of the bands, band after band
+    const std::vector<TSample>& get_magnitudes() const
+    {
+        return magnitudes_;
+    }
+
+    // Bins tracked by the recursion (the selected ones and their neighbours)
+    const std::vector<size_t>& get_tracked_bins() const
+    {
+        return bins_;
+    }
+
+    size_t get_size() const
+    {
+        return size_;
+    }
+
+private:
+    // Tracked bins used by a selected bin: its own and, for the window, the two neighbours
+    // (beyond DC and Nyquist, the conjugate of the mirrored bin)
+    struct Tap
+    {
+        size_t left = 0u;
+        size_t centre = 0u;
+        size_t right = 0u;
+        bool conjugate_left = false;
+        bool conjugate_right = false;
+    };
+
+    TSample sample_rate_ = static_cast<TSample>(44100.0);
+    size_t size_ = 2048u;
+    size_t resync_interval_ = 0u;
+    size_t update_interval_ = 1u;
+    bool hann_window_ = true;
+    bool resync_default_ = true;
+    std::vector<std::array<size_t, 2>> band_ranges_ = {};
+    std::vector<size_t> bins_ = {};
+    std::vector<Tap> taps_ = {};
+    std::vector<TSample> samples_ = {};
+    std::vector<std::complex<TSample>> spectrum_ = {};
+    std::vector<std::complex<TSample>> twiddles_ = {};
+    std::vector<std::complex<TSample>> roots_ = {};
+    std::vector<TSample> magnitudes_ = {};
+    std::vector<TSample> band_energies_ = {};
+    SlidingDescriptors<TSample> descriptors_;
+    size_t position_ = 0u;
+    size_t since_resync_ = 0u;
+    size_t since_update_ = 0u;
+
+    inline void push_(const TSample& sample)
+    {
+        const TSample change = sample - samples_[position_];
+        samples_[position_] = sample;
+        position_ = position_ + 1u == size_ ? 0u : position_ + 1u;
+
+        // Plain products: std::complex multiplication checks for infinities and NaNs
+        for (size_t r = 0; r < bins_.size(); r++)
+        {
+            const TSample real = spectrum_[r].real() + change;
+            const TSample imag = spectrum_[r].imag();
+            spectrum_[r] = std::complex<TSample>(real * twiddles_[r].real() - imag * twiddles_[r].imag(),
+                                                 real * twiddles_[r].imag() + imag * twiddles_[r].real());
+        }
+
+        if (resync_interval_ > 0u && ++since_resync_ >= resync_interval_)
+        {
+            resynchronize();
+        }
+    }
+
+    void allocate_()
+    {
+        constexpr WideSample<TSample> two_pi = static_cast<WideSample<TSample>>(6.28318530717958647692);
+        const size_t last_bin = size_ / 2u;
+
+        // By default all the bins, one band each
+        if (band_ranges_.empty())
+        {
+            band_ranges_.push_back({0u, last_bin});
+        }
+
+        // Tracked bins: the selected ones and their neighbours, mirrored inside [0, size / 2]
+        bins_.clear();
+        for (const auto& range : band_ranges_)
+        {
+            for (size_t k = range[0]; k <= range[1]; k++)
+            {
+                bins_.push_back(k);
+                bins_.push_back(k > 0u ? k - 1u : 1u);
+                bins_.push_back(k < last_bin ? k + 1u : last_bin - 1u);
+            }
+        }
+
+        std::sort(bins_.begin(), bins_.end());
+        bins_.erase(std::unique(bins_.begin(), bins_.end()), bins_.end());
+
+        auto tracked = [this](const size_t& bin)
+        {
+            return static_cast<size_t>(std::lower_bound(bins_.begin(), bins_.end(), bin) - bins_.begin());
+        };
+
+        taps_.clear();
+        for (const auto& range : band_ranges_)
+        {
+            for (size_t k = range[0]; k <= range[1]; k++)
+            {
+                Tap tap;
+                tap.centre = tracked(k);
+                tap.left = tracked(k > 0u ? k - 1u : 1u);
+                tap.right = tracked(k < last_bin ? k + 1u : last_bin - 1u);
+                tap.conjugate_left = k == 0u;
+                tap.conjugate_right = k == last_bin;
+                taps_.push_back(tap);
+            }
+        }
+
+        twiddles_.resize(bins_.size());
+        for (size_t r = 0; r < bins_.size(); r++)
+        {
+            const WideSample<TSample> angle = two_pi * static_cast<WideSample<TSample>>(bins_[r]) / static_cast<WideSample<TSample>>(size_);
+            twiddles_[r] = std::complex<TSample>(static_cast<TSample>(std::cos(angle)), static_cast<TSample>(std::sin(angle)));
+        }
+
+        roots_.resize(size_);
+        for (size_t n = 0; n < size_; n++)
+        {
+            const WideSample<TSample> angle = -two_pi * static_cast<WideSample<TSample>>(n) / static_cast<WideSample<TSample>>(size_);
+            roots_[n] = std::complex<TSample>(static_cast<TSample>(std::cos(angle)), static_cast<TSample>(std::sin(angle)));
+        }
+
+        if (resync_default_)
+        {
+            resync_interval_ = size_;
+        }
+
+        samples_.assign(size_, static_cast<TSample>(0.0));
+        spectrum_.assign(bins_.size(), std::complex<TSample>(0.0, 0.0));
+        magnitudes_.assign(taps_.size(), static_cast<TSample>(0.0));
+        band_energies_.assign(band_ranges_.size(), static_cast<TSample>(0.0));
+        clear();
+    }
+};
+
+} // namespace Informer
+
+#endif // INFORMER_SLIDING_DFT_H_
@@ -0,0 +1,388 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+// Part of informer.h, which includes it before the Informer class
+#include "informer.h"
+
+#ifndef INFORMER_TEMPO_H_
+#define INFORMER_TEMPO_H_
+
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+#if __cplusplus >= 202002L
+#include<concepts>
+#endif
+
+namespace Informer
+{
+
+/* TEMPO AND BEAT TRACKING */
+
+// Tempo and beats of the last frame pushed into a TempoTracker
+template <typename TSample>
+struct BeatEstimate
+{
+    // Beats per minute, 0 until a periodicity is found
+    TSample tempo = static_cast<TSample>(0.0);
+    // Position between the last beat (0) and the next one (1)
+    TSample phase = static_cast<TSample>(0.0);
+    // True on the frame of a beat
+    bool beat = false;
+    // Onset strength of the frame (log compressed spectral flux)
+    TSample onset = static_cast<TSample>(0.0);
+};
+
+// Streaming tempo estimation and beat tracking on the onset strength envelope, one value per
+// frame (frame_rate values per second, i.e. the sample rate over the hop size).
+// The tempo is the lag of the highest autocorrelation of the detrended envelope over the last
+// window_seconds, weighted by a log-Gaussian prior around 120 BPM. The autocorrelation is slid:
+// each frame adds the products of the new value and subtracts those of the value leaving the window,
+// only for the lags between min_tempo and max_tempo, so the cost per frame is proportional to the
+// lag range. Beats follow the causal dynamic programming tracker of Stark, Davies and Plumbley:
+// a cumulative score rewards onsets one period after a previous high score, and half a period
+// after each beat the score is projected one period ahead (without new onsets) to place the next
+// beat, reported when its frame arrives. Memory is allocated only by the setters.
+template <typename TSample>
+#if __cplusplus >= 202002L
+requires std::floating_point<TSample>
+#endif
+class TempoTracker
+{
+public:
+    TempoTracker(const TSample& frame_rate = static_cast<TSample>(44100.0 / 512.0), const TSample& window_seconds = static_cast<TSample>(6.0))
+    {
+        frame_rate_ = frame_rate;
+        window_seconds_ = window_seconds;
+        rebuild_();
+    }
+
+    ~TempoTracker() = default;
+
+    // All the setters reset the tracker
+    bool set_frame_rate(const TSample& frame_rate)
+    {
+        if (frame_rate <= static_cast<TSample>(0.0))
+        {
+            return false;
+        }
+
+        frame_rate_ = frame_rate;
+        rebuild_();
+
+        return true;
+    }
+
+    bool set_window(const TSample& seconds)
+    {
+        if (seconds <= static_cast<TSample>(0.0))
+        {
+            return false;
+        }
+
+        window_seconds_ = seconds;
+        rebuild_();
+
+        return true;
+    }
+
+    bool set_tempo_range(const TSample& min_tempo, const TSample& max_tempo)
+    {
+        if (min_tempo <= static_cast<TSample>(0.0) || max_tempo <= min_tempo)
+        {
+            return false;
+        }
+
+        min_tempo_ = min_tempo;
+        max_tempo_ = max_tempo;
+        rebuild_();
+
+        return true;
+    }
+
+    void reset()
+    {
+        std::fill(envelope_.begin(), envelope_.end(), static_cast<TSample>(0.0));
+        std::fill(acf_.begin(), acf_.end(), static_cast<WideSample<TSample>>(0.0));
+        std::fill(scores_.begin(), scores_.end(), static_cast<TSample>(0.0));
+        std::fill(compressed_.begin(), compressed_.end(), static_cast<TSample>(0.0));
+        estimate_ = BeatEstimate<TSample>();
+        onset_mean_ = static_cast<TSample>(0.0);
+        period_ = static_cast<TSample>(0.0);
+        weights_period_ = 0u;
+        frames_ = 0u;
+        last_beat_ = 0u;
+        next_beat_ = 0u;
+    }
+
+    // Onset strength of a magnitude spectrum: increase of the log compressed magnitudes over the
+    // previous spectrum given to this function, summed over the bins
+    const BeatEstimate<TSample>& process(const TSample* magnitudes, const size_t& size)
+    {
+        if (size != compressed_.size())
+        {
+            compressed_.assign(size, static_cast<TSample>(0.0));
+        }
+
+        Accumulator<TSample> flux;
+
+        for (size_t k = 0; k < size; k++)
+        {
+            const TSample compressed = std::log1p(compression_ * std::abs(magnitudes[k]));
+            flux += std::max(compressed - compressed_[k], static_cast<TSample>(0.0));
+            compressed_[k] = compressed;
+        }
+
+        return push(size > 0u ? static_cast<TSample>(flux) / static_cast<TSample>(size) : static_cast<TSample>(0.0));
+    }
+
+    // Any onset detection function, one value per frame
+    const BeatEstimate<TSample>& push(const TSample& onset)
+    {
+        INFORMER_PROFILE_SCOPE("tempo_tracking");
+
+        // Detrended envelope: onset minus its average over about a second
+        onset_mean_ += mean_coefficient_ * (onset - onset_mean_);
+        const TSample detrended = onset - onset_mean_;
+        const TSample novelty = std::max(detrended, static_cast<TSample>(0.0));
+
+        ++frames_;
+        envelope_[ring_(frames_)] = detrended;
+        slide_autocorrelation_();
+
+        estimate_.onset = onset;
+        estimate_.beat = false;
+        update_tempo_();
+
+        if (period_ > static_cast<TSample>(0.0))
+        {
+            track_beats_(novelty);
+        }
+
+        return estimate_;
+    }
+
+    const BeatEstimate<TSample>& get_estimate() const
+    {
+        return estimate_;
+    }
+
+    TSample get_frame_rate() const
+    {
+        return frame_rate_;
+    }
+
+private:
+    static constexpr TSample alpha_ = static_cast<TSample>(0.9);
+    static constexpr TSample tightness_ = static_cast<TSample>(5.0);
+    static constexpr TSample compression_ = static_cast<TSample>(1000.0);
+    static constexpr TSample prior_tempo_ = static_cast<TSample>(120.0);
+    static constexpr TSample prior_octaves_ = static_cast<TSample>(1.0);
+
+    TSample frame_rate_ = static_cast<TSample>(44100.0 / 512.0);
+    TSample window_seconds_ = static_cast<TSample>(6.0);
+    TSample min_tempo_ = static_cast<TSample>(40.0);
+    TSample max_tempo_ = static_cast<TSample>(240.0);
+    TSample mean_coefficient_ = static_cast<TSample>(0.01);
+    size_t length_ = 512u;
+    size_t min_lag_ = 21u;
+    size_t max_lag_ = 129u;
+
+    std::vector<TSample> envelope_ = {};
+    std::vector<WideSample<TSample>> acf_ = {};
+    std::vector<TSample> prior_ = {};
+    std::vector<TSample> scores_ = {};
+    std::vector<TSample> weights_ = {};
+    std::vector<TSample> projection_ = {};
+    std::vector<TSample> compressed_ = {};
+    BeatEstimate<TSample> estimate_;
+    TSample onset_mean_ = static_cast<TSample>(0.0);
+    TSample period_ = static_cast<TSample>(0.0);
+    size_t weights_period_ = 0u;
+    size_t frames_ = 0u;
+    size_t last_beat_ = 0u;
+    size_t next_beat_ = 0u;
+
+    inline size_t ring_(const size_t& frame) const
+    {
+        return frame % envelope_.size();
+    }
+
+    inline size_t score_ring_(const size_t& frame) const
+    {
+        return frame % scores_.size();
+    }
+
+    void rebuild_()
+    {
+        length_ = std::max(static_cast<size_t>(window_seconds_ * frame_rate_), static_cast<size_t>(8u));
+        min_lag_ = std::max(static_cast<size_t>(std::floor(static_cast<TSample>(60.0) * frame_rate_ / max_tempo_)), static_cast<size_t>(2u));
+        max_lag_ = std::max(static_cast<size_t>(std::ceil(static_cast<TSample>(60.0) * frame_rate_ / min_tempo_)), min_lag_ + 2u);
+        mean_coefficient_ = std::min(static_cast<TSample>(1.0) / frame_rate_, static_cast<TSample>(1.0));
+
+        // One lag more on each side for the interpolation of the maximum
+        envelope_.assign(length_ + max_lag_ + 2u, static_cast<TSample>(0.0));
+        acf_.assign(max_lag_ + 2u, static_cast<WideSample<TSample>>(0.0));
+        scores_.assign(3u * max_lag_ + 2u, static_cast<TSample>(0.0));
+        weights_.assign(2u * max_lag_ + 1u, static_cast<TSample>(0.0));
+        projection_.assign(max_lag_ + 2u, static_cast<TSample>(0.0));
+
+        prior_.assign(max_lag_ + 2u, static_cast<TSample>(0.0));
+        for (size_t lag = 1u; lag < prior_.size(); lag++)
+        {
+            const TSample octaves = std::log2(static_cast<TSample>(60.0) * frame_rate_ / (static_cast<TSample>(lag) * prior_tempo_)) / prior_octaves_;
+            prior_[lag] = std::exp(static_cast<TSample>(-0.5) * octaves * octaves);
+        }
+
+        reset();
+    }
+
+    void slide_autocorrelation_()
+    {
+        const TSample entering = envelope_[ring_(frames_)];
+        const bool full = frames_ > length_;
+        const TSample leaving = full ? envelope_[ring_(frames_ - length_)] : static_cast<TSample>(0.0);
+
+        for (size_t lag = min_lag_ - 1u; lag <= max_lag_ + 1u; lag++)
+        {
+            if (lag < frames_)
+            {
+                acf_[lag] += static_cast<WideSample<TSample>>(entering * envelope_[ring_(frames_ - lag)]);
+            }
+
+            if (full && frames_ - length_ > lag)
+            {
+                acf_[lag] -= static_cast<WideSample<TSample>>(leaving * envelope_[ring_(frames_ - length_ - lag)]);
+            }
+        }
+    }
+
+    void update_tempo_()
+    {
+        size_t best = 0u;
+        TSample best_score = static_cast<TSample>(0.0);
+
+        for (size_t lag = min_lag_; lag <= max_lag_; lag++)
+        {
+            const TSample score = static_cast<TSample>(acf_[lag]) * prior_[lag];
+
+            if (score > best_score)
+            {
+                best_score = score;
+                best = lag;
+            }
+        }
+
+        if (best == 0u)
+        {
+            return;
+        }
+
+        // Parabolic interpolation of the maximum
+        const TSample left = static_cast<TSample>(acf_[best - 1u]) * prior_[best - 1u];
+        const TSample right = static_cast<TSample>(acf_[best + 1u]) * prior_[best + 1u];
+        const TSample curvature = left - static_cast<TSample>(2.0) * best_score + right;
+        const TSample offset = curvature < static_cast<TSample>(0.0) ? std::clamp(static_cast<TSample>(0.5) * (left - right) / curvature, static_cast<TSample>(-0.5), static_cast<TSample>(0.5)) : static_cast<TSample>(0.0);
+
+        period_ = static_cast<TSample>(best) + offset;
+        estimate_.tempo = static_cast<TSample>(60.0) * frame_rate_ / period_;
+    }
+
+    // Weight of a past score v frames back, for the current period
+    void update_weights_(const size_t& period)
+    {
+        if (period == weights_period_)
+        {
+            return;
+        }
+
+        for (size_t v = 1u; v < weights_.size(); v++)
+        {
+            const TSample deviation = tightness_ * std::log(static_cast<TSample>(v) / period_);
+            weights_[v] = std::exp(static_cast<TSample>(-0.5) * deviation * deviation);
+        }
+
+        weights_period_ = period;
+    }
+
+    // Best weighted past score among the frames half a period to two periods before frame
+    inline TSample best_past_score_(const size_t& frame, const size_t& period, const TSample* projected, const size_t& now) const
+    {
+        TSample best = static_cast<TSample>(0.0);
+
+        for (size_t v = std::max(period / 2u, static_cast<size_t>(1u)); v <= 2u * period && v < frame; v++)
+        {
+            const size_t past = frame - v;
+            const TSample score = past > now ? projected[past - now] : scores_[score_ring_(past)];
+            best = std::max(best, weights_[v] * score);
+        }
+
+        return best;
+    }
+
+    void track_beats_(const TSample& novelty)
+    {
+        const size_t period = std::min(static_cast<size_t>(period_ + static_cast<TSample>(0.5)), max_lag_);
+        update_weights_(period);
+
+        scores_[score_ring_(frames_)] = (static_cast<TSample>(1.0) - alpha_) * novelty +
+                                        alpha_ * best_past_score_(frames_, period, projection_.data(), frames_);
+
+        // Half a period after the last beat, place the next one
+        if (next_beat_ <= last_beat_ && frames_ >= last_beat_ + period / 2u)
+        {
+            size_t best = period;
+            TSample best_score = static_cast<TSample>(-1.0);
+
+            for (size_t j = 1u; j <= period; j++)
+            {
+                projection_[j] = alpha_ * best_past_score_(frames_ + j, period, projection_.data(), frames_);
+
+                // Expectation of the beat one period after the last one
+                const TSample distance = (static_cast<TSample>(frames_ + j) - static_cast<TSample>(last_beat_) - period_) / (static_cast<TSample>(0.5) * period_);
+                const TSample score = projection_[j] * std::exp(static_cast<TSample>(-0.5) * distance * distance);
+
+                if (score > best_score)
+                {
+                    best_score = score;
+                    best = j;
+                }
+            }
+
+            next_beat_ = frames_ + best;
+        }
+
+        if (next_beat_ > last_beat_ && frames_ >= next_beat_)
+        {
+            estimate_.beat = true;
+            last_beat_ = frames_;
+        }
+
+        const TSample span = next_beat_ > last_beat_ ? static_cast<TSample>(next_beat_ - last_beat_) : period_;
+        estimate_.phase = std::clamp(static_cast<TSample>(frames_ - last_beat_) / span, static_cast<TSample>(0.0), static_cast<TSample>(0.999));
+    }
+};
+
+} // namespace Informer
+
+#endif // INFORMER_TEMPO_H_
@@ -0,0 +1,916 @@
+/******************************************************************************
+Copyright (c) 2023-2026 Valerio Orlandini
+
+Permission is hereby granted, free of charge, to any person obtaining a copy
+of this software and associated documentation files (the "Software"), to deal
+in the Software without restriction, including without limitation the rights
+to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+copies of the Software, and to permit persons to whom the Software is
+furnished to do so, subject to the following conditions:
+
+The above copyright notice and this permission notice shall be included in all
+copies or substantial portions of the Software.
+
+THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+SOFTWARE.
+******************************************************************************/
+
+#ifndef INFORMER_TRACKS_H_
+#define INFORMER_TRACKS_H_
+
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <limits>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+#ifdef _WIN32
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#ifndef WIN32_LEAN_AND_MEAN
+#define WIN32_LEAN_AND_MEAN
+#endif
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+#if __cplusplus >= 202002L
+#include<concepts>
+#endif
+
+#include "informer_codec.h"
+
+namespace Informer
+{
+
+/* DESCRIPTOR TRACKS FILES */
+
+// A track file stores one float32 value per descriptor per analysis frame.
+// Layout (little endian, every section aligned to 64 bytes):
+//
+//   FileHeader
+//   schema: descriptor_count names of name_size bytes, null terminated
+//   blocks: block_frames frames each (the last one can be shorter), column major,
+//           so that each descriptor of a block is a contiguous float array
+//           (Raw) or an independently compressed column (Packed, see informer_codec.h)
+//   index:  block_count BlockIndexEntry, to locate the block of any frame
+//
+// Blocks are written while the analysis runs, the index and the final header
+// when the writer is closed. The reader maps the file in memory and returns
+// pointers straight into the mapping: opening a file does not read the tracks,
+// and the pages are shared by all the processes reading the same file.
+namespace Tracks
+{
+
+constexpr char file_magic[8] = {'I', 'N', 'F', 'O', 'T', 'R', 'K', '\0'};
+constexpr uint32_t format_version = 1u;
+constexpr uint32_t endian_tag = 0x01020304u;
+constexpr size_t name_size = 64u;
+constexpr size_t alignment = 64u;
+
+// Storage of the block values. A Packed block starts with descriptor_count
+// ColumnEntry, followed by the column payloads, each padded to 4 bytes.
+enum class Codec : uint32_t
+{
+    Raw = 0,
+    Packed = 1
+};
+
+struct FileHeader
+{
+    char magic[8];
+    uint32_t version;
+    uint32_t endian;
+    uint32_t descriptor_count;
+    uint32_t block_frames;
+    uint64_t frame_count;
+    uint64_t block_count;
+    uint64_t schema_offset;
+    uint64_t index_offset;
+    double sample_rate;
+    uint32_t frame_size;
+    uint32_t hop_size;
+    uint32_t codec;
+    uint32_t reserved[5];
+};
+
+struct BlockIndexEntry
+{
+    uint64_t offset;
+    uint64_t size;
+    uint64_t first_frame;
+    uint32_t frame_count;
+    uint32_t codec;
+};
+
+struct ColumnEntry
+{
+    uint32_t encoding;
+    uint32_t size;
+};
+
+static_assert(sizeof(FileHeader) == 96u, "Unexpected FileHeader padding");
+static_assert(sizeof(BlockIndexEntry) == 32u, "Unexpected BlockIndexEntry padding");
+
+inline uint64_t aligned(const uint64_t& offset)
+{
+    return (offset + alignment - 1u) / alignment * alignment;
+}
+
+inline uint64_t padded_column_size(const uint64_t& size)
+{
+    return (size + 3u) / 4u * 4u;
+}
+
+// STREAMING WRITER
+class TrackWriter
+{
+public:
+    TrackWriter() = default;
+
+    ~TrackWriter()
+    {
+        close();
+    }
+
+    TrackWriter(const TrackWriter&) = delete;
+    TrackWriter& operator=(const TrackWriter&) = delete;
+
+    // descriptor_names fixes the schema: every frame has one value per name, in this order.
+    // With Codec::Packed each column of each block is compressed losslessly.
+    bool open(const std::string& path, const std::vector<std::string>& descriptor_names,
+              const double& sample_rate, const uint32_t& frame_size, const uint32_t& hop_size,
+              const uint32_t& block_frames = 4096u, const Codec& codec = Codec::Raw)
+    {
+        close();
+
+        if (descriptor_names.empty() || sample_rate <= 0.0 || block_frames == 0u ||
+            (codec != Codec::Raw && codec != Codec::Packed))
+        {
+            return false;
+        }
+
+        for (const auto& name : descriptor_names)
+        {
+            if (name.empty() || name.size() >= name_size)
+            {
+                return false;
+            }
+        }
+
+        file_.open(path, std::ios::binary | std::ios::out | std::ios::trunc);
+
+        if (!file_)
+        {
+            return false;
+        }
+
+        names_ = descriptor_names;
+        name_lookup_.clear();
+        for (size_t d = 0; d < names_.size(); d++)
+        {
+            name_lookup_[names_[d]] = d;
+        }
+
+        std::memset(&header_, 0, sizeof(FileHeader));
+        std::memcpy(header_.magic, file_magic, sizeof(file_magic));
+        header_.version = format_version;
+        header_.endian = endian_tag;
+        header_.descriptor_count = static_cast<uint32_t>(names_.size());
+        header_.block_frames = block_frames;
+        header_.sample_rate = sample_rate;
+        header_.frame_size = frame_size;
+        header_.hop_size = hop_size;
+        header_.codec = static_cast<uint32_t>(codec);
+        header_.schema_offset = aligned(sizeof(FileHeader));
+
+        block_.assign(names_.size() * block_frames, 0.0f);
+        frame_set_.assign(names_.size(), false);
+        quantization_steps_.assign(names_.size(), 0.0f);
+        block_fill_ = 0u;
+        index_.clear();
+
+        // Placeholder header, rewritten by close()
+        write_(&header_, sizeof(FileHeader));
+        pad_to_(header_.schema_offset);
+
+        std::vector<char> schema(names_.size() * name_size, '\0');
+        for (size_t d = 0; d < names_.size(); d++)
+        {
+            std::memcpy(schema.data() + d * name_size, names_[d].data(), names_[d].size());
+        }
+        write_(schema.data(), schema.size());
+
+        return static_cast<bool>(file_);
+    }
+
+    bool is_open() const
+    {
+        return file_.is_open();
+    }
+
+    // Packed files only: store a descriptor as multiples of step (lossy, e.g. 0.0001
+    // for a normalized descriptor), which compresses much better than full floats
+    bool set_quantization(const std::string& descriptor_name, const float& step)
+    {
+        auto d = name_lookup_.find(descriptor_name);
+
+        if (!file_.is_open() || header_.codec != static_cast<uint32_t>(Codec::Packed) ||
+            d == name_lookup_.end() || step < 0.0f)
+        {
+            return false;
+        }
+
+        quantization_steps_[d->second] = step;
+
+        return true;
+    }
+
+    // Append a frame, values holds one value per descriptor in schema order
+    template <typename TSample>
+#if __cplusplus >= 202002L
+    requires std::floating_point<TSample>
+#endif
+    bool write_frame(const TSample* values)
+    {
+        if (!file_.is_open() || values == nullptr)
+        {
+            return false;
+        }
+
+        for (size_t d = 0; d < names_.size(); d++)
+        {
+            block_[d * header_.block_frames + block_fill_] = static_cast<float>(values[d]);
+        }
+
+        return commit_frame_();
+    }
+
+    template <typename TSample>
+#if __cplusplus >= 202002L
+    requires std::floating_point<TSample>
+#endif
+    bool write_frame(const std::vector<TSample>& values)
+    {
+        return values.size() == names_.size() && write_frame(values.data());
+    }
+
+    // Append a frame from a descriptors map, as returned by Informer::get_*_descriptors(),
+    // with an optional prefix added to the keys. Descriptors not found are stored as NaN.
+    template <typename TSample>
+#if __cplusplus >= 202002L
+    requires std::floating_point<TSample>
+#endif
+    bool write_frame(const std::unordered_map<std::string, TSample>& descriptors, const std::string& prefix = "")
+    {
+        if (!file_.is_open())
+        {
+            return false;
+        }
+
+        set_values(descriptors, prefix);
+
+        return commit_frame();
+    }
+
+    // Fill part of the current frame from a descriptors map, to be completed with commit_frame().
+    // Useful when a frame is made of several maps (e.g. several channels).
+    template <typename TSample>
+#if __cplusplus >= 202002L
+    requires std::floating_point<TSample>
+#endif
+    void set_values(const std::unordered_map<std::string, TSample>& descriptors, const std::string& prefix = "")
+    {
+        if (!file_.is_open())
+        {
+            return;
+        }
+
+        for (const auto& [name, value] : descriptors)
+        {
+            auto d = name_lookup_.find(prefix + name);
+
+            if (d != name_lookup_.end())
+            {
+                block_[d->second * header_.block_frames + block_fill_] = static_cast<float>(value);
+                frame_set_[d->second] = true;
+            }
+        }
+    }
+
+    bool commit_frame()
+    {
+        if (!file_.is_open())
+        {
+            return false;
+        }
+
+        for (size_t d = 0; d < names_.size(); d++)
+        {
+            if (!frame_set_[d])
+            {
+                block_[d * header_.block_frames + block_fill_] = std::numeric_limits<float>::quiet_NaN();
+            }
+        }
+
+        return commit_frame_();
+    }
+
+    uint64_t get_frame_count() const
+    {
+        return header_.frame_count;
+    }
+
+    // Write the pending frames, the index and the final header
+    bool close()
+    {
+        if (!file_.is_open())
+        {
+            return false;
+        }
+
+        flush_block_();
+
+        header_.block_count = index_.size();
+        header_.index_offset = aligned(static_cast<uint64_t>(file_.tellp()));
+        pad_to_(header_.index_offset);
+        write_(index_.data(), index_.size() * sizeof(BlockIndexEntry));
+
+        file_.seekp(0);
+        write_(&header_, sizeof(FileHeader));
+
+        const bool result = static_cast<bool>(file_);
+        file_.close();
+
+        return result;
+    }
+
+private:
+    std::ofstream file_;
+    FileHeader header_ = {};
+    std::vector<std::string> names_;
+    std::unordered_map<std::string, size_t> name_lookup_;
+    std::vector<float> block_;
+    std::vector<bool> frame_set_;
+    std::vector<float> quantization_steps_;
+    uint32_t block_fill_ = 0u;
+    std::vector<BlockIndexEntry> index_;
+    std::vector<ColumnEntry> columns_;
+    std::vector<uint8_t> packed_;
+    std::vector<uint8_t> payload_;
+
+    void write_(const void* data, const size_t& size)
+    {
+        file_.write(static_cast<const char*>(data), static_cast<std::streamsize>(size));
+    }
+
+    void pad_to_(const uint64_t& offset)
+    {
+        static const char zeros[alignment] = {};
+        const uint64_t position = static_cast<uint64_t>(file_.tellp());
+
+        if (offset > position)
+        {
+            write_(zeros, static_cast<size_t>(offset - position));
+        }
+    }
+
+    bool commit_frame_()
+    {
+        frame_set_.assign(names_.size(), false);
+        header_.frame_count++;
+
+        if (++block_fill_ == header_.block_frames)
+        {
+            flush_block_();
+        }
+
+        return static_cast<bool>(file_);
+    }
+
+    void flush_block_()
+    {
+        if (block_fill_ == 0u)
+        {
+            return;
+        }
+
+        BlockIndexEntry entry = {};
+        entry.offset = aligned(static_cast<uint64_t>(file_.tellp()));
+        entry.first_frame = header_.frame_count - block_fill_;
+        entry.frame_count = block_fill_;
+        entry.codec = header_.codec;
+
+        pad_to_(entry.offset);
+
+        if (entry.codec == static_cast<uint32_t>(Codec::Packed))
+        {
+            columns_.resize(names_.size());
+            packed_.clear();
+
+            for (size_t d = 0; d < names_.size(); d++)
+            {
+                columns_[d].encoding = static_cast<uint32_t>(Compression::encode(block_.data() + d * header_.block_frames, block_fill_, payload_, quantization_steps_[d]));
+                columns_[d].size = static_cast<uint32_t>(payload_.size());
+                packed_.insert(packed_.end(), payload_.begin(), payload_.end());
+                packed_.resize(packed_.size() + (padded_column_size(payload_.size()) - payload_.size()), 0u);
+            }
+
+            write_(columns_.data(), columns_.size() * sizeof(ColumnEntry));
+            write_(packed_.data(), packed_.size());
+            entry.size = columns_.size() * sizeof(ColumnEntry) + packed_.size();
+        }
+        else
+        {
+            // Columns are stored packed, so a short last block has no gaps
+            for (size_t d = 0; d < names_.size(); d++)
+            {
+                write_(block_.data() + d * header_.block_frames, block_fill_ * sizeof(float));
+            }
+
+            entry.size = static_cast<uint64_t>(names_.size()) * block_fill_ * sizeof(float);
+        }
+
+        index_.push_back(entry);
+        block_fill_ = 0u;
+    }
+};
+
+// MEMORY MAPPED READER
+class TrackReader
+{
+public:
+    TrackReader() = default;
+
+    ~TrackReader()
+    {
+        close();
+    }
+
+    TrackReader(const TrackReader&) = delete;
+    TrackReader& operator=(const TrackReader&) = delete;
+
+    bool open(const std::string& path)
+    {
+        close();
+
+        if (!map_(path))
+        {
+            return false;
+        }
+
+        if (!validate_())
+        {
+            close();
+
+            return false;
+        }
+
+        names_.clear();
+        name_lookup_.clear();
+        for (size_t d = 0; d < header_->descriptor_count; d++)
+        {
+            const char* name = reinterpret_cast<const char*>(data_ + header_->schema_offset + d * name_size);
+            names_.emplace_back(name, strnlen(name, name_size));
+            name_lookup_[names_.back()] = d;
+        }
+
+        return true;
+    }
+
+    void close()
+    {
+#ifdef _WIN32
+        if (data_ != nullptr)
+        {
+            UnmapViewOfFile(data_);
+        }
+        if (mapping_ != nullptr)
+        {
+            CloseHandle(mapping_);
+            mapping_ = nullptr;
+        }
+#else
+        if (data_ != nullptr)
+        {
+            munmap(const_cast<unsigned char*>(data_), size_);
+        }
+#endif
+        data_ = nullptr;
+        size_ = 0u;
+        header_ = nullptr;
+        index_ = nullptr;
+        names_.clear();
+        name_lookup_.clear();
+    }
+
+    bool is_open() const
+    {
+        return data_ != nullptr;
+    }
+
+    uint64_t get_frame_count() const
+    {
+        return header_ != nullptr ? header_->frame_count : 0u;
+    }
+
+    size_t get_descriptor_count() const
+    {
+        return names_.size();
+    }
+
+    uint64_t get_block_count() const
+    {
+        return header_ != nullptr ? header_->block_count : 0u;
+    }
+
+    uint32_t get_block_frames() const
+    {
+        return header_ != nullptr ? header_->block_frames : 0u;
+    }
+
+    double get_sample_rate() const
+    {
+        return header_ != nullptr ? header_->sample_rate : 0.0;
+    }
+
+    uint32_t get_frame_size() const
+    {
+        return header_ != nullptr ? header_->frame_size : 0u;
+    }
+
+    uint32_t get_hop_size() const
+    {
+        return header_ != nullptr ? header_->hop_size : 0u;
+    }
+
+    Codec get_codec() const
+    {
+        return header_ != nullptr ? static_cast<Codec>(header_->codec) : Codec::Raw;
+    }
+
+    const std::vector<std::string>& get_descriptor_names() const
+    {
+        return names_;
+    }
+
+    // Index of a descriptor in the schema, -1 if not present
+    long find_descriptor(const std::string& name) const
+    {
+        auto d = name_lookup_.find(name);
+
+        return d != name_lookup_.end() ? static_cast<long>(d->second) : -1;
+    }
+
+    // Start time of a frame, in seconds
+    double frame_time(const uint64_t& frame) const
+    {
+        return header_ != nullptr ? static_cast<double>(frame) * static_cast<double>(header_->hop_size) / header_->sample_rate : 0.0;
+    }
+
+    // Frame starting at or just before the given time
+    uint64_t frame_at_time(const double& seconds) const
+    {
+        if (header_ == nullptr || header_->hop_size == 0u || seconds <= 0.0)
+        {
+            return 0u;
+        }
+
+        const double frame = std::floor(seconds * header_->sample_rate / static_cast<double>(header_->hop_size));
+
+        return std::min(static_cast<uint64_t>(frame), header_->frame_count > 0u ? header_->frame_count - 1u : 0u);
+    }
+
+    const BlockIndexEntry* get_block(const uint64_t& block) const
+    {
+        return header_ != nullptr && block < header_->block_count ? index_ + block : nullptr;
+    }
+
+    // Values of a descriptor in a block, straight from the mapping. Returns nullptr
+    // when the column is compressed, use decode_block_track() instead.
+    const float* block_track(const uint64_t& block, const size_t& descriptor) const
+    {
+        Compression::ColumnEncoding encoding;
+        const uint8_t* payload = column_(block, descriptor, encoding, nullptr);
+
+        return payload != nullptr && encoding == Compression::ColumnEncoding::Raw ? reinterpret_cast<const float*>(payload) : nullptr;
+    }
+
+    // Copy the values of a descriptor in a block (get_block(block)->frame_count values),
+    // decompressing them if needed
+    bool decode_block_track(const uint64_t& block, const size_t& descriptor, float* values) const
+    {
+        Compression::ColumnEncoding encoding;
+        size_t size = 0u;
+        const uint8_t* payload = column_(block, descriptor, encoding, &size);
+
+        return payload != nullptr && values != nullptr &&
+               Compression::decode(encoding, payload, size, index_[block].frame_count, values);
+    }
+
+    // Call slice(first_frame, values, count) for each contiguous piece of the
+    // range [first_frame, first_frame + frame_count) of a descriptor, without copies
+    template <typename Function>
+    bool for_each_slice(const size_t& descriptor, uint64_t first_frame, uint64_t frame_count, Function slice) const
+    {
+        if (header_ == nullptr || descriptor >= names_.size() ||
+            first_frame > header_->frame_count || frame_count > header_->frame_count - first_frame)
+        {
+            return false;
+        }
+
+        uint64_t block = first_frame / header_->block_frames;
+        std::vector<float> decoded;
+
+        while (frame_count > 0u)
+        {
+            const BlockIndexEntry& entry = index_[block];
+            const uint64_t offset = first_frame - entry.first_frame;
+            const uint64_t count = std::min(frame_count, static_cast<uint64_t>(entry.frame_count) - offset);
+            const float* values = block_track(block, descriptor);
+
+            if (values == nullptr)
+            {
+                decoded.resize(entry.frame_count);
+
+                if (!decode_block_track(block, descriptor, decoded.data()))
+                {
+                    return false;
+                }
+
+                values = decoded.data();
+            }
+
+            slice(first_frame, values + offset, static_cast<size_t>(count));
+
+            first_frame += count;
+            frame_count -= count;
+            block++;
+        }
+
+        return true;
+    }
+
+    // Copy a range of a descriptor track
+    template <typename TSample>
+#if __cplusplus >= 202002L
+    requires std::floating_point<TSample>
+#endif
+    bool read(const size_t& descriptor, const uint64_t& first_frame, const uint64_t& frame_count, TSample* values) const
+    {
+        if (values == nullptr)
+        {
+            return false;
+        }
+
+        return for_each_slice(descriptor, first_frame, frame_count, [&values, first_frame](uint64_t frame, const float* slice, size_t count)
+        {
+            std::copy(slice, slice + count, values + (frame - first_frame));
+        });
+    }
+
+    // Copy all the descriptors of a frame, in schema order
+    template <typename TSample>
+#if __cplusplus >= 202002L
+    requires std::floating_point<TSample>
+#endif
+    bool read_frame(const uint64_t& frame, TSample* values) const
+    {
+        if (header_ == nullptr || values == nullptr || frame >= header_->frame_count)
+        {
+            return false;
+        }
+
+        const uint64_t block = frame / header_->block_frames;
+        const uint64_t offset = frame - index_[block].first_frame;
+        std::vector<float> decoded;
+
+        for (size_t d = 0; d < names_.size(); d++)
+        {
+            const float* track = block_track(block, d);
+
+            if (track == nullptr)
+            {
+                decoded.resize(index_[block].frame_count);
+
+                if (!decode_block_track(block, d, decoded.data()))
+                {
+                    return false;
+                }
+
+                track = decoded.data();
+            }
+
+            values[d] = static_cast<TSample>(track[offset]);
+        }
+
+        return true;
+    }
+
+private:
+    const unsigned char* data_ = nullptr;
+    size_t size_ = 0u;
+    const FileHeader* header_ = nullptr;
+    const BlockIndexEntry* index_ = nullptr;
+    std::vector<std::string> names_;
+    std::unordered_map<std::string, size_t> name_lookup_;
+#ifdef _WIN32
+    HANDLE mapping_ = nullptr;
+#endif
+
+    // Locate the payload of a column, nullptr if the block or the descriptor does not exist
+    const uint8_t* column_(const uint64_t& block, const size_t& descriptor, Compression::ColumnEncoding& encoding, size_t* size) const
+    {
+        const BlockIndexEntry* entry = get_block(block);
+
+        if (entry == nullptr || descriptor >= names_.size())
+        {
+            return nullptr;
+        }
+
+        const uint8_t* block_data = data_ + entry->offset;
+
+        if (entry->codec == static_cast<uint32_t>(Codec::Raw))
+        {
+            encoding = Compression::ColumnEncoding::Raw;
+            if (size != nullptr)
+            {
+                *size = static_cast<size_t>(entry->frame_count) * sizeof(float);
+            }
+
+            return block_data + descriptor * entry->frame_count * sizeof(float);
+        }
+
+        const ColumnEntry* columns = reinterpret_cast<const ColumnEntry*>(block_data);
+        uint64_t offset = names_.size() * sizeof(ColumnEntry);
+
+        for (size_t d = 0; d < descriptor; d++)
+        {
+            offset += padded_column_size(columns[d].size);
+        }
+
+        encoding = static_cast<Compression::ColumnEncoding>(columns[descriptor].encoding);
+        if (size != nullptr)
+        {
+            *size = columns[descriptor].size;
+        }
+
+        return block_data + offset;
+    }
+
+    bool map_(const std::string& path)
+    {
+#ifdef _WIN32
+        HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+
+        if (file == INVALID_HANDLE_VALUE)
+        {
+            return false;
+        }
+
+        LARGE_INTEGER file_size;
+        if (!GetFileSizeEx(file, &file_size) || file_size.QuadPart < static_cast<LONGLONG>(sizeof(FileHeader)))
+        {
+            CloseHandle(file);
+            return false;
+        }
+
+        mapping_ = CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+        CloseHandle(file);
+
+        if (mapping_ == nullptr)
+        {
+            return false;
+        }
+
+        data_ = static_cast<const unsigned char*>(MapViewOfFile(mapping_, FILE_MAP_READ, 0, 0, 0));
+        size_ = static_cast<size_t>(file_size.QuadPart);
+#else
+        const int file = ::open(path.c_str(), O_RDONLY);
+
+        if (file < 0)
+        {
+            return false;
+        }
+
+        struct stat file_stat;
+        if (fstat(file, &file_stat) != 0 || file_stat.st_size < static_cast<off_t>(sizeof(FileHeader)))
+        {
+            ::close(file);
+            return false;
+        }
+
+        size_ = static_cast<size_t>(file_stat.st_size);
+        void* mapping = mmap(nullptr, size_, PROT_READ, MAP_SHARED, file, 0);
+        ::close(file);
+
+        data_ = mapping != MAP_FAILED ? static_cast<const unsigned char*>(mapping) : nullptr;
+#endif
+        if (data_ == nullptr)
+        {
+            close();
+            return false;
+        }
+
+        return true;
+    }
+
+    // Check every offset before trusting the file, so that a truncated or
+    // corrupted file is rejected instead of being read out of bounds
+    bool validate_()
+    {
+        header_ = reinterpret_cast<const FileHeader*>(data_);
+
+        if (std::memcmp(header_->magic, file_magic, sizeof(file_magic)) != 0 ||
+            header_->version != format_version || header_->endian != endian_tag ||
+            header_->descriptor_count == 0u || header_->block_frames == 0u || header_->sample_rate <= 0.0)
+        {
+            return false;
+        }
+
+        const uint64_t schema_end = header_->schema_offset + static_cast<uint64_t>(header_->descriptor_count) * name_size;
+        const uint64_t index_end = header_->index_offset + header_->block_count * sizeof(BlockIndexEntry);
+        const uint64_t expected_blocks = (header_->frame_count + header_->block_frames - 1u) / header_->block_frames;
+
+        if (schema_end > size_ || index_end > size_ || header_->index_offset % alignof(BlockIndexEntry) != 0u ||
+            header_->block_count != expected_blocks)
+        {
+            return false;
+        }
+
+        index_ = reinterpret_cast<const BlockIndexEntry*>(data_ + header_->index_offset);
+
+        for (uint64_t b = 0; b < header_->block_count; b++)
+        {
+            const BlockIndexEntry& entry = index_[b];
+            const uint64_t frames = std::min(static_cast<uint64_t>(header_->block_frames), header_->frame_count - b * header_->block_frames);
+
+            if (entry.first_frame != b * header_->block_frames || entry.frame_count != frames ||
+                entry.offset % alignof(float) != 0u || entry.offset > size_ || entry.size > size_ - entry.offset)
+            {
+                return false;
+            }
+
+            if (entry.codec == static_cast<uint32_t>(Codec::Raw))
+            {
+                if (entry.size != static_cast<uint64_t>(header_->descriptor_count) * entry.frame_count * sizeof(float))
+                {
+                    return false;
+                }
+            }
+            else if (entry.codec == static_cast<uint32_t>(Codec::Packed))
+            {
+                const uint64_t table_size = static_cast<uint64_t>(header_->descriptor_count) * sizeof(ColumnEntry);
+
+                if (entry.size < table_size)
+                {
+                    return false;
+                }
+
+                const ColumnEntry* columns = reinterpret_cast<const ColumnEntry*>(data_ + entry.offset);
+                uint64_t payload_size = table_size;
+
+                for (size_t d = 0; d < header_->descriptor_count; d++)
+                {
+                    if (columns[d].encoding > static_cast<uint32_t>(Compression::ColumnEncoding::DeltaQuantized))
+                    {
+                        return false;
+                    }
+
+                    payload_size += padded_column_size(columns[d].size);
+                }
+
+                if (payload_size > entry.size)
+                {
+                    return false;
+                }
+            }
+            else
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+};
+
+} // namespace Informer::Tracks
+
+} // namespace Informer
+
+#endif // INFORMER_TRACKS_H_
@@ -154,6 +154,18 @@ PYBIND11_MODULE(pyinformer, m)
                   "Calculate spectral flux", py::arg("magnitudes"), py::arg("previous_magnitudes"));
     frequency.def("flux", &Informer::Frequency::flux<std::vector<double>>,
                   "Calculate spectral flux", py::arg("magnitudes"), py::arg("previous_magnitudes"));
+    frequency.def("key_strengths", [](const std::vector<float>& chroma)
+    {
+        std::array<float, 24> strengths;
+        Informer::Frequency::key_strengths(chroma, strengths);
+        return strengths;
+    }, "Calculate the correlations of a chroma vector with the 24 key profiles", py::arg("chroma"));
+    frequency.def("key_strengths", [](const std::vector<double>& chroma)
+    {
+        std::array<double, 24> strengths;
+        Informer::Frequency::key_strengths(chroma, strengths);
+        return strengths;
+    }, "Calculate the correlations of a chroma vector with the 24 key profiles", py::arg("chroma"));
     frequency.def("irregularity", &Informer::Frequency::irregularity<std::vector<float>>,
                   "Calculate spectral irregularity", py::arg("magnitudes"));
     frequency.def("irregularity", &Informer::Frequency::irregularity<std::vector<double>>,
@@ -214,6 +226,27 @@ PYBIND11_MODULE(pyinformer, m)
     py::arg("precomputed_frequencies") = std::vector<double> {}, py::arg("stft_size") = 0u);
 
 
+    // Profiling data, available when the module is built with INFORMER_PROFILE defined
+    py::module_ profiler = m.def_submodule("profiler", "Per-stage timings of the descriptors computation");
+
+    profiler.def("summary", []()
+    {
+        py::list stages;
+        for (const auto& s : Informer::Profiler::summary())
+        {
+            py::dict stage;
+            stage["name"] = s.name;
+            stage["count"] = s.count;
+            stage["mean_ns"] = s.mean_ns;
+            stage["p99_ns"] = s.p99_ns;
+            stages.append(stage);
+        }
+        return stages;
+    }, "Count, mean and 99th percentile (ns) of each profiled stage");
+    profiler.def("chrome_trace", &Informer::Profiler::chrome_trace, "Recorded events in Chrome trace JSON format");
+    profiler.def("write_chrome_trace", &Informer::Profiler::write_chrome_trace, "Write the Chrome trace JSON to a file", py::arg("path"));
+    profiler.def("reset", &Informer::Profiler::reset, "Clear the recorded events");
+
     // Bind the main Informer class for float and double
     py::class_<Informer::Informer<float>>(m, "InformerFloat")
     .def(py::init<const std::vector<float>&, const std::vector<float>&, const float&,
@@ -228,8 +261,8 @@ PYBIND11_MODULE(pyinformer, m)
     .def("set_sample_rate", &Informer::Informer<float>::set_sample_rate)
     .def("set_rolloff_point", &Informer::Informer<float>::set_rolloff_point)
     .def("set_stft_size", &Informer::Informer<float>::set_stft_size)
-    .def("set_buffer", &Informer::Informer<float>::set_buffer)
-    .def("set_magnitudes", &Informer::Informer<float>::set_magnitudes,
+    .def("set_buffer", py::overload_cast<const std::vector<float>&>(&Informer::Informer<float>::set_buffer))
+    .def("set_magnitudes", py::overload_cast<const std::vector<float>&, bool>(&Informer::Informer<float>::set_magnitudes),
          py::arg("magnitudes"), py::arg("update_stft_size") = false)
     .def("set_magnitudes_from_stft", &Informer::Informer<float>::set_magnitudes_from_stft)
     .def("compute_descriptors", &Informer::Informer<float>::compute_descriptors,
@@ -242,6 +275,12 @@ PYBIND11_MODULE(pyinformer, m)
     .def("get_frequency_descriptor", &Informer::Informer<float>::get_frequency_descriptor)
     .def("get_time_descriptors", &Informer::Informer<float>::get_time_descriptors)
     .def("get_frequency_descriptors", &Informer::Informer<float>::get_frequency_descriptors)
+    .def("set_chroma_bins", &Informer::Informer<float>::set_chroma_bins)
+    .def("get_chroma_bins", &Informer::Informer<float>::get_chroma_bins)
+    .def("get_chroma", &Informer::Informer<float>::get_chroma)
+    .def("get_key_strengths", &Informer::Informer<float>::get_key_strengths)
+    .def("set_pitch_tracking", &Informer::Informer<float>::set_pitch_tracking)
+    .def("set_chroma_key", &Informer::Informer<float>::set_chroma_key)
     // Individual descriptor methods
     .def("amp_peak", &Informer::Informer<float>::amp_peak)
     .def("amp_rms", &Informer::Informer<float>::amp_rms)
@@ -263,8 +302,8 @@ PYBIND11_MODULE(pyinformer, m)
     .def("set_sample_rate", &Informer::Informer<double>::set_sample_rate)
     .def("set_rolloff_point", &Informer::Informer<double>::set_rolloff_point)
     .def("set_stft_size", &Informer::Informer<double>::set_stft_size)
-    .def("set_buffer", &Informer::Informer<double>::set_buffer)
-    .def("set_magnitudes", &Informer::Informer<double>::set_magnitudes,
+    .def("set_buffer", py::overload_cast<const std::vector<double>&>(&Informer::Informer<double>::set_buffer))
+    .def("set_magnitudes", py::overload_cast<const std::vector<double>&, bool>(&Informer::Informer<double>::set_magnitudes),
          py::arg("magnitudes"), py::arg("update_stft_size") = false)
     .def("set_magnitudes_from_stft", &Informer::Informer<double>::set_magnitudes_from_stft)
     .def("compute_descriptors", &Informer::Informer<double>::compute_descriptors,
@@ -277,6 +316,12 @@ PYBIND11_MODULE(pyinformer, m)
     .def("get_frequency_descriptor", &Informer::Informer<double>::get_frequency_descriptor)
     .def("get_time_descriptors", &Informer::Informer<double>::get_time_descriptors)
     .def("get_frequency_descriptors", &Informer::Informer<double>::get_frequency_descriptors)
+    .def("set_chroma_bins", &Informer::Informer<double>::set_chroma_bins)
+    .def("get_chroma_bins", &Informer::Informer<double>::get_chroma_bins)
+    .def("get_chroma", &Informer::Informer<double>::get_chroma)
+    .def("get_key_strengths", &Informer::Informer<double>::get_key_strengths)
+    .def("set_pitch_tracking", &Informer::Informer<double>::set_pitch_tracking)
+    .def("set_chroma_key", &Informer::Informer<double>::set_chroma_key)
     // Individual descriptor methods
     .def("amp_peak", &Informer::Informer<double>::amp_peak)
     .def("amp_rms", &Informer::Informer<double>::amp_rms)
@@ -77,6 +77,14 @@ struct TheInformer : Module
         informer->set_stft_size(BUFFER_SIZE);
         buffer->assign(BUFFER_SIZE, 0.f);
 
+        // Library rules, with the narrower ranges of this module for kurtosis, skewness and flux
+        timeNormalizer.set_rules(Informer::time_normalization_rules<float>());
+        timeNormalizer.set_rule(static_cast<size_t>(Informer::TimeDescriptor::Skewness), Informer::static_normalization(2.f, 0.25f));
+        freqNormalizer.set_rules(Informer::frequency_normalization_rules<float>());
+        freqNormalizer.set_rule(static_cast<size_t>(Informer::FrequencyDescriptor::Kurtosis), Informer::static_normalization(2.f, 0.25f));
+        freqNormalizer.set_rule(static_cast<size_t>(Informer::FrequencyDescriptor::Skewness), Informer::static_normalization(2.f, 0.25f));
+        freqNormalizer.set_rule(static_cast<size_t>(Informer::FrequencyDescriptor::Flux), Informer::static_normalization(0.f, 1.f / 2048.f));
+
         // Initialize the OSC socket 
         socket = new oscpkt::UdpSocket();
         socket->connectTo(ip.c_str(), port);
@@ -95,6 +103,8 @@ struct TheInformer : Module
     }
 
     Informer::Informer<float> *informer = nullptr;
+    Informer::Normalizer<float, static_cast<size_t>(Informer::TimeDescriptor::Count)> timeNormalizer;
+    Informer::Normalizer<float, static_cast<size_t>(Informer::FrequencyDescriptor::Count)> freqNormalizer;
     std::vector<float> *buffer = nullptr;
     oscpkt::UdpSocket *socket = nullptr;
     std::string ip = "127.0.0.1";
@@ -190,20 +200,23 @@ struct TheInformer : Module
         {
             return;
         }
-        float invNyquist = 1.f / (sampleRate * 0.5f);
-
-        ampKurtosis = clamp(ampKurtosis + 2.f, 0.f, 4.f) * 0.25f;
-        ampSkewness = clamp(ampSkewness + 2.f, 0.f, 4.f) * 0.25f;
-        centroid *= invNyquist;
-        decrease = clamp((decrease + 0.05f) * 10.f, 0.f, 1.f);
-        flux = clamp(flux / 2048.f, 0.f, 1.f);
-        kurtosis = clamp(kurtosis + 2.f, 0.f, 4.f) * 0.25f;
-        irregularity = clamp(irregularity * 0.5f, 0.f, 1.f);
-        peak *= invNyquist;
-        rolloff *= invNyquist;
-        skewness = clamp(skewness + 2.f, 0.f, 4.f) * 0.25f;
-        slope = clamp((slope + 1.f) * 0.5f, 0.f, 1.f);
-        spread *= invNyquist * 0.5f;
+        timeNormalizer.set_context(sampleRate, BUFFER_SIZE);
+        freqNormalizer.set_context(sampleRate, BUFFER_SIZE);
+
+        using TD = Informer::TimeDescriptor;
+        using FD = Informer::FrequencyDescriptor;
+        ampKurtosis = timeNormalizer.process(static_cast<size_t>(TD::Kurtosis), ampKurtosis);
+        ampSkewness = timeNormalizer.process(static_cast<size_t>(TD::Skewness), ampSkewness);
+        centroid = freqNormalizer.process(static_cast<size_t>(FD::Centroid), centroid);
+        decrease = freqNormalizer.process(static_cast<size_t>(FD::Decrease), decrease);
+        flux = freqNormalizer.process(static_cast<size_t>(FD::Flux), flux);
+        kurtosis = freqNormalizer.process(static_cast<size_t>(FD::Kurtosis), kurtosis);
+        irregularity = freqNormalizer.process(static_cast<size_t>(FD::Irregularity), irregularity);
+        peak = freqNormalizer.process(static_cast<size_t>(FD::Peak), peak);
+        rolloff = freqNormalizer.process(static_cast<size_t>(FD::Rolloff), rolloff);
+        skewness = freqNormalizer.process(static_cast<size_t>(FD::Skewness), skewness);
+        slope = freqNormalizer.process(static_cast<size_t>(FD::Slope), slope);
+        spread = freqNormalizer.process(static_cast<size_t>(FD::Spread), spread);
     }
 
     inline std::vector<float> createMagBuffer(float *fftBuffer)
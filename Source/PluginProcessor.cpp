@@ -42,6 +42,7 @@ TheInformerAudioProcessor::TheInformerAudioProcessor() :
         std::make_unique<juce::AudioParameterInt>("ip4", "IP address Octet 4", 0, 255, 1),
         std::make_unique<juce::AudioParameterBool>("normalize", "Normalize Values", false),
         std::make_unique<juce::AudioParameterBool>("smoothing", "Smooth Master Parameters", false),
+        std::make_unique<juce::AudioParameterBool>("gate", "Skip Silent Channels", false),
         std::make_unique<juce::AudioParameterInt>("reportbands", "Report Bands", 2, 16, 3),
 }),
 fftProcessorSmall(orderSmall),
@@ -88,7 +89,12 @@ spreads(64, 0.0f)
     host = makeHost();
 
     normParameter = treeState.getRawParameterValue("normalize");
+    timeNormalizer.set_rules(Informer::time_normalization_rules<float>());
+    timeNormalizer.set_rule(static_cast<size_t>(Informer::TimeDescriptor::F0), Informer::static_normalization(0.0f, 1.0f, Informer::NormalizationUnit::Nyquist, false));
+    freqNormalizer.set_rules(Informer::frequency_normalization_rules<float>());
+    freqNormalizer.set_rule(static_cast<size_t>(Informer::FrequencyDescriptor::Kurtosis), Informer::static_normalization(2.0f, 0.25f));
     smoothParameter = treeState.getRawParameterValue("smoothing");
+    gateParameter = treeState.getRawParameterValue("gate");
 
     reportBandsParameter = treeState.getRawParameterValue("reportbands");
     reportBands = static_cast<unsigned int>(*reportBandsParameter);
@@ -98,6 +104,21 @@ spreads(64, 0.0f)
 TheInformerAudioProcessor::~TheInformerAudioProcessor()
 {
     --instanceCounter;
+
+#ifdef INFORMER_PROFILE
+    // Dump the timings of the descriptors when the last instance is removed
+    if (instanceCounter == 0)
+    {
+        for (const auto& stage : Informer::Profiler::summary())
+        {
+            DBG(juce::String(stage.name) + ": " + juce::String(stage.count) + " calls, mean " +
+                juce::String(stage.mean_ns, 0) + " ns, p99 " + juce::String(stage.p99_ns, 0) + " ns");
+        }
+
+        Informer::Profiler::write_chrome_trace(juce::File::getSpecialLocation(juce::File::tempDirectory)
+                                               .getChildFile("theinformer_profile.json").getFullPathName().toStdString());
+    }
+#endif
 }
 
 const juce::String TheInformerAudioProcessor::getName() const
@@ -201,6 +222,8 @@ void TheInformerAudioProcessor::prepareToPlay(double sampleRate, int samplesPerB
     if (sampleRate > 0.0)
     {
         invNyquist = 1.0f / (static_cast<float>(sampleRate) * 0.5f);
+        timeNormalizer.set_context(static_cast<float>(sampleRate), fftSize);
+        freqNormalizer.set_context(static_cast<float>(sampleRate), fftSize);
     }
 
     getEqualOctaveBandEdges();
@@ -212,21 +235,19 @@ void TheInformerAudioProcessor::prepareToPlay(double sampleRate, int samplesPerB
         f.coefficients = smoothingCoefficients;
     }
 
+    gating = *gateParameter > 0.5f;
+
     for (auto& d : computeDescriptors)
     {
         d.set_sample_rate(static_cast<float>(sampleRate));
         d.set_stft_size(fftSize);
+        d.set_activity_gating(gating);
     }
 
     for (auto& m : magnitudes)
     {
         m.resize(fftSize / 2u, 0.0f);
     }
-
-    for (auto& m : prev_magnitudes)
-    {
-        m.resize(fftSize / 2u, 0.0f);
-    }
 }
 
 void TheInformerAudioProcessor::releaseResources()
@@ -296,6 +317,17 @@ void TheInformerAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
         slope = 0.0f;
         spread = 0.0f;
 
+        // With the gate parameter on, channels below -100 dB skip the FFT and the analysis
+        if ((*gateParameter > 0.5f) != gating)
+        {
+            gating = !gating;
+
+            for (auto& d : computeDescriptors)
+            {
+                d.set_activity_gating(gating);
+            }
+        }
+
         std::array<std::vector<float>, 65> bandMagnitudes;
         if (static_cast<unsigned int>(*reportBandsParameter) != reportBands)
         {
@@ -340,25 +372,38 @@ void TheInformerAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
 
             /* SPECTRAL DESCRIPTORS */
 
-            fftData.at(ch).clear();
-            fftData.at(ch).resize(static_cast<unsigned int>(fftSize) * 2u);
-            for (unsigned int s = 0u; s < static_cast<unsigned int>(std::min(static_cast<unsigned int>(samples.at(ch).size()), fftSize)); s++)
+            const unsigned int fftHalf = static_cast<unsigned int>(fftSize) / 2u;
+
+            if (computeDescriptors.at(ch).get_activity() == Informer::Activity::Active)
             {
-                fftData.at(ch).at(s) = samples.at(ch).at(s);
-            }
-            window.get().multiplyWithWindowingTable(fftData.at(ch).data(), static_cast<unsigned int>(fftSize));
-            fftProcessor.get().performFrequencyOnlyForwardTransform(fftData.at(ch).data());
+                fftData.at(ch).clear();
+                fftData.at(ch).resize(static_cast<unsigned int>(fftSize) * 2u);
+                for (unsigned int s = 0u; s < static_cast<unsigned int>(std::min(static_cast<unsigned int>(samples.at(ch).size()), fftSize)); s++)
+                {
+                    fftData.at(ch).at(s) = samples.at(ch).at(s);
+                }
+                {
+                    INFORMER_PROFILE_SCOPE("window");
+                    window.get().multiplyWithWindowingTable(fftData.at(ch).data(), static_cast<unsigned int>(fftSize));
+                }
+                {
+                    INFORMER_PROFILE_SCOPE("fft");
+                    fftProcessor.get().performFrequencyOnlyForwardTransform(fftData.at(ch).data());
+                }
 
-            unsigned int fftHalf = static_cast<unsigned int>(fftSize) / 2u;
+                for (unsigned int k = 0; k < fftHalf; k++)
+                {
+                    magnitudes.at(ch).at(k) = fabs(fftData.at(ch).at(k));
+                }
 
-            for (unsigned int k = 0; k < fftHalf; k++)
+                // The analyzer keeps the previous magnitudes (for the flux) in its history
+                computeDescriptors.at(ch).set_magnitudes(magnitudes.at(ch));
+            }
+            else if (computeDescriptors.at(ch).get_activity() == Informer::Activity::Silent)
             {
-                prev_magnitudes.at(ch).at(k) = magnitudes.at(ch).at(k);
-                magnitudes.at(ch).at(k) = fabs(fftData.at(ch).at(k));
+                std::fill(magnitudes.at(ch).begin(), magnitudes.at(ch).end(), 0.0f);
             }
 
-            computeDescriptors.at(ch).set_previous_magnitudes(prev_magnitudes.at(ch));
-            computeDescriptors.at(ch).set_magnitudes(magnitudes.at(ch));
             computeDescriptors.at(ch).compute_descriptors(false, true);
             auto spectralDescriptors = computeDescriptors.at(ch).get_frequency_descriptors();
 
@@ -435,111 +480,30 @@ void TheInformerAudioProcessor::processBlock(juce::AudioBuffer<float>& buffer, j
 
         if (*normParameter > 0.5f)
         {
-            ampKurtosis += 2.0f;
-            ampKurtosis = std::clamp(ampKurtosis, 0.0f, 4.0f);
-            ampKurtosis *= 0.25f;
-            for (float& k : ampKurtoses)
-            {
-                k += 2.0f;
-                k = std::clamp(k, 0.0f, 4.0f);
-                k *= 0.25f;
-            }
-
-            kurtosis += 2.0f;
-            kurtosis = std::clamp(kurtosis, 0.0f, 4.0f);
-            kurtosis *= 0.25f;
-            for (float& k : kurtoses)
-            {
-                k += 2.0f;
-                k = std::clamp(k, 0.0f, 4.0f);
-                k *= 0.25f;
-            }
-
-            f0 *= invNyquist;
-            for (float& f : f0s)
-            {
-                f *= invNyquist;
-            }
-
-            centroid *= invNyquist;
-            for (float& c : centroids)
-            {
-                c *= invNyquist;
-            }
-
-            decrease += 0.05f;
-            decrease *= 10.0f;
-            decrease = std::clamp(decrease, 0.0f, 1.0f);
-            for (float& d : decreases)
-            {
-                d += 0.05f;
-                d *= 10.0f;
-                d = std::clamp(d, 0.0f, 1.0f);
-            }
-
-            flux /= static_cast<float>(fftSize) * 0.5f;
-            flux = std::clamp(flux, 0.0f, 1.0f);
-            for (float& f : fluxes)
-            {
-                f /= static_cast<float>(fftSize) * 0.5f;
-                f = std::clamp(f, 0.0f, 1.0f);
-            }
-
-            peak *= invNyquist;
-            for (float& f : peaks)
-            {
-                f *= invNyquist;
-            }
-
-            irregularity *= 0.5f;
-            irregularity = std::clamp(irregularity, 0.0f, 1.0f);
-            for (float& i : irregularities)
-            {
-                i *= 0.5f;
-                i = std::clamp(i, 0.0f, 1.0f);
-            }
-
-            rolloff *= invNyquist;
-            for (float& r : rolloffs)
-            {
-                r *= invNyquist;
-            }
-
-            ampSkewness = std::clamp(ampSkewness, -5.0f, 5.0f);
-            ampSkewness += 5.0f;
-            ampSkewness *= 0.1f;
-            for (float& s : ampSkewnesses)
+            // Mix and channel values of a descriptor, with the same static rule
+            auto normalize = [](auto& normalizer, auto descriptor, float& value, std::vector<float>& values)
             {
-                s = std::clamp(s, -5.0f, 5.0f);
-                s += 5.0f;
-                s *= 0.1f;
-            }
-
-            skewness = std::clamp(skewness, -5.0f, 5.0f);
-            skewness += 5.0f;
-            skewness *= 0.1f;
-            for (float& s : skewnesses)
-            {
-                s = std::clamp(s, -5.0f, 5.0f);
-                s += 5.0f;
-                s *= 0.1f;
-            }
-
-            slope += 1.0f;
-            slope *= 0.5;
-            slope = std::clamp(slope, 0.0f, 1.0f);
-            for (float& s : slopes)
-            {
-                s += 1.0f;
-                s *= 0.5;
-                s = std::clamp(s, 0.0f, 1.0f);
-            }
-
-            spread *= invNyquist * 0.5f;
-            for (float& s : spreads)
-            {
-                s *= invNyquist * 0.5f;
-            }
+                const size_t index = static_cast<size_t>(descriptor);
+                value = normalizer.process(index, value);
+                for (float& v : values)
+                {
+                    v = normalizer.process(index, v);
+                }
+            };
+
+            normalize(timeNormalizer, Informer::TimeDescriptor::Kurtosis, ampKurtosis, ampKurtoses);
+            normalize(timeNormalizer, Informer::TimeDescriptor::F0, f0, f0s);
+            normalize(timeNormalizer, Informer::TimeDescriptor::Skewness, ampSkewness, ampSkewnesses);
+            normalize(freqNormalizer, Informer::FrequencyDescriptor::Kurtosis, kurtosis, kurtoses);
+            normalize(freqNormalizer, Informer::FrequencyDescriptor::Centroid, centroid, centroids);
+            normalize(freqNormalizer, Informer::FrequencyDescriptor::Decrease, decrease, decreases);
+            normalize(freqNormalizer, Informer::FrequencyDescriptor::Flux, flux, fluxes);
+            normalize(freqNormalizer, Informer::FrequencyDescriptor::Peak, peak, peaks);
+            normalize(freqNormalizer, Informer::FrequencyDescriptor::Irregularity, irregularity, irregularities);
+            normalize(freqNormalizer, Informer::FrequencyDescriptor::Rolloff, rolloff, rolloffs);
+            normalize(freqNormalizer, Informer::FrequencyDescriptor::Skewness, skewness, skewnesses);
+            normalize(freqNormalizer, Informer::FrequencyDescriptor::Slope, slope, slopes);
+            normalize(freqNormalizer, Informer::FrequencyDescriptor::Spread, spread, spreads);
         }
 
         for (unsigned int i = 0u; i < 64u; i++)
@@ -110,12 +110,15 @@ public:
 
     std::atomic<float>* smoothParameter = nullptr;
 
+    std::atomic<float>* gateParameter = nullptr;
+
     std::atomic<float>* reportBandsParameter = nullptr;
 
     juce::Value rootValue;
 
 private:
     std::array<Informer::Informer<float>, 64> computeDescriptors;
+    bool gating = false;
     unsigned int updateBlocks = 1u;
     unsigned int counter = 0u;
     unsigned int expectedSamples = 0u;
@@ -128,6 +131,11 @@ private:
 
     float invNyquist = 1.0f / 44100.0f;
 
+    // Rules of the "Normalize Values" option: the ones of the library, with the pitch over
+    // Nyquist and a narrower range for the spectral kurtosis
+    Informer::Normalizer<float, static_cast<size_t>(Informer::TimeDescriptor::Count)> timeNormalizer;
+    Informer::Normalizer<float, static_cast<size_t>(Informer::FrequencyDescriptor::Count)> freqNormalizer;
+
     // 4096 samples, for sample rates up to 48000 Hz
     static constexpr int orderSmall = 12;
     static constexpr int fftSizeSmall = 1 << orderSmall;
@@ -143,7 +151,6 @@ private:
     float fftBandwidth = 44100.0f / (float)fftSizeSmall;
     std::array<float, fftSizeLarge / 2> frequencies = {};
     std::array<std::vector<float>, 64> magnitudes = {};
-    std::array<std::vector<float>, 64> prev_magnitudes = {};
     unsigned int fftSize = static_cast<unsigned int>(fftSizeSmall);
 
     std::reference_wrapper<juce::dsp::FFT> fftProcessor = fftProcessorSmall;